@@ -15,26 +15,32 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/ancillary_data.hpp"
 #include "asio/associated_allocator.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/async_result.hpp"
 #include "asio/awaitable.hpp"
 #include "asio/basic_datagram_socket.hpp"
 #include "asio/basic_deadline_timer.hpp"
+#include "asio/basic_file.hpp"
 #include "asio/basic_io_object.hpp"
+#include "asio/basic_random_access_file.hpp"
 #include "asio/basic_raw_socket.hpp"
 #include "asio/basic_seq_packet_socket.hpp"
 #include "asio/basic_serial_port.hpp"
+#include "asio/basic_sharded_acceptor.hpp"
 #include "asio/basic_signal_set.hpp"
 #include "asio/basic_socket.hpp"
 #include "asio/basic_socket_acceptor.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_socket_streambuf.hpp"
+#include "asio/basic_stream_file.hpp"
 #include "asio/basic_stream_socket.hpp"
 #include "asio/basic_streambuf.hpp"
 #include "asio/basic_waitable_timer.hpp"
 #include "asio/bind_executor.hpp"
 #include "asio/buffer.hpp"
+#include "asio/buffer_pool.hpp"
 #include "asio/buffered_read_stream_fwd.hpp"
 #include "asio/buffered_read_stream.hpp"
 #include "asio/buffered_stream_fwd.hpp"
@@ -43,6 +49,7 @@
 #include "asio/buffered_write_stream.hpp"
 #include "asio/buffers_iterator.hpp"
 #include "asio/co_spawn.hpp"
+#include "asio/coarse_steady_timer.hpp"
 #include "asio/completion_condition.hpp"
 #include "asio/compose.hpp"
 #include "asio/connect.hpp"
@@ -56,6 +63,7 @@
 #include "asio/execution_context.hpp"
 #include "asio/executor.hpp"
 #include "asio/executor_work_guard.hpp"
+#include "asio/file_base.hpp"
 #include "asio/generic/basic_endpoint.hpp"
 #include "asio/generic/datagram_protocol.hpp"
 #include "asio/generic/raw_protocol.hpp"
@@ -64,8 +72,10 @@
 #include "asio/handler_alloc_hook.hpp"
 #include "asio/handler_continuation_hook.hpp"
 #include "asio/handler_invoke_hook.hpp"
+#include "asio/handler_memory_statistics.hpp"
 #include "asio/high_resolution_timer.hpp"
 #include "asio/io_context.hpp"
+#include "asio/io_context_pool.hpp"
 #include "asio/io_context_strand.hpp"
 #include "asio/io_service.hpp"
 #include "asio/io_service_strand.hpp"
@@ -100,7 +110,9 @@
 #include "asio/local/connect_pair.hpp"
 #include "asio/local/datagram_protocol.hpp"
 #include "asio/local/stream_protocol.hpp"
+#include "asio/memory_resource.hpp"
 #include "asio/packaged_task.hpp"
+#include "asio/packet_timestamp.hpp"
 #include "asio/placeholders.hpp"
 #include "asio/posix/basic_descriptor.hpp"
 #include "asio/posix/basic_stream_descriptor.hpp"
@@ -108,6 +120,8 @@
 #include "asio/posix/descriptor_base.hpp"
 #include "asio/posix/stream_descriptor.hpp"
 #include "asio/post.hpp"
+#include "asio/random_access_file.hpp"
+#include "asio/reactor_statistics.hpp"
 #include "asio/read.hpp"
 #include "asio/read_at.hpp"
 #include "asio/read_until.hpp"
@@ -115,9 +129,12 @@
 #include "asio/serial_port.hpp"
 #include "asio/serial_port_base.hpp"
 #include "asio/signal_set.hpp"
+#include "asio/slab_memory_resource.hpp"
+#include "asio/slack_wait_traits.hpp"
 #include "asio/socket_base.hpp"
 #include "asio/steady_timer.hpp"
 #include "asio/strand.hpp"
+#include "asio/stream_file.hpp"
 #include "asio/streambuf.hpp"
 #include "asio/system_context.hpp"
 #include "asio/system_error.hpp"
@@ -127,6 +144,7 @@
 #include "asio/thread.hpp"
 #include "asio/thread_pool.hpp"
 #include "asio/time_traits.hpp"
+#include "asio/timing_wheel_wait_traits.hpp"
 #include "asio/use_awaitable.hpp"
 #include "asio/use_future.hpp"
 #include "asio/uses_executor.hpp"
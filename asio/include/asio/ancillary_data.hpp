@@ -0,0 +1,364 @@
+//
+// ancillary_data.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_ANCILLARY_DATA_HPP
+#define ASIO_ANCILLARY_DATA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include "asio/buffer.hpp"
+#include "asio/socket_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail { class ancillary_data_access; }
+
+/// Holds the ancillary data, or control messages, that accompany a message
+/// sent or received on a socket.
+/**
+ * The ancillary_data class refers to caller-supplied storage that holds a
+ * sequence of control messages, such as those carrying packet information,
+ * timestamps or file descriptors. For a send, control messages are appended
+ * using push_back(). After a receive, the control messages delivered by the
+ * operating system may be examined by iterating from begin() to end().
+ *
+ * The storage must remain valid for as long as the ancillary_data object is
+ * in use, including for the duration of any asynchronous operation to which
+ * the ancillary_data object is passed.
+ *
+ * Control messages are not supported on Windows. There, push_back() always
+ * fails, and receive operations deliver no control messages.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Receiving a datagram together with its destination address, on a socket
+ * that has the @c IP_PKTINFO option enabled:
+ * @code unsigned char storage[128];
+ * asio::ancillary_data control(asio::buffer(storage));
+ * socket.receive_msg(asio::buffer(data), control);
+ * for (asio::ancillary_data::const_iterator i = control.begin();
+ *     i != control.end(); ++i)
+ * {
+ *   if (i->level() == IPPROTO_IP && i->type() == IP_PKTINFO)
+ *     handle_pktinfo(i->data_as<in_pktinfo>());
+ * } @endcode
+ */
+class ancillary_data
+{
+public:
+  class message;
+  class const_iterator;
+
+  /// Construct an ancillary_data object that has no storage.
+  ancillary_data() ASIO_NOEXCEPT
+    : data_(0),
+      capacity_(0),
+      size_(0),
+      flags_(0)
+  {
+  }
+
+  /// Construct an ancillary_data object that uses the specified storage.
+  /**
+   * The start of the storage is aligned as required for control messages, so
+   * the capacity may be slightly less than the size of the storage.
+   */
+  ASIO_DECL explicit ancillary_data(
+      const mutable_buffer& storage) ASIO_NOEXCEPT;
+
+  /// Get the number of bytes of storage available for control messages.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return capacity_;
+  }
+
+  /// Get the number of bytes of control messages held.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Determine whether any control messages are held.
+  bool empty() const ASIO_NOEXCEPT
+  {
+    return size_ == 0;
+  }
+
+  /// Get the control messages in their native representation.
+  const_buffer data() const ASIO_NOEXCEPT
+  {
+    return const_buffer(data_, size_);
+  }
+
+  /// Get the flags returned by the most recent receive operation.
+  socket_base::message_flags flags() const ASIO_NOEXCEPT
+  {
+    return flags_;
+  }
+
+  /// Determine whether control messages were discarded by the most recent
+  /// receive operation because the storage was too small.
+  ASIO_DECL bool truncated() const ASIO_NOEXCEPT;
+
+  /// Remove all control messages.
+  void clear() ASIO_NOEXCEPT
+  {
+    size_ = 0;
+    flags_ = 0;
+  }
+
+  /// Append a control message.
+  /**
+   * @param level The protocol level of the control message, such as
+   * @c SOL_SOCKET.
+   *
+   * @param type The protocol-specific type of the control message, such as
+   * @c SCM_RIGHTS.
+   *
+   * @param data A pointer to the data of the control message.
+   *
+   * @param size The size of the data of the control message, in bytes.
+   *
+   * @returns @c true if the message was appended, or @c false if there is not
+   * enough space.
+   */
+  ASIO_DECL bool push_back(int level, int type,
+      const void* data, std::size_t size) ASIO_NOEXCEPT;
+
+  /// Append a control message containing a single value.
+  template <typename T>
+  bool push_back(int level, int type, const T& value) ASIO_NOEXCEPT
+  {
+    return push_back(level, type, &value, sizeof(T));
+  }
+
+  /// Get an iterator to the first control message.
+  ASIO_DECL const_iterator begin() const ASIO_NOEXCEPT;
+
+  /// Get an iterator to the end of the control messages.
+  const_iterator end() const ASIO_NOEXCEPT;
+
+  /// Get the number of bytes of storage needed to hold a control message with
+  /// the specified size of data.
+  ASIO_DECL static std::size_t space(std::size_t data_size) ASIO_NOEXCEPT;
+
+private:
+  friend class detail::ancillary_data_access;
+
+  // Get the header that follows the specified one, or null if there is none.
+  ASIO_DECL const void* next(const void* header) const ASIO_NOEXCEPT;
+
+  // Load the message that starts at the specified header.
+  ASIO_DECL static void load(const void* header, message& m) ASIO_NOEXCEPT;
+
+  // The aligned start of the storage.
+  void* data_;
+
+  // The number of bytes of aligned storage.
+  std::size_t capacity_;
+
+  // The number of bytes of control messages held.
+  std::size_t size_;
+
+  // The flags returned by the most recent receive.
+  socket_base::message_flags flags_;
+};
+
+/// A single control message held in an ancillary_data object.
+class ancillary_data::message
+{
+public:
+  /// Construct an empty message.
+  message() ASIO_NOEXCEPT
+    : level_(0),
+      type_(0),
+      data_(0),
+      size_(0)
+  {
+  }
+
+  /// Get the protocol level of the control message.
+  int level() const ASIO_NOEXCEPT
+  {
+    return level_;
+  }
+
+  /// Get the protocol-specific type of the control message.
+  int type() const ASIO_NOEXCEPT
+  {
+    return type_;
+  }
+
+  /// Get the data of the control message.
+  const_buffer data() const ASIO_NOEXCEPT
+  {
+    return const_buffer(data_, size_);
+  }
+
+  /// Get the data of the control message as a value of the specified type.
+  /**
+   * The data is copied, so no alignment requirements apply. If the data is
+   * smaller than @c T, the remaining bytes of the result are zero.
+   */
+  template <typename T>
+  T data_as() const ASIO_NOEXCEPT
+  {
+    T value;
+    std::memset(&value, 0, sizeof(T));
+    std::memcpy(&value, data_, size_ < sizeof(T) ? size_ : sizeof(T));
+    return value;
+  }
+
+private:
+  friend class ancillary_data;
+
+  int level_;
+  int type_;
+  const void* data_;
+  std::size_t size_;
+};
+
+/// A forward iterator over the control messages held in an ancillary_data
+/// object.
+class ancillary_data::const_iterator
+{
+public:
+  /// The type of the value pointed to by the iterator.
+  typedef message value_type;
+
+  /// The type of the result of applying operator->() to the iterator.
+  typedef const message* pointer;
+
+  /// The type of the result of applying operator*() to the iterator.
+  typedef const message& reference;
+
+  /// Distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The iterator category.
+  typedef std::forward_iterator_tag iterator_category;
+
+  /// Construct an iterator that does not refer to any control message.
+  const_iterator() ASIO_NOEXCEPT
+    : owner_(0),
+      header_(0)
+  {
+  }
+
+  /// Dereference the iterator.
+  const message& operator*() const ASIO_NOEXCEPT
+  {
+    return message_;
+  }
+
+  /// Dereference the iterator.
+  const message* operator->() const ASIO_NOEXCEPT
+  {
+    return &message_;
+  }
+
+  /// Increment operator (prefix).
+  const_iterator& operator++() ASIO_NOEXCEPT
+  {
+    header_ = owner_->next(header_);
+    if (header_)
+      ancillary_data::load(header_, message_);
+    return *this;
+  }
+
+  /// Increment operator (postfix).
+  const_iterator operator++(int) ASIO_NOEXCEPT
+  {
+    const_iterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  /// Test two iterators for equality.
+  friend bool operator==(const const_iterator& a,
+      const const_iterator& b) ASIO_NOEXCEPT
+  {
+    return a.header_ == b.header_;
+  }
+
+  /// Test two iterators for inequality.
+  friend bool operator!=(const const_iterator& a,
+      const const_iterator& b) ASIO_NOEXCEPT
+  {
+    return a.header_ != b.header_;
+  }
+
+private:
+  friend class ancillary_data;
+
+  const_iterator(const ancillary_data* owner,
+      const void* header) ASIO_NOEXCEPT
+    : owner_(owner),
+      header_(header)
+  {
+    if (header_)
+      ancillary_data::load(header_, message_);
+  }
+
+  const ancillary_data* owner_;
+  const void* header_;
+  message message_;
+};
+
+inline ancillary_data::const_iterator
+ancillary_data::end() const ASIO_NOEXCEPT
+{
+  return const_iterator(this, 0);
+}
+
+namespace detail {
+
+// Helper class to give socket operations access to the storage.
+class ancillary_data_access
+{
+public:
+  static void* data(ancillary_data& d)
+  {
+    return d.data_;
+  }
+
+  static std::size_t capacity(const ancillary_data& d)
+  {
+    return d.capacity_;
+  }
+
+  static void set_received(ancillary_data& d,
+      std::size_t size, int flags)
+  {
+    d.size_ = size;
+    d.flags_ = flags;
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/ancillary_data.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_ANCILLARY_DATA_HPP
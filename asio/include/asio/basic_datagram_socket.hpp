@@ -692,130 +692,1209 @@ public:
         initiate_async_send_to(this), handler, buffers, destination, flags);
   }
 
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system call
+   * where the platform supports it, such as @c sendmmsg on Linux. The function
+   * call will block until at least one datagram has been sent successfully or
+   * an error occurs.
+   *
+   * @param buffers An array of @c count buffers, each holding the data of one
+   * datagram.
+   *
+   * @param destinations An array of @c count endpoints, each being the remote
+   * endpoint to which the corresponding datagram will be sent. May be null if
+   * the socket is connected.
+   *
+   * @param count The number of datagrams in the batch.
+   *
+   * @returns The number of datagrams sent, which may be less than @c count.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note At most 64 datagrams are sent by a single call. Where the platform
+   * does not support sending a batch, a single datagram is sent.
+   */
+  std::size_t send_many(const const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_many(
+        this->impl_.get_implementation(), buffers, destinations, count, 0, ec);
+    asio::detail::throw_error(ec, "send_many");
+    return s;
+  }
+
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system call
+   * where the platform supports it, such as @c sendmmsg on Linux. The function
+   * call will block until at least one datagram has been sent successfully or
+   * an error occurs.
+   *
+   * @param buffers An array of @c count buffers, each holding the data of one
+   * datagram.
+   *
+   * @param destinations An array of @c count endpoints, each being the remote
+   * endpoint to which the corresponding datagram will be sent. May be null if
+   * the socket is connected.
+   *
+   * @param count The number of datagrams in the batch.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams sent, which may be less than @c count.
+   */
+  std::size_t send_many(const const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().send_many(
+        this->impl_.get_implementation(), buffers,
+        destinations, count, flags, ec);
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call where the platform supports it, such as @c sendmmsg on
+   * Linux. The function call always returns immediately.
+   *
+   * @param buffers An array of @c count buffers, each holding the data of one
+   * datagram. Ownership of the array and of the underlying memory blocks is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param destinations An array of @c count endpoints, each being the remote
+   * endpoint to which the corresponding datagram will be sent. May be null if
+   * the socket is connected. Ownership of the array is retained by the caller,
+   * which must guarantee that it remains valid until the handler is called.
+   *
+   * @param count The number of datagrams in the batch.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_sent // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note At most 64 datagrams are sent by a single operation, and fewer may
+   * be sent if the socket's send buffer fills. Where the platform does not
+   * support sending a batch, a single datagram is sent.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_many(const const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_many(this), handler, buffers,
+        destinations, count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call where the platform supports it, such as @c sendmmsg on
+   * Linux. The function call always returns immediately.
+   *
+   * @param buffers An array of @c count buffers, each holding the data of one
+   * datagram. Ownership of the array and of the underlying memory blocks is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param destinations An array of @c count endpoints, each being the remote
+   * endpoint to which the corresponding datagram will be sent. May be null if
+   * the socket is connected. Ownership of the array is retained by the caller,
+   * which must guarantee that it remains valid until the handler is called.
+   *
+   * @param count The number of datagrams in the batch.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_sent // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_many(const const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_many(this), handler, buffers,
+        destinations, count, flags);
+  }
+
+  /// Send a payload to the specified endpoint as a series of datagrams.
+  /**
+   * This function is used to send a payload that is divided into datagrams of
+   * @c segment_size bytes, the last of which may be shorter. Where the
+   * platform supports segmentation offload, such as @c UDP_SEGMENT on Linux,
+   * the payload is passed to the kernel in a single system call and divided
+   * there, or by the network interface. The function call will block until
+   * the data has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers containing the payload.
+   *
+   * @param destination The remote endpoint to which the datagrams will be sent.
+   *
+   * @param segment_size The size of each datagram. A value of zero sends the
+   * payload as a single datagram.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure. On platforms without
+   * segmentation offload, a payload larger than @c segment_size fails with
+   * asio::error::operation_not_supported.
+   *
+   * @par Example
+   * To send forty datagrams of 1200 bytes each from a contiguous buffer:
+   * @code
+   * socket.send_segments_to(
+   *     asio::buffer(data, 40 * 1200), destination, 1200);
+   * @endcode
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_segments_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_segments_to(
+        this->impl_.get_implementation(), buffers,
+        destination, segment_size, 0, ec);
+    asio::detail::throw_error(ec, "send_segments_to");
+    return s;
+  }
+
+  /// Send a payload to the specified endpoint as a series of datagrams.
+  /**
+   * This function is used to send a payload that is divided into datagrams of
+   * @c segment_size bytes, the last of which may be shorter. The function call
+   * will block until the data has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers containing the payload.
+   *
+   * @param destination The remote endpoint to which the datagrams will be sent.
+   *
+   * @param segment_size The size of each datagram. A value of zero sends the
+   * payload as a single datagram.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes sent.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_segments_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().send_segments_to(
+        this->impl_.get_implementation(), buffers,
+        destination, segment_size, flags, ec);
+  }
+
+  /// Start an asynchronous send of a payload as a series of datagrams.
+  /**
+   * This function is used to asynchronously send a payload that is divided
+   * into datagrams of @c segment_size bytes, the last of which may be shorter.
+   * The function call always returns immediately.
+   *
+   * @param buffers One or more data buffers containing the payload. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the datagrams will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param segment_size The size of each datagram. A value of zero sends the
+   * payload as a single datagram.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_segments_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_segments_to(this), handler, buffers,
+        destination, segment_size, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a payload as a series of datagrams.
+  /**
+   * This function is used to asynchronously send a payload that is divided
+   * into datagrams of @c segment_size bytes, the last of which may be shorter.
+   * The function call always returns immediately.
+   *
+   * @param buffers One or more data buffers containing the payload. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the datagrams will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param segment_size The size of each datagram. A value of zero sends the
+   * payload as a single datagram.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_segments_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_segments_to(this), handler, buffers,
+        destination, segment_size, flags);
+  }
+
+  /// Send a datagram together with ancillary data to the specified endpoint.
+  /**
+   * This function is used to send a datagram to the specified remote endpoint,
+   * along with the control messages held by an ancillary_data object, such as
+   * the source address or interface to be used for the datagram. The function
+   * call will block until the data has been sent successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   *
+   * @param control The control messages to be sent with the datagram.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure. On platforms that do
+   * not support ancillary data, sending non-empty ancillary data fails with
+   * asio::error::operation_not_supported.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_msg_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, const ancillary_data& control)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_msg(
+        this->impl_.get_implementation(), buffers,
+        &destination, control, 0, ec);
+    asio::detail::throw_error(ec, "send_msg_to");
+    return s;
+  }
+
+  /// Send a datagram together with ancillary data to the specified endpoint.
+  /**
+   * This function is used to send a datagram to the specified remote endpoint,
+   * along with the control messages held by an ancillary_data object. The
+   * function call will block until the data has been sent successfully or an
+   * error occurs.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   *
+   * @param control The control messages to be sent with the datagram.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_msg_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, const ancillary_data& control,
+      socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_msg(
+        this->impl_.get_implementation(), buffers,
+        &destination, control, flags, ec);
+    asio::detail::throw_error(ec, "send_msg_to");
+    return s;
+  }
+
+  /// Send a datagram together with ancillary data to the specified endpoint.
+  /**
+   * This function is used to send a datagram to the specified remote endpoint,
+   * along with the control messages held by an ancillary_data object. The
+   * function call will block until the data has been sent successfully or an
+   * error occurs.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   *
+   * @param control The control messages to be sent with the datagram.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes sent.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_msg_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, const ancillary_data& control,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().send_msg(
+        this->impl_.get_implementation(), buffers,
+        &destination, control, flags, ec);
+  }
+
+  /// Start an asynchronous send of a datagram together with ancillary data.
+  /**
+   * This function is used to asynchronously send a datagram to the specified
+   * remote endpoint, along with the control messages held by an
+   * ancillary_data object. The function call always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param control The control messages to be sent with the datagram. The
+   * storage referred to by the ancillary_data object must remain valid until
+   * the handler is called.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_msg_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, const ancillary_data& control,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_msg_to(this), handler, buffers,
+        destination, &control, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a datagram together with ancillary data.
+  /**
+   * This function is used to asynchronously send a datagram to the specified
+   * remote endpoint, along with the control messages held by an
+   * ancillary_data object. The function call always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param control The control messages to be sent with the datagram. The
+   * storage referred to by the ancillary_data object must remain valid until
+   * the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_msg_to(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, const ancillary_data& control,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_msg_to(this), handler, buffers,
+        destination, &control, flags);
+  }
+
+  /// Receive some data on a connected socket.
+  /**
+   * This function is used to receive data on the datagram socket. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note The receive operation can only be used with a connected socket. Use
+   * the receive_from function to receive data on an unconnected datagram
+   * socket.
+   *
+   * @par Example
+   * To receive into a single data buffer use the @ref buffer function as
+   * follows:
+   * @code socket.receive(asio::buffer(data, size)); @endcode
+   * See the @ref buffer documentation for information on receiving into
+   * multiple buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive(
+        this->impl_.get_implementation(), buffers, 0, ec);
+    asio::detail::throw_error(ec, "receive");
+    return s;
+  }
+
+  /// Receive some data on a connected socket.
+  /**
+   * This function is used to receive data on the datagram socket. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note The receive operation can only be used with a connected socket. Use
+   * the receive_from function to receive data on an unconnected datagram
+   * socket.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive(
+        this->impl_.get_implementation(), buffers, flags, ec);
+    asio::detail::throw_error(ec, "receive");
+    return s;
+  }
+
   /// Receive some data on a connected socket.
   /**
-   * This function is used to receive data on the datagram socket. The function
-   * call will block until data has been received successfully or an error
-   * occurs.
+   * This function is used to receive data on the datagram socket. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received.
+   *
+   * @note The receive operation can only be used with a connected socket. Use
+   * the receive_from function to receive data on an unconnected datagram
+   * socket.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive(
+        this->impl_.get_implementation(), buffers, flags, ec);
+  }
+
+  /// Start an asynchronous receive on a connected socket.
+  /**
+   * This function is used to asynchronously receive data from the datagram
+   * socket. The function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The async_receive operation can only be used with a connected socket.
+   * Use the async_receive_from function to receive data on an unconnected
+   * datagram socket.
+   *
+   * @par Example
+   * To receive into a single data buffer use the @ref buffer function as
+   * follows:
+   * @code
+   * socket.async_receive(asio::buffer(data, size), handler);
+   * @endcode
+   * See the @ref buffer documentation for information on receiving into
+   * multiple buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive(this), handler,
+        buffers, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive on a connected socket.
+  /**
+   * This function is used to asynchronously receive data from the datagram
+   * socket. The function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The async_receive operation can only be used with a connected socket.
+   * Use the async_receive_from function to receive data on an unconnected
+   * datagram socket.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive(this), handler, buffers, flags);
+  }
+
+  /// Receive a datagram with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram. The function call will block
+   * until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * To receive into a single data buffer use the @ref buffer function as
+   * follows:
+   * @code
+   * asio::ip::udp::endpoint sender_endpoint;
+   * socket.receive_from(
+   *     asio::buffer(data, size), sender_endpoint);
+   * @endcode
+   * See the @ref buffer documentation for information on receiving into
+   * multiple buffers in one go, and how to use it with arrays, boost::array or
+   * std::vector.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_from(
+        this->impl_.get_implementation(), buffers, sender_endpoint, 0, ec);
+    asio::detail::throw_error(ec, "receive_from");
+    return s;
+  }
+  
+  /// Receive a datagram with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram. The function call will block
+   * until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_from(
+        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
+    asio::detail::throw_error(ec, "receive_from");
+    return s;
+  }
+  
+  /// Receive a datagram with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram. The function call will block
+   * until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_from(
+        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
+  }
+
+  /// Start an asynchronous receive.
+  /**
+   * This function is used to asynchronously receive a datagram. The function
+   * call always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
    *
-   * @returns The number of bytes received.
-   *
-   * @throws asio::system_error Thrown on failure.
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
    *
-   * @note The receive operation can only be used with a connected socket. Use
-   * the receive_from function to receive data on an unconnected datagram
-   * socket.
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
    *
    * @par Example
    * To receive into a single data buffer use the @ref buffer function as
    * follows:
-   * @code socket.receive(asio::buffer(data, size)); @endcode
+   * @code socket.async_receive_from(
+   *     asio::buffer(data, size), sender_endpoint, handler); @endcode
    * See the @ref buffer documentation for information on receiving into
    * multiple buffers in one go, and how to use it with arrays, boost::array or
    * std::vector.
    */
-  template <typename MutableBufferSequence>
-  std::size_t receive(const MutableBufferSequence& buffers)
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
   {
-    asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive(
-        this->impl_.get_implementation(), buffers, 0, ec);
-    asio::detail::throw_error(ec, "receive");
-    return s;
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from(this), handler, buffers,
+        &sender_endpoint, socket_base::message_flags(0));
   }
 
-  /// Receive some data on a connected socket.
+  /// Start an asynchronous receive.
   /**
-   * This function is used to receive data on the datagram socket. The function
-   * call will block until data has been received successfully or an error
-   * occurs.
+   * This function is used to asynchronously receive a datagram. The function
+   * call always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
    *
    * @param flags Flags specifying how the receive call is to be made.
    *
-   * @returns The number of bytes received.
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from(this), handler,
+        buffers, &sender_endpoint, flags);
+  }
+
+  /// Receive a batch of datagrams with the endpoints of their senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call where the platform supports it, such as @c recvmmsg on Linux. The
+   * function call will block until at least one datagram has been received
+   * successfully or an error occurs. Any further datagrams that are already
+   * queued on the socket are received without blocking.
+   *
+   * @param buffers An array of @c count buffers, each of which will receive
+   * the data of one datagram.
+   *
+   * @param sender_endpoints An array of @c count endpoints, each of which will
+   * receive the endpoint of the remote sender of the corresponding datagram.
+   * May be null.
+   *
+   * @param sizes An array of @c count elements, each of which will receive the
+   * size of the corresponding datagram.
+   *
+   * @param count The number of datagrams that may be received.
+   *
+   * @returns The number of datagrams received. Only the first elements of
+   * @c sender_endpoints and @c sizes, up to this number, are set.
    *
    * @throws asio::system_error Thrown on failure.
    *
-   * @note The receive operation can only be used with a connected socket. Use
-   * the receive_from function to receive data on an unconnected datagram
-   * socket.
+   * @note At most 64 datagrams are received by a single call. Where the
+   * platform does not support receiving a batch, a single datagram is
+   * received.
    */
-  template <typename MutableBufferSequence>
-  std::size_t receive(const MutableBufferSequence& buffers,
-      socket_base::message_flags flags)
+  std::size_t receive_many(const mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count)
   {
     asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive(
-        this->impl_.get_implementation(), buffers, flags, ec);
-    asio::detail::throw_error(ec, "receive");
+    std::size_t s = this->impl_.get_service().receive_many(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoints, sizes, count, 0, ec);
+    asio::detail::throw_error(ec, "receive_many");
     return s;
   }
 
-  /// Receive some data on a connected socket.
+  /// Receive a batch of datagrams with the endpoints of their senders.
   /**
-   * This function is used to receive data on the datagram socket. The function
-   * call will block until data has been received successfully or an error
-   * occurs.
+   * This function is used to receive several datagrams using a single system
+   * call where the platform supports it, such as @c recvmmsg on Linux. The
+   * function call will block until at least one datagram has been received
+   * successfully or an error occurs. Any further datagrams that are already
+   * queued on the socket are received without blocking.
    *
-   * @param buffers One or more buffers into which the data will be received.
+   * @param buffers An array of @c count buffers, each of which will receive
+   * the data of one datagram.
+   *
+   * @param sender_endpoints An array of @c count endpoints, each of which will
+   * receive the endpoint of the remote sender of the corresponding datagram.
+   * May be null.
+   *
+   * @param sizes An array of @c count elements, each of which will receive the
+   * size of the corresponding datagram.
+   *
+   * @param count The number of datagrams that may be received.
    *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @param ec Set to indicate what error occurred, if any.
    *
-   * @returns The number of bytes received.
-   *
-   * @note The receive operation can only be used with a connected socket. Use
-   * the receive_from function to receive data on an unconnected datagram
-   * socket.
+   * @returns The number of datagrams received. Only the first elements of
+   * @c sender_endpoints and @c sizes, up to this number, are set.
    */
-  template <typename MutableBufferSequence>
-  std::size_t receive(const MutableBufferSequence& buffers,
+  std::size_t receive_many(const mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
       socket_base::message_flags flags, asio::error_code& ec)
   {
-    return this->impl_.get_service().receive(
-        this->impl_.get_implementation(), buffers, flags, ec);
+    return this->impl_.get_service().receive_many(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoints, sizes, count, flags, ec);
   }
 
-  /// Start an asynchronous receive on a connected socket.
+  /// Start an asynchronous receive of a batch of datagrams.
   /**
-   * This function is used to asynchronously receive data from the datagram
-   * socket. The function call always returns immediately.
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call where the platform supports it, such as @c recvmmsg on
+   * Linux. The function call always returns immediately. The operation
+   * completes once at least one datagram has been received, and also receives
+   * any further datagrams that are already queued on the socket.
+   *
+   * @param buffers An array of @c count buffers, each of which will receive
+   * the data of one datagram. Ownership of the array and of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
    *
-   * @param buffers One or more buffers into which the data will be received.
-   * Although the buffers object may be copied as necessary, ownership of the
-   * underlying memory blocks is retained by the caller, which must guarantee
-   * that they remain valid until the handler is called.
+   * @param sender_endpoints An array of @c count endpoints, each of which will
+   * receive the endpoint of the remote sender of the corresponding datagram.
+   * May be null. Ownership of the array is retained by the caller, which must
+   * guarantee that it remains valid until the handler is called.
+   *
+   * @param sizes An array of @c count elements, each of which will receive the
+   * size of the corresponding datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it remains valid until the handler
+   * is called.
+   *
+   * @param count The number of datagrams that may be received.
    *
    * @param handler The handler to be called when the receive operation
    * completes. Copies will be made of the handler as required. The function
    * signature of the handler must be:
    * @code void handler(
    *   const asio::error_code& error, // Result of operation.
-   *   std::size_t bytes_transferred           // Number of bytes received.
+   *   std::size_t messages_received // Number of datagrams received.
    * ); @endcode
    * Regardless of whether the asynchronous operation completes immediately or
    * not, the handler will not be invoked from within this function. On
    * immediate completion, invocation of the handler will be performed in a
    * manner equivalent to using asio::post().
    *
-   * @note The async_receive operation can only be used with a connected socket.
-   * Use the async_receive_from function to receive data on an unconnected
-   * datagram socket.
+   * @note At most 64 datagrams are received by a single operation. Where the
+   * platform does not support receiving a batch, a single datagram is
+   * received.
    *
    * @par Example
-   * To receive into a single data buffer use the @ref buffer function as
-   * follows:
    * @code
-   * socket.async_receive(asio::buffer(data, size), handler);
+   * std::array<char, 1500> data[32];
+   * asio::mutable_buffer buffers[32];
+   * asio::ip::udp::endpoint senders[32];
+   * std::size_t sizes[32];
+   * for (int i = 0; i < 32; ++i)
+   *   buffers[i] = asio::buffer(data[i]);
+   * socket.async_receive_many(buffers, senders, sizes, 32, handler);
    * @endcode
-   * See the @ref buffer documentation for information on receiving into
-   * multiple buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_many(const mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_many(this), handler, buffers,
+        sender_endpoints, sizes, count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call where the platform supports it, such as @c recvmmsg on
+   * Linux. The function call always returns immediately. The operation
+   * completes once at least one datagram has been received, and also receives
+   * any further datagrams that are already queued on the socket.
+   *
+   * @param buffers An array of @c count buffers, each of which will receive
+   * the data of one datagram. Ownership of the array and of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param sender_endpoints An array of @c count endpoints, each of which will
+   * receive the endpoint of the remote sender of the corresponding datagram.
+   * May be null. Ownership of the array is retained by the caller, which must
+   * guarantee that it remains valid until the handler is called.
+   *
+   * @param sizes An array of @c count elements, each of which will receive the
+   * size of the corresponding datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it remains valid until the handler
+   * is called.
+   *
+   * @param count The number of datagrams that may be received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_received // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_many(const mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_many(this), handler, buffers,
+        sender_endpoints, sizes, count, flags);
+  }
+
+  /// Receive one or more coalesced datagrams with the endpoint of the sender.
+  /**
+   * This function is used to receive data that may consist of several
+   * datagrams from the same sender, coalesced by receive offload. Coalescing
+   * takes place only when it has been enabled on the socket, such as with the
+   * ip::udp::receive_offload option. All datagrams other than the last have a
+   * size of @c segment_size bytes. The function call will block until data has
+   * been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * The buffers should be large enough to hold a coalesced payload of up to
+   * 64KB.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Receives the size of each datagram. When the data is
+   * a single datagram, this is the number of bytes received.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * std::size_t segment_size = 0;
+   * std::size_t n = socket.receive_segments_from(
+   *     asio::buffer(data, 65536), sender_endpoint, segment_size);
+   * for (std::size_t i = 0; i < n; i += segment_size)
+   *   process(data + i, std::min(segment_size, n - i));
+   * @endcode
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_segments_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_segments_from(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, 0, ec);
+    asio::detail::throw_error(ec, "receive_segments_from");
+    return s;
+  }
+
+  /// Receive one or more coalesced datagrams with the endpoint of the sender.
+  /**
+   * This function is used to receive data that may consist of several
+   * datagrams from the same sender, coalesced by receive offload. All
+   * datagrams other than the last have a size of @c segment_size bytes. The
+   * function call will block until data has been received successfully or an
+   * error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Receives the size of each datagram. When the data is
+   * a single datagram, this is the number of bytes received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_segments_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_segments_from(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, flags, ec);
+  }
+
+  /// Start an asynchronous receive of one or more coalesced datagrams.
+  /**
+   * This function is used to asynchronously receive data that may consist of
+   * several datagrams from the same sender, coalesced by receive offload. All
+   * datagrams other than the last have a size of @c segment_size bytes. The
+   * function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param segment_size Receives the size of each datagram before the handler
+   * is called. Ownership of the segment_size object is retained by the caller,
+   * which must guarantee that it is valid until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
    */
   template <typename MutableBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
@@ -823,26 +1902,38 @@ public:
           ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
   ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
       void (asio::error_code, std::size_t))
-  async_receive(const MutableBufferSequence& buffers,
+  async_receive_segments_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
       ASIO_MOVE_ARG(ReadHandler) handler
         ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
   {
     return async_initiate<ReadHandler,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive(this), handler,
-        buffers, socket_base::message_flags(0));
+        initiate_async_receive_segments_from(this), handler, buffers,
+        &sender_endpoint, &segment_size, socket_base::message_flags(0));
   }
 
-  /// Start an asynchronous receive on a connected socket.
+  /// Start an asynchronous receive of one or more coalesced datagrams.
   /**
-   * This function is used to asynchronously receive data from the datagram
-   * socket. The function call always returns immediately.
+   * This function is used to asynchronously receive data that may consist of
+   * several datagrams from the same sender, coalesced by receive offload. All
+   * datagrams other than the last have a size of @c segment_size bytes. The
+   * function call always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
    * Although the buffers object may be copied as necessary, ownership of the
    * underlying memory blocks is retained by the caller, which must guarantee
    * that they remain valid until the handler is called.
    *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param segment_size Receives the size of each datagram before the handler
+   * is called. Ownership of the segment_size object is retained by the caller,
+   * which must guarantee that it is valid until the handler is called.
+   *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @param handler The handler to be called when the receive operation
@@ -856,10 +1947,6 @@ public:
    * not, the handler will not be invoked from within this function. On
    * immediate completion, invocation of the handler will be performed in a
    * manner equivalent to using asio::post().
-   *
-   * @note The async_receive operation can only be used with a connected socket.
-   * Use the async_receive_from function to receive data on an unconnected
-   * datagram socket.
    */
   template <typename MutableBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
@@ -867,63 +1954,79 @@ public:
           ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
   ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
       void (asio::error_code, std::size_t))
-  async_receive(const MutableBufferSequence& buffers,
+  async_receive_segments_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
       socket_base::message_flags flags,
       ASIO_MOVE_ARG(ReadHandler) handler
         ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
   {
     return async_initiate<ReadHandler,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive(this), handler, buffers, flags);
+        initiate_async_receive_segments_from(this), handler, buffers,
+        &sender_endpoint, &segment_size, flags);
   }
 
-  /// Receive a datagram with the endpoint of the sender.
+  /// Receive a datagram together with any ancillary data.
   /**
-   * This function is used to receive a datagram. The function call will block
-   * until data has been received successfully or an error occurs.
+   * This function is used to receive a datagram, the endpoint of its sender
+   * and any ancillary data (control messages) that accompanies it, such as
+   * the packet information or timestamps requested using socket options. The
+   * function call will block until data has been received successfully or an
+   * error occurs.
    *
    * @param buffers One or more buffers into which the data will be received.
    *
    * @param sender_endpoint An endpoint object that receives the endpoint of
    * the remote sender of the datagram.
    *
+   * @param control Refers to storage into which the ancillary data will be
+   * received. On return, the ancillary_data object describes the control
+   * messages that were received.
+   *
    * @returns The number of bytes received.
    *
    * @throws asio::system_error Thrown on failure.
    *
    * @par Example
-   * To receive into a single data buffer use the @ref buffer function as
-   * follows:
+   * To find the local address to which a datagram was sent, on a socket for
+   * which the @c IP_PKTINFO option has been enabled:
    * @code
-   * asio::ip::udp::endpoint sender_endpoint;
-   * socket.receive_from(
-   *     asio::buffer(data, size), sender_endpoint);
+   * unsigned char storage[128];
+   * asio::ancillary_data control(asio::buffer(storage));
+   * asio::ip::udp::endpoint sender;
+   * socket.receive_msg_from(asio::buffer(data), sender, control);
+   * for (const asio::ancillary_data::message& m : control)
+   *   if (m.level() == IPPROTO_IP && m.type() == IP_PKTINFO)
+   *     handle_pktinfo(m.data_as<in_pktinfo>());
    * @endcode
-   * See the @ref buffer documentation for information on receiving into
-   * multiple buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
    */
   template <typename MutableBufferSequence>
-  std::size_t receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint)
+  std::size_t receive_msg_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, ancillary_data& control)
   {
     asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive_from(
-        this->impl_.get_implementation(), buffers, sender_endpoint, 0, ec);
-    asio::detail::throw_error(ec, "receive_from");
+    std::size_t s = this->impl_.get_service().receive_msg(
+        this->impl_.get_implementation(), buffers,
+        &sender_endpoint, control, 0, ec);
+    asio::detail::throw_error(ec, "receive_msg_from");
     return s;
   }
-  
-  /// Receive a datagram with the endpoint of the sender.
+
+  /// Receive a datagram together with any ancillary data.
   /**
-   * This function is used to receive a datagram. The function call will block
-   * until data has been received successfully or an error occurs.
+   * This function is used to receive a datagram, the endpoint of its sender
+   * and any ancillary data (control messages) that accompanies it. The
+   * function call will block until data has been received successfully or an
+   * error occurs.
    *
    * @param buffers One or more buffers into which the data will be received.
    *
    * @param sender_endpoint An endpoint object that receives the endpoint of
    * the remote sender of the datagram.
    *
+   * @param control Refers to storage into which the ancillary data will be
+   * received.
+   *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @returns The number of bytes received.
@@ -931,26 +2034,33 @@ public:
    * @throws asio::system_error Thrown on failure.
    */
   template <typename MutableBufferSequence>
-  std::size_t receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint, socket_base::message_flags flags)
+  std::size_t receive_msg_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, ancillary_data& control,
+      socket_base::message_flags flags)
   {
     asio::error_code ec;
-    std::size_t s = this->impl_.get_service().receive_from(
-        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
-    asio::detail::throw_error(ec, "receive_from");
+    std::size_t s = this->impl_.get_service().receive_msg(
+        this->impl_.get_implementation(), buffers,
+        &sender_endpoint, control, flags, ec);
+    asio::detail::throw_error(ec, "receive_msg_from");
     return s;
   }
-  
-  /// Receive a datagram with the endpoint of the sender.
+
+  /// Receive a datagram together with any ancillary data.
   /**
-   * This function is used to receive a datagram. The function call will block
-   * until data has been received successfully or an error occurs.
+   * This function is used to receive a datagram, the endpoint of its sender
+   * and any ancillary data (control messages) that accompanies it. The
+   * function call will block until data has been received successfully or an
+   * error occurs.
    *
    * @param buffers One or more buffers into which the data will be received.
    *
    * @param sender_endpoint An endpoint object that receives the endpoint of
    * the remote sender of the datagram.
    *
+   * @param control Refers to storage into which the ancillary data will be
+   * received.
+   *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @param ec Set to indicate what error occurred, if any.
@@ -958,18 +2068,21 @@ public:
    * @returns The number of bytes received.
    */
   template <typename MutableBufferSequence>
-  std::size_t receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint, socket_base::message_flags flags,
-      asio::error_code& ec)
+  std::size_t receive_msg_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, ancillary_data& control,
+      socket_base::message_flags flags, asio::error_code& ec)
   {
-    return this->impl_.get_service().receive_from(
-        this->impl_.get_implementation(), buffers, sender_endpoint, flags, ec);
+    return this->impl_.get_service().receive_msg(
+        this->impl_.get_implementation(), buffers,
+        &sender_endpoint, control, flags, ec);
   }
 
-  /// Start an asynchronous receive.
+  /// Start an asynchronous receive of a datagram together with any ancillary
+  /// data.
   /**
-   * This function is used to asynchronously receive a datagram. The function
-   * call always returns immediately.
+   * This function is used to asynchronously receive a datagram, the endpoint
+   * of its sender and any ancillary data (control messages) that accompanies
+   * it. The function call always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
    * Although the buffers object may be copied as necessary, ownership of the
@@ -981,6 +2094,11 @@ public:
    * is retained by the caller, which must guarantee that it is valid until the
    * handler is called.
    *
+   * @param control Refers to storage into which the ancillary data will be
+   * received. Ownership of the ancillary_data object and its storage is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
    * @param handler The handler to be called when the receive operation
    * completes. Copies will be made of the handler as required. The function
    * signature of the handler must be:
@@ -992,15 +2110,6 @@ public:
    * not, the handler will not be invoked from within this function. On
    * immediate completion, invocation of the handler will be performed in a
    * manner equivalent to using asio::post().
-   *
-   * @par Example
-   * To receive into a single data buffer use the @ref buffer function as
-   * follows:
-   * @code socket.async_receive_from(
-   *     asio::buffer(data, size), sender_endpoint, handler); @endcode
-   * See the @ref buffer documentation for information on receiving into
-   * multiple buffers in one go, and how to use it with arrays, boost::array or
-   * std::vector.
    */
   template <typename MutableBufferSequence,
       ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
@@ -1008,21 +2117,23 @@ public:
           ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
   ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
       void (asio::error_code, std::size_t))
-  async_receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint,
+  async_receive_msg_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, ancillary_data& control,
       ASIO_MOVE_ARG(ReadHandler) handler
         ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
   {
     return async_initiate<ReadHandler,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive_from(this), handler, buffers,
-        &sender_endpoint, socket_base::message_flags(0));
+        initiate_async_receive_msg_from(this), handler, buffers,
+        &sender_endpoint, &control, socket_base::message_flags(0));
   }
 
-  /// Start an asynchronous receive.
+  /// Start an asynchronous receive of a datagram together with any ancillary
+  /// data.
   /**
-   * This function is used to asynchronously receive a datagram. The function
-   * call always returns immediately.
+   * This function is used to asynchronously receive a datagram, the endpoint
+   * of its sender and any ancillary data (control messages) that accompanies
+   * it. The function call always returns immediately.
    *
    * @param buffers One or more buffers into which the data will be received.
    * Although the buffers object may be copied as necessary, ownership of the
@@ -1034,6 +2145,11 @@ public:
    * is retained by the caller, which must guarantee that it is valid until the
    * handler is called.
    *
+   * @param control Refers to storage into which the ancillary data will be
+   * received. Ownership of the ancillary_data object and its storage is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
    * @param flags Flags specifying how the receive call is to be made.
    *
    * @param handler The handler to be called when the receive operation
@@ -1054,15 +2170,16 @@ public:
           ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
   ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
       void (asio::error_code, std::size_t))
-  async_receive_from(const MutableBufferSequence& buffers,
-      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+  async_receive_msg_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, ancillary_data& control,
+      socket_base::message_flags flags,
       ASIO_MOVE_ARG(ReadHandler) handler
         ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
   {
     return async_initiate<ReadHandler,
       void (asio::error_code, std::size_t)>(
-        initiate_async_receive_from(this), handler,
-        buffers, &sender_endpoint, flags);
+        initiate_async_receive_msg_from(this), handler, buffers,
+        &sender_endpoint, &control, flags);
   }
 
 private:
@@ -1134,6 +2251,75 @@ private:
     basic_datagram_socket* self_;
   };
 
+  class initiate_async_send_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_many(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const const_buffer* buffers, const endpoint_type* destinations,
+        std::size_t count, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_many(
+          self_->impl_.get_implementation(), buffers, destinations, count,
+          flags, handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_send_segments_to
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_segments_to(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type& destination,
+        std::size_t segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_segments_to(
+          self_->impl_.get_implementation(), buffers, destination,
+          segment_size, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
   class initiate_async_receive
   {
   public:
@@ -1201,6 +2387,147 @@ private:
   private:
     basic_datagram_socket* self_;
   };
+
+  class initiate_async_receive_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_many(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const mutable_buffer* buffers, endpoint_type* sender_endpoints,
+        std::size_t* sizes, std::size_t count,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_many(
+          self_->impl_.get_implementation(), buffers, sender_endpoints,
+          sizes, count, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_segments_from
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_segments_from(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        std::size_t* segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_segments_from(
+          self_->impl_.get_implementation(), buffers, *sender_endpoint,
+          *segment_size, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_send_msg_to
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_msg_to(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type& destination,
+        const ancillary_data* control, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_msg(
+          self_->impl_.get_implementation(), buffers, &destination,
+          *control, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_msg_from
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_msg_from(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        ancillary_data* control, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_msg(
+          self_->impl_.get_implementation(), buffers, sender_endpoint,
+          *control, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
 };
 
 } // namespace asio
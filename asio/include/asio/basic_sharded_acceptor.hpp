@@ -0,0 +1,470 @@
+//
+// basic_sharded_acceptor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_SHARDED_ACCEPTOR_HPP
+#define ASIO_BASIC_SHARDED_ACCEPTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/async_result.hpp"
+#include "asio/basic_socket_acceptor.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_option.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/executor.hpp"
+#include "asio/io_context.hpp"
+
+// The socket option that lets several listening sockets share an endpoint and
+// has the kernel spread incoming connections between them. On other platforms
+// SO_REUSEPORT lets the sockets share the endpoint, but delivers every
+// connection to the same socket.
+#if defined(SO_REUSEPORT_LB)
+# define ASIO_SHARDED_ACCEPTOR_REUSE_PORT SO_REUSEPORT_LB
+#elif defined(__linux__) && defined(SO_REUSEPORT)
+# define ASIO_SHARDED_ACCEPTOR_REUSE_PORT SO_REUSEPORT
+#endif // defined(__linux__) && defined(SO_REUSEPORT)
+
+#if !defined(ASIO_SHARDED_ACCEPTOR_REUSE_PORT) \
+  && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <cerrno>
+# include <unistd.h>
+#endif // !defined(ASIO_SHARDED_ACCEPTOR_REUSE_PORT)
+       //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if !defined(ASIO_BASIC_SHARDED_ACCEPTOR_FWD_DECL)
+#define ASIO_BASIC_SHARDED_ACCEPTOR_FWD_DECL
+
+// Forward declaration with defaulted arguments.
+template <typename Protocol, typename Executor = executor>
+class basic_sharded_acceptor;
+
+#endif // !defined(ASIO_BASIC_SHARDED_ACCEPTOR_FWD_DECL)
+
+/// Accepts new connections on a set of listening sockets, one per executor.
+/**
+ * The basic_sharded_acceptor class template presents several acceptors, each
+ * associated with a different executor (typically each with its own
+ * io_context), as a single logical acceptor bound to one endpoint.
+ *
+ * On Linux, where the @c SO_REUSEPORT socket option distributes incoming
+ * connections between listening sockets, and on platforms that provide
+ * @c SO_REUSEPORT_LB, each shard has its own listening socket and the
+ * operating system spreads connections between them, so that accepting
+ * connections scales with the number of shards. Otherwise, on POSIX platforms,
+ * all shards share a single listening socket, and a connection is accepted by
+ * whichever shard's accept operation the operating system wakes. On Windows
+ * only a single shard is supported.
+ *
+ * A connection accepted by a shard is associated with that shard's executor.
+ * When async_accept() is called from a thread that is running one of the
+ * shards' executors, the accept is performed on that shard; otherwise the
+ * shards are used in turn. An accept loop that is started once on each shard,
+ * and which restarts itself from its completion handler, therefore keeps every
+ * shard accepting connections for the io_context that will serve them.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for concurrent calls to async_accept(), provided
+ * each shard is only accessed from its own executor. Unsafe otherwise.
+ *
+ * @par Example
+ * Starting an accept loop on each of a number of io_context objects:
+ * @code
+ * std::vector<asio::io_context::executor_type> executors;
+ * ...
+ * asio::ip::tcp::sharded_acceptor acceptor(
+ *     executors.begin(), executors.end(),
+ *     asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+ *
+ * for (std::size_t i = 0; i < acceptor.size(); ++i)
+ *   asio::post(acceptor.shard(i).get_executor(),
+ *       [&]{ start_accept(acceptor); });
+ * @endcode
+ */
+template <typename Protocol, typename Executor>
+class basic_sharded_acceptor
+  : private noncopyable
+{
+public:
+  /// The type of the executor associated with each shard.
+  typedef Executor executor_type;
+
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of the acceptor used for each shard.
+  typedef basic_socket_acceptor<Protocol, Executor> acceptor_type;
+
+  /// The type of the sockets produced by async_accept().
+  typedef typename Protocol::socket::template
+    rebind_executor<executor_type>::other socket_type;
+
+  /// Construct a sharded acceptor opened on the specified endpoint.
+  /**
+   * This constructor creates one acceptor for each executor in the range
+   * [first, last), and opens, binds and listens on each of them.
+   *
+   * @param first The beginning of a range of executors, one for each shard.
+   *
+   * @param last The end of the range of executors.
+   *
+   * @param endpoint An endpoint on the local machine on which the acceptor
+   * will listen for new connections. If the endpoint's port is 0, the port
+   * chosen for the first shard is used for all of them.
+   *
+   * @param reuse_addr Whether the constructor should set the socket option
+   * socket_base::reuse_address.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ExecutorIterator>
+  basic_sharded_acceptor(ExecutorIterator first, ExecutorIterator last,
+      const endpoint_type& endpoint, bool reuse_addr = true)
+    : next_shard_(0)
+  {
+    try
+    {
+      for (; first != last; ++first)
+      {
+        shards_.push_back(0);
+        shards_.back() = new acceptor_type(*first);
+      }
+    }
+    catch (...)
+    {
+      destroy_shards();
+      throw;
+    }
+
+    asio::error_code ec;
+    open_shards(endpoint, reuse_addr, ec);
+    if (ec)
+      destroy_shards();
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Destroys the sharded acceptor.
+  /**
+   * This function destroys the acceptor for each shard, cancelling any
+   * outstanding asynchronous operations associated with them as if by calling
+   * @c cancel.
+   */
+  ~basic_sharded_acceptor()
+  {
+    destroy_shards();
+  }
+
+  /// Get the number of shards.
+  std::size_t size() const
+  {
+    return shards_.size();
+  }
+
+  /// Get the acceptor for the specified shard.
+  acceptor_type& shard(std::size_t index)
+  {
+    return *shards_[index];
+  }
+
+  /// Get the acceptor for the specified shard.
+  const acceptor_type& shard(std::size_t index) const
+  {
+    return *shards_[index];
+  }
+
+  /// Get the acceptor that will be used by the next call to async_accept().
+  /**
+   * @returns The acceptor of the shard whose executor is running in the
+   * current thread, if any. Otherwise, the shards are returned in turn.
+   */
+  acceptor_type& select_shard()
+  {
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      if (running_in_this_thread(shards_[i]->get_executor()))
+        return *shards_[i];
+
+    std::size_t index = static_cast<std::size_t>(++next_shard_ - 1);
+    return *shards_[index % shards_.size()];
+  }
+
+  /// Determine whether the acceptors are open.
+  bool is_open() const
+  {
+    return !shards_.empty() && shards_[0]->is_open();
+  }
+
+  /// Get the local endpoint of the acceptor.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  endpoint_type local_endpoint() const
+  {
+    asio::error_code ec;
+    endpoint_type ep = local_endpoint(ec);
+    asio::detail::throw_error(ec, "local_endpoint");
+    return ep;
+  }
+
+  /// Get the local endpoint of the acceptor.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  endpoint_type local_endpoint(asio::error_code& ec) const
+  {
+    if (shards_.empty())
+    {
+      ec = asio::error::bad_descriptor;
+      return endpoint_type();
+    }
+    return shards_[0]->local_endpoint(ec);
+  }
+
+  /// Set an option on the acceptor of every shard.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename SettableSocketOption>
+  void set_option(const SettableSocketOption& option)
+  {
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      shards_[i]->set_option(option);
+  }
+
+  /// Set an option on the acceptor of every shard.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  template <typename SettableSocketOption>
+  ASIO_SYNC_OP_VOID set_option(const SettableSocketOption& option,
+      asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    for (std::size_t i = 0; i < shards_.size() && !ec; ++i)
+      shards_[i]->set_option(option, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Cancel all asynchronous operations associated with the acceptors.
+  /**
+   * This function causes all outstanding asynchronous accept operations on
+   * every shard to finish immediately, and the handlers for cancelled
+   * operations will be passed the asio::error::operation_aborted error.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      shards_[i]->cancel();
+  }
+
+  /// Cancel all asynchronous operations associated with the acceptors.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID cancel(asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    for (std::size_t i = 0; i < shards_.size() && !ec; ++i)
+      shards_[i]->cancel(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Close the acceptors.
+  /**
+   * This function is used to close the acceptor of every shard. Any
+   * asynchronous accept operations will be cancelled immediately.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close the acceptors.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+    {
+      asio::error_code shard_ec;
+      shards_[i]->close(shard_ec);
+      if (shard_ec && !ec)
+        ec = shard_ec;
+    }
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Start an asynchronous accept.
+  /**
+   * This function is used to asynchronously accept a new connection on the
+   * shard returned by select_shard(). The function call always returns
+   * immediately.
+   *
+   * @param handler The handler to be called when the accept operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *   // On success, the newly accepted socket, associated with the executor
+   *   // of the shard that accepted it.
+   *   socket_type peer
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        socket_type)) MoveAcceptHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(MoveAcceptHandler,
+      void (asio::error_code, socket_type))
+  async_accept(
+      ASIO_MOVE_ARG(MoveAcceptHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return select_shard().async_accept(
+        ASIO_MOVE_CAST(MoveAcceptHandler)(handler));
+  }
+
+private:
+  // Open, bind and listen on each shard's acceptor.
+  void open_shards(const endpoint_type& endpoint,
+      bool reuse_addr, asio::error_code& ec)
+  {
+    if (shards_.empty())
+    {
+      ec = asio::error::invalid_argument;
+      return;
+    }
+
+#if defined(ASIO_SHARDED_ACCEPTOR_REUSE_PORT)
+    typedef asio::detail::socket_option::boolean<
+      SOL_SOCKET, ASIO_SHARDED_ACCEPTOR_REUSE_PORT> reuse_port;
+
+    // Each shard has its own listening socket bound to the same endpoint.
+    endpoint_type shard_endpoint = endpoint;
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+    {
+      acceptor_type& acceptor = *shards_[i];
+      acceptor.open(shard_endpoint.protocol(), ec);
+      if (!ec && reuse_addr)
+        acceptor.set_option(socket_base::reuse_address(true), ec);
+      if (!ec)
+        acceptor.set_option(reuse_port(true), ec);
+      if (!ec)
+        acceptor.bind(shard_endpoint, ec);
+      if (!ec)
+        acceptor.listen(socket_base::max_listen_connections, ec);
+      if (!ec && i == 0)
+        shard_endpoint = acceptor.local_endpoint(ec);
+      if (ec)
+        return;
+    }
+#elif !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+    // All shards share the first shard's listening socket.
+    acceptor_type& first = *shards_[0];
+    first.open(endpoint.protocol(), ec);
+    if (!ec && reuse_addr)
+      first.set_option(socket_base::reuse_address(true), ec);
+    if (!ec)
+      first.bind(endpoint, ec);
+    if (!ec)
+      first.listen(socket_base::max_listen_connections, ec);
+    for (std::size_t i = 1; i < shards_.size() && !ec; ++i)
+    {
+      int fd = ::dup(first.native_handle());
+      if (fd == -1)
+      {
+        ec = asio::error_code(errno, asio::error::get_system_category());
+        return;
+      }
+      shards_[i]->assign(endpoint.protocol(), fd, ec);
+      if (ec)
+        ::close(fd);
+    }
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+    // A listening socket can only be associated with one I/O completion port.
+    if (shards_.size() > 1)
+    {
+      ec = asio::error::operation_not_supported;
+      return;
+    }
+
+    acceptor_type& first = *shards_[0];
+    first.open(endpoint.protocol(), ec);
+    if (!ec && reuse_addr)
+      first.set_option(socket_base::reuse_address(true), ec);
+    if (!ec)
+      first.bind(endpoint, ec);
+    if (!ec)
+      first.listen(socket_base::max_listen_connections, ec);
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  }
+
+  // Destroy all shards.
+  void destroy_shards()
+  {
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      delete shards_[i];
+    shards_.clear();
+  }
+
+  // Determine whether an executor is running in the current thread.
+  template <typename Executor1>
+  static bool running_in_this_thread(const Executor1& ex)
+  {
+    return ex.running_in_this_thread();
+  }
+
+  // Determine whether a polymorphic executor is running in the current thread.
+  static bool running_in_this_thread(const executor& ex)
+  {
+    const io_context::executor_type* io_ex
+      = ex.target<io_context::executor_type>();
+    return io_ex && io_ex->running_in_this_thread();
+  }
+
+  // The acceptor for each shard.
+  std::vector<acceptor_type*> shards_;
+
+  // Used to select shards in turn when called from other threads.
+  detail::atomic_count next_shard_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BASIC_SHARDED_ACCEPTOR_HPP
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/ancillary_data.hpp"
 #include "asio/async_result.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/io_object_impl.hpp"
@@ -1785,6 +1786,386 @@ public:
         initiate_async_wait(this), handler, w);
   }
 
+  /// Receive some data together with any ancillary data.
+  /**
+   * This function is used to receive data on the socket, along with any
+   * ancillary data (control messages) that accompanies it, such as file
+   * descriptors passed over a local socket or packet information requested
+   * using a socket option. The function call will block until data has been
+   * received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param control Refers to storage into which the ancillary data will be
+   * received. On return, the ancillary_data object describes the control
+   * messages that were received.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the connection was closed by the
+   * peer.
+   *
+   * @note Control messages that do not fit in the storage are discarded, and
+   * are reported by ancillary_data::truncated().
+   *
+   * @par Example
+   * To receive a file descriptor over a local stream socket:
+   * @code
+   * char data[64];
+   * unsigned char storage[64];
+   * asio::ancillary_data control(asio::buffer(storage));
+   * std::size_t n = socket.receive_msg(asio::buffer(data), control);
+   * for (const asio::ancillary_data::message& m : control)
+   *   if (m.level() == SOL_SOCKET && m.type() == SCM_RIGHTS)
+   *     adopt_descriptor(m.data_as<int>());
+   * @endcode
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_msg(const MutableBufferSequence& buffers,
+      ancillary_data& control)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().receive_msg(
+        impl_.get_implementation(), buffers,
+        static_cast<endpoint_type*>(0), control, 0, ec);
+    asio::detail::throw_error(ec, "receive_msg");
+    return s;
+  }
+
+  /// Receive some data together with any ancillary data.
+  /**
+   * This function is used to receive data on the socket, along with any
+   * ancillary data (control messages) that accompanies it. The function call
+   * will block until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param control Refers to storage into which the ancillary data will be
+   * received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the connection was closed by the
+   * peer.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_msg(const MutableBufferSequence& buffers,
+      ancillary_data& control, socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().receive_msg(
+        impl_.get_implementation(), buffers,
+        static_cast<endpoint_type*>(0), control, flags, ec);
+    asio::detail::throw_error(ec, "receive_msg");
+    return s;
+  }
+
+  /// Receive some data together with any ancillary data.
+  /**
+   * This function is used to receive data on the socket, along with any
+   * ancillary data (control messages) that accompanies it. The function call
+   * will block until data has been received successfully or an error occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param control Refers to storage into which the ancillary data will be
+   * received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received. Returns 0 if an error occurred.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_msg(const MutableBufferSequence& buffers,
+      ancillary_data& control, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    return impl_.get_service().receive_msg(
+        impl_.get_implementation(), buffers,
+        static_cast<endpoint_type*>(0), control, flags, ec);
+  }
+
+  /// Start an asynchronous receive of data together with any ancillary data.
+  /**
+   * This function is used to asynchronously receive data on the socket, along
+   * with any ancillary data (control messages) that accompanies it. The
+   * function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param control Refers to storage into which the ancillary data will be
+   * received. Ownership of the ancillary_data object and its storage is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_msg(const MutableBufferSequence& buffers,
+      ancillary_data& control,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_msg(this), handler, buffers,
+        &control, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of data together with any ancillary data.
+  /**
+   * This function is used to asynchronously receive data on the socket, along
+   * with any ancillary data (control messages) that accompanies it. The
+   * function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param control Refers to storage into which the ancillary data will be
+   * received. Ownership of the ancillary_data object and its storage is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_msg(const MutableBufferSequence& buffers,
+      ancillary_data& control, socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_msg(this), handler, buffers, &control, flags);
+  }
+
+  /// Send some data together with ancillary data.
+  /**
+   * This function is used to send data on the socket, along with the control
+   * messages held by an ancillary_data object. The function call will block
+   * until the data has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers to be sent on the socket.
+   *
+   * @param control The control messages to be sent with the data.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure. On platforms that do
+   * not support ancillary data, sending non-empty ancillary data fails with
+   * asio::error::operation_not_supported.
+   *
+   * @note On a stream socket the ancillary data is sent with the first byte
+   * of data. If fewer bytes are sent than requested, the remaining data should
+   * be sent without the ancillary data.
+   *
+   * @par Example
+   * To pass a file descriptor over a local stream socket:
+   * @code
+   * unsigned char storage[64];
+   * asio::ancillary_data control(asio::buffer(storage));
+   * control.push_back(SOL_SOCKET, SCM_RIGHTS, fd);
+   * socket.send_msg(asio::buffer("x", 1), control);
+   * @endcode
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_msg(const ConstBufferSequence& buffers,
+      const ancillary_data& control)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().send_msg(
+        impl_.get_implementation(), buffers,
+        static_cast<const endpoint_type*>(0), control, 0, ec);
+    asio::detail::throw_error(ec, "send_msg");
+    return s;
+  }
+
+  /// Send some data together with ancillary data.
+  /**
+   * This function is used to send data on the socket, along with the control
+   * messages held by an ancillary_data object. The function call will block
+   * until the data has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers to be sent on the socket.
+   *
+   * @param control The control messages to be sent with the data.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_msg(const ConstBufferSequence& buffers,
+      const ancillary_data& control, socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = impl_.get_service().send_msg(
+        impl_.get_implementation(), buffers,
+        static_cast<const endpoint_type*>(0), control, flags, ec);
+    asio::detail::throw_error(ec, "send_msg");
+    return s;
+  }
+
+  /// Send some data together with ancillary data.
+  /**
+   * This function is used to send data on the socket, along with the control
+   * messages held by an ancillary_data object. The function call will block
+   * until the data has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers to be sent on the socket.
+   *
+   * @param control The control messages to be sent with the data.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes sent. Returns 0 if an error occurred.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_msg(const ConstBufferSequence& buffers,
+      const ancillary_data& control, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    return impl_.get_service().send_msg(
+        impl_.get_implementation(), buffers,
+        static_cast<const endpoint_type*>(0), control, flags, ec);
+  }
+
+  /// Start an asynchronous send of data together with ancillary data.
+  /**
+   * This function is used to asynchronously send data on the socket, along
+   * with the control messages held by an ancillary_data object. The function
+   * call always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param control The control messages to be sent with the data. The storage
+   * referred to by the ancillary_data object must remain valid until the
+   * handler is called.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_msg(const ConstBufferSequence& buffers,
+      const ancillary_data& control,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_msg(this), handler, buffers,
+        &control, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of data together with ancillary data.
+  /**
+   * This function is used to asynchronously send data on the socket, along
+   * with the control messages held by an ancillary_data object. The function
+   * call always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param control The control messages to be sent with the data. The storage
+   * referred to by the ancillary_data object must remain valid until the
+   * handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_msg(const ConstBufferSequence& buffers,
+      const ancillary_data& control, socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_msg(this), handler, buffers, &control, flags);
+  }
+
 protected:
   /// Protected destructor to prevent deletion through this type.
   /**
@@ -1885,6 +2266,76 @@ private:
   private:
     basic_socket* self_;
   };
+
+  class initiate_async_receive_msg
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_msg(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, ancillary_data* control,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_msg(
+          self_->impl_.get_implementation(), buffers,
+          static_cast<endpoint_type*>(0), *control, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_socket* self_;
+  };
+
+  class initiate_async_send_msg
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_msg(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const ancillary_data* control,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_msg(
+          self_->impl_.get_implementation(), buffers,
+          static_cast<const endpoint_type*>(0), *control, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_socket* self_;
+  };
 };
 
 } // namespace asio
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include "asio/async_result.hpp"
 #include "asio/basic_socket.hpp"
+#include "asio/buffer_pool.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
@@ -532,6 +533,108 @@ public:
         initiate_async_send(this), handler, buffers, flags);
   }
 
+  /// Start an asynchronous send of all of the data without copying it.
+  /**
+   * This function is used to asynchronously send all of the data on the stream
+   * socket, without the kernel copying the data where this is supported. The
+   * function call always returns immediately.
+   *
+   * On Linux, the socket's @c SO_ZEROCOPY option is enabled and the data is
+   * sent using @c MSG_ZEROCOPY. The kernel then transmits directly from the
+   * buffers, and the operation completes only once the kernel has notified,
+   * via the socket's error queue, that it no longer refers to them. Elsewhere,
+   * or if the kernel cannot send without copying, the data is copied as for
+   * async_send().
+   *
+   * Zero-copy sends are worthwhile for large amounts of data only, as the
+   * tracking of their completion has a cost of its own.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid, and unmodified, until the handler is called.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note Once all of the data has been sent, the operation is not affected by
+   * cancel(). If the socket is closed before the kernel has released the
+   * buffers, the handler is called with asio::error::operation_aborted.
+   * The operation reads the socket's error queue, and so should not be used
+   * together with reads of the error queue by the application.
+   *
+   * @par Example
+   * @code
+   * socket.async_send_zero_copy(asio::buffer(data, size), handler);
+   * @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_zero_copy(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_zero_copy(this), handler,
+        buffers, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of all of the data without copying it.
+  /**
+   * This function is used to asynchronously send all of the data on the stream
+   * socket, without the kernel copying the data where this is supported. The
+   * function call always returns immediately. See the overload without flags
+   * for details.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid, and unmodified, until the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_zero_copy(const ConstBufferSequence& buffers,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_zero_copy(this), handler, buffers, flags);
+  }
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
@@ -972,6 +1075,57 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous read into a buffer taken from a pool.
+  /**
+   * This function is used to asynchronously read data from the stream socket
+   * into a buffer taken from a buffer_pool. The buffer is taken from the pool
+   * only when the socket is ready to be read, so that no buffer memory is held
+   * while the operation waits for data. The function call always returns
+   * immediately.
+   *
+   * @param pool The pool from which the buffer will be taken. Ownership of the
+   * pool is retained by the caller, which must guarantee that it remains valid
+   * until the handler is called.
+   *
+   * @param handler The handler to be called when the read operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   asio::pooled_buffer data       // The data that was read.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The read operation reads at most one buffer's worth of data. If the
+   * pool has no free buffer when data arrives, the operation fails with
+   * asio::error::no_buffer_space.
+   *
+   * @par Example
+   * @code
+   * socket.async_read_some(pool, handler);
+   * @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        pooled_buffer)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, pooled_buffer))
+  async_read_some(buffer_pool& pool,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, pooled_buffer)>(
+        initiate_async_receive_pooled(this), handler,
+        &pool, socket_base::message_flags(0));
+  }
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
 private:
   class initiate_async_send
   {
@@ -1007,6 +1161,40 @@ private:
     basic_stream_socket* self_;
   };
 
+  class initiate_async_send_zero_copy
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_zero_copy(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_zero_copy(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+
   class initiate_async_receive
   {
   public:
@@ -1040,6 +1228,37 @@ private:
   private:
     basic_stream_socket* self_;
   };
+
+#if defined(ASIO_HAS_MOVE)
+  class initiate_async_receive_pooled
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_pooled(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        buffer_pool* pool, socket_base::message_flags flags) const
+    {
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive(
+          self_->impl_.get_implementation(), *pool, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_MOVE)
 };
 
 } // namespace asio
@@ -0,0 +1,271 @@
+//
+// buffer_pool.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFER_POOL_HPP
+#define ASIO_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail { class buffer_pool_access; }
+
+/// A pool of fixed-size buffers from which asynchronous receive operations
+/// select a buffer only once data has arrived.
+/**
+ * The buffer_pool class owns a fixed number of equally sized buffers, carved
+ * from a single region that is allocated when the pool is constructed. A pool
+ * may be passed to an asynchronous read operation in place of a buffer
+ * sequence, such as basic_stream_socket::async_read_some(). The operation
+ * takes a buffer from the pool only when the socket is ready to be read, so an
+ * idle connection with an outstanding read does not hold any buffer memory.
+ * The data is delivered to the completion handler in a pooled_buffer, which
+ * returns the buffer to the pool when it is destroyed.
+ *
+ * The pool must outlive all operations that use it and all pooled_buffer
+ * objects that refer to it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code asio::buffer_pool pool(16384, 1024);
+ * ...
+ * socket.async_read_some(pool,
+ *     [](asio::error_code ec, asio::pooled_buffer data)
+ *     {
+ *       if (!ec)
+ *         process(data.data());
+ *     }); @endcode
+ */
+class buffer_pool
+  : private detail::noncopyable
+{
+public:
+  /// Construct a pool containing the specified number of buffers.
+  /**
+   * @param buffer_size The size of each buffer, in bytes.
+   *
+   * @param buffer_count The number of buffers in the pool.
+   *
+   * @throws std::length_error If the total size of the buffers cannot be
+   * represented in a std::size_t.
+   */
+  ASIO_DECL buffer_pool(std::size_t buffer_size, std::size_t buffer_count);
+
+  /// Destructor. Releases the memory used by the buffers.
+  ASIO_DECL ~buffer_pool();
+
+  /// Get the size of each buffer.
+  std::size_t buffer_size() const
+  {
+    return buffer_size_;
+  }
+
+  /// Get the number of buffers in the pool.
+  std::size_t buffer_count() const
+  {
+    return buffer_count_;
+  }
+
+  /// Get the number of buffers that are not currently in use.
+  ASIO_DECL std::size_t available() const;
+
+private:
+  friend class detail::buffer_pool_access;
+
+  // Take a buffer from the pool, or return null if none are available.
+  ASIO_DECL void* acquire();
+
+  // Return a buffer to the pool.
+  ASIO_DECL void release(void* p);
+
+  // Mutex to protect access to the free list.
+  mutable detail::mutex mutex_;
+
+  // The region from which the buffers are carved.
+  unsigned char* region_;
+
+  // The size of each buffer.
+  std::size_t buffer_size_;
+
+  // The distance between the starts of consecutive buffers.
+  std::size_t stride_;
+
+  // The number of buffers in the pool.
+  std::size_t buffer_count_;
+
+  // The first buffer in the list of free buffers. Each free buffer holds a
+  // pointer to the next.
+  void* free_list_;
+
+  // The number of buffers in the free list.
+  std::size_t available_;
+};
+
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+/// Holds data received into a buffer taken from a buffer_pool.
+/**
+ * The pooled_buffer class owns a buffer that was taken from a buffer_pool by
+ * an asynchronous receive operation. The buffer is returned to the pool when
+ * the pooled_buffer is destroyed or reset. A pooled_buffer may be moved, but
+ * not copied.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class pooled_buffer
+{
+public:
+  /// Construct an empty pooled_buffer that does not own a buffer.
+  pooled_buffer() ASIO_NOEXCEPT
+    : pool_(0),
+      data_(0),
+      size_(0)
+  {
+  }
+
+  /// Move constructor.
+  pooled_buffer(pooled_buffer&& other) ASIO_NOEXCEPT
+    : pool_(other.pool_),
+      data_(other.data_),
+      size_(other.size_)
+  {
+    other.pool_ = 0;
+    other.data_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Destructor. Returns the buffer to the pool.
+  ~pooled_buffer()
+  {
+    reset();
+  }
+
+  /// Move assignment operator.
+  pooled_buffer& operator=(pooled_buffer&& other) ASIO_NOEXCEPT
+  {
+    if (this != &other)
+    {
+      reset();
+      pool_ = other.pool_;
+      data_ = other.data_;
+      size_ = other.size_;
+      other.pool_ = 0;
+      other.data_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// Get the received data.
+  mutable_buffer data() const ASIO_NOEXCEPT
+  {
+    return mutable_buffer(data_, size_);
+  }
+
+  /// Get the number of bytes of received data.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Determine whether the pooled_buffer owns a buffer.
+  bool empty() const ASIO_NOEXCEPT
+  {
+    return data_ == 0;
+  }
+
+  /// Return the buffer to the pool, leaving the pooled_buffer empty.
+  void reset() ASIO_NOEXCEPT;
+
+private:
+  friend class detail::buffer_pool_access;
+
+  pooled_buffer(buffer_pool* pool, void* data, std::size_t size)
+    : pool_(pool),
+      data_(data),
+      size_(size)
+  {
+  }
+
+  pooled_buffer(const pooled_buffer&) ASIO_DELETED;
+  pooled_buffer& operator=(const pooled_buffer&) ASIO_DELETED;
+
+  buffer_pool* pool_;
+  void* data_;
+  std::size_t size_;
+};
+
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+namespace detail {
+
+// Helper class to give operations access to the pool's buffers.
+class buffer_pool_access
+{
+public:
+  static void* acquire(buffer_pool& pool)
+  {
+    return pool.acquire();
+  }
+
+  static void release(buffer_pool& pool, void* p)
+  {
+    pool.release(p);
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  static pooled_buffer make_buffer(buffer_pool& pool,
+      void* data, std::size_t size)
+  {
+    return data ? pooled_buffer(&pool, data, size) : pooled_buffer();
+  }
+#endif // defined(ASIO_HAS_MOVE)
+};
+
+} // namespace detail
+
+#if defined(ASIO_HAS_MOVE)
+
+inline void pooled_buffer::reset() ASIO_NOEXCEPT
+{
+  if (data_)
+  {
+    detail::buffer_pool_access::release(*pool_, data_);
+    pool_ = 0;
+    data_ = 0;
+    size_ = 0;
+  }
+}
+
+#endif // defined(ASIO_HAS_MOVE)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/buffer_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_BUFFER_POOL_HPP
@@ -0,0 +1,44 @@
+//
+// coarse_steady_timer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_COARSE_STEADY_TIMER_HPP
+#define ASIO_COARSE_STEADY_TIMER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/coarse_steady_clock.hpp"
+
+namespace asio {
+
+/// Typedef for a timer based on a coarse monotonic clock.
+/**
+ * This typedef uses a monotonic clock that is cheaper to read than the steady
+ * clock, at the cost of advancing only once per operating system scheduler
+ * tick, which is typically every 1 to 10 milliseconds. It is suited to
+ * timeouts that are checked or reset frequently from within handlers. On
+ * Linux the clock is @c CLOCK_MONOTONIC_COARSE. Where no such clock is
+ * available, the timer is equivalent to steady_timer.
+ *
+ * Waits on the timer may complete up to one clock tick after the expiry time.
+ */
+typedef basic_waitable_timer<detail::coarse_steady_clock> coarse_steady_timer;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_COARSE_STEADY_TIMER_HPP
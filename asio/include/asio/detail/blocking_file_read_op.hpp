@@ -0,0 +1,155 @@
+//
+// detail/blocking_file_read_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_BLOCKING_FILE_READ_OP_HPP
+#define ASIO_DETAIL_BLOCKING_FILE_READ_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE)
+
+#include "asio/error.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/operation.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class blocking_file_read_op : public operation
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(blocking_file_read_op);
+
+  blocking_file_read_op(const shared_ptr<void>& descriptor_owner,
+      socket_ops::weak_cancel_token_type cancel_token, int descriptor,
+      uint64_t offset, const MutableBufferSequence& buffers, scheduler& sched,
+      Handler& handler, const IoExecutor& io_ex)
+    : operation(&blocking_file_read_op::do_complete),
+      descriptor_owner_(descriptor_owner),
+      cancel_token_(cancel_token),
+      descriptor_(descriptor),
+      offset_(offset),
+      buffers_(buffers),
+      scheduler_(sched),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex),
+      bytes_transferred_(0)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the operation object.
+    blocking_file_read_op* o(static_cast<blocking_file_read_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    if (owner && owner != &o->scheduler_)
+    {
+      // The operation is being run on the worker scheduler. Time to perform
+      // the blocking file operation, unless it has been cancelled.
+      if (o->cancel_token_.expired())
+        o->ec_ = asio::error::operation_aborted;
+      else
+      {
+        buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence> bufs(o->buffers_);
+
+        if (o->offset_ == ~uint64_t(0))
+        {
+          o->bytes_transferred_ = descriptor_ops::sync_read(o->descriptor_,
+              0, bufs.buffers(), bufs.count(), bufs.all_empty(), o->ec_);
+        }
+        else
+        {
+          o->bytes_transferred_ = descriptor_ops::sync_read_at(o->descriptor_,
+              o->offset_, bufs.buffers(), bufs.count(), bufs.all_empty(),
+              o->ec_);
+        }
+      }
+
+      // Release our reference to the descriptor so that it may be closed.
+      o->descriptor_owner_.reset();
+
+      // Pass operation back to main scheduler for completion.
+      o->scheduler_.post_deferred_completion(o);
+      p.v = p.p = 0;
+    }
+    else
+    {
+      // The operation has been returned to the main scheduler. The completion
+      // handler is ready to be delivered.
+
+      // Take ownership of the operation's outstanding work.
+      handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+      ASIO_HANDLER_COMPLETION((*o));
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made. Even if we're not about to make an upcall,
+      // a sub-object of the handler may be the true owner of the memory
+      // associated with the handler. Consequently, a local copy of the handler
+      // is required to ensure that any owning sub-object remains valid until
+      // after we have deallocated the memory here.
+      detail::binder2<Handler, asio::error_code, std::size_t>
+        handler(o->handler_, o->ec_, o->bytes_transferred_);
+      p.h = asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      if (owner)
+      {
+        fenced_block b(fenced_block::half);
+        ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+        w.complete(handler, handler.handler_);
+        ASIO_HANDLER_INVOCATION_END;
+      }
+    }
+  }
+
+private:
+  shared_ptr<void> descriptor_owner_;
+  socket_ops::weak_cancel_token_type cancel_token_;
+  int descriptor_;
+  uint64_t offset_;
+  MutableBufferSequence buffers_;
+  scheduler& scheduler_;
+  Handler handler_;
+  IoExecutor io_executor_;
+  asio::error_code ec_;
+  std::size_t bytes_transferred_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_BLOCKING_FILE_READ_OP_HPP
@@ -27,6 +27,10 @@ namespace detail {
 
 class buffer_sequence_adapter_base
 {
+public:
+  // The size of the storage used to linearise a buffer sequence.
+  enum { linearisation_storage_size = 16384 };
+
 #if defined(ASIO_WINDOWS_RUNTIME)
 public:
   // The maximum number of buffers to support in a single operation.
@@ -104,6 +108,8 @@ class buffer_sequence_adapter
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = false };
+
   explicit buffer_sequence_adapter(const Buffers& buffer_sequence)
     : count_(0), total_buffer_size_(0)
   {
@@ -153,6 +159,14 @@ public:
         asio::buffer_sequence_end(buffer_sequence));
   }
 
+  static Buffer linearise(const Buffers& buffer_sequence,
+      const asio::mutable_buffer& storage)
+  {
+    return buffer_sequence_adapter::linearise(
+        asio::buffer_sequence_begin(buffer_sequence),
+        asio::buffer_sequence_end(buffer_sequence), storage);
+  }
+
 private:
   template <typename Iterator>
   void init(Iterator begin, Iterator end)
@@ -201,6 +215,33 @@ private:
     return Buffer();
   }
 
+  // Copy as many buffers as fit into the storage, unless the first non-empty
+  // buffer is the only one or would fill the storage by itself, in which case
+  // it is returned directly.
+  template <typename Iterator>
+  static Buffer linearise(Iterator begin, Iterator end,
+      const asio::mutable_buffer& storage)
+  {
+    asio::mutable_buffer unused_storage = storage;
+    Iterator iter = begin;
+    while (iter != end && unused_storage.size() != 0)
+    {
+      Buffer buffer(*iter);
+      ++iter;
+      if (buffer.size() == 0)
+        continue;
+      if (unused_storage.size() == storage.size())
+      {
+        if (iter == end)
+          return buffer;
+        if (buffer.size() >= unused_storage.size())
+          return buffer;
+      }
+      unused_storage += asio::buffer_copy(unused_storage, buffer);
+    }
+    return Buffer(storage.data(), storage.size() - unused_storage.size());
+  }
+
   native_buffer_type buffers_[max_buffers];
   std::size_t count_;
   std::size_t total_buffer_size_;
@@ -211,6 +252,8 @@ class buffer_sequence_adapter<Buffer, asio::mutable_buffer>
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = true };
+
   explicit buffer_sequence_adapter(
       const asio::mutable_buffer& buffer_sequence)
   {
@@ -253,6 +296,12 @@ public:
     return Buffer(buffer_sequence);
   }
 
+  static Buffer linearise(const asio::mutable_buffer& buffer_sequence,
+      const asio::mutable_buffer&)
+  {
+    return Buffer(buffer_sequence);
+  }
+
 private:
   native_buffer_type buffer_;
   std::size_t total_buffer_size_;
@@ -263,6 +312,8 @@ class buffer_sequence_adapter<Buffer, asio::const_buffer>
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = true };
+
   explicit buffer_sequence_adapter(
       const asio::const_buffer& buffer_sequence)
   {
@@ -305,6 +356,12 @@ public:
     return Buffer(buffer_sequence);
   }
 
+  static Buffer linearise(const asio::const_buffer& buffer_sequence,
+      const asio::mutable_buffer&)
+  {
+    return Buffer(buffer_sequence);
+  }
+
 private:
   native_buffer_type buffer_;
   std::size_t total_buffer_size_;
@@ -317,6 +374,8 @@ class buffer_sequence_adapter<Buffer, asio::mutable_buffers_1>
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = true };
+
   explicit buffer_sequence_adapter(
       const asio::mutable_buffers_1& buffer_sequence)
   {
@@ -359,6 +418,12 @@ public:
     return Buffer(buffer_sequence);
   }
 
+  static Buffer linearise(const asio::mutable_buffers_1& buffer_sequence,
+      const asio::mutable_buffer&)
+  {
+    return Buffer(buffer_sequence);
+  }
+
 private:
   native_buffer_type buffer_;
   std::size_t total_buffer_size_;
@@ -369,6 +434,8 @@ class buffer_sequence_adapter<Buffer, asio::const_buffers_1>
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = true };
+
   explicit buffer_sequence_adapter(
       const asio::const_buffers_1& buffer_sequence)
   {
@@ -411,6 +478,12 @@ public:
     return Buffer(buffer_sequence);
   }
 
+  static Buffer linearise(const asio::const_buffers_1& buffer_sequence,
+      const asio::mutable_buffer&)
+  {
+    return Buffer(buffer_sequence);
+  }
+
 private:
   native_buffer_type buffer_;
   std::size_t total_buffer_size_;
@@ -423,6 +496,8 @@ class buffer_sequence_adapter<Buffer, boost::array<Elem, 2> >
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = false };
+
   explicit buffer_sequence_adapter(
       const boost::array<Elem, 2>& buffer_sequence)
   {
@@ -468,6 +543,19 @@ public:
         ? buffer_sequence[0] : buffer_sequence[1]);
   }
 
+  static Buffer linearise(const boost::array<Elem, 2>& buffer_sequence,
+      const asio::mutable_buffer& storage)
+  {
+    if (buffer_sequence[0].size() == 0)
+      return Buffer(buffer_sequence[1]);
+    if (buffer_sequence[1].size() == 0)
+      return Buffer(buffer_sequence[0]);
+    if (buffer_sequence[0].size() >= storage.size())
+      return Buffer(buffer_sequence[0]);
+    return Buffer(storage.data(),
+        asio::buffer_copy(storage, buffer_sequence));
+  }
+
 private:
   native_buffer_type buffers_[2];
   std::size_t total_buffer_size_;
@@ -480,6 +568,8 @@ class buffer_sequence_adapter<Buffer, std::array<Elem, 2> >
   : buffer_sequence_adapter_base
 {
 public:
+  enum { is_single_buffer = false };
+
   explicit buffer_sequence_adapter(
       const std::array<Elem, 2>& buffer_sequence)
   {
@@ -525,6 +615,19 @@ public:
         ? buffer_sequence[0] : buffer_sequence[1]);
   }
 
+  static Buffer linearise(const std::array<Elem, 2>& buffer_sequence,
+      const asio::mutable_buffer& storage)
+  {
+    if (buffer_sequence[0].size() == 0)
+      return Buffer(buffer_sequence[1]);
+    if (buffer_sequence[1].size() == 0)
+      return Buffer(buffer_sequence[0]);
+    if (buffer_sequence[0].size() >= storage.size())
+      return Buffer(buffer_sequence[0]);
+    return Buffer(storage.data(),
+        asio::buffer_copy(storage, buffer_sequence));
+  }
+
 private:
   native_buffer_type buffers_[2];
   std::size_t total_buffer_size_;
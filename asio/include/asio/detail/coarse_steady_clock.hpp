@@ -0,0 +1,125 @@
+//
+// detail/coarse_steady_clock.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
+#define ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/detail/chrono.hpp"
+#include "asio/wait_traits.hpp"
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <time.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A monotonic clock that trades resolution for a cheaper now(). On Linux it
+// uses CLOCK_MONOTONIC_COARSE, which is read from the vDSO without consulting
+// the hardware clock source, and which advances once per scheduler tick.
+// Elsewhere it is equivalent to the steady clock.
+class coarse_steady_clock
+{
+public:
+  typedef chrono::nanoseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef chrono::time_point<coarse_steady_clock> time_point;
+  static const bool is_steady = true;
+
+  // Get the current time.
+  static time_point now() ASIO_NOEXCEPT
+  {
+#if defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return time_point(duration(
+          static_cast<rep>(ts.tv_sec) * 1000000000 + ts.tv_nsec));
+#else // defined(CLOCK_MONOTONIC_COARSE)
+    return time_point(chrono::duration_cast<duration>(
+          chrono::steady_clock::now().time_since_epoch()));
+#endif // defined(CLOCK_MONOTONIC_COARSE)
+  }
+
+  // Get the interval at which the clock advances, or zero if the clock is as
+  // precise as the steady clock.
+  static duration resolution() ASIO_NOEXCEPT
+  {
+#if defined(CLOCK_MONOTONIC_COARSE)
+    static const duration res = query_resolution();
+    return res;
+#else // defined(CLOCK_MONOTONIC_COARSE)
+    return duration::zero();
+#endif // defined(CLOCK_MONOTONIC_COARSE)
+  }
+
+private:
+#if defined(CLOCK_MONOTONIC_COARSE)
+  static duration query_resolution() ASIO_NOEXCEPT
+  {
+    timespec ts;
+    if (::clock_getres(CLOCK_MONOTONIC_COARSE, &ts) != 0)
+      return duration::zero();
+    return duration(static_cast<rep>(ts.tv_sec) * 1000000000 + ts.tv_nsec);
+  }
+#endif // defined(CLOCK_MONOTONIC_COARSE)
+};
+
+} // namespace detail
+
+// The coarse clock can lag the time used by the reactor to wait by up to one
+// clock tick. A wait that ends when the clock has not yet reached the timer's
+// expiry would be restarted with an ever shorter timeout until the clock
+// catches up, so non-zero waits are extended by the clock's resolution.
+template <>
+struct wait_traits<detail::coarse_steady_clock>
+{
+  static detail::coarse_steady_clock::duration to_wait_duration(
+      const detail::coarse_steady_clock::duration& d)
+  {
+    if (d <= detail::coarse_steady_clock::duration::zero())
+      return d;
+    detail::coarse_steady_clock::duration res =
+      detail::coarse_steady_clock::resolution();
+    if ((detail::coarse_steady_clock::duration::max)() - d < res)
+      return (detail::coarse_steady_clock::duration::max)();
+    return d + res;
+  }
+
+  static detail::coarse_steady_clock::duration to_wait_duration(
+      const detail::coarse_steady_clock::time_point& t)
+  {
+    detail::coarse_steady_clock::time_point now =
+      detail::coarse_steady_clock::now();
+    if (now + (detail::coarse_steady_clock::duration::max)() < t)
+      return (detail::coarse_steady_clock::duration::max)();
+    if (now + (detail::coarse_steady_clock::duration::min)() > t)
+      return (detail::coarse_steady_clock::duration::min)();
+    return to_wait_duration(t - now);
+  }
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_DETAIL_COARSE_STEADY_CLOCK_HPP
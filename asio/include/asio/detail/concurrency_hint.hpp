@@ -21,7 +21,7 @@
 // The concurrency hint ID and mask are used to identify when a "well-known"
 // concurrency hint value has been passed to the io_context.
 #define ASIO_CONCURRENCY_HINT_ID 0xA5100000u
-#define ASIO_CONCURRENCY_HINT_ID_MASK 0xFFFF0000u
+#define ASIO_CONCURRENCY_HINT_ID_MASK 0xFFF00000u
 
 // If set, this bit indicates that the scheduler should perform locking.
 #define ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER 0x1u
@@ -33,6 +33,28 @@
 // If set, this bit indicates that the reactor should perform locking for I/O.
 #define ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO 0x4u
 
+// If set, this bit indicates that the scheduler should use per-thread queues
+// with work stealing between the threads that run it.
+#define ASIO_CONCURRENCY_HINT_WORK_STEALING 0x8u
+
+// The position and width of the bits holding the number of events the reactor
+// harvests with each system call, encoded as the base 2 logarithm less 5.
+#define ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SHIFT 4
+#define ASIO_CONCURRENCY_HINT_REACTOR_BATCH_MASK 0x7u
+
+// If set, this bit indicates that the reactor should poll again without
+// blocking, while events keep arriving, before returning to the scheduler.
+#define ASIO_CONCURRENCY_HINT_REACTOR_REPOLL 0x80u
+
+// The position and width of the bits holding the number of per-thread queues
+// used when work stealing is enabled.
+#define ASIO_CONCURRENCY_HINT_SHARDS_SHIFT 8
+#define ASIO_CONCURRENCY_HINT_SHARDS_MASK 0xFFu
+
+// If set, this bit indicates that the scheduler is run from a single thread,
+// and that other threads post operations to it through a lock-free queue.
+#define ASIO_CONCURRENCY_HINT_LOCK_FREE_POST 0x10000u
+
 // Helper macro to determine if we have a special concurrency hint.
 #define ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
   ((static_cast<unsigned>(hint) \
@@ -60,6 +82,24 @@
 #define ASIO_CONCURRENCY_HINT_UNSAFE \
   static_cast<int>(ASIO_CONCURRENCY_HINT_ID)
 
+// This special concurrency hint disables locking in both the scheduler and
+// reactor I/O, as for ASIO_CONCURRENCY_HINT_UNSAFE, but still allows functions
+// to be posted or dispatched to the io_context, and the io_context to be
+// stopped, from any thread. Operations posted from threads other than the one
+// running the io_context are added to a lock-free queue, and the reactor is
+// interrupted only when that queue goes from empty to non-empty. This hint has
+// the following restrictions:
+//
+// - The io_context must only be run from one thread at a time.
+//
+// - All operations on the io_context's associated I/O objects (such as sockets
+//   and timers) must occur in the thread that runs the io_context.
+//
+// - Asynchronous resolve operations fail with operation_not_supported.
+#define ASIO_CONCURRENCY_HINT_UNSAFE_LOCK_FREE_POST \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCK_FREE_POST)
+
 // This special concurrency hint disables locking in the reactor I/O. This hint
 // has the following restrictions:
 //
@@ -71,6 +111,17 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION)
 
+// This special concurrency hint disables locking in the reactor I/O, as for
+// ASIO_CONCURRENCY_HINT_UNSAFE_IO, and has operations posted from threads other
+// than the one running the io_context added to a lock-free queue, as for
+// ASIO_CONCURRENCY_HINT_UNSAFE_LOCK_FREE_POST. The io_context must only be run
+// from one thread at a time.
+#define ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_LOCK_FREE_POST)
+
 // The special concurrency hint provides full thread safety.
 #define ASIO_CONCURRENCY_HINT_SAFE \
   static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
@@ -78,6 +129,76 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO)
 
+// Helper macro to determine if work stealing is enabled for the scheduler.
+#define ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER, hint) \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_WORK_STEALING) != 0)
+
+// Helper macro to determine if lock-free posting is enabled for the scheduler.
+#define ASIO_CONCURRENCY_HINT_IS_LOCK_FREE_POST(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_WORK_STEALING) == 0 \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_LOCK_FREE_POST) != 0)
+
+// Helper macro to extract the number of per-thread queues from a hint.
+#define ASIO_CONCURRENCY_HINT_SHARDS(hint) \
+  ((static_cast<unsigned>(hint) >> ASIO_CONCURRENCY_HINT_SHARDS_SHIFT) \
+    & ASIO_CONCURRENCY_HINT_SHARDS_MASK)
+
+// Helper macro to extract the reactor's event batch size from a hint. Returns
+// 0 if the hint does not specify one.
+#define ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SIZE(hint) \
+  ((ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && ((static_cast<unsigned>(hint) \
+      >> ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SHIFT) \
+        & ASIO_CONCURRENCY_HINT_REACTOR_BATCH_MASK) != 0) \
+    ? (32u << ((static_cast<unsigned>(hint) \
+        >> ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SHIFT) \
+          & ASIO_CONCURRENCY_HINT_REACTOR_BATCH_MASK)) \
+    : 0u)
+
+// Helper macro to determine if reactor re-polling is enabled by a hint.
+#define ASIO_CONCURRENCY_HINT_IS_REACTOR_REPOLL(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_REACTOR_REPOLL) != 0)
+
+// Adds reactor tuning to one of the special concurrency hints. The reactor
+// harvests up to 2 to the power of log2_size events, where log2_size is
+// between 6 and 12, with each system call. If repoll is true, the reactor
+// polls again without blocking for as long as new events keep arriving, rather
+// than returning to the scheduler after a single system call.
+#define ASIO_CONCURRENCY_HINT_REACTOR_BATCH(hint, log2_size, repoll) \
+  static_cast<int>((static_cast<unsigned>(hint) \
+      & ~((ASIO_CONCURRENCY_HINT_REACTOR_BATCH_MASK \
+          << ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SHIFT) \
+        | ASIO_CONCURRENCY_HINT_REACTOR_REPOLL)) \
+      | (((static_cast<unsigned>(log2_size) - 5) \
+          & ASIO_CONCURRENCY_HINT_REACTOR_BATCH_MASK) \
+        << ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SHIFT) \
+      | ((repoll) ? ASIO_CONCURRENCY_HINT_REACTOR_REPOLL : 0u))
+
+// This special concurrency hint provides full thread safety, and has the
+// scheduler keep a lock-free run queue for each thread that runs it. Handlers
+// posted from within a running handler are queued on the calling thread,
+// handlers posted from other threads are spread across the queues, and idle
+// threads steal work from busy ones. The argument specifies the number of
+// queues, where 0 means one per hardware thread; any thread beyond that number
+// runs without a queue of its own and relies on stealing.
+#define ASIO_CONCURRENCY_HINT_WORK_STEALING_SAFE(shards) \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | ASIO_CONCURRENCY_HINT_WORK_STEALING \
+      | ((static_cast<unsigned>(shards) \
+        & ASIO_CONCURRENCY_HINT_SHARDS_MASK) \
+          << ASIO_CONCURRENCY_HINT_SHARDS_SHIFT))
+
 // This #define may be overridden at compile time to specify a program-wide
 // default concurrency hint, used by the zero-argument io_context constructor.
 #if !defined(ASIO_CONCURRENCY_HINT_DEFAULT)
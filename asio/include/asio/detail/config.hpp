@@ -328,6 +328,27 @@
 # endif // !defined(ASIO_DISABLE_ALIAS_TEMPLATES)
 #endif // !defined(ASIO_HAS_ALIAS_TEMPLATES)
 
+// Support for the alignof operator.
+#if !defined(ASIO_HAS_ALIGNOF)
+# if !defined(ASIO_DISABLE_ALIGNOF)
+#  if (__cplusplus >= 201103) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+#   define ASIO_HAS_ALIGNOF 1
+#  endif // (__cplusplus >= 201103) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+# endif // !defined(ASIO_DISABLE_ALIGNOF)
+#endif // !defined(ASIO_HAS_ALIGNOF)
+
+#if defined(ASIO_HAS_ALIGNOF)
+# define ASIO_ALIGNOF(T) alignof(T)
+# if defined(__STDCPP_DEFAULT_NEW_ALIGNMENT__)
+#  define ASIO_DEFAULT_ALIGN __STDCPP_DEFAULT_NEW_ALIGNMENT__
+# else // defined(__STDCPP_DEFAULT_NEW_ALIGNMENT__)
+#  define ASIO_DEFAULT_ALIGN alignof(std::max_align_t)
+# endif // defined(__STDCPP_DEFAULT_NEW_ALIGNMENT__)
+#else // defined(ASIO_HAS_ALIGNOF)
+# define ASIO_ALIGNOF(T) 1
+# define ASIO_DEFAULT_ALIGN 1
+#endif // defined(ASIO_HAS_ALIGNOF)
+
 // Support return type deduction on compilers known to allow it.
 #if !defined(ASIO_HAS_RETURN_TYPE_DEDUCTION)
 # if !defined(ASIO_DISABLE_RETURN_TYPE_DEDUCTION)
@@ -1069,7 +1090,7 @@
 # include <unistd.h>
 #endif // defined(ASIO_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd, recvmmsg/sendmmsg, and MSG_ZEROCOPY.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(ASIO_HAS_EPOLL)
@@ -1093,8 +1114,40 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_MMSG)
+#  if !defined(ASIO_DISABLE_MMSG)
+#   if defined(_GNU_SOURCE) && defined(__GLIBC__)
+#    if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#     define ASIO_HAS_MMSG 1
+#    endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#   endif // defined(_GNU_SOURCE) && defined(__GLIBC__)
+#  endif // !defined(ASIO_DISABLE_MMSG)
+# endif // !defined(ASIO_HAS_MMSG)
+# if !defined(ASIO_HAS_MSG_ZEROCOPY)
+#  if !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#   if defined(ASIO_HAS_EPOLL) && defined(__GLIBC__)
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#     if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#      define ASIO_HAS_MSG_ZEROCOPY 1
+#     endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#    endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#   endif // defined(ASIO_HAS_EPOLL) && defined(__GLIBC__)
+#  endif // !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+# endif // !defined(ASIO_HAS_MSG_ZEROCOPY)
 #endif // defined(__linux__)
 
+// Linux: io_uring. Support is opt-in, as it requires kernel 5.5 or later, and
+// is layered on top of the epoll reactor.
+#if defined(ASIO_HAS_IO_URING)
+# if !defined(ASIO_HAS_EPOLL) \
+  || !defined(ASIO_HAS_EVENTFD) \
+  || defined(ASIO_DISABLE_IO_URING)
+#  undef ASIO_HAS_IO_URING
+# endif // !defined(ASIO_HAS_EPOLL)
+        //   || !defined(ASIO_HAS_EVENTFD)
+        //   || defined(ASIO_DISABLE_IO_URING)
+#endif // defined(ASIO_HAS_IO_URING)
+
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
 #if (defined(__MACH__) && defined(__APPLE__)) \
   || defined(__FreeBSD__) \
@@ -1303,6 +1356,18 @@
 # endif // defined(ASIO_HAS_THREADS)
 #endif // !defined(ASIO_HAS_PTHREADS)
 
+// Linux: regular files. Asynchronous file operations are submitted to
+// io_uring when it is enabled, or otherwise run on a private thread pool.
+#if !defined(ASIO_HAS_FILE)
+# if !defined(ASIO_DISABLE_FILE)
+#  if defined(__linux__)
+#   if defined(ASIO_HAS_IO_URING) || defined(ASIO_HAS_THREADS)
+#    define ASIO_HAS_FILE 1
+#   endif // defined(ASIO_HAS_IO_URING) || defined(ASIO_HAS_THREADS)
+#  endif // defined(__linux__)
+# endif // !defined(ASIO_DISABLE_FILE)
+#endif // !defined(ASIO_HAS_FILE)
+
 // Helper to prevent macro expansion.
 #define ASIO_PREVENT_MACRO_SUBSTITUTION
 
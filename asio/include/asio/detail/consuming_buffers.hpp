@@ -17,9 +17,16 @@
 
 #include "asio/detail/config.hpp"
 #include <cstddef>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <new>
 #include "asio/buffer.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/thread_info_base.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -56,7 +63,12 @@ struct prepared_buffers
   typedef Buffer value_type;
   typedef const Buffer* const_iterator;
 
-  enum { max_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
+  enum
+  {
+    max_buffers = MaxBuffers < static_cast<std::size_t>(
+        buffer_sequence_adapter_base::max_buffers) ? MaxBuffers
+      : static_cast<std::size_t>(buffer_sequence_adapter_base::max_buffers)
+  };
 
   prepared_buffers() : count(0) {}
   const_iterator begin() const { return elems; }
@@ -66,6 +78,119 @@ struct prepared_buffers
   std::size_t count;
 };
 
+// Scratch space into which runs of small buffers are copied, so that a long
+// sequence may be gathered by fewer operations. Buffers that are read into
+// cannot be coalesced.
+template <typename Buffer>
+class buffer_coalescer
+{
+public:
+  // Buffers no larger than this are candidates for coalescing.
+  enum { max_size = 0 };
+
+  void reset()
+  {
+  }
+
+  Buffer copy(const Buffer&)
+  {
+    return Buffer();
+  }
+};
+
+template <>
+class buffer_coalescer<const_buffer>
+{
+private:
+  // The header at the start of the scratch space.
+  struct block
+  {
+    block() : ref_count_(1) {}
+    atomic_count ref_count_;
+  };
+
+  // The scratch space is taken from the recycling allocator, and is sized so
+  // that the thread's cache can hold it.
+  enum { block_size = thread_info_base::max_cached_size };
+
+public:
+  // Buffers no larger than this are candidates for coalescing.
+  enum { max_size = 128 };
+
+  // The amount of scratch space.
+  enum { capacity = block_size - sizeof(block) };
+
+  buffer_coalescer()
+    : block_(0),
+      used_(0)
+  {
+  }
+
+  // Copies share the scratch space, as the data prepared by one copy may still
+  // be in use by an operation after the object has been copied or moved.
+  buffer_coalescer(const buffer_coalescer& other)
+    : block_(other.block_),
+      used_(other.used_)
+  {
+    if (block_)
+      increment(block_->ref_count_, 1);
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  buffer_coalescer(buffer_coalescer&& other)
+    : block_(other.block_),
+      used_(other.used_)
+  {
+    other.block_ = 0;
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  ~buffer_coalescer()
+  {
+    if (block_ && --block_->ref_count_ == 0)
+    {
+      block_->~block();
+      recycling_allocator<unsigned char>().deallocate(
+          reinterpret_cast<unsigned char*>(block_), block_size);
+    }
+  }
+
+  buffer_coalescer& operator=(const buffer_coalescer& other)
+  {
+    buffer_coalescer tmp(other);
+    std::swap(block_, tmp.block_);
+    used_ = other.used_;
+    return *this;
+  }
+
+  // Start filling the scratch space from the beginning.
+  void reset()
+  {
+    used_ = 0;
+  }
+
+  // Copy the buffer into the scratch space. Returns an empty buffer if there
+  // is not enough room, in which case the caller uses the buffer as is.
+  const_buffer copy(const const_buffer& buffer)
+  {
+    if (buffer.size() > static_cast<std::size_t>(capacity) - used_)
+      return const_buffer();
+
+    if (!block_)
+      block_ = new (recycling_allocator<unsigned char>().allocate(
+            block_size)) block;
+
+    unsigned char* data = reinterpret_cast<unsigned char*>(block_ + 1) + used_;
+    std::memcpy(data, buffer.data(), buffer.size());
+    used_ += buffer.size();
+    return const_buffer(data, buffer.size());
+  }
+
+private:
+  block* block_;
+  std::size_t used_;
+};
+
 // A proxy for a sub-range in a list of buffers.
 template <typename Buffer, typename Buffers, typename Buffer_Iterator>
 class consuming_buffers
@@ -83,6 +208,9 @@ public:
   {
     using asio::buffer_size;
     total_size_ = buffer_size(buffers);
+    total_elems_ = static_cast<std::size_t>(
+        std::distance(asio::buffer_sequence_begin(buffers_),
+          asio::buffer_sequence_end(buffers_)));
   }
 
   // Determine if we are at the end of the buffers.
@@ -99,17 +227,47 @@ public:
     Buffer_Iterator next = asio::buffer_sequence_begin(buffers_);
     Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
 
+    // Runs of small buffers are copied into scratch space only when there are
+    // more buffers left than can be transferred in one operation.
+    bool coalesce = coalescer_type::max_size > 0
+      && total_elems_ - next_elem_ > static_cast<std::size_t>(
+          prepared_buffers_type::max_buffers);
+    bool last_copied = false;
+    coalescer_.reset();
+
     std::advance(next, next_elem_);
     std::size_t elem_offset = next_elem_offset_;
     while (next != end && max_size > 0 && (result.count) < result.max_buffers)
     {
-      Buffer next_buf = Buffer(*next) + elem_offset;
-      result.elems[result.count] = asio::buffer(next_buf, max_size);
-      max_size -= result.elems[result.count].size();
+      Buffer next_buf = asio::buffer(Buffer(*next) + elem_offset, max_size);
       elem_offset = 0;
-      if (result.elems[result.count].size() > 0)
-        ++result.count;
       ++next;
+      if (next_buf.size() == 0)
+        continue;
+      max_size -= next_buf.size();
+
+      if (coalesce && next_buf.size()
+          <= static_cast<std::size_t>(coalescer_type::max_size))
+      {
+        Buffer copied_buf = coalescer_.copy(next_buf);
+        if (copied_buf.size() > 0)
+        {
+          // Consecutive copies are contiguous in the scratch space.
+          if (last_copied)
+          {
+            Buffer& last_buf = result.elems[result.count - 1];
+            last_buf = Buffer(last_buf.data(),
+                last_buf.size() + copied_buf.size());
+          }
+          else
+            result.elems[result.count++] = copied_buf;
+          last_copied = true;
+          continue;
+        }
+      }
+
+      result.elems[result.count++] = next_buf;
+      last_copied = false;
     }
 
     return result;
@@ -149,11 +307,15 @@ public:
   }
 
 private:
+  typedef buffer_coalescer<Buffer> coalescer_type;
+
   Buffers buffers_;
   std::size_t total_size_;
+  std::size_t total_elems_;
   std::size_t total_consumed_;
   std::size_t next_elem_;
   std::size_t next_elem_offset_;
+  coalescer_type coalescer_;
 };
 
 // Base class of all consuming_buffers specialisations for single buffers.
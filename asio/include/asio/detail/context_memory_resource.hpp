@@ -0,0 +1,53 @@
+//
+// detail/context_memory_resource.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CONTEXT_MEMORY_RESOURCE_HPP
+#define ASIO_DETAIL_CONTEXT_MEMORY_RESOURCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/memory_resource.hpp"
+
+#if defined(ASIO_HAS_IOCP)
+# include "asio/detail/win_iocp_io_context.hpp"
+#else // defined(ASIO_HAS_IOCP)
+# include "asio/detail/scheduler.hpp"
+#endif // defined(ASIO_HAS_IOCP)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Get the memory resource used for internal allocations by an execution
+// context, or null if it has none.
+inline memory_resource* context_memory_resource(execution_context& ctx)
+{
+#if defined(ASIO_HAS_IOCP)
+  typedef win_iocp_io_context scheduler_impl;
+#else // defined(ASIO_HAS_IOCP)
+  typedef scheduler scheduler_impl;
+#endif // defined(ASIO_HAS_IOCP)
+
+  if (has_service<scheduler_impl>(ctx))
+    return use_service<scheduler_impl>(ctx).get_memory_resource();
+  return 0;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_CONTEXT_MEMORY_RESOURCE_HPP
@@ -20,6 +20,7 @@
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/context_memory_resource.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -66,6 +67,7 @@ public:
   deadline_timer_service(execution_context& context)
     : execution_context_service_base<
         deadline_timer_service<Time_Traits> >(context),
+      timer_queue_(context_memory_resource(context)),
       scheduler_(asio::use_service<timer_scheduler>(context))
   {
     scheduler_.init_task();
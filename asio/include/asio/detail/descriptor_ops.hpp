@@ -24,6 +24,7 @@
 #include <cstddef>
 #include "asio/error.hpp"
 #include "asio/error_code.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/socket_types.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -87,6 +88,17 @@ ASIO_DECL bool non_blocking_write(int d,
     const buf* bufs, std::size_t count,
     asio::error_code& ec, std::size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_FILE)
+
+ASIO_DECL std::size_t sync_read_at(int d, uint64_t offset,
+    buf* bufs, std::size_t count, bool all_empty, asio::error_code& ec);
+
+ASIO_DECL std::size_t sync_write_at(int d, uint64_t offset,
+    const buf* bufs, std::size_t count, bool all_empty,
+    asio::error_code& ec);
+
+#endif // defined(ASIO_HAS_FILE)
+
 ASIO_DECL int ioctl(int d, state_type& state, long cmd,
     ioctl_arg_type* arg, asio::error_code& ec);
 
@@ -21,10 +21,12 @@
 
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/held_error_queue.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/object_pool.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/reactor_zero_copy_op.hpp"
 #include "asio/detail/select_interrupter.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/timer_queue_base.hpp"
@@ -32,6 +34,8 @@
 #include "asio/detail/wait_op.hpp"
 #include "asio/execution_context.hpp"
 
+#include <sys/epoll.h>
+
 #if defined(ASIO_HAS_TIMERFD)
 # include <sys/timerfd.h>
 #endif // defined(ASIO_HAS_TIMERFD)
@@ -39,6 +43,9 @@
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
+
+class reactor_statistics;
+
 namespace detail {
 
 class epoll_reactor
@@ -68,11 +75,24 @@ public:
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
     bool shutdown_;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // Zero-copy sends waiting for the kernel to release their buffers.
+    op_queue<reactor_op> release_queue_;
+    uint32_t zero_copy_next_;
+
+    // Other entries taken from the error queue while waiting for zero-copy
+    // notifications.
+    held_error_queue held_errors_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
     ASIO_DECL operation* perform_io(uint32_t events);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    ASIO_DECL void start_release(reactor_op* op);
+    ASIO_DECL void perform_release(op_queue<operation>& ops);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
     ASIO_DECL static void do_complete(
         void* owner, operation* base,
         const asio::error_code& ec, std::size_t bytes_transferred);
@@ -125,6 +145,15 @@ public:
       per_descriptor_data& descriptor_data, reactor_op* op,
       bool is_continuation, bool allow_speculative);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Get the entries taken from the descriptor's error queue while waiting for
+  // zero-copy notifications. Reads of the error queue must take these first.
+  held_error_queue* held_errors(per_descriptor_data& descriptor_data)
+  {
+    return descriptor_data ? &descriptor_data->held_errors_ : 0;
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Cancel all operations associated with the given descriptor. The
   // handlers associated with the descriptor will be invoked with the
   // operation_aborted error.
@@ -182,10 +211,25 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Get the event harvesting counters.
+  ASIO_DECL reactor_statistics statistics() const;
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
 
+  // The default number of events to harvest with each call to epoll_wait.
+  enum { default_batch_size = 128 };
+
+  // The maximum number of additional non-blocking calls to epoll_wait made by
+  // a single run of the reactor when re-polling is enabled.
+  enum { max_repolls = 16 };
+
+  // Harvest ready events with a single call to epoll_wait. Returns false if
+  // the reactor has been interrupted.
+  ASIO_DECL bool harvest_events(int timeout,
+      op_queue<operation>& ops, bool& check_timers);
+
   // Create the epoll file descriptor. Throws an exception if the descriptor
   // cannot be created.
   ASIO_DECL static int do_epoll_create();
@@ -246,6 +290,22 @@ private:
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
 
+  // The maximum number of events to harvest with each call to epoll_wait.
+  const int batch_size_;
+
+  // Whether to poll again while events keep arriving.
+  const bool repoll_;
+
+  // The buffer into which events are harvested. Only used by the thread that
+  // is running the reactor.
+  epoll_event* events_;
+
+  // Event harvesting counters.
+  atomic_count wakeups_;
+  atomic_count polls_;
+  atomic_count events_harvested_;
+  atomic_count full_batches_;
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
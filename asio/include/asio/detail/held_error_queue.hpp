@@ -0,0 +1,119 @@
+//
+// detail/held_error_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_HELD_ERROR_QUEUE_HPP
+#define ASIO_DETAIL_HELD_ERROR_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include <cstddef>
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Entries taken from a socket's error queue by the reactor, while it waits for
+// zero-copy notifications, that are not themselves zero-copy notifications.
+// The kernel always removes an entry from the error queue when it is read,
+// even with MSG_PEEK, so such entries are held here until the next read of the
+// error queue.
+class held_error_queue
+  : private noncopyable
+{
+public:
+  // The maximum number of entries that are held. As with the kernel's own
+  // queue, newer entries are dropped once the queue is full.
+  enum { max_entries = 64 };
+
+  // The maximum number of data bytes held with each entry. The data is
+  // truncated beyond this, and reported to the reader with MSG_TRUNC.
+  enum { max_data_size = 2048 };
+
+  // Constructor.
+  held_error_queue()
+    : front_(0),
+      back_(0),
+      size_(0)
+  {
+  }
+
+  // Destructor.
+  ~held_error_queue()
+  {
+    clear();
+  }
+
+  // Whether there are no held entries.
+  bool empty()
+  {
+    mutex::scoped_lock lock(mutex_);
+    return front_ == 0;
+  }
+
+  // Hold a copy of an entry that was read from the error queue, where bytes is
+  // the number of data bytes that were received.
+  ASIO_DECL void push(const msghdr& msg, std::size_t bytes);
+
+  // Remove the oldest entry, copying it out as recvmsg would. Returns false if
+  // there are no held entries.
+  ASIO_DECL bool pop(socket_ops::buf* bufs, std::size_t count,
+      socket_addr_type* addr, std::size_t* addrlen, void* control,
+      std::size_t* control_len, int& out_flags,
+      std::size_t& bytes_transferred);
+
+  // Discard all held entries.
+  ASIO_DECL void clear();
+
+private:
+  // An entry is allocated together with its control, name and data bytes,
+  // which follow it in that order.
+  struct entry
+  {
+    entry* next_;
+    std::size_t data_size_;
+    std::size_t name_size_;
+    std::size_t control_size_;
+    int flags_;
+  };
+
+  // Mutex to protect access to the entries.
+  mutex mutex_;
+
+  // The oldest and newest entries.
+  entry* front_;
+  entry* back_;
+
+  // The number of held entries.
+  std::size_t size_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/held_error_queue.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_HELD_ERROR_QUEUE_HPP
@@ -321,6 +321,84 @@ bool non_blocking_write(int d, const buf* bufs, std::size_t count,
   }
 }
 
+#if defined(ASIO_HAS_FILE)
+
+std::size_t sync_read_at(int d, uint64_t offset,
+    buf* bufs, std::size_t count, bool all_empty, asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to read 0 bytes is a no-op.
+  if (all_empty)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  for (;;)
+  {
+    // Read some data at the given offset.
+    errno = 0;
+    signed_size_type bytes = error_wrapper(::preadv(d, bufs,
+          static_cast<int>(count), static_cast<off_t>(offset)), ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Check for EOF.
+    if (bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec != asio::error::interrupted)
+      return 0;
+  }
+}
+
+std::size_t sync_write_at(int d, uint64_t offset,
+    const buf* bufs, std::size_t count, bool all_empty,
+    asio::error_code& ec)
+{
+  if (d == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes is a no-op.
+  if (all_empty)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  for (;;)
+  {
+    // Write some data at the given offset.
+    errno = 0;
+    signed_size_type bytes = error_wrapper(::pwritev(d, bufs,
+          static_cast<int>(count), static_cast<off_t>(offset)), ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Retry operation if interrupted by signal.
+    if (ec != asio::error::interrupted)
+      return 0;
+  }
+}
+
+#endif // defined(ASIO_HAS_FILE)
+
 int ioctl(int d, state_type& state, long cmd,
     ioctl_arg_type* arg, asio::error_code& ec)
 {
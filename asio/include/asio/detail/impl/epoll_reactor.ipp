@@ -20,15 +20,21 @@
 #if defined(ASIO_HAS_EPOLL)
 
 #include <cstddef>
+#include <cstring>
 #include <sys/epoll.h>
 #include "asio/detail/epoll_reactor.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
+#include "asio/reactor_statistics.hpp"
 
 #if defined(ASIO_HAS_TIMERFD)
 # include <sys/timerfd.h>
 #endif // defined(ASIO_HAS_TIMERFD)
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+# include <linux/errqueue.h>
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -43,7 +49,20 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    registered_descriptors_(scheduler_.get_memory_resource()),
+    batch_size_(ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SIZE(
+          scheduler_.concurrency_hint())
+        ? static_cast<int>(ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SIZE(
+            scheduler_.concurrency_hint()))
+        : static_cast<int>(default_batch_size)),
+    repoll_(ASIO_CONCURRENCY_HINT_IS_REACTOR_REPOLL(
+          scheduler_.concurrency_hint())),
+    events_(new epoll_event[batch_size_]),
+    wakeups_(0),
+    polls_(0),
+    events_harvested_(0),
+    full_batches_(0)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -67,6 +86,7 @@ epoll_reactor::~epoll_reactor()
     close(epoll_fd_);
   if (timer_fd_ != -1)
     close(timer_fd_);
+  delete[] events_;
 }
 
 void epoll_reactor::shutdown()
@@ -81,6 +101,9 @@ void epoll_reactor::shutdown()
   {
     for (int i = 0; i < max_ops; ++i)
       ops.push(state->op_queue_[i]);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    ops.push(state->release_queue_);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
     state->shutdown_ = true;
     registered_descriptors_.free(state);
   }
@@ -164,6 +187,10 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->shutdown_ = false;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    descriptor_data->zero_copy_next_ = 0;
+    descriptor_data->held_errors_.clear();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -207,6 +234,10 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->op_queue_[op_type].push(op);
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    descriptor_data->zero_copy_next_ = 0;
+    descriptor_data->held_errors_.clear();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -257,6 +288,14 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       {
         if (reactor_op::status status = op->perform())
         {
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+          if (status == reactor_op::done_pending_release)
+          {
+            descriptor_data->start_release(op);
+            scheduler_.work_started();
+            return;
+          }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
           if (status == reactor_op::done_and_exhausted)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
@@ -326,6 +365,8 @@ void epoll_reactor::cancel_ops(socket_type,
 
   mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
+  // Zero-copy sends waiting for release have already sent all of their data,
+  // and the kernel may still be using their buffers, so they are not cancelled.
   op_queue<operation> ops;
   for (int i = 0; i < max_ops; ++i)
   {
@@ -373,6 +414,15 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
         ops.push(op);
       }
     }
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    while (reactor_op* op = descriptor_data->release_queue_.front())
+    {
+      op->ec_ = asio::error::operation_aborted;
+      descriptor_data->release_queue_.pop();
+      ops.push(op);
+    }
+    descriptor_data->held_errors_.clear();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     descriptor_data->descriptor_ = -1;
     descriptor_data->shutdown_ = true;
@@ -412,6 +462,9 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
     op_queue<operation> ops;
     for (int i = 0; i < max_ops; ++i)
       ops.push(descriptor_data->op_queue_[i]);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    ops.push(descriptor_data->release_queue_);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     descriptor_data->descriptor_ = -1;
     descriptor_data->shutdown_ = true;
@@ -465,9 +518,51 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     }
   }
 
-  // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  ++wakeups_;
+
+#if defined(ASIO_HAS_TIMERFD)
+  bool check_timers = (timer_fd_ == -1);
+#else // defined(ASIO_HAS_TIMERFD)
+  bool check_timers = true;
+#endif // defined(ASIO_HAS_TIMERFD)
+
+  // Block on the epoll descriptor. If re-polling is enabled, keep harvesting
+  // events without blocking while they continue to arrive, unless the reactor
+  // is interrupted because the scheduler has other work to do.
+  if (harvest_events(timeout, ops, check_timers) && repoll_)
+    for (int i = 0; i < max_repolls; ++i)
+      if (!harvest_events(0, ops, check_timers))
+        break;
+
+  if (check_timers)
+  {
+    mutex::scoped_lock common_lock(mutex_);
+    timer_queues_.get_ready_timers(ops);
+
+#if defined(ASIO_HAS_TIMERFD)
+    if (timer_fd_ != -1)
+    {
+      itimerspec new_timeout;
+      itimerspec old_timeout;
+      int flags = get_timeout(new_timeout);
+      timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+    }
+#endif // defined(ASIO_HAS_TIMERFD)
+  }
+}
+
+bool epoll_reactor::harvest_events(int timeout,
+    op_queue<operation>& ops, bool& check_timers)
+{
+  epoll_event* events = events_;
+  int num_events = epoll_wait(epoll_fd_, events, batch_size_, timeout);
+
+  ++polls_;
+  if (num_events <= 0)
+    return false;
+  increment(events_harvested_, num_events);
+  if (num_events == batch_size_)
+    ++full_batches_;
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -499,13 +594,8 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   }
 #endif // defined(ASIO_ENABLE_HANDLER_TRACKING)
 
-#if defined(ASIO_HAS_TIMERFD)
-  bool check_timers = (timer_fd_ == -1);
-#else // defined(ASIO_HAS_TIMERFD)
-  bool check_timers = true;
-#endif // defined(ASIO_HAS_TIMERFD)
-
   // Dispatch the waiting events.
+  bool interrupted = false;
   for (int i = 0; i < num_events; ++i)
   {
     void* ptr = events[i].data.ptr;
@@ -522,6 +612,8 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 #else // defined(ASIO_HAS_TIMERFD)
       check_timers = true;
 #endif // defined(ASIO_HAS_TIMERFD)
+
+      interrupted = true;
     }
 #if defined(ASIO_HAS_TIMERFD)
     else if (ptr == &timer_fd_)
@@ -547,21 +639,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     }
   }
 
-  if (check_timers)
-  {
-    mutex::scoped_lock common_lock(mutex_);
-    timer_queues_.get_ready_timers(ops);
-
-#if defined(ASIO_HAS_TIMERFD)
-    if (timer_fd_ != -1)
-    {
-      itimerspec new_timeout;
-      itimerspec old_timeout;
-      int flags = get_timeout(new_timeout);
-      timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
-    }
-#endif // defined(ASIO_HAS_TIMERFD)
-  }
+  return !interrupted;
 }
 
 void epoll_reactor::interrupt()
@@ -628,6 +706,15 @@ epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
         REACTOR_IO, scheduler_.concurrency_hint()));
 }
 
+reactor_statistics epoll_reactor::statistics() const
+{
+  return reactor_statistics(
+      static_cast<long>(wakeups_),
+      static_cast<long>(polls_),
+      static_cast<long>(events_harvested_),
+      static_cast<long>(full_batches_));
+}
+
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
@@ -720,6 +807,9 @@ struct epoll_reactor::perform_io_cleanup_on_block_exit
 epoll_reactor::descriptor_state::descriptor_state(bool locking)
   : operation(&epoll_reactor::descriptor_state::do_complete),
     mutex_(locking)
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    , zero_copy_next_(0)
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 {
 }
 
@@ -729,6 +819,12 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   perform_io_cleanup_on_block_exit io_cleanup(reactor_);
   mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // The kernel notifies the release of zero-copy sends via the error queue.
+  if ((events & EPOLLERR) && !release_queue_.empty())
+    perform_release(io_cleanup.ops_);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
   static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
@@ -742,6 +838,13 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
         if (reactor_op::status status = op->perform())
         {
           op_queue_[j].pop();
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+          if (status == reactor_op::done_pending_release)
+          {
+            start_release(op);
+            continue;
+          }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
           io_cleanup.ops_.push(op);
           if (status == reactor_op::done_and_exhausted)
           {
@@ -762,6 +865,88 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   return io_cleanup.first_op_;
 }
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+void epoll_reactor::descriptor_state::start_release(reactor_op* base)
+{
+  // The kernel numbers zero-copy sends consecutively, starting from zero, and
+  // the write queue ensures that only one operation is sending at a time.
+  reactor_zero_copy_op* op = static_cast<reactor_zero_copy_op*>(base);
+  op->zero_copy_first_ = zero_copy_next_;
+  op->zero_copy_pending_ = op->zero_copy_sends_;
+  zero_copy_next_ += op->zero_copy_sends_;
+  release_queue_.push(op);
+}
+
+void epoll_reactor::descriptor_state::perform_release(op_queue<operation>& ops)
+{
+  // Reading an entry always removes it from the error queue, so the queue is
+  // read only while zero-copy sends are waiting to be released. Any other
+  // entries are held for the next read of the error queue.
+  while (!release_queue_.empty())
+  {
+    union
+    {
+      cmsghdr header;
+      char buffer[512];
+    } control;
+    char data[held_error_queue::max_data_size];
+    sockaddr_storage name;
+
+    iovec iov = { data, sizeof(data) };
+    msghdr msg = msghdr();
+    msg.msg_name = &name;
+    msg.msg_namelen = sizeof(name);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = &control;
+    msg.msg_controllen = sizeof(control);
+    signed_size_type bytes = ::recvmsg(descriptor_,
+        &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+    if (bytes < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return;
+    }
+
+    bool is_zero_copy = false;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == IPPROTO_IPV6
+            && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        sock_extended_err err;
+        std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+          continue;
+        is_zero_copy = true;
+
+        // Each notification releases an inclusive range of sends, which may
+        // span several operations.
+        op_queue<reactor_op> pending;
+        while (reactor_op* op = release_queue_.front())
+        {
+          release_queue_.pop();
+          if (static_cast<reactor_zero_copy_op*>(op)->release(
+                err.ee_info, err.ee_data))
+            ops.push(op);
+          else
+            pending.push(op);
+        }
+        release_queue_.push(pending);
+      }
+    }
+
+    if (!is_zero_copy)
+      held_errors_.push(msg, static_cast<std::size_t>(bytes));
+  }
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
 void epoll_reactor::descriptor_state::do_complete(
     void* owner, operation* base,
     const asio::error_code& ec, std::size_t bytes_transferred)
@@ -0,0 +1,162 @@
+//
+// detail/impl/held_error_queue.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_HELD_ERROR_QUEUE_IPP
+#define ASIO_DETAIL_IMPL_HELD_ERROR_QUEUE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include <cstring>
+#include <new>
+#include "asio/detail/held_error_queue.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+void held_error_queue::push(const msghdr& msg, std::size_t bytes)
+{
+  std::size_t data_size = bytes < static_cast<std::size_t>(max_data_size)
+    ? bytes : static_cast<std::size_t>(max_data_size);
+  std::size_t name_size = msg.msg_name ? msg.msg_namelen : 0;
+  std::size_t control_size = msg.msg_control ? msg.msg_controllen : 0;
+
+  mutex::scoped_lock lock(mutex_);
+
+  if (size_ == max_entries)
+    return;
+
+  entry* e = static_cast<entry*>(::operator new(
+        sizeof(entry) + control_size + name_size + data_size));
+  e->next_ = 0;
+  e->data_size_ = data_size;
+  e->name_size_ = name_size;
+  e->control_size_ = control_size;
+  e->flags_ = msg.msg_flags;
+  if (data_size < bytes)
+    e->flags_ |= MSG_TRUNC;
+
+  char* p = reinterpret_cast<char*>(e + 1);
+  if (control_size)
+    std::memcpy(p, msg.msg_control, control_size);
+  p += control_size;
+  if (name_size)
+    std::memcpy(p, msg.msg_name, name_size);
+  p += name_size;
+  for (std::size_t i = 0; data_size > 0 && i < msg.msg_iovlen; ++i)
+  {
+    std::size_t n = msg.msg_iov[i].iov_len < data_size
+      ? msg.msg_iov[i].iov_len : data_size;
+    std::memcpy(p, msg.msg_iov[i].iov_base, n);
+    p += n;
+    data_size -= n;
+  }
+
+  if (back_)
+    back_->next_ = e;
+  else
+    front_ = e;
+  back_ = e;
+  ++size_;
+}
+
+bool held_error_queue::pop(socket_ops::buf* bufs, std::size_t count,
+    socket_addr_type* addr, std::size_t* addrlen, void* control,
+    std::size_t* control_len, int& out_flags, std::size_t& bytes_transferred)
+{
+  entry* e = 0;
+  {
+    mutex::scoped_lock lock(mutex_);
+    e = front_;
+    if (!e)
+      return false;
+    front_ = e->next_;
+    if (!front_)
+      back_ = 0;
+    --size_;
+  }
+
+  const char* control_data = reinterpret_cast<const char*>(e + 1);
+  const char* name_data = control_data + e->control_size_;
+  const char* data = name_data + e->name_size_;
+  out_flags = e->flags_;
+
+  // Copy only complete control messages, as the kernel does.
+  msghdr held = msghdr();
+  held.msg_control = const_cast<char*>(control_data);
+  held.msg_controllen = e->control_size_;
+  std::size_t control_copied = 0;
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&held);
+      cmsg != 0; cmsg = CMSG_NXTHDR(&held, cmsg))
+  {
+    std::size_t space = CMSG_SPACE(cmsg->cmsg_len - CMSG_LEN(0));
+    if (space > e->control_size_ - control_copied)
+      space = e->control_size_ - control_copied;
+    if (control_copied + space > *control_len)
+    {
+      out_flags |= MSG_CTRUNC;
+      break;
+    }
+    std::memcpy(static_cast<char*>(control) + control_copied, cmsg, space);
+    control_copied += space;
+  }
+  *control_len = control_copied;
+
+  if (addr)
+  {
+    if (*addrlen > e->name_size_)
+      *addrlen = e->name_size_;
+    if (*addrlen)
+      std::memcpy(addr, name_data, *addrlen);
+  }
+
+  bytes_transferred = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::size_t remaining = e->data_size_ - bytes_transferred;
+    std::size_t n = bufs[i].iov_len < remaining ? bufs[i].iov_len : remaining;
+    if (n)
+      std::memcpy(bufs[i].iov_base, data + bytes_transferred, n);
+    bytes_transferred += n;
+  }
+  if (bytes_transferred < e->data_size_)
+    out_flags |= MSG_TRUNC;
+
+  ::operator delete(e);
+  return true;
+}
+
+void held_error_queue::clear()
+{
+  mutex::scoped_lock lock(mutex_);
+  while (entry* e = front_)
+  {
+    front_ = e->next_;
+    ::operator delete(e);
+  }
+  back_ = 0;
+  size_ = 0;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_IMPL_HELD_ERROR_QUEUE_IPP
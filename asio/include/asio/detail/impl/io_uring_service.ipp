@@ -0,0 +1,807 @@
+//
+// detail/impl/io_uring_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <cstddef>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class io_uring_service::event_fd_read_op : public reactor_op
+{
+public:
+  event_fd_read_op(io_uring_service* s)
+    : reactor_op(&event_fd_read_op::do_perform, event_fd_read_op::do_complete),
+      service_(s)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    event_fd_read_op* o(static_cast<event_fd_read_op*>(base));
+
+    // Reset the eventfd before harvesting, so that any completion that arrives
+    // after we have looked at the ring generates a new readiness event.
+    uint64_t counter = 0;
+    while (::read(o->service_->event_fd_, &counter, sizeof(uint64_t)) > 0)
+      ;
+
+    op_queue<operation> ops;
+    o->service_->harvest_completions(ops);
+    o->service_->scheduler_.post_deferred_completions(ops);
+
+    return not_done;
+  }
+
+  static void do_complete(void* /*owner*/, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    event_fd_read_op* o(static_cast<event_fd_read_op*>(base));
+    delete o;
+  }
+
+private:
+  io_uring_service* service_;
+};
+
+io_uring_service::io_uring_service(asio::execution_context& ctx)
+  : execution_context_service_base<io_uring_service>(ctx),
+    scheduler_(use_service<scheduler>(ctx)),
+    reactor_(use_service<reactor>(ctx)),
+    mutex_(ASIO_CONCURRENCY_HINT_IS_LOCKING(
+          REACTOR_REGISTRATION, scheduler_.concurrency_hint())),
+    ring_fd_(-1),
+    features_(0),
+    sq_ring_ptr_(0),
+    sq_ring_size_(0),
+    sq_flags_(0),
+    sqes_(0),
+    sqes_size_(0),
+    cq_ring_ptr_(0),
+    cq_ring_size_(0),
+    sq_entries_(0),
+    sqe_tail_(0),
+    pending_sqes_(0),
+    pending_submit_sqes_op_(false),
+    outstanding_ops_(0),
+    event_fd_(-1),
+    reactor_data_(),
+    shutdown_(false),
+    registered_io_objects_mutex_(mutex_.enabled()),
+    registered_io_objects_(scheduler_.get_memory_resource()),
+    submit_sqes_op_(this)
+{
+  reactor_.init_task();
+
+  // If the ring cannot be created, leave the service disabled so that I/O
+  // objects fall back to the reactor.
+  asio::error_code ec;
+  if (init_ring(ec) || register_with_reactor(ec))
+    destroy_ring();
+}
+
+io_uring_service::~io_uring_service()
+{
+  deregister_from_reactor();
+  destroy_ring();
+}
+
+void io_uring_service::shutdown()
+{
+  mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  lock.unlock();
+
+  mutex::scoped_lock registration_lock(registered_io_objects_mutex_);
+
+  // Request cancellation of every operation that is in flight.
+  for (io_object* io_obj = registered_io_objects_.first();
+      io_obj != 0; io_obj = io_obj->next_)
+  {
+    mutex::scoped_lock io_object_lock(io_obj->mutex_);
+    for (int i = 0; i < max_ops; ++i)
+      if (!io_obj->queues_[i].op_queue_.empty())
+        cancel_io(io_obj->queues_[i]);
+  }
+
+  // The kernel may still be referencing the operations' buffers, so wait for
+  // all outstanding entries to complete before abandoning the operations.
+  lock.lock();
+  while (outstanding_ops_ > 0)
+  {
+    submit_sqes();
+    if (::syscall(__NR_io_uring_enter, ring_fd_,
+          0, 1, IORING_ENTER_GETEVENTS, 0, 0) < 0 && errno != EINTR)
+      break;
+    lock.unlock();
+    op_queue<operation> completed_queues;
+    harvest_completions(completed_queues);
+    while (!completed_queues.empty())
+      completed_queues.pop();
+    lock.lock();
+  }
+  lock.unlock();
+
+  op_queue<operation> ops;
+  while (io_object* io_obj = registered_io_objects_.first())
+  {
+    for (int i = 0; i < max_ops; ++i)
+      ops.push(io_obj->queues_[i].op_queue_);
+    io_obj->shutdown_ = true;
+    registered_io_objects_.free(io_obj);
+  }
+
+  scheduler_.abandon_operations(ops);
+}
+
+void io_uring_service::notify_fork(
+    asio::execution_context::fork_event fork_ev)
+{
+  if (fork_ev == asio::execution_context::fork_child && is_enabled())
+  {
+    // The ring's memory is shared with the parent, so the child must create
+    // its own. Operations that were in flight at the time of the fork belong
+    // to the parent's ring and are completed with operation_aborted.
+    deregister_from_reactor();
+    destroy_ring();
+    asio::error_code ec;
+    if (init_ring(ec) || register_with_reactor(ec))
+    {
+      destroy_ring();
+      asio::detail::throw_error(ec, "io_uring_setup");
+    }
+
+    op_queue<operation> ops;
+    mutex::scoped_lock registration_lock(registered_io_objects_mutex_);
+    for (io_object* io_obj = registered_io_objects_.first();
+        io_obj != 0; io_obj = io_obj->next_)
+    {
+      mutex::scoped_lock io_object_lock(io_obj->mutex_);
+      for (int i = 0; i < max_ops; ++i)
+      {
+        while (io_uring_operation* op = io_obj->queues_[i].op_queue_.front())
+        {
+          op->ec_ = asio::error::operation_aborted;
+          io_obj->queues_[i].op_queue_.pop();
+          ops.push(op);
+        }
+      }
+    }
+    registration_lock.unlock();
+
+    mutex::scoped_lock lock(mutex_);
+    outstanding_ops_ = 0;
+    pending_submit_sqes_op_ = false;
+    lock.unlock();
+
+    scheduler_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_service::init_task()
+{
+  reactor_.init_task();
+}
+
+void io_uring_service::register_io_object(
+    io_uring_service::per_io_object_data& io_obj)
+{
+  if (!is_enabled())
+  {
+    io_obj = 0;
+    return;
+  }
+
+  io_obj = allocate_io_object();
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  io_obj->service_ = this;
+  io_obj->shutdown_ = false;
+  for (int i = 0; i < max_ops; ++i)
+  {
+    io_obj->queues_[i].io_object_ = io_obj;
+    io_obj->queues_[i].cancel_requested_ = false;
+  }
+}
+
+void io_uring_service::start_op(int op_type,
+    io_uring_service::per_io_object_data& io_obj,
+    io_uring_operation* op, bool is_continuation)
+{
+  if (!io_obj)
+  {
+    op->ec_ = asio::error::bad_descriptor;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  if (io_obj->shutdown_)
+  {
+    io_object_lock.unlock();
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  io_queue& q = io_obj->queues_[op_type];
+  bool first = q.op_queue_.empty();
+  if (first)
+  {
+    if (op->perform(false))
+    {
+      io_object_lock.unlock();
+      post_immediate_completion(op, is_continuation);
+      return;
+    }
+  }
+
+  q.op_queue_.push(op);
+  scheduler_.work_started();
+  if (first)
+    start_io(q);
+}
+
+void io_uring_service::cancel_ops(
+    io_uring_service::per_io_object_data& io_obj)
+{
+  if (!io_obj)
+    return;
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  op_queue<operation> ops;
+  for (int i = 0; i < max_ops; ++i)
+  {
+    io_queue& q = io_obj->queues_[i];
+    if (io_uring_operation* first_op = q.op_queue_.front())
+    {
+      // Operations behind the first have not been submitted, so they can be
+      // aborted immediately. The first must wait for its completion.
+      q.op_queue_.pop();
+      while (io_uring_operation* op = q.op_queue_.front())
+      {
+        op->ec_ = asio::error::operation_aborted;
+        q.op_queue_.pop();
+        ops.push(op);
+      }
+      q.op_queue_.push(first_op);
+      q.cancel_requested_ = true;
+      cancel_io(q);
+    }
+  }
+
+  io_object_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+void io_uring_service::deregister_io_object(
+    io_uring_service::per_io_object_data& io_obj)
+{
+  if (!io_obj)
+    return;
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  if (!io_obj->shutdown_)
+  {
+    op_queue<operation> ops;
+    bool pending_cancelled_ops = false;
+    for (int i = 0; i < max_ops; ++i)
+    {
+      io_queue& q = io_obj->queues_[i];
+      if (io_uring_operation* first_op = q.op_queue_.front())
+      {
+        q.op_queue_.pop();
+        while (io_uring_operation* op = q.op_queue_.front())
+        {
+          op->ec_ = asio::error::operation_aborted;
+          q.op_queue_.pop();
+          ops.push(op);
+        }
+        q.op_queue_.push(first_op);
+        q.cancel_requested_ = true;
+        cancel_io(q);
+        pending_cancelled_ops = true;
+      }
+    }
+
+    io_obj->shutdown_ = true;
+
+    io_object_lock.unlock();
+
+    scheduler_.post_deferred_completions(ops);
+
+    if (pending_cancelled_ops)
+    {
+      // There are operations still in flight. Prevent cleanup_io_object from
+      // freeing the I/O object and let the last operation to complete free it.
+      io_obj = 0;
+    }
+    else
+    {
+      // Leave io_obj set so that it will be freed by the subsequent call to
+      // cleanup_io_object.
+    }
+  }
+  else
+  {
+    // We are shutting down, so prevent cleanup_io_object from freeing the I/O
+    // object and let the destructor free it instead.
+    io_obj = 0;
+  }
+}
+
+void io_uring_service::cleanup_io_object(
+    io_uring_service::per_io_object_data& io_obj)
+{
+  if (io_obj)
+  {
+    free_io_object(io_obj);
+    io_obj = 0;
+  }
+}
+
+void io_uring_service::harvest_completions(op_queue<operation>& ops)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  do
+  {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+      ::io_uring_cqe* cqe = &cqes_[head & *cq_ring_mask_];
+      if (cqe->user_data != static_cast<uint64_t>(internal_user_data))
+      {
+        // The operation doesn't count as work in and of itself, so we don't
+        // call work_started() here. This still allows the scheduler to stop
+        // if the only remaining operations are those in flight in the kernel.
+        io_queue* q = reinterpret_cast<io_queue*>(cqe->user_data);
+        q->set_result(cqe->res);
+        ops.push(q);
+        --outstanding_ops_;
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  } while (flush_overflowed_cqes());
+}
+
+asio::error_code io_uring_service::init_ring(asio::error_code& ec)
+{
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  ring_fd_ = static_cast<int>(
+      ::syscall(__NR_io_uring_setup, ring_size, &params));
+  if (ring_fd_ < 0)
+  {
+    ring_fd_ = -1;
+    ec = asio::error_code(errno,
+        asio::error::get_system_category());
+    return ec;
+  }
+  ::fcntl(ring_fd_, F_SETFD, FD_CLOEXEC);
+
+  features_ = params.features;
+  sq_entries_ = params.sq_entries;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes
+    + params.cq_entries * sizeof(::io_uring_cqe);
+  if ((features_ & IORING_FEAT_SINGLE_MMAP) != 0)
+  {
+    if (cq_ring_size_ > sq_ring_size_)
+      sq_ring_size_ = cq_ring_size_;
+    cq_ring_size_ = sq_ring_size_;
+  }
+
+  sq_ring_ptr_ = ::mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  cq_ring_ptr_ = ((features_ & IORING_FEAT_SINGLE_MMAP) != 0)
+    ? sq_ring_ptr_ : ::mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+  sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+  sqes_ = static_cast< ::io_uring_sqe*>(::mmap(0, sqes_size_,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring_fd_, IORING_OFF_SQES));
+
+  if (sq_ring_ptr_ == MAP_FAILED || cq_ring_ptr_ == MAP_FAILED
+      || sqes_ == MAP_FAILED)
+  {
+    ec = asio::error_code(errno,
+        asio::error::get_system_category());
+    destroy_ring();
+    return ec;
+  }
+
+  char* sq_ring = static_cast<char*>(sq_ring_ptr_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.tail);
+  sq_ring_mask_ = reinterpret_cast<unsigned*>(
+      sq_ring + params.sq_off.ring_mask);
+  sq_flags_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.flags);
+  sq_array_ = reinterpret_cast<unsigned*>(sq_ring + params.sq_off.array);
+
+  char* cq_ring = static_cast<char*>(cq_ring_ptr_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq_ring + params.cq_off.tail);
+  cq_ring_mask_ = reinterpret_cast<unsigned*>(
+      cq_ring + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast< ::io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+
+  sqe_tail_ = *sq_tail_;
+  pending_sqes_ = 0;
+
+  ec = asio::error_code();
+  return ec;
+}
+
+void io_uring_service::destroy_ring()
+{
+  if (sqes_ != MAP_FAILED && sqes_ != 0)
+    ::munmap(sqes_, sqes_size_);
+  if (cq_ring_ptr_ != MAP_FAILED && cq_ring_ptr_ != 0
+      && cq_ring_ptr_ != sq_ring_ptr_)
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  if (sq_ring_ptr_ != MAP_FAILED && sq_ring_ptr_ != 0)
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+  sqes_ = 0;
+  cq_ring_ptr_ = 0;
+  sq_ring_ptr_ = 0;
+
+  if (ring_fd_ != -1)
+    ::close(ring_fd_);
+  ring_fd_ = -1;
+}
+
+asio::error_code io_uring_service::register_with_reactor(
+    asio::error_code& ec)
+{
+  event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (event_fd_ == -1)
+  {
+    ec = asio::error_code(errno,
+        asio::error::get_system_category());
+    return ec;
+  }
+
+  if (::syscall(__NR_io_uring_register, ring_fd_,
+        IORING_REGISTER_EVENTFD, &event_fd_, 1) != 0)
+  {
+    ec = asio::error_code(errno,
+        asio::error::get_system_category());
+    ::close(event_fd_);
+    event_fd_ = -1;
+    return ec;
+  }
+
+  reactor_.register_internal_descriptor(reactor::read_op,
+      event_fd_, reactor_data_, new event_fd_read_op(this));
+
+  ec = asio::error_code();
+  return ec;
+}
+
+void io_uring_service::deregister_from_reactor()
+{
+  if (event_fd_ != -1)
+  {
+    reactor_.deregister_internal_descriptor(event_fd_, reactor_data_);
+    reactor_.cleanup_descriptor_data(reactor_data_);
+    ::close(event_fd_);
+    event_fd_ = -1;
+  }
+}
+
+::io_uring_sqe* io_uring_service::get_sqe()
+{
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sqe_tail_ - head >= sq_entries_)
+  {
+    submit_sqes();
+    head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= sq_entries_)
+      return 0;
+  }
+
+  unsigned index = sqe_tail_ & *sq_ring_mask_;
+  ::io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(::io_uring_sqe));
+  sq_array_[index] = index;
+  ++sqe_tail_;
+  ++pending_sqes_;
+  return sqe;
+}
+
+void io_uring_service::submit_sqes()
+{
+  if (pending_sqes_ != 0)
+  {
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    int result = static_cast<int>(::syscall(__NR_io_uring_enter,
+          ring_fd_, pending_sqes_, 0, 0, 0, 0));
+    if (result > 0)
+      pending_sqes_ -= (result < pending_sqes_) ? result : pending_sqes_;
+  }
+}
+
+bool io_uring_service::flush_overflowed_cqes()
+{
+#if defined(IORING_SQ_CQ_OVERFLOW)
+  // When the completion queue is full, the kernel holds further completions
+  // back until it is asked to flush them.
+  if ((__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE)
+        & IORING_SQ_CQ_OVERFLOW) != 0)
+  {
+    ::syscall(__NR_io_uring_enter, ring_fd_, 0, 0,
+        IORING_ENTER_GETEVENTS, 0, 0);
+    return true;
+  }
+#endif // defined(IORING_SQ_CQ_OVERFLOW)
+  return false;
+}
+
+void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
+{
+  if (pending_sqes_ >= submit_batch_size || !scheduler_.can_dispatch())
+  {
+    // Submit immediately when there are enough entries to make it worthwhile,
+    // or when we are not inside the scheduler and so have no opportunity to
+    // gather more entries.
+    submit_sqes();
+    lock.unlock();
+  }
+  else if (pending_sqes_ != 0 && !pending_submit_sqes_op_)
+  {
+    // Defer the submission until the currently executing handler returns, so
+    // that entries prepared by other handlers are submitted together.
+    pending_submit_sqes_op_ = true;
+    lock.unlock();
+    scheduler_.post_immediate_completion(&submit_sqes_op_, false);
+  }
+  else
+  {
+    lock.unlock();
+  }
+}
+
+void io_uring_service::start_io(io_uring_service::io_queue& q)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    q.op_queue_.front()->prepare(sqe);
+    sqe->user_data = reinterpret_cast<uint64_t>(&q);
+    ++outstanding_ops_;
+    post_submit_sqes_op(lock);
+  }
+  else
+  {
+    // The submission queue is full and the kernel is not consuming it, so
+    // fail every operation in the queue.
+    lock.unlock();
+    op_queue<operation> ops;
+    while (io_uring_operation* op = q.op_queue_.front())
+    {
+      op->ec_ = asio::error::no_buffer_space;
+      q.op_queue_.pop();
+      ops.push(op);
+    }
+    scheduler_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_service::cancel_io(io_uring_service::io_queue& q)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(&q);
+    sqe->user_data = static_cast<uint64_t>(internal_user_data);
+    submit_sqes();
+  }
+}
+
+io_uring_service::io_object* io_uring_service::allocate_io_object()
+{
+  mutex::scoped_lock registration_lock(registered_io_objects_mutex_);
+  return registered_io_objects_.alloc(ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+}
+
+void io_uring_service::free_io_object(io_uring_service::io_object* s)
+{
+  mutex::scoped_lock registration_lock(registered_io_objects_mutex_);
+  registered_io_objects_.free(s);
+}
+
+struct io_uring_service::perform_io_cleanup_on_block_exit
+{
+  explicit perform_io_cleanup_on_block_exit(io_uring_service* s)
+    : service_(s), first_op_(0)
+  {
+  }
+
+  ~perform_io_cleanup_on_block_exit()
+  {
+    if (first_op_)
+    {
+      // Post the remaining completed operations for invocation.
+      if (!ops_.empty())
+        service_->scheduler_.post_deferred_completions(ops_);
+
+      // A user-initiated operation has completed, but there's no need to
+      // explicitly call work_finished() here. Instead, we'll take advantage of
+      // the fact that the scheduler will call work_finished() once we return.
+    }
+    else
+    {
+      // No user-initiated operations have completed, so we need to compensate
+      // for the work_finished() call that the scheduler will make once this
+      // operation returns.
+      service_->scheduler_.compensating_work_started();
+    }
+  }
+
+  io_uring_service* service_;
+  op_queue<operation> ops_;
+  operation* first_op_;
+};
+
+io_uring_service::io_queue::io_queue()
+  : operation(&io_uring_service::io_queue::do_complete),
+    io_object_(0),
+    cancel_requested_(false)
+{
+}
+
+operation* io_uring_service::io_queue::perform_io(int result)
+{
+  io_uring_service* service = io_object_->service_;
+  perform_io_cleanup_on_block_exit io_cleanup(service);
+  mutex::scoped_lock io_object_lock(io_object_->mutex_);
+
+  if (io_uring_operation* op = op_queue_.front())
+  {
+    if (result < 0)
+    {
+      op->ec_ = asio::error_code(-result,
+          asio::error::get_system_category());
+      op->bytes_transferred_ = 0;
+    }
+    else
+    {
+      op->ec_ = asio::error_code();
+      op->bytes_transferred_ = static_cast<std::size_t>(result);
+    }
+
+    bool done = op->perform(true);
+    if (!done && (cancel_requested_ || io_object_->shutdown_))
+    {
+      op->ec_ = asio::error::operation_aborted;
+      done = true;
+    }
+
+    if (done)
+    {
+      op_queue_.pop();
+      io_cleanup.ops_.push(op);
+    }
+
+    cancel_requested_ = false;
+  }
+
+  bool free_io_object = false;
+  if (io_object_->shutdown_)
+  {
+    while (io_uring_operation* op = op_queue_.front())
+    {
+      op->ec_ = asio::error::operation_aborted;
+      op_queue_.pop();
+      io_cleanup.ops_.push(op);
+    }
+
+    free_io_object = true;
+    for (int i = 0; i < max_ops; ++i)
+      if (!io_object_->queues_[i].op_queue_.empty())
+        free_io_object = false;
+  }
+  else if (!op_queue_.empty())
+  {
+    service->start_io(*this);
+  }
+
+  io_object* obj = io_object_;
+  io_object_lock.unlock();
+
+  // The last operation to complete after deregistration frees the I/O object.
+  // This queue is part of the object, so it must not be touched afterwards.
+  if (free_io_object)
+    service->free_io_object(obj);
+
+  // The first operation will be returned for completion now. The others will
+  // be posted for later by the io_cleanup object's destructor.
+  io_cleanup.first_op_ = io_cleanup.ops_.front();
+  io_cleanup.ops_.pop();
+  return io_cleanup.first_op_;
+}
+
+void io_uring_service::io_queue::do_complete(void* owner, operation* base,
+    const asio::error_code& ec, std::size_t bytes_transferred)
+{
+  if (owner)
+  {
+    io_queue* io_q = static_cast<io_queue*>(base);
+    int result = static_cast<int>(bytes_transferred);
+    if (operation* op = io_q->perform_io(result))
+    {
+      op->complete(owner, ec, 0);
+    }
+  }
+}
+
+io_uring_service::io_object::io_object(bool locking)
+  : mutex_(locking)
+{
+}
+
+io_uring_service::submit_sqes_op::submit_sqes_op(io_uring_service* s)
+  : operation(&io_uring_service::submit_sqes_op::do_complete),
+    service_(s)
+{
+}
+
+void io_uring_service::submit_sqes_op::do_complete(void* owner,
+    operation* base, const asio::error_code& /*ec*/,
+    std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    submit_sqes_op* o = static_cast<submit_sqes_op*>(base);
+    mutex::scoped_lock lock(o->service_->mutex_);
+    o->service_->pending_submit_sqes_op_ = false;
+    o->service_->submit_sqes();
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
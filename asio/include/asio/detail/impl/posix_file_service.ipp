@@ -0,0 +1,474 @@
+//
+// detail/impl/posix_file_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_POSIX_FILE_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_POSIX_FILE_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "asio/detail/posix_file_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class posix_file_service::work_scheduler_runner
+{
+public:
+  work_scheduler_runner(scheduler& work_scheduler)
+    : work_scheduler_(work_scheduler)
+  {
+  }
+
+  void operator()()
+  {
+    asio::error_code ec;
+    work_scheduler_.run(ec);
+  }
+
+private:
+  scheduler& work_scheduler_;
+};
+
+posix_file_service::posix_file_service(execution_context& context)
+  : execution_context_service_base<posix_file_service>(context),
+    scheduler_(asio::use_service<scheduler>(context)),
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_(asio::use_service<io_uring_service>(context)),
+#endif // defined(ASIO_HAS_IO_URING)
+    work_scheduler_(new scheduler(context, -1, false)),
+    work_threads_started_(false)
+{
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.init_task();
+#endif // defined(ASIO_HAS_IO_URING)
+  work_scheduler_->work_started();
+}
+
+posix_file_service::~posix_file_service()
+{
+  shutdown();
+}
+
+void posix_file_service::shutdown()
+{
+  if (work_scheduler_.get())
+  {
+    work_scheduler_->work_finished();
+    work_scheduler_->stop();
+    work_threads_.join();
+    work_scheduler_.reset();
+  }
+}
+
+void posix_file_service::notify_fork(execution_context::fork_event fork_ev)
+{
+  if (work_threads_started_)
+  {
+    if (fork_ev == execution_context::fork_prepare)
+    {
+      work_scheduler_->stop();
+      work_threads_.join();
+    }
+    else
+    {
+      work_scheduler_->restart();
+      work_threads_.create_threads(
+          work_scheduler_runner(*work_scheduler_), work_thread_count);
+    }
+  }
+}
+
+void posix_file_service::construct(
+    posix_file_service::implementation_type& impl)
+{
+  impl.descriptor_ = -1;
+#if defined(ASIO_HAS_IO_URING)
+  impl.io_object_data_ = 0;
+#endif // defined(ASIO_HAS_IO_URING)
+}
+
+void posix_file_service::move_construct(
+    posix_file_service::implementation_type& impl,
+    posix_file_service::implementation_type& other_impl)
+{
+  impl.descriptor_ = other_impl.descriptor_;
+  other_impl.descriptor_ = -1;
+
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
+  impl.descriptor_owner_ = other_impl.descriptor_owner_;
+  other_impl.descriptor_owner_.reset();
+  impl.cancel_token_ = other_impl.cancel_token_;
+  other_impl.cancel_token_.reset();
+}
+
+void posix_file_service::move_assign(
+    posix_file_service::implementation_type& impl,
+    posix_file_service& other_service,
+    posix_file_service::implementation_type& other_impl)
+{
+  destroy(impl);
+
+  impl.descriptor_ = other_impl.descriptor_;
+  other_impl.descriptor_ = -1;
+
+#if defined(ASIO_HAS_IO_URING)
+  other_service.io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+#else // defined(ASIO_HAS_IO_URING)
+  (void)other_service;
+#endif // defined(ASIO_HAS_IO_URING)
+  impl.descriptor_owner_ = other_impl.descriptor_owner_;
+  other_impl.descriptor_owner_.reset();
+  impl.cancel_token_ = other_impl.cancel_token_;
+  other_impl.cancel_token_.reset();
+}
+
+void posix_file_service::destroy(
+    posix_file_service::implementation_type& impl)
+{
+  if (is_open(impl))
+  {
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "file", &impl, impl.descriptor_, "close"));
+
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      io_uring_service_.deregister_io_object(impl.io_object_data_);
+      ::close(impl.descriptor_);
+      io_uring_service_.cleanup_io_object(impl.io_object_data_);
+      impl.descriptor_ = -1;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
+    impl.cancel_token_.reset();
+    impl.descriptor_owner_.reset();
+    impl.descriptor_ = -1;
+  }
+}
+
+asio::error_code posix_file_service::open(
+    posix_file_service::implementation_type& impl,
+    const char* path, file_base::flags open_flags,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ec = asio::error::already_open;
+    return ec;
+  }
+
+  errno = 0;
+  int descriptor = ::open(path, static_cast<int>(open_flags), 0777);
+  if (descriptor < 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return ec;
+  }
+
+  // We're done. Take ownership of the descriptor.
+#if defined(ASIO_HAS_IO_URING)
+  if (io_uring_service_.is_enabled())
+    io_uring_service_.register_io_object(impl.io_object_data_);
+  else
+#endif // defined(ASIO_HAS_IO_URING)
+    take_ownership(impl, descriptor);
+
+  impl.descriptor_ = descriptor;
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::assign(
+    posix_file_service::implementation_type& impl,
+    const native_handle_type& native_descriptor, asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ec = asio::error::already_open;
+    return ec;
+  }
+
+#if defined(ASIO_HAS_IO_URING)
+  if (io_uring_service_.is_enabled())
+    io_uring_service_.register_io_object(impl.io_object_data_);
+  else
+#endif // defined(ASIO_HAS_IO_URING)
+    take_ownership(impl, native_descriptor);
+
+  impl.descriptor_ = native_descriptor;
+  ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::close(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (is_open(impl))
+  {
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "file", &impl, impl.descriptor_, "close"));
+
+    bool use_io_uring = false;
+#if defined(ASIO_HAS_IO_URING)
+    use_io_uring = io_uring_service_.is_enabled();
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
+
+    // If an operation is still running on the thread pool, closing the
+    // descriptor is deferred until the operation has finished with it.
+    if (use_io_uring || give_up_ownership(impl))
+    {
+      descriptor_ops::state_type state = 0;
+      descriptor_ops::close(impl.descriptor_, state, ec);
+    }
+    else
+      ec = asio::error_code();
+
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
+  }
+  else
+  {
+    ec = asio::error_code();
+  }
+
+  construct(impl);
+
+  return ec;
+}
+
+posix_file_service::native_handle_type posix_file_service::release(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return -1;
+  }
+
+  ASIO_HANDLER_OPERATION((scheduler_.context(),
+        "file", &impl, impl.descriptor_, "release"));
+
+  native_handle_type descriptor = impl.descriptor_;
+
+#if defined(ASIO_HAS_IO_URING)
+  if (io_uring_service_.is_enabled())
+  {
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+    construct(impl);
+    ec = asio::error_code();
+    return descriptor;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+
+  // Disarm the holder so that the descriptor is not closed when the last
+  // background operation releases its reference.
+  impl.cancel_token_.reset();
+  impl.descriptor_owner_->descriptor_ = -1;
+  impl.descriptor_owner_.reset();
+
+  construct(impl);
+  ec = asio::error_code();
+  return descriptor;
+}
+
+asio::error_code posix_file_service::cancel(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return ec;
+  }
+
+  ASIO_HANDLER_OPERATION((scheduler_.context(),
+        "file", &impl, impl.descriptor_, "cancel"));
+
+#if defined(ASIO_HAS_IO_URING)
+  if (io_uring_service_.is_enabled())
+  {
+    io_uring_service_.cancel_ops(impl.io_object_data_);
+    ec = asio::error_code();
+    return ec;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+
+  // Operations that have not yet started will see the expired token and
+  // complete with operation_aborted. Running operations are not interrupted.
+  impl.cancel_token_.reset(static_cast<void*>(0), socket_ops::noop_deleter());
+
+  ec = asio::error_code();
+  return ec;
+}
+
+uint64_t posix_file_service::size(
+    const posix_file_service::implementation_type& impl,
+    asio::error_code& ec) const
+{
+  struct stat s;
+  errno = 0;
+  if (::fstat(native_handle(impl), &s) == -1)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return 0;
+  }
+  ec = asio::error_code();
+  return s.st_size;
+}
+
+asio::error_code posix_file_service::resize(
+    posix_file_service::implementation_type& impl,
+    uint64_t n, asio::error_code& ec)
+{
+  errno = 0;
+  if (::ftruncate(native_handle(impl), static_cast<off_t>(n)) == -1)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+  else
+    ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::sync_all(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  errno = 0;
+  if (::fsync(native_handle(impl)) == -1)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+  else
+    ec = asio::error_code();
+  return ec;
+}
+
+asio::error_code posix_file_service::sync_data(
+    posix_file_service::implementation_type& impl,
+    asio::error_code& ec)
+{
+  errno = 0;
+  if (::fdatasync(native_handle(impl)) == -1)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+  else
+    ec = asio::error_code();
+  return ec;
+}
+
+uint64_t posix_file_service::seek(
+    posix_file_service::implementation_type& impl, int64_t offset,
+    file_base::seek_basis whence, asio::error_code& ec)
+{
+  errno = 0;
+  off_t result = ::lseek(native_handle(impl),
+      static_cast<off_t>(offset), static_cast<int>(whence));
+  if (result == -1)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return 0;
+  }
+  ec = asio::error_code();
+  return static_cast<uint64_t>(result);
+}
+
+#if defined(ASIO_HAS_IO_URING)
+void posix_file_service::start_io_uring_op(
+    posix_file_service::implementation_type& impl, int op_type,
+    io_uring_operation* op, bool is_continuation, bool noop)
+{
+  if (!noop)
+  {
+    io_uring_service_.start_op(op_type,
+        impl.io_object_data_, op, is_continuation);
+    return;
+  }
+
+  io_uring_service_.post_immediate_completion(op, is_continuation);
+}
+#endif // defined(ASIO_HAS_IO_URING)
+
+void posix_file_service::start_op(
+    posix_file_service::implementation_type&, int /*op_type*/,
+    operation* op, bool is_continuation, bool noop)
+{
+  if (!noop)
+  {
+    start_work_threads();
+    scheduler_.work_started();
+    work_scheduler_->post_immediate_completion(op, false);
+  }
+  else
+  {
+    // A zero-length operation is delivered directly by the main scheduler.
+    scheduler_.post_immediate_completion(op, is_continuation);
+  }
+}
+
+void posix_file_service::start_work_threads()
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (!work_threads_started_)
+  {
+    work_threads_.create_threads(
+        work_scheduler_runner(*work_scheduler_), work_thread_count);
+    work_threads_started_ = true;
+  }
+}
+
+void posix_file_service::take_ownership(
+    posix_file_service::implementation_type& impl, int descriptor)
+{
+  impl.descriptor_owner_.reset(new descriptor_holder(descriptor));
+  impl.cancel_token_.reset(static_cast<void*>(0), socket_ops::noop_deleter());
+}
+
+bool posix_file_service::give_up_ownership(
+    posix_file_service::implementation_type& impl)
+{
+  impl.cancel_token_.reset();
+
+  bool last_reference = (impl.descriptor_owner_.use_count() == 1);
+  if (last_reference)
+  {
+    // No background operation refers to the descriptor, so the caller can
+    // dispose of it directly.
+    impl.descriptor_owner_->descriptor_ = -1;
+  }
+  impl.descriptor_owner_.reset();
+
+  return last_reference;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_IMPL_POSIX_FILE_SERVICE_IPP
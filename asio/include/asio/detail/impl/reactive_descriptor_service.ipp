@@ -33,6 +33,9 @@ reactive_descriptor_service::reactive_descriptor_service(
     execution_context& context)
   : execution_context_service_base<reactive_descriptor_service>(context),
     reactor_(asio::use_service<reactor>(context))
+#if defined(ASIO_HAS_IO_URING)
+    , io_uring_service_(asio::use_service<io_uring_service>(context))
+#endif // defined(ASIO_HAS_IO_URING)
 {
   reactor_.init_task();
 }
@@ -46,6 +49,9 @@ void reactive_descriptor_service::construct(
 {
   impl.descriptor_ = -1;
   impl.state_ = 0;
+#if defined(ASIO_HAS_IO_URING)
+  impl.io_object_data_ = 0;
+#endif // defined(ASIO_HAS_IO_URING)
 }
 
 void reactive_descriptor_service::move_construct(
@@ -60,6 +66,11 @@ void reactive_descriptor_service::move_construct(
 
   reactor_.move_descriptor(impl.descriptor_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 }
 
 void reactive_descriptor_service::move_assign(
@@ -77,6 +88,11 @@ void reactive_descriptor_service::move_assign(
 
   other_service.reactor_.move_descriptor(impl.descriptor_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(ASIO_HAS_IO_URING)
+  other_service.io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 }
 
 void reactive_descriptor_service::destroy(
@@ -89,11 +105,17 @@ void reactive_descriptor_service::destroy(
 
     reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_,
         (impl.state_ & descriptor_ops::possible_dup) == 0);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 
     asio::error_code ignored_ec;
     descriptor_ops::close(impl.descriptor_, impl.state_, ignored_ec);
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   }
 }
 
@@ -115,6 +137,10 @@ asio::error_code reactive_descriptor_service::assign(
     return ec;
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.register_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
+
   impl.descriptor_ = native_descriptor;
   impl.state_ = descriptor_ops::possible_dup;
   ec = asio::error_code();
@@ -132,10 +158,16 @@ asio::error_code reactive_descriptor_service::close(
 
     reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_,
         (impl.state_ & descriptor_ops::possible_dup) == 0);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 
     descriptor_ops::close(impl.descriptor_, impl.state_, ec);
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   }
   else
   {
@@ -166,6 +198,10 @@ reactive_descriptor_service::release(
 
     reactor_.deregister_descriptor(impl.descriptor_, impl.reactor_data_, false);
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
     construct(impl);
   }
 
@@ -186,6 +222,9 @@ asio::error_code reactive_descriptor_service::cancel(
         "descriptor", &impl, impl.descriptor_, "cancel"));
 
   reactor_.cancel_ops(impl.descriptor_, impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.cancel_ops(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   ec = asio::error_code();
   return ec;
 }
@@ -210,6 +249,28 @@ void reactive_descriptor_service::start_op(
   reactor_.post_immediate_completion(op, is_continuation);
 }
 
+#if defined(ASIO_HAS_IO_URING)
+void reactive_descriptor_service::start_io_uring_op(
+    reactive_descriptor_service::implementation_type& impl,
+    int op_type, io_uring_operation* op, bool is_continuation, bool noop)
+{
+  if (!noop)
+  {
+    if (io_uring_service_.supports_fast_poll()
+        || (impl.state_ & descriptor_ops::non_blocking)
+        || descriptor_ops::set_internal_non_blocking(
+          impl.descriptor_, impl.state_, true, op->ec_))
+    {
+      io_uring_service_.start_op(op_type,
+          impl.io_object_data_, op, is_continuation);
+      return;
+    }
+  }
+
+  io_uring_service_.post_immediate_completion(op, is_continuation);
+}
+#endif // defined(ASIO_HAS_IO_URING)
+
 } // namespace detail
 } // namespace asio
 
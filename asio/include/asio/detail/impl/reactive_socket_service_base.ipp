@@ -30,6 +30,9 @@ namespace detail {
 reactive_socket_service_base::reactive_socket_service_base(
     execution_context& context)
   : reactor_(use_service<reactor>(context))
+#if defined(ASIO_HAS_IO_URING)
+    , io_uring_service_(use_service<io_uring_service>(context))
+#endif // defined(ASIO_HAS_IO_URING)
 {
   reactor_.init_task();
 }
@@ -43,6 +46,9 @@ void reactive_socket_service_base::construct(
 {
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
+#if defined(ASIO_HAS_IO_URING)
+  impl.io_object_data_ = 0;
+#endif // defined(ASIO_HAS_IO_URING)
 }
 
 void reactive_socket_service_base::base_move_construct(
@@ -58,6 +64,11 @@ void reactive_socket_service_base::base_move_construct(
 
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 }
 
 void reactive_socket_service_base::base_move_assign(
@@ -75,6 +86,11 @@ void reactive_socket_service_base::base_move_assign(
 
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(ASIO_HAS_IO_URING)
+  other_service.io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 }
 
 void reactive_socket_service_base::destroy(
@@ -87,11 +103,17 @@ void reactive_socket_service_base::destroy(
 
     reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
         (impl.state_ & socket_ops::possible_dup) == 0);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 
     asio::error_code ignored_ec;
     socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   }
 }
 
@@ -106,10 +128,16 @@ asio::error_code reactive_socket_service_base::close(
 
     reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
         (impl.state_ & socket_ops::possible_dup) == 0);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
 
     socket_ops::close(impl.socket_, impl.state_, false, ec);
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   }
   else
   {
@@ -144,6 +172,10 @@ socket_type reactive_socket_service_base::release(
 
   reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
   reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.deregister_io_object(impl.io_object_data_);
+  io_uring_service_.cleanup_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   socket_type sock = impl.socket_;
   construct(impl);
   ec = asio::error_code();
@@ -164,6 +196,9 @@ asio::error_code reactive_socket_service_base::cancel(
         "socket", &impl, impl.socket_, "cancel"));
 
   reactor_.cancel_ops(impl.socket_, impl.reactor_data_);
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.cancel_ops(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
   ec = asio::error_code();
   return ec;
 }
@@ -189,6 +224,10 @@ asio::error_code reactive_socket_service_base::do_open(
     return ec;
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.register_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
+
   impl.socket_ = sock.release();
   switch (type)
   {
@@ -219,6 +258,10 @@ asio::error_code reactive_socket_service_base::do_assign(
     return ec;
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  io_uring_service_.register_io_object(impl.io_object_data_);
+#endif // defined(ASIO_HAS_IO_URING)
+
   impl.socket_ = native_socket;
   switch (type)
   {
@@ -231,6 +274,25 @@ asio::error_code reactive_socket_service_base::do_assign(
   return ec;
 }
 
+void reactive_socket_service_base::enable_zero_copy(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  if ((impl.state_ & socket_ops::zero_copy_enabled) == 0)
+  {
+    // Without the option the kernel silently copies the data, and does not
+    // notify the release of the sends.
+    int optval = 1;
+    asio::error_code ec;
+    if (socket_ops::setsockopt(impl.socket_, impl.state_, SOL_SOCKET,
+          SO_ZEROCOPY, &optval, sizeof(optval), ec) == 0)
+      impl.state_ |= socket_ops::zero_copy_enabled;
+  }
+#else // defined(ASIO_HAS_MSG_ZEROCOPY)
+  (void)impl;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+}
+
 void reactive_socket_service_base::start_op(
     reactive_socket_service_base::base_implementation_type& impl,
     int op_type, reactor_op* op, bool is_continuation,
@@ -251,6 +313,28 @@ void reactive_socket_service_base::start_op(
   reactor_.post_immediate_completion(op, is_continuation);
 }
 
+#if defined(ASIO_HAS_IO_URING)
+void reactive_socket_service_base::start_io_uring_op(
+    reactive_socket_service_base::base_implementation_type& impl,
+    int op_type, io_uring_operation* op, bool is_continuation, bool noop)
+{
+  if (!noop)
+  {
+    if (io_uring_service_.supports_fast_poll()
+        || (impl.state_ & socket_ops::non_blocking)
+        || socket_ops::set_internal_non_blocking(
+          impl.socket_, impl.state_, true, op->ec_))
+    {
+      io_uring_service_.start_op(op_type,
+          impl.io_object_data_, op, is_continuation);
+      return;
+    }
+  }
+
+  io_uring_service_.post_immediate_completion(op, is_continuation);
+}
+#endif // defined(ASIO_HAS_IO_URING)
+
 void reactive_socket_service_base::start_accept_op(
     reactive_socket_service_base::base_implementation_type& impl,
     reactor_op* op, bool is_continuation, bool peer_is_open)
@@ -22,6 +22,8 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/scheduler_inbox.hpp"
+#include "asio/detail/scheduler_shard.hpp"
 #include "asio/detail/scheduler_thread_info.hpp"
 #include "asio/detail/signal_blocker.hpp"
 
@@ -103,14 +105,177 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+struct scheduler::work_stealing_state
+{
+  explicit work_stealing_state(std::size_t shard_count)
+    : shards_(new scheduler_shard[shard_count]),
+      shard_count_(shard_count),
+      next_shard_(0),
+      idle_threads_(0),
+      stopped_(false)
+  {
+  }
+
+  ~work_stealing_state()
+  {
+    delete[] shards_;
+  }
+
+  // Determine whether any of the per-thread queues has work.
+  bool has_work() const
+  {
+    for (std::size_t i = 0; i < shard_count_; ++i)
+      if (shards_[i].has_work())
+        return true;
+    return false;
+  }
+
+  // Remove all operations from the per-thread queues.
+  void take_all(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i < shard_count_; ++i)
+    {
+      while (operation* o = shards_[i].pop())
+        ops.push(o);
+      shards_[i].take_inbox(ops);
+    }
+  }
+
+  // The per-thread queues.
+  scheduler_shard* shards_;
+  std::size_t shard_count_;
+
+  // Used to spread shard claims and foreign posts across the queues.
+  std::atomic<std::size_t> next_shard_;
+
+  // The number of threads waiting for work, including one blocked in the task.
+  std::atomic<long> idle_threads_;
+
+  // Mirrors stopped_ so that it can be checked without locking.
+  std::atomic<bool> stopped_;
+};
+
+struct scheduler::shard_claim
+{
+  shard_claim(scheduler* s, thread_info& this_thread)
+    : this_thread_(this_thread)
+  {
+    work_stealing_state& state = *s->work_stealing_;
+    std::size_t start = state.next_shard_.fetch_add(
+        1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < state.shard_count_; ++i)
+    {
+      scheduler_shard& shard = state.shards_[(start + i) % state.shard_count_];
+      if (shard.try_claim())
+      {
+        this_thread_.shard = &shard;
+        break;
+      }
+    }
+  }
+
+  ~shard_claim()
+  {
+    // Any operations left on the queue will be stolen by other threads.
+    if (this_thread_.shard)
+      this_thread_.shard->release();
+    this_thread_.shard = 0;
+  }
+
+  thread_info& this_thread_;
+};
+
+struct scheduler::work_stealing_task_cleanup
+{
+  ~work_stealing_task_cleanup()
+  {
+    if (idle_)
+      --scheduler_->work_stealing_->idle_threads_;
+
+    if (this_thread_->private_outstanding_work > 0)
+    {
+      asio::detail::increment(
+          scheduler_->outstanding_work_,
+          this_thread_->private_outstanding_work);
+    }
+    this_thread_->private_outstanding_work = 0;
+
+    // Enqueue the completed operations on the per-thread queues, so that idle
+    // threads can steal them, and reinsert the task at the end of the
+    // operation queue.
+    scheduler_->enqueue_work_stealing(this_thread_->private_op_queue);
+    lock_->lock();
+    scheduler_->task_interrupted_ = true;
+    scheduler_->op_queue_.push(&scheduler_->task_operation_);
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+  bool idle_;
+};
+
+struct scheduler::work_stealing_cleanup
+{
+  ~work_stealing_cleanup()
+  {
+    if (this_thread_->private_outstanding_work > 1)
+    {
+      asio::detail::increment(
+          scheduler_->outstanding_work_,
+          this_thread_->private_outstanding_work - 1);
+    }
+    else if (this_thread_->private_outstanding_work < 1)
+    {
+      scheduler_->work_finished();
+    }
+    this_thread_->private_outstanding_work = 0;
+
+    if (!this_thread_->private_op_queue.empty())
+      scheduler_->enqueue_work_stealing(this_thread_->private_op_queue);
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::lock_free_post_state
+{
+  lock_free_post_state()
+    : stop_requested_(false)
+  {
+  }
+
+  // Operations posted from threads other than the one running the scheduler.
+  scheduler_inbox inbox_;
+
+  // Set by a stop() from another thread, for the running thread to act on.
+  std::atomic<bool> stop_requested_;
+};
+
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+struct scheduler::work_stealing_state
+{
+};
+
+struct scheduler::lock_free_post_state
+{
+};
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
 scheduler::scheduler(asio::execution_context& ctx,
-    int concurrency_hint, bool own_thread)
+    int concurrency_hint, bool own_thread, memory_resource* resource)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
     one_thread_(concurrency_hint == 1
         || !ASIO_CONCURRENCY_HINT_IS_LOCKING(
           SCHEDULER, concurrency_hint)
         || !ASIO_CONCURRENCY_HINT_IS_LOCKING(
-          REACTOR_IO, concurrency_hint)),
+          REACTOR_IO, concurrency_hint)
+        || ASIO_CONCURRENCY_HINT_IS_LOCK_FREE_POST(concurrency_hint)),
     mutex_(ASIO_CONCURRENCY_HINT_IS_LOCKING(
           SCHEDULER, concurrency_hint)),
     task_(0),
@@ -119,10 +284,27 @@ scheduler::scheduler(asio::execution_context& ctx,
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
+    memory_resource_(resource),
+    work_stealing_(0),
+    lock_free_post_(0),
     thread_(0)
 {
   ASIO_HANDLER_TRACKING_INIT;
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(concurrency_hint))
+  {
+    std::size_t shard_count = ASIO_CONCURRENCY_HINT_SHARDS(concurrency_hint);
+    if (shard_count == 0)
+      shard_count = asio::detail::thread::hardware_concurrency();
+    work_stealing_ = new work_stealing_state(shard_count ? shard_count : 1);
+  }
+  else if (ASIO_CONCURRENCY_HINT_IS_LOCK_FREE_POST(concurrency_hint))
+  {
+    lock_free_post_ = new lock_free_post_state;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   if (own_thread)
   {
     ++outstanding_work_;
@@ -138,6 +320,9 @@ scheduler::~scheduler()
     thread_->join();
     delete thread_;
   }
+
+  delete work_stealing_;
+  delete lock_free_post_;
 }
 
 void scheduler::shutdown()
@@ -156,6 +341,16 @@ void scheduler::shutdown()
     thread_ = 0;
   }
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // Collect handler objects from the per-thread queues.
+  if (work_stealing_)
+    work_stealing_->take_all(op_queue_);
+
+  // Collect handler objects posted without locking.
+  if (lock_free_post_)
+    lock_free_post_->inbox_.take(op_queue_);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   // Destroy handler objects.
   while (!op_queue_.empty())
   {
@@ -191,8 +386,22 @@ std::size_t scheduler::run(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard = 0;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    shard_claim claim(this, this_thread);
+    std::size_t n = 0;
+    for (; do_work_stealing_one(this_thread, -1, ec); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
@@ -213,8 +422,18 @@ std::size_t scheduler::run_one(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard = 0;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    shard_claim claim(this, this_thread);
+    return do_work_stealing_one(this_thread, -1, ec);
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
 
   return do_run_one(lock, this_thread, ec);
@@ -231,8 +450,18 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard = 0;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    shard_claim claim(this, this_thread);
+    return do_work_stealing_one(this_thread, usec > 0 ? usec : 0, ec);
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
 
   return do_wait_one(lock, this_thread, usec, ec);
@@ -249,8 +478,22 @@ std::size_t scheduler::poll(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard = 0;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    shard_claim claim(this, this_thread);
+    std::size_t n = 0;
+    for (; do_work_stealing_one(this_thread, 0, ec); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(ASIO_HAS_THREADS)
@@ -280,8 +523,18 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard = 0;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    shard_claim claim(this, this_thread);
+    return do_work_stealing_one(this_thread, 0, ec);
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(ASIO_HAS_THREADS)
@@ -298,6 +551,17 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
 
 void scheduler::stop()
 {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (lock_free_post_ && !thread_call_stack::contains(this))
+  {
+    // The scheduler may be running in another thread without locking, so ask
+    // that thread to stop itself.
+    lock_free_post_->stop_requested_.store(true, std::memory_order_seq_cst);
+    interrupt_lock_free();
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
   stop_all_threads(lock);
 }
@@ -305,6 +569,10 @@ void scheduler::stop()
 bool scheduler::stopped() const
 {
   mutex::scoped_lock lock(mutex_);
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (lock_free_post_ && lock_free_post_->stop_requested_.load())
+    return true;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   return stopped_;
 }
 
@@ -312,6 +580,12 @@ void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+    work_stealing_->stopped_ = false;
+  if (lock_free_post_)
+    lock_free_post_->stop_requested_ = false;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
 }
 
 void scheduler::compensating_work_started()
@@ -323,6 +597,17 @@ void scheduler::compensating_work_started()
 void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    // Handlers may be stolen and completed by another thread, so the work
+    // count is shared rather than being accumulated privately.
+    work_started();
+    enqueue_work_stealing(op);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -338,6 +623,13 @@ void scheduler::post_immediate_completion(
 #endif // defined(ASIO_HAS_THREADS)
 
   work_started();
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (lock_free_post_)
+  {
+    post_lock_free(op);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -345,6 +637,14 @@ void scheduler::post_immediate_completion(
 
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    enqueue_work_stealing(op);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_)
   {
@@ -356,6 +656,14 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
   }
 #endif // defined(ASIO_HAS_THREADS)
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (lock_free_post_)
+  {
+    post_lock_free(op);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -366,6 +674,14 @@ void scheduler::post_deferred_completions(
 {
   if (!ops.empty())
   {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    if (work_stealing_)
+    {
+      enqueue_work_stealing(ops);
+      return;
+    }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
 #if defined(ASIO_HAS_THREADS)
     if (one_thread_)
     {
@@ -377,6 +693,14 @@ void scheduler::post_deferred_completions(
     }
 #endif // defined(ASIO_HAS_THREADS)
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    if (lock_free_post_)
+    {
+      post_lock_free(ops);
+      return;
+    }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
     mutex::scoped_lock lock(mutex_);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
@@ -387,6 +711,18 @@ void scheduler::do_dispatch(
     scheduler::operation* op)
 {
   work_started();
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+  {
+    enqueue_work_stealing(op);
+    return;
+  }
+  if (lock_free_post_)
+  {
+    post_lock_free(op);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -403,7 +739,7 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const asio::error_code& ec)
 {
-  while (!stopped_)
+  for (take_lock_free_posts(); !stopped_; take_lock_free_posts())
   {
     if (!op_queue_.empty())
     {
@@ -462,6 +798,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread, long usec,
     const asio::error_code& ec)
 {
+  take_lock_free_posts();
   if (stopped_)
     return 0;
 
@@ -471,6 +808,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     wakeup_event_.clear(lock);
     wakeup_event_.wait_for_usec(lock, usec);
     usec = 0; // Wait at most once.
+    take_lock_free_posts();
     o = op_queue_.front();
   }
 
@@ -496,6 +834,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
     }
 
+    take_lock_free_posts();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
@@ -532,6 +871,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const asio::error_code& ec)
 {
+  take_lock_free_posts();
   if (stopped_)
     return 0;
 
@@ -551,6 +891,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
       task_->run(0, this_thread.private_op_queue);
     }
 
+    take_lock_free_posts();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
@@ -582,10 +923,301 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   return 1;
 }
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+std::size_t scheduler::do_work_stealing_one(
+    scheduler::thread_info& this_thread, long usec,
+    const asio::error_code& ec)
+{
+  bool task_has_run = false;
+  for (;;)
+  {
+    if (work_stealing_->stopped_.load(std::memory_order_acquire))
+      return 0;
+
+    // Try the per-thread queues without locking.
+    if (operation* o = dequeue_work_stealing(this_thread))
+    {
+      // Let an idle thread steal any remaining work from our queue.
+      if (this_thread.shard
+          && work_stealing_->idle_threads_.load(std::memory_order_relaxed) > 0
+          && this_thread.shard->has_work())
+        wake_idle_thread();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_stealing_cleanup on_exit = { this, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      o->complete(this, ec, o->task_result_);
+
+      return 1;
+    }
+
+    mutex::scoped_lock lock(mutex_);
+
+    if (stopped_)
+      return 0;
+
+    operation* o = op_queue_.front();
+    if (o == &task_operation_ && !task_has_run)
+    {
+      op_queue_.pop();
+      bool more_handlers = (!op_queue_.empty());
+
+      // Only block in the task if there is no work anywhere. The thread is
+      // counted as idle before the per-thread queues are checked, so that a
+      // thread that subsequently posts work will interrupt the task.
+      bool idle = false;
+      if (!more_handlers && usec != 0)
+      {
+        ++work_stealing_->idle_threads_;
+        if (work_stealing_->has_work())
+        {
+          --work_stealing_->idle_threads_;
+          more_handlers = true;
+        }
+        else
+          idle = true;
+      }
+
+      task_interrupted_ = !idle;
+
+      if (!op_queue_.empty())
+        wakeup_event_.unlock_and_signal_one(lock);
+      else
+        lock.unlock();
+
+      {
+        work_stealing_task_cleanup on_exit =
+          { this, &lock, &this_thread, idle };
+        (void)on_exit;
+
+        // Run the task. May throw an exception. Only block if there are no
+        // handlers waiting to run, otherwise we want to return as soon as
+        // possible.
+        task_->run(idle ? usec : 0, this_thread.private_op_queue);
+      }
+
+      // When polling or waiting with a timeout the task is run at most once.
+      if (usec >= 0)
+      {
+        task_has_run = true;
+        usec = 0;
+      }
+
+      continue;
+    }
+
+    if (o != 0 && o != &task_operation_)
+    {
+      op_queue_.pop();
+      bool more_handlers = (!op_queue_.empty());
+
+      std::size_t task_result = o->task_result_;
+
+      if (more_handlers)
+        wake_one_thread_and_unlock(lock);
+      else
+        lock.unlock();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_stealing_cleanup on_exit = { this, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      o->complete(this, ec, task_result);
+
+      return 1;
+    }
+
+    if (usec == 0)
+      return 0;
+
+    // Wait for work. As for the task, the thread is counted as idle before the
+    // per-thread queues are checked for the last time.
+    wakeup_event_.clear(lock);
+    ++work_stealing_->idle_threads_;
+    if (!work_stealing_->has_work())
+    {
+      if (usec < 0)
+        wakeup_event_.wait(lock);
+      else
+      {
+        wakeup_event_.wait_for_usec(lock, usec);
+        usec = 0; // Wait at most once.
+      }
+    }
+    --work_stealing_->idle_threads_;
+  }
+}
+
+scheduler::operation* scheduler::dequeue_work_stealing(
+    scheduler::thread_info& this_thread)
+{
+  work_stealing_state& state = *work_stealing_;
+  scheduler_shard* own_shard = this_thread.shard;
+  op_queue<operation> ops;
+
+  if (own_shard)
+  {
+    if (operation* o = own_shard->pop())
+      return o;
+
+    own_shard->take_inbox(ops);
+    if (operation* o = ops.front())
+    {
+      ops.pop();
+      enqueue_work_stealing(ops);
+      return o;
+    }
+  }
+
+  // Steal from the other queues, starting with the one after our own.
+  std::size_t start = own_shard
+    ? static_cast<std::size_t>(own_shard - state.shards_) + 1
+    : state.next_shard_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < state.shard_count_; ++i)
+  {
+    scheduler_shard& victim = state.shards_[(start + i) % state.shard_count_];
+    if (&victim == own_shard)
+      continue;
+
+    if (operation* o = victim.pop())
+      return o;
+
+    victim.take_inbox(ops);
+    if (operation* o = ops.front())
+    {
+      ops.pop();
+      enqueue_work_stealing(ops);
+      return o;
+    }
+  }
+
+  return 0;
+}
+
+void scheduler::enqueue_work_stealing(scheduler::operation* op)
+{
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  if (scheduler_shard* shard = this_thread
+      ? static_cast<thread_info*>(this_thread)->shard : 0)
+  {
+    if (!shard->push(op))
+    {
+      // The queue is full, so fall back to the shared queue.
+      mutex::scoped_lock lock(mutex_);
+      op_queue_.push(op);
+      wake_one_thread_and_unlock(lock);
+      return;
+    }
+  }
+  else
+  {
+    work_stealing_state& state = *work_stealing_;
+    std::size_t i = state.next_shard_.fetch_add(
+        1, std::memory_order_relaxed) % state.shard_count_;
+    state.shards_[i].push_inbox(op);
+  }
+
+  wake_idle_thread();
+}
+
+void scheduler::enqueue_work_stealing(op_queue<scheduler::operation>& ops)
+{
+  if (ops.empty())
+    return;
+
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  if (scheduler_shard* shard = this_thread
+      ? static_cast<thread_info*>(this_thread)->shard : 0)
+  {
+    while (operation* o = ops.front())
+    {
+      // Once pushed, the operation may be stolen and destroyed by another
+      // thread, so it must be unlinked from the list first.
+      ops.pop();
+      if (!shard->push(o))
+      {
+        // The queue is full, so fall back to the shared queue.
+        mutex::scoped_lock lock(mutex_);
+        op_queue_.push(o);
+        op_queue_.push(ops);
+        wake_one_thread_and_unlock(lock);
+        return;
+      }
+    }
+  }
+  else
+  {
+    work_stealing_state& state = *work_stealing_;
+    std::size_t i = state.next_shard_.fetch_add(
+        1, std::memory_order_relaxed) % state.shard_count_;
+    while (operation* o = ops.front())
+    {
+      ops.pop();
+      state.shards_[i].push_inbox(o);
+    }
+  }
+
+  wake_idle_thread();
+}
+
+void scheduler::wake_idle_thread()
+{
+  if (work_stealing_->idle_threads_.load(std::memory_order_seq_cst) > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+void scheduler::post_lock_free(scheduler::operation* op)
+{
+  if (lock_free_post_->inbox_.push(op))
+    interrupt_lock_free();
+}
+
+void scheduler::post_lock_free(op_queue<scheduler::operation>& ops)
+{
+  if (lock_free_post_->inbox_.push(ops))
+    interrupt_lock_free();
+}
+
+void scheduler::interrupt_lock_free()
+{
+  // The task is created along with the io_context, so the running thread
+  // blocks in the task rather than on the wakeup event.
+  if (task_)
+    task_->interrupt();
+  else
+  {
+    mutex::scoped_lock lock(mutex_);
+    wakeup_event_.signal_all(lock);
+  }
+}
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+void scheduler::do_take_lock_free_posts()
+{
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (!lock_free_post_->inbox_.empty())
+    lock_free_post_->inbox_.take(op_queue_);
+  if (lock_free_post_->stop_requested_.load(std::memory_order_acquire))
+    stopped_ = true;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+}
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (work_stealing_)
+    work_stealing_->stopped_ = true;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   wakeup_event_.signal_all(lock);
 
   if (!task_interrupted_ && task_)
@@ -1038,6 +1038,120 @@ bool non_blocking_recvfrom(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+signed_size_type recvfrom_segments(socket_type s, buf* bufs, size_t count,
+    int flags, socket_addr_type* addr, std::size_t* addrlen,
+    std::size_t* segment_size, asio::error_code& ec)
+{
+#if defined(UDP_GRO)
+  clear_last_error();
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = static_cast<int>(*addrlen);
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  union
+  {
+    cmsghdr align;
+    char data[CMSG_SPACE(sizeof(int))];
+  } control;
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+  signed_size_type result = error_wrapper(::recvmsg(s, &msg, flags), ec);
+  *addrlen = msg.msg_namelen;
+  if (result >= 0)
+  {
+    ec = asio::error_code();
+
+    // A datagram that was not coalesced carries no segment size.
+    *segment_size = result;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO)
+      {
+        int size = 0;
+        std::memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+        *segment_size = size;
+      }
+    }
+  }
+  return result;
+#else // defined(UDP_GRO)
+  // Without receive offload, each datagram is a single segment.
+  signed_size_type result = socket_ops::recvfrom(
+      s, bufs, count, flags, addr, addrlen, ec);
+  if (result >= 0)
+    *segment_size = result;
+  return result;
+#endif // defined(UDP_GRO)
+}
+
+size_t sync_recvfrom_segments(socket_type s, state_type state, buf* bufs,
+    size_t count, int flags, socket_addr_type* addr, std::size_t* addrlen,
+    std::size_t* segment_size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::recvfrom_segments(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvfrom_segments(socket_type s,
+    buf* bufs, size_t count, int flags,
+    socket_addr_type* addr, std::size_t* addrlen, std::size_t* segment_size,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Read some data.
+    signed_size_type bytes = socket_ops::recvfrom_segments(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes >= 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+      bytes_transferred = 0;
+
+    return true;
+  }
+}
+
 signed_size_type recvmsg(socket_type s, buf* bufs, size_t count,
     int in_flags, int& out_flags, asio::error_code& ec)
 {
@@ -1154,6 +1268,259 @@ bool non_blocking_recvmsg(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+signed_size_type recvmmsg(socket_type s, mmsg_buf* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MMSG)
+  clear_last_error();
+  if (count > max_mmsg_count)
+    count = max_mmsg_count;
+  mmsghdr hdrs[max_mmsg_count];
+  for (size_t i = 0; i < count; ++i)
+  {
+    hdrs[i] = mmsghdr();
+    init_msghdr_msg_name(hdrs[i].msg_hdr.msg_name, msgs[i].addr);
+    hdrs[i].msg_hdr.msg_namelen = static_cast<int>(msgs[i].addrlen);
+    hdrs[i].msg_hdr.msg_iov = &msgs[i].data;
+    hdrs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // Block until the first datagram arrives, but not for the rest.
+  signed_size_type result = error_wrapper(::recvmmsg(s, hdrs,
+        static_cast<unsigned int>(count), flags | MSG_WAITFORONE, 0), ec);
+  for (signed_size_type i = 0; i < result; ++i)
+  {
+    msgs[i].addrlen = hdrs[i].msg_hdr.msg_namelen;
+    msgs[i].bytes_transferred = hdrs[i].msg_len;
+  }
+  if (result >= 0)
+    ec = asio::error_code();
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Without recvmmsg, a batch consists of a single datagram.
+  if (count == 0)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+  signed_size_type bytes = socket_ops::recvfrom(s, &msgs[0].data, 1,
+      flags, msgs[0].addr, &msgs[0].addrlen, ec);
+  if (bytes < 0)
+    return socket_error_retval;
+  msgs[0].bytes_transferred = bytes;
+  return 1;
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+size_t sync_recvmmsg(socket_type s, state_type state,
+    mmsg_buf* msgs, size_t count, int flags, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type n = socket_ops::recvmmsg(s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (n >= 0)
+      return n;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvmmsg(socket_type s,
+    mmsg_buf* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    signed_size_type n = socket_ops::recvmmsg(s, msgs, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (n >= 0)
+    {
+      ec = asio::error_code();
+      msgs_transferred = n;
+    }
+    else
+      msgs_transferred = 0;
+
+    return true;
+  }
+}
+
+signed_size_type recvmsg_control(socket_type s, buf* bufs, size_t count,
+    int in_flags, socket_addr_type* addr, std::size_t* addrlen,
+    void* control, std::size_t* control_len, int& out_flags,
+    asio::error_code& ec)
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  // Control data is not received on Windows.
+  *control_len = 0;
+  out_flags = 0;
+  if (addr)
+    return socket_ops::recvfrom(s, bufs, count, in_flags, addr, addrlen, ec);
+  return socket_ops::recv(s, bufs, count, in_flags, ec);
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  clear_last_error();
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = addr ? static_cast<int>(*addrlen) : 0;
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = *control_len ? control : 0;
+  msg.msg_controllen = *control_len;
+  signed_size_type result = error_wrapper(::recvmsg(s, &msg, in_flags), ec);
+  if (result >= 0)
+  {
+    ec = asio::error_code();
+    if (addr)
+      *addrlen = msg.msg_namelen;
+    *control_len = msg.msg_controllen;
+    out_flags = msg.msg_flags;
+  }
+  else
+  {
+    *control_len = 0;
+    out_flags = 0;
+  }
+  return result;
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+}
+
+size_t sync_recvmsg_control(socket_type s, state_type state,
+    buf* bufs, size_t count, int in_flags, socket_addr_type* addr,
+    std::size_t* addrlen, void* control, std::size_t* control_len,
+    int& out_flags, bool all_empty, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to read 0 bytes on a stream is a no-op.
+  if (all_empty && (state & stream_oriented))
+  {
+    ec = asio::error_code();
+    *control_len = 0;
+    out_flags = 0;
+    return 0;
+  }
+
+  // Read some data.
+  std::size_t capacity = *control_len;
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    *control_len = capacity;
+    signed_size_type bytes = socket_ops::recvmsg_control(s, bufs, count,
+        in_flags, addr, addrlen, control, control_len, out_flags, ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Check for EOF.
+    if ((state & stream_oriented) && bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready. Queued errors are signalled as an
+    // error condition rather than as readability.
+#if defined(MSG_ERRQUEUE)
+    if (in_flags & MSG_ERRQUEUE)
+    {
+      if (socket_ops::poll_error(s, 0, -1, ec) < 0)
+        return 0;
+      continue;
+    }
+#endif // defined(MSG_ERRQUEUE)
+    if (socket_ops::poll_read(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvmsg_control(socket_type s,
+    buf* bufs, size_t count, int in_flags, bool is_stream,
+    socket_addr_type* addr, std::size_t* addrlen, void* control,
+    std::size_t* control_len, int& out_flags,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  std::size_t capacity = *control_len;
+  for (;;)
+  {
+    // Read some data.
+    *control_len = capacity;
+    signed_size_type bytes = socket_ops::recvmsg_control(s, bufs, count,
+        in_flags, addr, addrlen, control, control_len, out_flags, ec);
+
+    // Check for end of stream.
+    if (is_stream && bytes == 0)
+    {
+      ec = asio::error::eof;
+      bytes_transferred = 0;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+    {
+      *control_len = capacity;
+      return false;
+    }
+
+    // Operation is complete.
+    if (bytes >= 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+      bytes_transferred = 0;
+
+    return true;
+  }
+}
+
 signed_size_type send(socket_type s, const buf* bufs, size_t count,
     int flags, asio::error_code& ec)
 {
@@ -1386,6 +1753,344 @@ bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+signed_size_type sendto_segments(socket_type s, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec)
+{
+  if (segment_size == 0)
+    return socket_ops::sendto(s, bufs, count, flags, addr, addrlen, ec);
+
+#if defined(UDP_SEGMENT)
+  // The kernel takes the segment size as a 16-bit value.
+  if (segment_size > 0xFFFF)
+  {
+    ec = asio::error::invalid_argument;
+    return socket_error_retval;
+  }
+
+  clear_last_error();
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = static_cast<int>(addrlen);
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  union
+  {
+    cmsghdr align;
+    char data[CMSG_SPACE(sizeof(uint16_t))];
+  } control;
+  std::memset(&control, 0, sizeof(control));
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = IPPROTO_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t size = static_cast<uint16_t>(segment_size);
+  std::memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+  flags |= MSG_NOSIGNAL;
+  signed_size_type result = error_wrapper(::sendmsg(s, &msg, flags), ec);
+  if (result >= 0)
+    ec = asio::error_code();
+  return result;
+#else // defined(UDP_SEGMENT)
+  // Without segmentation offload, the data must fit in a single segment.
+  std::size_t total_size = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    total_size += bufs[i].len;
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    total_size += bufs[i].iov_len;
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  }
+  if (total_size > segment_size)
+  {
+    ec = asio::error::operation_not_supported;
+    return socket_error_retval;
+  }
+  return socket_ops::sendto(s, bufs, count, flags, addr, addrlen, ec);
+#endif // defined(UDP_SEGMENT)
+}
+
+size_t sync_sendto_segments(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::sendto_segments(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendto_segments(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* addr, std::size_t addrlen,
+    std::size_t segment_size, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendto_segments(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes >= 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+      bytes_transferred = 0;
+
+    return true;
+  }
+}
+
+signed_size_type sendmmsg(socket_type s, mmsg_buf* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MMSG)
+  clear_last_error();
+  if (count > max_mmsg_count)
+    count = max_mmsg_count;
+  mmsghdr hdrs[max_mmsg_count];
+  for (size_t i = 0; i < count; ++i)
+  {
+    hdrs[i] = mmsghdr();
+    init_msghdr_msg_name(hdrs[i].msg_hdr.msg_name, msgs[i].addr);
+    hdrs[i].msg_hdr.msg_namelen = static_cast<int>(msgs[i].addrlen);
+    hdrs[i].msg_hdr.msg_iov = &msgs[i].data;
+    hdrs[i].msg_hdr.msg_iovlen = 1;
+  }
+  flags |= MSG_NOSIGNAL;
+  signed_size_type result = error_wrapper(::sendmmsg(s, hdrs,
+        static_cast<unsigned int>(count), flags), ec);
+  for (signed_size_type i = 0; i < result; ++i)
+    msgs[i].bytes_transferred = hdrs[i].msg_len;
+  if (result >= 0)
+    ec = asio::error_code();
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Without sendmmsg, a batch consists of a single datagram.
+  if (count == 0)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+  signed_size_type bytes = socket_ops::sendto(s, &msgs[0].data, 1,
+      flags, msgs[0].addr, msgs[0].addrlen, ec);
+  if (bytes < 0)
+    return socket_error_retval;
+  msgs[0].bytes_transferred = bytes;
+  return 1;
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+size_t sync_sendmmsg(socket_type s, state_type state,
+    mmsg_buf* msgs, size_t count, int flags, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type n = socket_ops::sendmmsg(s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (n >= 0)
+      return n;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendmmsg(socket_type s,
+    mmsg_buf* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    signed_size_type n = socket_ops::sendmmsg(s, msgs, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (n >= 0)
+    {
+      ec = asio::error_code();
+      msgs_transferred = n;
+    }
+    else
+      msgs_transferred = 0;
+
+    return true;
+  }
+}
+
+signed_size_type sendmsg_control(socket_type s, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, const void* control, std::size_t control_len,
+    asio::error_code& ec)
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  // Control data is not sent on Windows.
+  if (control_len)
+  {
+    ec = asio::error::operation_not_supported;
+    return socket_error_retval;
+  }
+  if (addr)
+    return socket_ops::sendto(s, bufs, count, flags, addr, addrlen, ec);
+  return socket_ops::send(s, bufs, count, flags, ec);
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  clear_last_error();
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = addr ? static_cast<int>(addrlen) : 0;
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = control_len ? const_cast<void*>(control) : 0;
+  msg.msg_controllen = control_len;
+#if defined(__linux__)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+  signed_size_type result = error_wrapper(::sendmsg(s, &msg, flags), ec);
+  if (result >= 0)
+    ec = asio::error_code();
+  return result;
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+}
+
+size_t sync_sendmsg_control(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, const void* control, std::size_t control_len,
+    bool all_empty, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes and no control data to a stream is a no-op.
+  if (all_empty && control_len == 0 && (state & stream_oriented))
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // Write some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::sendmsg_control(s, bufs, count,
+        flags, addr, addrlen, control, control_len, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendmsg_control(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* addr, std::size_t addrlen,
+    const void* control, std::size_t control_len,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendmsg_control(s, bufs, count,
+        flags, addr, addrlen, control, control_len, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes >= 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+      bytes_transferred = 0;
+
+    return true;
+  }
+}
+
 socket_type socket(int af, int type, int protocol,
     asio::error_code& ec)
 {
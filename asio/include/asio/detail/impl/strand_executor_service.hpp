@@ -56,11 +56,8 @@ public:
 
     ~on_invoker_exit()
     {
-      this_->impl_->mutex_->lock();
-      this_->impl_->ready_queue_.push(this_->impl_->waiting_queue_);
-      bool more_handlers = this_->impl_->locked_ =
-        !this_->impl_->ready_queue_.empty();
-      this_->impl_->mutex_->unlock();
+      bool more_handlers = this_->impl_->queue_.take_or_unlock(
+          this_->impl_->ready_queue_);
 
       if (more_handlers)
       {
@@ -26,7 +26,6 @@ namespace detail {
 strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
-    salt_(0),
     impl_list_(0)
 {
 }
@@ -40,11 +39,8 @@ void strand_executor_service::shutdown()
   strand_impl* impl = impl_list_;
   while (impl)
   {
-    impl->mutex_->lock();
-    impl->shutdown_ = true;
-    ops.push(impl->waiting_queue_);
+    impl->queue_.shutdown(ops);
     ops.push(impl->ready_queue_);
-    impl->mutex_->unlock();
     impl = impl->next_;
   }
 }
@@ -53,21 +49,9 @@ strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
   implementation_type new_impl(new strand_impl);
-  new_impl->locked_ = false;
-  new_impl->shutdown_ = false;
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
-  // Select a mutex from the pool of shared mutexes.
-  std::size_t salt = salt_++;
-  std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
-  mutex_index += (reinterpret_cast<std::size_t>(new_impl.get()) >> 3);
-  mutex_index ^= salt + 0x9e3779b9 + (mutex_index << 6) + (mutex_index >> 2);
-  mutex_index = mutex_index % num_mutexes;
-  if (!mutexes_[mutex_index].get())
-    mutexes_[mutex_index].reset(new mutex);
-  new_impl->mutex_ = mutexes_[mutex_index].get();
-
   // Insert implementation into linked list of all implementations.
   new_impl->next_ = impl_list_;
   new_impl->prev_ = 0;
@@ -95,29 +79,14 @@ strand_executor_service::strand_impl::~strand_impl()
 bool strand_executor_service::enqueue(const implementation_type& impl,
     scheduler_operation* op)
 {
-  impl->mutex_->lock();
-  if (impl->shutdown_)
-  {
-    impl->mutex_->unlock();
-    op->destroy();
-    return false;
-  }
-  else if (impl->locked_)
-  {
-    // Some other function already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_->unlock();
+  // If some other function already holds the strand lock, the function is
+  // enqueued for later. Otherwise, the function is acquiring the strand lock
+  // and so is responsible for scheduling the strand.
+  if (!impl->queue_.push(op))
     return false;
-  }
-  else
-  {
-    // The function is acquiring the strand lock and so is responsible for
-    // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_->unlock();
-    impl->ready_queue_.push(op);
-    return true;
-  }
+
+  impl->ready_queue_.push(op);
+  return true;
 }
 
 bool strand_executor_service::running_in_this_thread(
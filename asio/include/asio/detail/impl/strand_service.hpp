@@ -29,7 +29,8 @@ namespace detail {
 
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
-    locked_(false)
+    next_(0),
+    prev_(0)
 {
 }
 
@@ -40,13 +41,7 @@ struct strand_service::on_dispatch_exit
 
   ~on_dispatch_exit()
   {
-    impl_->mutex_.lock();
-    impl_->ready_queue_.push(impl_->waiting_queue_);
-    bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
-      io_context_->post_immediate_completion(impl_, false);
+    strand_service::release(impl_, io_context_, false);
   }
 };
 
@@ -55,7 +50,7 @@ void strand_service::dispatch(strand_service::implementation_type& impl,
     Handler& handler)
 {
   // If we are already in the strand then the handler can run immediately.
-  if (call_stack<strand_impl>::contains(impl))
+  if (call_stack<strand_impl>::contains(impl.get()))
   {
     fenced_block b(fenced_block::full);
     asio_handler_invoke_helpers::invoke(handler, handler);
@@ -69,7 +64,7 @@ void strand_service::dispatch(strand_service::implementation_type& impl,
   p.p = new (p.v) op(handler);
 
   ASIO_HANDLER_CREATION((this->context(),
-        *p.p, "strand", impl, 0, "dispatch"));
+        *p.p, "strand", impl.get(), 0, "dispatch"));
 
   bool dispatch_immediately = do_dispatch(impl, p.p);
   operation* o = p.p;
@@ -78,10 +73,10 @@ void strand_service::dispatch(strand_service::implementation_type& impl,
   if (dispatch_immediately)
   {
     // Indicate that this strand is executing on the current thread.
-    call_stack<strand_impl>::context ctx(impl);
+    call_stack<strand_impl>::context ctx(impl.get());
 
     // Ensure the next handler, if any, is scheduled on block exit.
-    on_dispatch_exit on_exit = { &io_context_, impl };
+    on_dispatch_exit on_exit = { &io_context_, impl.get() };
     (void)on_exit;
 
     completion_handler<Handler>::do_complete(
@@ -104,7 +99,7 @@ void strand_service::post(strand_service::implementation_type& impl,
   p.p = new (p.v) op(handler);
 
   ASIO_HANDLER_CREATION((this->context(),
-        *p.p, "strand", impl, 0, "post"));
+        *p.p, "strand", impl.get(), 0, "post"));
 
   do_post(impl, p.p, is_continuation);
   p.v = p.p = 0;
@@ -31,21 +31,14 @@ struct strand_service::on_do_complete_exit
 
   ~on_do_complete_exit()
   {
-    impl_->mutex_.lock();
-    impl_->ready_queue_.push(impl_->waiting_queue_);
-    bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
-      owner_->post_immediate_completion(impl_, true);
+    strand_service::release(impl_, owner_, true);
   }
 };
 
 strand_service::strand_service(asio::io_context& io_context)
   : asio::detail::service_base<strand_service>(io_context),
     io_context_(asio::use_service<io_context_impl>(io_context)),
-    mutex_(),
-    salt_(0)
+    impl_list_(new impl_list)
 {
 }
 
@@ -53,71 +46,73 @@ void strand_service::shutdown()
 {
   op_queue<operation> ops;
 
-  asio::detail::mutex::scoped_lock lock(mutex_);
+  asio::detail::mutex::scoped_lock lock(impl_list_->mutex_);
 
-  for (std::size_t i = 0; i < num_implementations; ++i)
+  strand_impl* impl = impl_list_->head_;
+  while (impl)
   {
-    if (strand_impl* impl = implementations_[i].get())
-    {
-      ops.push(impl->waiting_queue_);
-      ops.push(impl->ready_queue_);
-    }
+    impl->queue_.shutdown(ops);
+    ops.push(impl->ready_queue_);
+    impl = impl->next_;
   }
 }
 
 void strand_service::construct(strand_service::implementation_type& impl)
 {
-  asio::detail::mutex::scoped_lock lock(mutex_);
-
-  std::size_t salt = salt_++;
-#if defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  std::size_t index = salt;
-#else // defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  std::size_t index = reinterpret_cast<std::size_t>(&impl);
-  index += (reinterpret_cast<std::size_t>(&impl) >> 3);
-  index ^= salt + 0x9e3779b9 + (index << 6) + (index >> 2);
-#endif // defined(ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  index = index % num_implementations;
-
-  if (!implementations_[index].get())
-    implementations_[index].reset(new strand_impl);
-  impl = implementations_[index].get();
+  implementation_type new_impl(new strand_impl);
+
+  asio::detail::mutex::scoped_lock lock(impl_list_->mutex_);
+
+  // Insert implementation into linked list of all implementations.
+  new_impl->next_ = impl_list_->head_;
+  new_impl->prev_ = 0;
+  if (impl_list_->head_)
+    impl_list_->head_->prev_ = new_impl.get();
+  impl_list_->head_ = new_impl.get();
+  new_impl->list_ = impl_list_;
+
+  impl = new_impl;
+}
+
+strand_service::strand_impl::~strand_impl()
+{
+  // The list is used rather than the service, as the strand may be destroyed
+  // after the io_context.
+  asio::detail::mutex::scoped_lock lock(list_->mutex_);
+
+  // Remove implementation from linked list of all implementations.
+  if (list_->head_ == this)
+    list_->head_ = next_;
+  if (prev_)
+    prev_->next_ = next_;
+  if (next_)
+    next_->prev_= prev_;
 }
 
 bool strand_service::running_in_this_thread(
     const implementation_type& impl) const
 {
-  return call_stack<strand_impl>::contains(impl) != 0;
+  return call_stack<strand_impl>::contains(impl.get()) != 0;
 }
 
 bool strand_service::do_dispatch(implementation_type& impl, operation* op)
 {
   // If we are running inside the io_context, and no other handler already
   // holds the strand lock, then the handler can run immediately.
-  bool can_dispatch = io_context_.can_dispatch();
-  impl->mutex_.lock();
-  if (can_dispatch && !impl->locked_)
+  if (io_context_.can_dispatch() && impl->queue_.try_lock())
   {
     // Immediate invocation is allowed.
-    impl->locked_ = true;
-    impl->mutex_.unlock();
+    impl->self_ = impl;
     return true;
   }
 
-  if (impl->locked_)
-  {
-    // Some other handler already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_.unlock();
-  }
-  else
+  if (impl->queue_.push(op))
   {
     // The handler is acquiring the strand lock and so is responsible for
     // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_.unlock();
+    impl->self_ = impl;
     impl->ready_queue_.push(op);
-    io_context_.post_immediate_completion(impl, false);
+    io_context_.post_immediate_completion(impl.get(), false);
   }
 
   return false;
@@ -126,31 +121,37 @@ bool strand_service::do_dispatch(implementation_type& impl, operation* op)
 void strand_service::do_post(implementation_type& impl,
     operation* op, bool is_continuation)
 {
-  impl->mutex_.lock();
-  if (impl->locked_)
-  {
-    // Some other handler already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_.unlock();
-  }
-  else
+  if (impl->queue_.push(op))
   {
     // The handler is acquiring the strand lock and so is responsible for
     // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_.unlock();
+    impl->self_ = impl;
     impl->ready_queue_.push(op);
-    io_context_.post_immediate_completion(impl, is_continuation);
+    io_context_.post_immediate_completion(impl.get(), is_continuation);
+  }
+}
+
+void strand_service::release(strand_impl* impl,
+    io_context_impl* owner, bool is_continuation)
+{
+  // Once the lock is released another thread may acquire it, so the reference
+  // that keeps the implementation alive must be taken first.
+  shared_ptr<strand_impl> self;
+  self.swap(impl->self_);
+
+  if (impl->queue_.take_or_unlock(impl->ready_queue_))
+  {
+    impl->self_.swap(self);
+    owner->post_immediate_completion(impl, is_continuation);
   }
 }
 
 void strand_service::do_complete(void* owner, operation* base,
     const asio::error_code& ec, std::size_t /*bytes_transferred*/)
 {
+  strand_impl* impl = static_cast<strand_impl*>(base);
   if (owner)
   {
-    strand_impl* impl = static_cast<strand_impl*>(base);
-
     // Indicate that this strand is executing on the current thread.
     call_stack<strand_impl>::context ctx(impl);
 
@@ -167,6 +168,13 @@ void strand_service::do_complete(void* owner, operation* base,
       o->complete(owner, ec, 0);
     }
   }
+  else
+  {
+    // The strand is being destroyed without being run, so the reference that
+    // was held while it was scheduled is no longer needed.
+    shared_ptr<strand_impl> self;
+    self.swap(impl->self_);
+  }
 }
 
 } // namespace detail
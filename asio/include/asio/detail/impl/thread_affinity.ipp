@@ -0,0 +1,189 @@
+//
+// detail/impl/thread_affinity.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
+#define ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/thread_affinity.hpp"
+#include "asio/error.hpp"
+
+#if defined(__linux__)
+# include <cerrno>
+# include <cstdio>
+# include <cstdlib>
+# include <cstring>
+# include <dirent.h>
+# include <sched.h>
+#elif defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+# include "asio/detail/socket_types.hpp"
+#endif // defined(ASIO_WINDOWS) && !defined(ASIO_WINDOWS_APP) ...
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(__linux__)
+
+// Add to the mask those permitted CPUs that share a NUMA node with the given
+// CPU. The node is found by looking for the cpuN/nodeM entry in sysfs, and its
+// CPUs are read from the node's cpulist file, e.g. "0-3,8-11".
+inline void add_numa_node_cpus(int cpu,
+    const cpu_set_t& allowed, cpu_set_t& mask)
+{
+  char path[128];
+  std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+  DIR* dir = ::opendir(path);
+  if (!dir)
+    return;
+
+  int node = -1;
+  while (dirent* entry = ::readdir(dir))
+  {
+    if (std::strncmp(entry->d_name, "node", 4) == 0
+        && entry->d_name[4] >= '0' && entry->d_name[4] <= '9')
+    {
+      node = std::atoi(entry->d_name + 4);
+      break;
+    }
+  }
+  ::closedir(dir);
+  if (node < 0)
+    return;
+
+  std::snprintf(path, sizeof(path),
+      "/sys/devices/system/node/node%d/cpulist", node);
+  std::FILE* file = std::fopen(path, "r");
+  if (!file)
+    return;
+
+  char list[1024];
+  char* p = std::fgets(list, sizeof(list), file);
+  std::fclose(file);
+  while (p && *p >= '0' && *p <= '9')
+  {
+    long first = std::strtol(p, &p, 10);
+    long last = first;
+    if (*p == '-')
+      last = std::strtol(p + 1, &p, 10);
+    for (long i = first; i <= last && i < CPU_SETSIZE; ++i)
+      if (CPU_ISSET(i, &allowed))
+        CPU_SET(i, &mask);
+    if (*p == ',')
+      ++p;
+  }
+}
+
+void bind_this_thread_to_cpu(std::size_t cpu_index,
+    bool numa_node, asio::error_code& ec)
+{
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return;
+  }
+
+  std::size_t count = CPU_COUNT(&allowed);
+  if (count == 0)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  int cpu = 0;
+  for (std::size_t n = cpu_index % count; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &allowed) && n-- == 0)
+      break;
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  if (numa_node)
+    add_numa_node_cpus(cpu, allowed, mask);
+
+  if (::sched_setaffinity(0, sizeof(mask), &mask) != 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return;
+  }
+
+  ec = asio::error_code();
+}
+
+#elif defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+
+void bind_this_thread_to_cpu(std::size_t cpu_index,
+    bool numa_node, asio::error_code& ec)
+{
+  DWORD_PTR allowed = 0, system = 0;
+  if (!::GetProcessAffinityMask(::GetCurrentProcess(), &allowed, &system))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = asio::error_code(last_error, asio::error::get_system_category());
+    return;
+  }
+
+  std::size_t count = 0;
+  for (DWORD_PTR m = allowed; m; m &= m - 1)
+    ++count;
+  if (count == 0)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  UCHAR cpu = 0;
+  for (std::size_t n = cpu_index % count; cpu < sizeof(DWORD_PTR) * 8; ++cpu)
+    if ((allowed & (static_cast<DWORD_PTR>(1) << cpu)) && n-- == 0)
+      break;
+
+  DWORD_PTR mask = static_cast<DWORD_PTR>(1) << cpu;
+  UCHAR node = 0;
+  ULONGLONG node_mask = 0;
+  if (numa_node && ::GetNumaProcessorNode(cpu, &node)
+      && ::GetNumaNodeProcessorMask(node, &node_mask))
+    mask |= static_cast<DWORD_PTR>(node_mask) & allowed;
+
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = asio::error_code(last_error, asio::error::get_system_category());
+    return;
+  }
+
+  ec = asio::error_code();
+}
+
+#else // defined(ASIO_WINDOWS) && !defined(ASIO_WINDOWS_APP) ...
+
+void bind_this_thread_to_cpu(std::size_t, bool, asio::error_code& ec)
+{
+  ec = asio::error::operation_not_supported;
+}
+
+#endif // defined(ASIO_WINDOWS) && !defined(ASIO_WINDOWS_APP) ...
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
@@ -26,7 +26,9 @@
 namespace asio {
 namespace detail {
 
-timer_queue<time_traits<boost::posix_time::ptime> >::timer_queue()
+timer_queue<time_traits<boost::posix_time::ptime> >::timer_queue(
+    memory_resource* resource)
+  : impl_(resource)
 {
 }
 
@@ -79,7 +79,8 @@ struct win_iocp_io_context::timer_thread_function
 };
 
 win_iocp_io_context::win_iocp_io_context(
-    asio::execution_context& ctx, int concurrency_hint, bool own_thread)
+    asio::execution_context& ctx, int concurrency_hint,
+    bool own_thread, memory_resource* resource)
   : execution_context_service_base<win_iocp_io_context>(ctx),
     iocp_(),
     outstanding_work_(0),
@@ -88,7 +89,8 @@ win_iocp_io_context::win_iocp_io_context(
     shutdown_(0),
     gqcs_timeout_(get_gqcs_timeout()),
     dispatch_required_(0),
-    concurrency_hint_(concurrency_hint)
+    concurrency_hint_(concurrency_hint),
+    memory_resource_(resource)
 {
   ASIO_HANDLER_TRACKING_INIT;
 
@@ -195,6 +197,7 @@ size_t win_iocp_io_context::run(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
   size_t n = 0;
@@ -214,6 +217,7 @@ size_t win_iocp_io_context::run_one(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(INFINITE, ec);
@@ -229,6 +233,7 @@ size_t win_iocp_io_context::wait_one(long usec, asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(usec < 0 ? INFINITE : ((usec - 1) / 1000 + 1), ec);
@@ -244,6 +249,7 @@ size_t win_iocp_io_context::poll(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
   size_t n = 0;
@@ -263,6 +269,7 @@ size_t win_iocp_io_context::poll_one(asio::error_code& ec)
   }
 
   win_iocp_thread_info this_thread;
+  this_thread.set_memory_resource(memory_resource_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(0, ec);
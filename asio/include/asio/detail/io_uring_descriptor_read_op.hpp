@@ -0,0 +1,173 @@
+//
+// detail/io_uring_descriptor_read_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_DESCRIPTOR_READ_OP_HPP
+#define ASIO_DETAIL_IO_URING_DESCRIPTOR_READ_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_operation.hpp"
+#include "asio/detail/memory.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence>
+class io_uring_descriptor_read_op_base : public io_uring_operation
+{
+public:
+  io_uring_descriptor_read_op_base(int descriptor,
+      descriptor_ops::state_type state, const MutableBufferSequence& buffers,
+      func_type complete_func)
+    : io_uring_operation(&io_uring_descriptor_read_op_base::do_prepare,
+        &io_uring_descriptor_read_op_base::do_perform, complete_func),
+      descriptor_(descriptor),
+      state_(state),
+      bufs_(buffers)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    io_uring_descriptor_read_op_base* o(
+        static_cast<io_uring_descriptor_read_op_base*>(base));
+
+    if ((o->state_ & descriptor_ops::non_blocking) != 0)
+    {
+      prepare_poll(sqe, o->descriptor_, POLLIN);
+    }
+    else
+    {
+      // An offset of -1 uses and updates the current file position.
+      prepare_sqe(sqe, IORING_OP_READV, o->descriptor_, o->bufs_.buffers(),
+          static_cast<uint32_t>(o->bufs_.count()), static_cast<uint64_t>(-1));
+    }
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    io_uring_descriptor_read_op_base* o(
+        static_cast<io_uring_descriptor_read_op_base*>(base));
+
+    if ((o->state_ & descriptor_ops::non_blocking) != 0)
+    {
+      // The poll entry failed, e.g. because it was cancelled.
+      if (after_completion && o->ec_)
+        return true;
+
+      bool result = descriptor_ops::non_blocking_read(o->descriptor_,
+          o->bufs_.buffers(), o->bufs_.count(), o->ec_, o->bytes_transferred_);
+
+      ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_read",
+            o->ec_, o->bytes_transferred_));
+
+      return result;
+    }
+    else if (after_completion)
+    {
+      if (!o->ec_ && o->bytes_transferred_ == 0)
+        o->ec_ = asio::error::eof;
+    }
+
+    // The descriptor was put into non-blocking mode outside of our knowledge,
+    // so fall back to waiting for readiness.
+    if (o->ec_ == asio::error::would_block
+        || o->ec_ == asio::error::try_again)
+    {
+      o->state_ |= descriptor_ops::internal_non_blocking;
+      return false;
+    }
+
+    return after_completion;
+  }
+
+private:
+  int descriptor_;
+  descriptor_ops::state_type state_;
+  buffer_sequence_adapter<asio::mutable_buffer, MutableBufferSequence> bufs_;
+};
+
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class io_uring_descriptor_read_op
+  : public io_uring_descriptor_read_op_base<MutableBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_descriptor_read_op);
+
+  io_uring_descriptor_read_op(int descriptor,
+      descriptor_ops::state_type state, const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_descriptor_read_op_base<MutableBufferSequence>(descriptor, state,
+        buffers, &io_uring_descriptor_read_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    io_uring_descriptor_read_op* o(
+        static_cast<io_uring_descriptor_read_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_DESCRIPTOR_READ_OP_HPP
@@ -0,0 +1,137 @@
+//
+// detail/io_uring_file_read_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_FILE_READ_OP_HPP
+#define ASIO_DETAIL_IO_URING_FILE_READ_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_FILE)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_operation.hpp"
+#include "asio/detail/memory.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence>
+class io_uring_file_read_op_base : public io_uring_operation
+{
+public:
+  io_uring_file_read_op_base(int descriptor, uint64_t offset,
+      const MutableBufferSequence& buffers, func_type complete_func)
+    : io_uring_operation(&io_uring_file_read_op_base::do_prepare,
+        &io_uring_file_read_op_base::do_perform, complete_func),
+      descriptor_(descriptor),
+      offset_(offset),
+      bufs_(buffers)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    io_uring_file_read_op_base* o(
+        static_cast<io_uring_file_read_op_base*>(base));
+
+    // An offset of -1 uses and updates the current file position.
+    prepare_sqe(sqe, IORING_OP_READV, o->descriptor_, o->bufs_.buffers(),
+        static_cast<uint32_t>(o->bufs_.count()), o->offset_);
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    io_uring_file_read_op_base* o(
+        static_cast<io_uring_file_read_op_base*>(base));
+
+    // Reading zero bytes from a non-empty buffer means the end of the file.
+    if (after_completion && !o->ec_ && o->bytes_transferred_ == 0)
+      o->ec_ = asio::error::eof;
+
+    return after_completion;
+  }
+
+private:
+  int descriptor_;
+  uint64_t offset_;
+  buffer_sequence_adapter<asio::mutable_buffer, MutableBufferSequence> bufs_;
+};
+
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class io_uring_file_read_op
+  : public io_uring_file_read_op_base<MutableBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_file_read_op);
+
+  io_uring_file_read_op(int descriptor, uint64_t offset,
+      const MutableBufferSequence& buffers, Handler& handler, const IoExecutor& io_ex)
+    : io_uring_file_read_op_base<MutableBufferSequence>(descriptor, offset,
+        buffers, &io_uring_file_read_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    io_uring_file_read_op* o(static_cast<io_uring_file_read_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_IO_URING_FILE_READ_OP_HPP
@@ -0,0 +1,109 @@
+//
+// detail/io_uring_operation.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_OPERATION_HPP
+#define ASIO_DETAIL_IO_URING_OPERATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class io_uring_operation
+  : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  asio::error_code ec_;
+
+  // The number of bytes transferred, to be passed to the completion handler.
+  std::size_t bytes_transferred_;
+
+  // Prepare the operation by filling in the submission queue entry.
+  void prepare(::io_uring_sqe* sqe)
+  {
+    prepare_func_(this, sqe);
+  }
+
+  // Perform actions associated with the operation. Returns true when complete.
+  // The after_completion flag is true when called after the submission queue
+  // entry has produced a completion.
+  bool perform(bool after_completion)
+  {
+    return perform_func_(this, after_completion);
+  }
+
+protected:
+  typedef void (*prepare_func_type)(io_uring_operation*, ::io_uring_sqe*);
+  typedef bool (*perform_func_type)(io_uring_operation*, bool);
+
+  io_uring_operation(prepare_func_type prepare_func,
+      perform_func_type perform_func, func_type complete_func)
+    : operation(complete_func),
+      bytes_transferred_(0),
+      prepare_func_(prepare_func),
+      perform_func_(perform_func)
+  {
+  }
+
+  // Helper to fill in the fields that are common to all entries.
+  static void prepare_sqe(::io_uring_sqe* sqe, uint8_t opcode,
+      int fd, const void* addr, uint32_t len, uint64_t offset)
+  {
+    sqe->opcode = opcode;
+    sqe->flags = 0;
+    sqe->ioprio = 0;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(addr);
+    sqe->len = len;
+    sqe->rw_flags = 0;
+    sqe->user_data = 0;
+  }
+
+  // Helper to prepare a poll entry for the given descriptor.
+  static void prepare_poll(::io_uring_sqe* sqe, int fd, unsigned events)
+  {
+    prepare_sqe(sqe, IORING_OP_POLL_ADD, fd, 0, 0, 0);
+#if defined(IORING_FEAT_POLL_32BITS)
+# if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    events = (events << 16) | (events >> 16);
+# endif // defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    sqe->poll32_events = events;
+#else // defined(IORING_FEAT_POLL_32BITS)
+    sqe->poll_events = static_cast<uint16_t>(events);
+#endif // defined(IORING_FEAT_POLL_32BITS)
+  }
+
+private:
+  prepare_func_type prepare_func_;
+  perform_func_type perform_func_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_OPERATION_HPP
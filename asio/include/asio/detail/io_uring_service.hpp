@@ -0,0 +1,326 @@
+//
+// detail/io_uring_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SERVICE_HPP
+#define ASIO_DETAIL_IO_URING_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/io_uring_operation.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/object_pool.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/reactor.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/error_code.hpp"
+#include "asio/execution_context.hpp"
+
+// The number of entries requested for each io_context's submission queue. The
+// kernel rounds this up to a power of two.
+#if !defined(ASIO_IO_URING_ENTRIES)
+# define ASIO_IO_URING_ENTRIES 256
+#endif // !defined(ASIO_IO_URING_ENTRIES)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Submits socket and descriptor operations to a Linux io_uring instance. The
+// ring's completions are signalled through an eventfd that is registered with
+// the reactor, so that completions are harvested in batches by whichever
+// thread is currently running the reactor task inside the scheduler. If the
+// ring cannot be created, the service is disabled and the I/O objects perform
+// their operations through the reactor.
+class io_uring_service
+  : public execution_context_service_base<io_uring_service>
+{
+private:
+  // The mutex type used by this service.
+  typedef conditionally_enabled_mutex mutex;
+
+public:
+  enum op_types { read_op = 0, write_op = 1, except_op = 2, max_ops = 3 };
+
+  class io_object;
+
+  // An I/O queue holds operations that must be submitted to the ring one at a
+  // time, in order to preserve the ordering of reads or writes on a stream.
+  class io_queue : operation
+  {
+    friend class io_uring_service;
+
+    io_object* io_object_;
+    op_queue<io_uring_operation> op_queue_;
+    bool cancel_requested_;
+
+    ASIO_DECL io_queue();
+    void set_result(int r) { task_result_ = static_cast<unsigned>(r); }
+    ASIO_DECL operation* perform_io(int result);
+    ASIO_DECL static void do_complete(void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+  };
+
+  // Per I/O object state.
+  class io_object
+  {
+    friend class io_uring_service;
+    friend class object_pool_access;
+
+    io_object* next_;
+    io_object* prev_;
+
+    mutex mutex_;
+    io_uring_service* service_;
+    io_queue queues_[max_ops];
+    bool shutdown_;
+
+    ASIO_DECL io_object(bool locking);
+  };
+
+  // Per I/O object data.
+  typedef io_object* per_io_object_data;
+
+  // Constructor.
+  ASIO_DECL io_uring_service(asio::execution_context& ctx);
+
+  // Destructor.
+  ASIO_DECL ~io_uring_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Recreate internal state following a fork.
+  ASIO_DECL void notify_fork(
+      asio::execution_context::fork_event fork_ev);
+
+  // Initialise the task.
+  ASIO_DECL void init_task();
+
+  // Whether the ring was created. When it was not, because the kernel does not
+  // support io_uring or its use is not permitted, operations must be started
+  // on the reactor instead.
+  bool is_enabled() const
+  {
+    return ring_fd_ != -1;
+  }
+
+  // Register an I/O object with io_uring. Leaves the I/O object unregistered
+  // if the service is disabled.
+  ASIO_DECL void register_io_object(per_io_object_data& io_obj);
+
+  // Move I/O object registration from one object to another.
+  void move_io_object(per_io_object_data& target_io_obj,
+      per_io_object_data& source_io_obj)
+  {
+    target_io_obj = source_io_obj;
+    source_io_obj = 0;
+  }
+
+  // Post an operation for immediate completion.
+  void post_immediate_completion(operation* op, bool is_continuation)
+  {
+    scheduler_.post_immediate_completion(op, is_continuation);
+  }
+
+  // Start a new operation. The operation will be prepared and submitted to
+  // the io_uring when it reaches the head of its operation queue.
+  ASIO_DECL void start_op(int op_type, per_io_object_data& io_obj,
+      io_uring_operation* op, bool is_continuation);
+
+  // Cancel all operations associated with the given I/O object. The handlers
+  // associated with the I/O object will be invoked with the operation_aborted
+  // error.
+  ASIO_DECL void cancel_ops(per_io_object_data& io_obj);
+
+  // Cancel any operations that are running against the I/O object and remove
+  // its registration from the service. The service resources associated with
+  // the I/O object must be released by calling cleanup_io_object.
+  ASIO_DECL void deregister_io_object(per_io_object_data& io_obj);
+
+  // Perform any post-deregistration cleanup tasks associated with the I/O
+  // object.
+  ASIO_DECL void cleanup_io_object(per_io_object_data& io_obj);
+
+  // Whether the kernel arms an internal poll for operations that cannot
+  // complete immediately, allowing blocking descriptors to be submitted.
+  bool supports_fast_poll() const
+  {
+    return (features_ & IORING_FEAT_FAST_POLL) != 0;
+  }
+
+  // Harvest all available completions from the ring and add the associated
+  // queues to the supplied operation queue.
+  ASIO_DECL void harvest_completions(op_queue<operation>& ops);
+
+private:
+  // The number of entries requested for the submission queue.
+  enum { ring_size = ASIO_IO_URING_ENTRIES };
+
+  // The number of pending entries that forces an immediate submission.
+  enum { submit_batch_size = 128 };
+
+  // The value used in a completion's user data for internal entries.
+  enum { internal_user_data = 0 };
+
+  // Create and map the ring.
+  ASIO_DECL asio::error_code init_ring(asio::error_code& ec);
+
+  // Unmap and close the ring.
+  ASIO_DECL void destroy_ring();
+
+  // Create the eventfd and register it with the ring and the reactor.
+  ASIO_DECL asio::error_code register_with_reactor(asio::error_code& ec);
+
+  // Deregister the eventfd from the reactor and close it.
+  ASIO_DECL void deregister_from_reactor();
+
+  // Get a new submission queue entry, flushing the queue if it is full. Must
+  // be called with the mutex held.
+  ASIO_DECL ::io_uring_sqe* get_sqe();
+
+  // Submit all pending entries to the kernel. Must be called with the mutex
+  // held.
+  ASIO_DECL void submit_sqes();
+
+  // Move any completions that overflowed the completion queue back into it.
+  // Returns true if there were any. Must be called with the mutex held.
+  ASIO_DECL bool flush_overflowed_cqes();
+
+  // Submit pending entries now, or arrange for them to be submitted by the
+  // scheduler once the current handler returns. Always unlocks the mutex.
+  ASIO_DECL void post_submit_sqes_op(mutex::scoped_lock& lock);
+
+  // Prepare and submit the operation at the head of the queue. Must be called
+  // with the I/O object's mutex held.
+  ASIO_DECL void start_io(io_queue& q);
+
+  // Submit an entry to cancel the operation in flight for the queue. Must be
+  // called with the I/O object's mutex held.
+  ASIO_DECL void cancel_io(io_queue& q);
+
+  // Allocate a new I/O object.
+  ASIO_DECL io_object* allocate_io_object();
+
+  // Free an existing I/O object.
+  ASIO_DECL void free_io_object(io_object* s);
+
+  // The scheduler implementation used to post completions.
+  scheduler& scheduler_;
+
+  // The reactor used to wait for completion notifications.
+  reactor& reactor_;
+
+  // Mutex to protect access to the ring.
+  mutex mutex_;
+
+  // The ring file descriptor.
+  int ring_fd_;
+
+  // The features reported by the kernel when the ring was created.
+  unsigned features_;
+
+  // The mapped submission queue ring.
+  void* sq_ring_ptr_;
+  std::size_t sq_ring_size_;
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_ring_mask_;
+  unsigned* sq_flags_;
+  unsigned* sq_array_;
+
+  // The mapped submission queue entries.
+  ::io_uring_sqe* sqes_;
+  std::size_t sqes_size_;
+
+  // The mapped completion queue ring.
+  void* cq_ring_ptr_;
+  std::size_t cq_ring_size_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_ring_mask_;
+  ::io_uring_cqe* cqes_;
+
+  // The number of entries in the submission queue.
+  unsigned sq_entries_;
+
+  // The local submission queue tail, ahead of the shared one while entries
+  // are being prepared.
+  unsigned sqe_tail_;
+
+  // The number of prepared entries that have not yet been submitted.
+  int pending_sqes_;
+
+  // Whether an operation to submit pending entries has been posted.
+  bool pending_submit_sqes_op_;
+
+  // The number of operations in flight in the kernel.
+  std::size_t outstanding_ops_;
+
+  // The eventfd used to signal completions.
+  int event_fd_;
+
+  // Per-descriptor data used by the reactor for the eventfd.
+  reactor::per_descriptor_data reactor_data_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
+  // Mutex to protect access to the registered I/O objects.
+  mutex registered_io_objects_mutex_;
+
+  // Keep track of all registered I/O objects.
+  object_pool<io_object> registered_io_objects_;
+
+  // Helper class to submit pending entries from within the scheduler.
+  class submit_sqes_op : operation
+  {
+    friend class io_uring_service;
+
+    io_uring_service* service_;
+
+    ASIO_DECL submit_sqes_op(io_uring_service* s);
+    ASIO_DECL static void do_complete(void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+  };
+  friend class submit_sqes_op;
+
+  // The operation used to submit pending entries.
+  submit_sqes_op submit_sqes_op_;
+
+  // Helper class to harvest completions when the eventfd becomes readable.
+  class event_fd_read_op;
+  friend class event_fd_read_op;
+
+  // Helper class to do post-perform_io cleanup.
+  struct perform_io_cleanup_on_block_exit;
+  friend struct perform_io_cleanup_on_block_exit;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/io_uring_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_SERVICE_HPP
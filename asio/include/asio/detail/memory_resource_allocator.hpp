@@ -0,0 +1,139 @@
+//
+// detail/memory_resource_allocator.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MEMORY_RESOURCE_ALLOCATOR_HPP
+#define ASIO_DETAIL_MEMORY_RESOURCE_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/limits.hpp"
+#include "asio/memory_resource.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Allocate memory from a resource, or from the heap if there is no resource.
+inline void* allocate_from_resource(memory_resource* resource,
+    std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
+{
+  return resource ? resource->allocate(size, align) : ::operator new(size);
+}
+
+// Deallocate memory obtained from allocate_from_resource().
+inline void deallocate_to_resource(memory_resource* resource,
+    void* pointer, std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
+{
+  if (resource)
+    resource->deallocate(pointer, size, align);
+  else
+    ::operator delete(pointer);
+}
+
+// A standard allocator that obtains memory from a memory resource, or from the
+// heap if there is no resource.
+template <typename T>
+class memory_resource_allocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef memory_resource_allocator<U> other;
+  };
+
+  explicit memory_resource_allocator(memory_resource* resource = 0)
+    : resource_(resource)
+  {
+  }
+
+  template <typename U>
+  memory_resource_allocator(const memory_resource_allocator<U>& other)
+    : resource_(other.resource())
+  {
+  }
+
+  memory_resource* resource() const
+  {
+    return resource_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(allocate_from_resource(
+          resource_, sizeof(T) * n, ASIO_ALIGNOF(T)));
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    deallocate_to_resource(resource_, p, sizeof(T) * n, ASIO_ALIGNOF(T));
+  }
+
+  std::size_t max_size() const
+  {
+    return (std::numeric_limits<std::size_t>::max)() / sizeof(T);
+  }
+
+  T* address(T& t) const
+  {
+    return &t;
+  }
+
+  const T* address(const T& t) const
+  {
+    return &t;
+  }
+
+  void construct(T* p, const T& t)
+  {
+    new (static_cast<void*>(p)) T(t);
+  }
+
+  void destroy(T* p)
+  {
+    p->~T();
+  }
+
+  friend bool operator==(const memory_resource_allocator& a,
+      const memory_resource_allocator& b)
+  {
+    return a.resource_ == b.resource_;
+  }
+
+  friend bool operator!=(const memory_resource_allocator& a,
+      const memory_resource_allocator& b)
+  {
+    return a.resource_ != b.resource_;
+  }
+
+private:
+  memory_resource* resource_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_MEMORY_RESOURCE_ALLOCATOR_HPP
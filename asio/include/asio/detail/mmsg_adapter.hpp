@@ -0,0 +1,101 @@
+//
+// detail/mmsg_adapter.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MMSG_ADAPTER_HPP
+#define ASIO_DETAIL_MMSG_ADAPTER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Helper class to translate arrays of buffers and endpoints into the batch of
+// datagrams used by recvmmsg and sendmmsg.
+template <typename Endpoint>
+class mmsg_adapter
+{
+public:
+  // Construct a batch for receiving datagrams. The endpoints may be null.
+  mmsg_adapter(const mutable_buffer* buffers,
+      Endpoint* endpoints, std::size_t count)
+    : count_(count < socket_ops::max_mmsg_count
+        ? count : socket_ops::max_mmsg_count)
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      socket_ops::init_buf(msgs_[i].data,
+          buffers[i].data(), buffers[i].size());
+      msgs_[i].addr = endpoints ? endpoints[i].data() : 0;
+      msgs_[i].addrlen = endpoints ? endpoints[i].capacity() : 0;
+      msgs_[i].bytes_transferred = 0;
+    }
+  }
+
+  // Construct a batch for sending datagrams. The endpoints may be null if the
+  // socket is connected.
+  mmsg_adapter(const const_buffer* buffers,
+      const Endpoint* endpoints, std::size_t count)
+    : count_(count < socket_ops::max_mmsg_count
+        ? count : socket_ops::max_mmsg_count)
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      socket_ops::init_buf(msgs_[i].data,
+          buffers[i].data(), buffers[i].size());
+      msgs_[i].addr = endpoints
+        ? const_cast<socket_addr_type*>(endpoints[i].data()) : 0;
+      msgs_[i].addrlen = endpoints ? endpoints[i].size() : 0;
+      msgs_[i].bytes_transferred = 0;
+    }
+  }
+
+  socket_ops::mmsg_buf* msgs()
+  {
+    return msgs_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+  // Store the sizes and sender endpoints of the received datagrams.
+  void complete_receive(std::size_t msgs_transferred,
+      Endpoint* endpoints, std::size_t* sizes) const
+  {
+    for (std::size_t i = 0; i < msgs_transferred; ++i)
+    {
+      if (endpoints)
+        endpoints[i].resize(msgs_[i].addrlen);
+      if (sizes)
+        sizes[i] = msgs_[i].bytes_transferred;
+    }
+  }
+
+private:
+  socket_ops::mmsg_buf msgs_[socket_ops::max_mmsg_count];
+  std::size_t count_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_MMSG_ADAPTER_HPP
@@ -19,7 +19,9 @@
 
 #if defined(ASIO_WINDOWS_RUNTIME)
 
+#include "asio/ancillary_data.hpp"
 #include "asio/buffer.hpp"
+#include "asio/buffer_pool.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/post.hpp"
@@ -293,6 +295,17 @@ public:
           handler, ec, bytes_transferred));
   }
 
+  // Start an asynchronous send of all of the data.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zero_copy(implementation_type&, const ConstBufferSequence&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, bytes_transferred));
+  }
+
   // Receive some data from the peer. Returns the number of bytes received.
   template <typename MutableBufferSequence>
   std::size_t receive(implementation_type&, const MutableBufferSequence&,
@@ -334,6 +347,19 @@ public:
           handler, ec, bytes_transferred));
   }
 
+#if defined(ASIO_HAS_MOVE)
+  // Start an asynchronous receive into a buffer taken from a pool.
+  template <typename Handler, typename IoExecutor>
+  void async_receive(implementation_type&, buffer_pool&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    asio::post(io_ex, detail::move_binder2<Handler,
+        asio::error_code, pooled_buffer>(0,
+          ASIO_MOVE_CAST(Handler)(handler), ec, pooled_buffer()));
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -425,6 +451,51 @@ public:
           handler, ec, bytes_transferred));
   }
 
+  // Send a batch of datagrams, each to the corresponding endpoint. Returns the
+  // number of datagrams sent.
+  std::size_t send_many(implementation_type&, const const_buffer*,
+      const endpoint_type*, std::size_t, socket_base::message_flags,
+      asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous send of a batch of datagrams.
+  template <typename Handler, typename IoExecutor>
+  void async_send_many(implementation_type&, const const_buffer*,
+      const endpoint_type*, std::size_t, socket_base::message_flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t msgs_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, msgs_transferred));
+  }
+
+  // Send a datagram payload to the specified endpoint, to be divided into
+  // datagrams of the given segment size. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  std::size_t send_segments_to(implementation_type&,
+      const ConstBufferSequence&, const endpoint_type&, std::size_t,
+      socket_base::message_flags, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous send of a payload to be divided into datagrams.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_segments_to(implementation_type&,
+      const ConstBufferSequence&, const endpoint_type&, std::size_t,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, bytes_transferred));
+  }
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -472,6 +543,101 @@ public:
           handler, ec, bytes_transferred));
   }
 
+  // Receive a batch of datagrams, storing the size and sender of each. Returns
+  // the number of datagrams received.
+  std::size_t receive_many(implementation_type&, const mutable_buffer*,
+      endpoint_type*, std::size_t*, std::size_t, socket_base::message_flags,
+      asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_many(implementation_type&, const mutable_buffer*,
+      endpoint_type*, std::size_t*, std::size_t, socket_base::message_flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t msgs_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, msgs_transferred));
+  }
+
+  // Receive a payload of one or more coalesced datagrams. Returns the number of
+  // bytes received.
+  template <typename MutableBufferSequence>
+  std::size_t receive_segments_from(implementation_type&,
+      const MutableBufferSequence&, endpoint_type&, std::size_t&,
+      socket_base::message_flags, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous receive of a payload of one or more coalesced
+  // datagrams.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_segments_from(implementation_type&,
+      const MutableBufferSequence&, endpoint_type&, std::size_t&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, bytes_transferred));
+  }
+
+  // Receive data together with any ancillary data. Returns the number of bytes
+  // received.
+  template <typename MutableBufferSequence>
+  std::size_t receive_msg(implementation_type&,
+      const MutableBufferSequence&, endpoint_type*, ancillary_data&,
+      socket_base::message_flags, asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous receive of data together with any ancillary data.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_msg(implementation_type&,
+      const MutableBufferSequence&, endpoint_type*, ancillary_data&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, bytes_transferred));
+  }
+
+  // Send data together with ancillary data. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  std::size_t send_msg(implementation_type&,
+      const ConstBufferSequence&, const endpoint_type*,
+      const ancillary_data&, socket_base::message_flags,
+      asio::error_code& ec)
+  {
+    ec = asio::error::operation_not_supported;
+    return 0;
+  }
+
+  // Start an asynchronous send of data together with ancillary data.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_msg(implementation_type&,
+      const ConstBufferSequence&, const endpoint_type*,
+      const ancillary_data&, socket_base::message_flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    const std::size_t bytes_transferred = 0;
+    asio::post(io_ex, detail::bind_handler(
+          handler, ec, bytes_transferred));
+  }
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type&,
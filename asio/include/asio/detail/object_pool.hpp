@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/memory_resource_allocator.hpp"
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -25,25 +26,54 @@ namespace detail {
 template <typename Object>
 class object_pool;
 
+// Memory for an object that is released unless construction succeeds.
+template <typename Object>
+struct raw_object
+{
+  explicit raw_object(memory_resource* resource)
+    : resource_(resource),
+      pointer_(allocate_from_resource(resource,
+            sizeof(Object), ASIO_ALIGNOF(Object)))
+  {
+  }
+
+  ~raw_object()
+  {
+    if (pointer_)
+      deallocate_to_resource(resource_, pointer_,
+          sizeof(Object), ASIO_ALIGNOF(Object));
+  }
+
+  memory_resource* resource_;
+  void* pointer_;
+};
+
 class object_pool_access
 {
 public:
   template <typename Object>
-  static Object* create()
+  static Object* create(memory_resource* resource)
   {
-    return new Object;
+    raw_object<Object> raw(resource);
+    Object* o = new (raw.pointer_) Object;
+    raw.pointer_ = 0;
+    return o;
   }
 
   template <typename Object, typename Arg>
-  static Object* create(Arg arg)
+  static Object* create(memory_resource* resource, Arg arg)
   {
-    return new Object(arg);
+    raw_object<Object> raw(resource);
+    Object* o = new (raw.pointer_) Object(arg);
+    raw.pointer_ = 0;
+    return o;
   }
 
   template <typename Object>
-  static void destroy(Object* o)
+  static void destroy(memory_resource* resource, Object* o)
   {
-    delete o;
+    o->~Object();
+    deallocate_to_resource(resource, o, sizeof(Object), ASIO_ALIGNOF(Object));
   }
 
   template <typename Object>
@@ -64,9 +94,11 @@ class object_pool
   : private noncopyable
 {
 public:
-  // Constructor.
-  object_pool()
-    : live_list_(0),
+  // Constructor. Objects are allocated from the given memory resource, or from
+  // the heap if there is none.
+  explicit object_pool(memory_resource* resource = 0)
+    : resource_(resource),
+      live_list_(0),
       free_list_(0)
   {
   }
@@ -91,7 +123,7 @@ public:
     if (o)
       free_list_ = object_pool_access::next(free_list_);
     else
-      o = object_pool_access::create<Object>();
+      o = object_pool_access::create<Object>(resource_);
 
     object_pool_access::next(o) = live_list_;
     object_pool_access::prev(o) = 0;
@@ -110,7 +142,7 @@ public:
     if (o)
       free_list_ = object_pool_access::next(free_list_);
     else
-      o = object_pool_access::create<Object>(arg);
+      o = object_pool_access::create<Object>(resource_, arg);
 
     object_pool_access::next(o) = live_list_;
     object_pool_access::prev(o) = 0;
@@ -152,10 +184,13 @@ private:
     {
       Object* o = list;
       list = object_pool_access::next(o);
-      object_pool_access::destroy(o);
+      object_pool_access::destroy(resource_, o);
     }
   }
 
+  // The memory resource used to allocate objects.
+  memory_resource* resource_;
+
   // The list of live objects.
   Object* live_list_;
 
@@ -0,0 +1,427 @@
+//
+// detail/posix_file_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_POSIX_FILE_SERVICE_HPP
+#define ASIO_DETAIL_POSIX_FILE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_FILE)
+
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/file_base.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/descriptor_ops.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/blocking_file_read_op.hpp"
+#include "asio/detail/blocking_file_write_op.hpp"
+#include "asio/detail/io_uring_file_read_op.hpp"
+#include "asio/detail/io_uring_file_write_op.hpp"
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/thread_group.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Regular files cannot be waited on for readiness, so rather than performing
+// operations through the reactor they are submitted to io_uring, if
+// available, or run to completion on a private pool of threads. The pool is
+// also used when io_uring support is enabled but the kernel does not provide
+// it.
+class posix_file_service :
+  public execution_context_service_base<posix_file_service>
+{
+public:
+  // The native type of a file.
+  typedef int native_handle_type;
+
+  // The offset used to indicate that an operation should use, and update,
+  // the current file position.
+  static const uint64_t current_position = ~static_cast<uint64_t>(0);
+
+  // Owns a descriptor, closing it when the last reference is released.
+  struct descriptor_holder
+    : private asio::detail::noncopyable
+  {
+    explicit descriptor_holder(int d)
+      : descriptor_(d)
+    {
+    }
+
+    ~descriptor_holder()
+    {
+      if (descriptor_ != -1)
+        ::close(descriptor_);
+    }
+
+    int descriptor_;
+  };
+
+  // The implementation type of the file.
+  class implementation_type
+    : private asio::detail::noncopyable
+  {
+  public:
+    // Default constructor.
+    implementation_type()
+      : descriptor_(-1)
+#if defined(ASIO_HAS_IO_URING)
+        , io_object_data_(0)
+#endif // defined(ASIO_HAS_IO_URING)
+    {
+    }
+
+  private:
+    // Only this service will have access to the internal values.
+    friend class posix_file_service;
+
+    // The native file descriptor.
+    int descriptor_;
+
+#if defined(ASIO_HAS_IO_URING)
+    // Per-I/O object data used by the io_uring service.
+    io_uring_service::per_io_object_data io_object_data_;
+#endif // defined(ASIO_HAS_IO_URING)
+
+    // Shared ownership of the descriptor. Operations running on the thread
+    // pool hold a reference, so that the descriptor is not closed (and its
+    // number reused) while a blocking call is in progress.
+    shared_ptr<descriptor_holder> descriptor_owner_;
+
+    // Operations hold a weak reference to this token, which is reset when
+    // the operations are cancelled.
+    socket_ops::shared_cancel_token_type cancel_token_;
+  };
+
+  // Constructor.
+  ASIO_DECL posix_file_service(execution_context& context);
+
+  // Destructor.
+  ASIO_DECL ~posix_file_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Construct a new file implementation.
+  ASIO_DECL void construct(implementation_type& impl);
+
+  // Move-construct a new file implementation.
+  ASIO_DECL void move_construct(implementation_type& impl,
+      implementation_type& other_impl);
+
+  // Move-assign from another file implementation.
+  ASIO_DECL void move_assign(implementation_type& impl,
+      posix_file_service& other_service,
+      implementation_type& other_impl);
+
+  // Destroy a file implementation.
+  ASIO_DECL void destroy(implementation_type& impl);
+
+  // Open a file.
+  ASIO_DECL asio::error_code open(implementation_type& impl,
+      const char* path, file_base::flags open_flags,
+      asio::error_code& ec);
+
+  // Assign a native descriptor to a file implementation.
+  ASIO_DECL asio::error_code assign(implementation_type& impl,
+      const native_handle_type& native_descriptor,
+      asio::error_code& ec);
+
+  // Determine whether the file is open.
+  bool is_open(const implementation_type& impl) const
+  {
+    return impl.descriptor_ != -1;
+  }
+
+  // Destroy a file implementation.
+  ASIO_DECL asio::error_code close(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the native file representation.
+  native_handle_type native_handle(const implementation_type& impl) const
+  {
+    return impl.descriptor_;
+  }
+
+  // Release ownership of the native descriptor representation.
+  ASIO_DECL native_handle_type release(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Cancel all operations associated with the file.
+  ASIO_DECL asio::error_code cancel(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Get the size of the file.
+  ASIO_DECL uint64_t size(const implementation_type& impl,
+      asio::error_code& ec) const;
+
+  // Alter the size of the file.
+  ASIO_DECL asio::error_code resize(implementation_type& impl,
+      uint64_t n, asio::error_code& ec);
+
+  // Synchronise the file to disk.
+  ASIO_DECL asio::error_code sync_all(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Synchronise the file data to disk.
+  ASIO_DECL asio::error_code sync_data(implementation_type& impl,
+      asio::error_code& ec);
+
+  // Seek to a position in the file.
+  ASIO_DECL uint64_t seek(implementation_type& impl, int64_t offset,
+      file_base::seek_basis whence, asio::error_code& ec);
+
+  // Write the given data at the current file position. Returns the number of
+  // bytes written.
+  template <typename ConstBufferSequence>
+  size_t write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_write(impl.descriptor_, 0,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Write the given data at the specified offset. Returns the number of bytes
+  // written.
+  template <typename ConstBufferSequence>
+  size_t write_some_at(implementation_type& impl, uint64_t offset,
+      const ConstBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_write_at(impl.descriptor_, offset,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous write at the current file position.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    async_write_some_at(impl, current_position, buffers, handler, io_ex);
+  }
+
+  // Start an asynchronous write at the specified offset. The data being
+  // written must be valid for the lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_write_some_at(implementation_type& impl, uint64_t offset,
+      const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_file_write_op<
+          ConstBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(impl.descriptor_, offset, buffers, handler, io_ex);
+
+      ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+            &impl, impl.descriptor_, "async_write_some_at"));
+
+      start_io_uring_op(impl, write_op, p.p, is_continuation,
+          buffer_sequence_adapter<asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers));
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef blocking_file_write_op<ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.descriptor_owner_, impl.cancel_token_,
+        impl.descriptor_, offset, buffers, scheduler_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+          &impl, impl.descriptor_, "async_write_some_at"));
+
+    start_op(impl, write_op, p.p, is_continuation,
+        buffer_sequence_adapter<asio::const_buffer,
+          ConstBufferSequence>::all_empty(buffers));
+    p.v = p.p = 0;
+  }
+
+  // Read some data at the current file position. Returns the number of bytes
+  // read.
+  template <typename MutableBufferSequence>
+  size_t read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_read(impl.descriptor_, 0,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Read some data at the specified offset. Returns the number of bytes read.
+  template <typename MutableBufferSequence>
+  size_t read_some_at(implementation_type& impl, uint64_t offset,
+      const MutableBufferSequence& buffers, asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    return descriptor_ops::sync_read_at(impl.descriptor_, offset,
+        bufs.buffers(), bufs.count(), bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous read at the current file position.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    async_read_some_at(impl, current_position, buffers, handler, io_ex);
+  }
+
+  // Start an asynchronous read at the specified offset. The buffer for the
+  // data being read must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_read_some_at(implementation_type& impl, uint64_t offset,
+      const MutableBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_file_read_op<
+          MutableBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(impl.descriptor_, offset, buffers, handler, io_ex);
+
+      ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+            &impl, impl.descriptor_, "async_read_some_at"));
+
+      start_io_uring_op(impl, read_op, p.p, is_continuation,
+          buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers));
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef blocking_file_read_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.descriptor_owner_, impl.cancel_token_,
+        impl.descriptor_, offset, buffers, scheduler_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((scheduler_.context(), *p.p, "file",
+          &impl, impl.descriptor_, "async_read_some_at"));
+
+    start_op(impl, read_op, p.p, is_continuation,
+        buffer_sequence_adapter<asio::mutable_buffer,
+          MutableBufferSequence>::all_empty(buffers));
+    p.v = p.p = 0;
+  }
+
+private:
+  enum op_types { read_op = 0, write_op = 1 };
+
+#if defined(ASIO_HAS_IO_URING)
+  // Start the asynchronous operation using io_uring.
+  ASIO_DECL void start_io_uring_op(implementation_type& impl, int op_type,
+      io_uring_operation* op, bool is_continuation, bool noop);
+#endif // defined(ASIO_HAS_IO_URING)
+
+  // Start the asynchronous operation on the thread pool.
+  ASIO_DECL void start_op(implementation_type& impl, int op_type,
+      operation* op, bool is_continuation, bool noop);
+
+  // Helper class to run the work scheduler in a thread.
+  class work_scheduler_runner;
+
+  // Start the work threads if they're not already running.
+  ASIO_DECL void start_work_threads();
+
+  // Take ownership of a descriptor, creating the implementation's shared
+  // owner and cancellation token.
+  ASIO_DECL void take_ownership(implementation_type& impl, int descriptor);
+
+  // Give up ownership of the implementation's descriptor. Returns true if no
+  // background operation holds a reference to it.
+  ASIO_DECL bool give_up_ownership(implementation_type& impl);
+
+  // The scheduler used to deliver completions.
+  scheduler& scheduler_;
+
+#if defined(ASIO_HAS_IO_URING)
+  // The io_uring service used for reads and writes.
+  io_uring_service& io_uring_service_;
+#endif // defined(ASIO_HAS_IO_URING)
+
+  // The number of threads used to perform blocking file operations.
+  enum { work_thread_count = 4 };
+
+  // Mutex to protect access to internal data.
+  asio::detail::mutex mutex_;
+
+  // Private scheduler used for performing blocking file operations.
+  asio::detail::scoped_ptr<scheduler> work_scheduler_;
+
+  // Threads used for running the work scheduler's run loop.
+  asio::detail::thread_group work_threads_;
+
+  // Whether the work threads have been started.
+  bool work_threads_started_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/posix_file_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_FILE)
+
+#endif // ASIO_DETAIL_POSIX_FILE_SERVICE_HPP
@@ -29,6 +29,9 @@
 #include "asio/detail/descriptor_read_op.hpp"
 #include "asio/detail/descriptor_write_op.hpp"
 #include "asio/detail/fenced_block.hpp"
+#include "asio/detail/io_uring_descriptor_read_op.hpp"
+#include "asio/detail/io_uring_descriptor_write_op.hpp"
+#include "asio/detail/io_uring_service.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
@@ -57,6 +60,9 @@ public:
     implementation_type()
       : descriptor_(-1),
         state_(0)
+#if defined(ASIO_HAS_IO_URING)
+        , io_object_data_(0)
+#endif // defined(ASIO_HAS_IO_URING)
     {
     }
 
@@ -72,6 +78,11 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if defined(ASIO_HAS_IO_URING)
+    // Per-I/O object data used by the io_uring service.
+    io_uring_service::per_io_object_data io_object_data_;
+#endif // defined(ASIO_HAS_IO_URING)
   };
 
   // Constructor.
@@ -261,6 +272,28 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_descriptor_write_op<
+          ConstBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(impl.descriptor_,
+          io_uring_op_state(impl), buffers, handler, io_ex);
+
+      ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "descriptor",
+            &impl, impl.descriptor_, "async_write_some"));
+
+      start_io_uring_op(impl, io_uring_service::write_op, p.p, is_continuation,
+          buffer_sequence_adapter<asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers));
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
     // Allocate and construct an operation to wrap the handler.
     typedef descriptor_write_op<ConstBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -330,6 +363,28 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_descriptor_read_op<
+          MutableBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(impl.descriptor_,
+          io_uring_op_state(impl), buffers, handler, io_ex);
+
+      ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "descriptor",
+            &impl, impl.descriptor_, "async_read_some"));
+
+      start_io_uring_op(impl, io_uring_service::read_op, p.p, is_continuation,
+          buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers));
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
     // Allocate and construct an operation to wrap the handler.
     typedef descriptor_read_op<MutableBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -371,8 +426,32 @@ private:
   ASIO_DECL void start_op(implementation_type& impl, int op_type,
       reactor_op* op, bool is_continuation, bool is_non_blocking, bool noop);
 
+#if defined(ASIO_HAS_IO_URING)
+  // Get the state to be captured by an io_uring operation. When the kernel
+  // can poll internally the operation is submitted directly, regardless of
+  // whether the descriptor is in non-blocking mode.
+  descriptor_ops::state_type io_uring_op_state(
+      const implementation_type& impl) const
+  {
+    if (io_uring_service_.supports_fast_poll())
+      return static_cast<descriptor_ops::state_type>(
+          impl.state_ & ~descriptor_ops::non_blocking);
+    return static_cast<descriptor_ops::state_type>(
+        impl.state_ | descriptor_ops::internal_non_blocking);
+  }
+
+  // Start the asynchronous operation using io_uring.
+  ASIO_DECL void start_io_uring_op(implementation_type& impl, int op_type,
+      io_uring_operation* op, bool is_continuation, bool noop);
+#endif // defined(ASIO_HAS_IO_URING)
+
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
+
+#if defined(ASIO_HAS_IO_URING)
+  // The io_uring service used for reads and writes.
+  io_uring_service& io_uring_service_;
+#endif // defined(ASIO_HAS_IO_URING)
 };
 
 } // namespace detail
@@ -0,0 +1,178 @@
+//
+// detail/reactive_socket_recv_pooled_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_POOLED_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_POOLED_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MOVE)
+
+#include "asio/buffer_pool.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class reactive_socket_recv_pooled_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_pooled_op_base(socket_type socket,
+      socket_ops::state_type state, buffer_pool& pool,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(&reactive_socket_recv_pooled_op_base::do_perform,
+        complete_func),
+      socket_(socket),
+      state_(state),
+      pool_(pool),
+      flags_(flags),
+      data_(0)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recv_pooled_op_base* o(
+        static_cast<reactive_socket_recv_pooled_op_base*>(base));
+
+    // The buffer is taken from the pool only now that the socket may be ready,
+    // and is given back if no data was received.
+    void* data = buffer_pool_access::acquire(o->pool_);
+    if (!data)
+    {
+      // The read fails for lack of a buffer only if data has arrived, so peek
+      // at the socket to see whether there is anything to read.
+      char peek_data;
+      socket_ops::buf b;
+      socket_ops::init_buf(b, &peek_data, 1);
+      if (!socket_ops::non_blocking_recv(o->socket_, &b, 1,
+            o->flags_ | ASIO_OS_DEF(MSG_PEEK),
+            (o->state_ & socket_ops::stream_oriented) != 0,
+            o->ec_, o->bytes_transferred_))
+        return not_done;
+
+      if (!o->ec_)
+        o->ec_ = asio::error::no_buffer_space;
+      o->bytes_transferred_ = 0;
+      return done;
+    }
+
+    socket_ops::buf b;
+    socket_ops::init_buf(b, data, o->pool_.buffer_size());
+
+    status result = socket_ops::non_blocking_recv(o->socket_, &b, 1,
+        o->flags_, (o->state_ & socket_ops::stream_oriented) != 0,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result == done && !o->ec_ && o->bytes_transferred_ > 0)
+      o->data_ = data;
+    else
+      buffer_pool_access::release(o->pool_, data);
+
+    if (result == done)
+      if ((o->state_ & socket_ops::stream_oriented) != 0)
+        if (o->bytes_transferred_ == 0)
+          result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+protected:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  buffer_pool& pool_;
+  socket_base::message_flags flags_;
+
+  // The buffer holding the received data, if any.
+  void* data_;
+};
+
+template <typename Handler, typename IoExecutor>
+class reactive_socket_recv_pooled_op :
+  public reactive_socket_recv_pooled_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_pooled_op);
+
+  reactive_socket_recv_pooled_op(socket_type socket,
+      socket_ops::state_type state, buffer_pool& pool,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_recv_pooled_op_base(socket, state, pool,
+        flags, &reactive_socket_recv_pooled_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_recv_pooled_op* o(
+        static_cast<reactive_socket_recv_pooled_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here. The received data is owned by the bound
+    // pooled_buffer, which returns it to the pool if no upcall is made.
+    detail::move_binder2<Handler, asio::error_code, pooled_buffer>
+      handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+          buffer_pool_access::make_buffer(o->pool_,
+            o->data_, o->bytes_transferred_));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_.size()));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_POOLED_OP_HPP
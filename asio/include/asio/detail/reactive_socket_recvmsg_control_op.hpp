@@ -0,0 +1,188 @@
+//
+// detail/reactive_socket_recvmsg_control_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECVMSG_CONTROL_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECVMSG_CONTROL_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/ancillary_data.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/held_error_queue.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence, typename Endpoint>
+class reactive_socket_recvmsg_control_op_base : public reactor_op
+{
+public:
+  reactive_socket_recvmsg_control_op_base(socket_type socket,
+      socket_ops::state_type state, const MutableBufferSequence& buffers,
+      Endpoint* sender_endpoint, ancillary_data& control,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(&reactive_socket_recvmsg_control_op_base::do_perform,
+        complete_func),
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+      held_errors_(0),
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+      socket_(socket),
+      state_(state),
+      buffers_(buffers),
+      sender_endpoint_(sender_endpoint),
+      control_(control),
+      flags_(flags)
+  {
+    ancillary_data_access::set_received(control_, 0, 0);
+  }
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Entries taken from the error queue by the reactor, which a read of the
+  // error queue receives before reading from the socket.
+  held_error_queue* held_errors_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recvmsg_control_op_base* o(
+        static_cast<reactive_socket_recvmsg_control_op_base*>(base));
+
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(o->buffers_);
+
+    std::size_t addr_len = o->sender_endpoint_
+      ? o->sender_endpoint_->capacity() : 0;
+    std::size_t control_len = ancillary_data_access::capacity(o->control_);
+    int out_flags = 0;
+    status result = not_done;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    if (o->held_errors_ && o->held_errors_->pop(bufs.buffers(), bufs.count(),
+          o->sender_endpoint_ ? o->sender_endpoint_->data() : 0, &addr_len,
+          ancillary_data_access::data(o->control_), &control_len, out_flags,
+          o->bytes_transferred_))
+    {
+      o->ec_ = asio::error_code();
+      result = done;
+    }
+    else
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+    result = socket_ops::non_blocking_recvmsg_control(o->socket_,
+        bufs.buffers(), bufs.count(), o->flags_,
+        (o->state_ & socket_ops::stream_oriented) != 0,
+        o->sender_endpoint_ ? o->sender_endpoint_->data() : 0, &addr_len,
+        ancillary_data_access::data(o->control_), &control_len, out_flags,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result && !o->ec_)
+    {
+      if (o->sender_endpoint_)
+        o->sender_endpoint_->resize(addr_len);
+      ancillary_data_access::set_received(o->control_,
+          control_len, out_flags);
+    }
+
+    if (result == done)
+      if ((o->state_ & socket_ops::stream_oriented) != 0)
+        if (o->bytes_transferred_ == 0)
+          result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recvmsg_control",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  MutableBufferSequence buffers_;
+  Endpoint* sender_endpoint_;
+  ancillary_data& control_;
+  socket_base::message_flags flags_;
+};
+
+template <typename MutableBufferSequence, typename Endpoint,
+    typename Handler, typename IoExecutor>
+class reactive_socket_recvmsg_control_op :
+  public reactive_socket_recvmsg_control_op_base<
+    MutableBufferSequence, Endpoint>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recvmsg_control_op);
+
+  reactive_socket_recvmsg_control_op(socket_type socket,
+      socket_ops::state_type state, const MutableBufferSequence& buffers,
+      Endpoint* sender_endpoint, ancillary_data& control,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_recvmsg_control_op_base<
+        MutableBufferSequence, Endpoint>(socket, state, buffers,
+          sender_endpoint, control, flags,
+          &reactive_socket_recvmsg_control_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_recvmsg_control_op* o(
+        static_cast<reactive_socket_recvmsg_control_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECVMSG_CONTROL_OP_HPP
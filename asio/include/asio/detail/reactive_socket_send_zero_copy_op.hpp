@@ -0,0 +1,203 @@
+//
+// detail/reactive_socket_send_zero_copy_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_zero_copy_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename ConstBufferSequence>
+class reactive_socket_send_zero_copy_op_base : public reactor_zero_copy_op
+{
+public:
+  reactive_socket_send_zero_copy_op_base(socket_type socket,
+      socket_ops::state_type state, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_zero_copy_op(
+        &reactive_socket_send_zero_copy_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      buffers_(buffers),
+      flags_(flags)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_send_zero_copy_op_base* o(
+        static_cast<reactive_socket_send_zero_copy_op_base*>(base));
+
+    // Keep sending until all of the data has been sent. The buffers are not
+    // copied into the kernel, so they are sent directly from their original
+    // location rather than being coalesced.
+    for (;;)
+    {
+      socket_ops::buf bufs[buffer_sequence_adapter_base::max_buffers];
+      std::size_t count = gather(asio::buffer_sequence_begin(o->buffers_),
+          asio::buffer_sequence_end(o->buffers_),
+          o->bytes_transferred_, bufs);
+      if (count == 0)
+      {
+        o->ec_ = asio::error_code();
+        break;
+      }
+
+      int flags = o->flags_;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+      bool zero_copy = (o->state_ & socket_ops::zero_copy_enabled) != 0;
+      if (zero_copy)
+        flags |= MSG_ZEROCOPY;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+      signed_size_type bytes = socket_ops::send(
+          o->socket_, bufs, count, flags, o->ec_);
+
+      // Retry operation if interrupted by signal.
+      if (o->ec_ == asio::error::interrupted)
+        continue;
+
+      // Check if we need to run the operation again.
+      if (o->ec_ == asio::error::would_block
+          || o->ec_ == asio::error::try_again)
+        return not_done;
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+      // The kernel fails zero-copy sends when it cannot allocate the memory
+      // needed to track them, in which case the data is sent by copying.
+      if (zero_copy && o->ec_ == asio::error::no_buffer_space)
+      {
+        o->state_ &= ~socket_ops::zero_copy_enabled;
+        continue;
+      }
+
+      if (zero_copy && bytes > 0)
+        ++o->zero_copy_sends_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+      if (bytes <= 0)
+        break;
+
+      o->bytes_transferred_ += bytes;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_send_zero_copy",
+          o->ec_, o->bytes_transferred_));
+
+    return o->zero_copy_sends_ > 0 ? done_pending_release : done;
+  }
+
+private:
+  // Fill the native buffers with the data following the given offset.
+  template <typename Iterator>
+  static std::size_t gather(Iterator begin, Iterator end,
+      std::size_t offset, socket_ops::buf* bufs)
+  {
+    std::size_t count = 0;
+    for (Iterator iter = begin; iter != end
+        && count < buffer_sequence_adapter_base::max_buffers; ++iter)
+    {
+      asio::const_buffer buffer(*iter);
+      if (offset >= buffer.size())
+      {
+        offset -= buffer.size();
+        continue;
+      }
+      buffer += offset;
+      offset = 0;
+      socket_ops::init_buf(bufs[count++], buffer.data(), buffer.size());
+    }
+    return count;
+  }
+
+  socket_type socket_;
+  socket_ops::state_type state_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+};
+
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class reactive_socket_send_zero_copy_op :
+  public reactive_socket_send_zero_copy_op_base<ConstBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_zero_copy_op);
+
+  reactive_socket_send_zero_copy_op(socket_type socket,
+      socket_ops::state_type state, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_send_zero_copy_op_base<ConstBufferSequence>(socket,
+        state, buffers, flags, &reactive_socket_send_zero_copy_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_send_zero_copy_op* o(
+        static_cast<reactive_socket_send_zero_copy_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
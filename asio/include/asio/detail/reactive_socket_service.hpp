@@ -19,6 +19,7 @@
 
 #if !defined(ASIO_HAS_IOCP)
 
+#include "asio/ancillary_data.hpp"
 #include "asio/buffer.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
@@ -29,8 +30,15 @@
 #include "asio/detail/reactive_null_buffers_op.hpp"
 #include "asio/detail/reactive_socket_accept_op.hpp"
 #include "asio/detail/reactive_socket_connect_op.hpp"
+#include "asio/detail/mmsg_adapter.hpp"
 #include "asio/detail/reactive_socket_recvfrom_op.hpp"
+#include "asio/detail/reactive_socket_recvfrom_segments_op.hpp"
+#include "asio/detail/reactive_socket_recvmmsg_op.hpp"
+#include "asio/detail/reactive_socket_recvmsg_control_op.hpp"
+#include "asio/detail/reactive_socket_sendmmsg_op.hpp"
+#include "asio/detail/reactive_socket_sendmsg_control_op.hpp"
 #include "asio/detail/reactive_socket_sendto_op.hpp"
+#include "asio/detail/reactive_socket_sendto_segments_op.hpp"
 #include "asio/detail/reactive_socket_service_base.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -286,6 +294,87 @@ public:
     p.v = p.p = 0;
   }
 
+  // Send a batch of datagrams, each to the corresponding endpoint. Returns the
+  // number of datagrams sent.
+  size_t send_many(implementation_type& impl, const const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    mmsg_adapter<endpoint_type> msgs(buffers, destinations, count);
+
+    return socket_ops::sync_sendmmsg(impl.socket_, impl.state_,
+        msgs.msgs(), msgs.count(), flags, ec);
+  }
+
+  // Start an asynchronous send of a batch of datagrams. The buffers, the data
+  // and the endpoints must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Handler, typename IoExecutor>
+  void async_send_many(implementation_type& impl,
+      const const_buffer* buffers, const endpoint_type* destinations,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        destinations, count, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_many"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+
+  // Send a datagram payload to the specified endpoint, to be divided into
+  // datagrams of the given segment size. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  size_t send_segments_to(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type& destination,
+      std::size_t segment_size, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return socket_ops::sync_sendto_segments(impl.socket_, impl.state_,
+        bufs.buffers(), bufs.count(), flags,
+        destination.data(), destination.size(), segment_size, ec);
+  }
+
+  // Start an asynchronous send of a payload to be divided into datagrams of
+  // the given segment size. The data being sent must be valid for the lifetime
+  // of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_segments_to(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type& destination,
+      std::size_t segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendto_segments_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        destination, segment_size, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_segments_to"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -382,6 +471,242 @@ public:
     p.v = p.p = 0;
   }
 
+  // Receive a batch of datagrams, storing the size and sender of each. Returns
+  // the number of datagrams received.
+  size_t receive_many(implementation_type& impl,
+      const mutable_buffer* buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    mmsg_adapter<endpoint_type> msgs(buffers, sender_endpoints, count);
+
+    std::size_t msgs_recvd = socket_ops::sync_recvmmsg(impl.socket_,
+        impl.state_, msgs.msgs(), msgs.count(), flags, ec);
+
+    if (!ec)
+      msgs.complete_receive(msgs_recvd, sender_endpoints, sizes);
+
+    return msgs_recvd;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. The buffers, the
+  // sender endpoints and the sizes must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_many(implementation_type& impl,
+      const mutable_buffer* buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        sender_endpoints, sizes, count, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_many"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+
+  // Receive a payload of one or more coalesced datagrams, storing the size of
+  // each datagram in segment_size. Returns the number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t receive_segments_from(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    std::size_t addr_len = sender_endpoint.capacity();
+    std::size_t bytes_recvd = socket_ops::sync_recvfrom_segments(
+        impl.socket_, impl.state_, bufs.buffers(), bufs.count(),
+        flags, sender_endpoint.data(), &addr_len, &segment_size, ec);
+
+    if (!ec)
+      sender_endpoint.resize(addr_len);
+
+    return bytes_recvd;
+  }
+
+  // Start an asynchronous receive of a payload of one or more coalesced
+  // datagrams. The buffer for the data being received, the sender_endpoint
+  // and the segment_size must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_segments_from(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvfrom_segments_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        sender_endpoint, segment_size, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_segments_from"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+
+  // Receive data together with any ancillary data, and optionally the endpoint
+  // of the sender. Returns the number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t receive_msg(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+      ancillary_data& control, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    std::size_t addr_len = sender_endpoint ? sender_endpoint->capacity() : 0;
+    std::size_t control_len = ancillary_data_access::capacity(control);
+    int out_flags = 0;
+    std::size_t bytes_recvd = 0;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    held_error_queue* held = (flags & socket_base::message_error_queue)
+      ? reactor_.held_errors(impl.reactor_data_) : 0;
+    if (held && held->pop(bufs.buffers(), bufs.count(),
+          sender_endpoint ? sender_endpoint->data() : 0, &addr_len,
+          ancillary_data_access::data(control), &control_len, out_flags,
+          bytes_recvd))
+      ec = asio::error_code();
+    else
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+    bytes_recvd = socket_ops::sync_recvmsg_control(
+        impl.socket_, receive_msg_state(impl, flags),
+        bufs.buffers(), bufs.count(), flags,
+        sender_endpoint ? sender_endpoint->data() : 0, &addr_len,
+        ancillary_data_access::data(control), &control_len, out_flags,
+        bufs.all_empty(), ec);
+
+    if (!ec && sender_endpoint)
+      sender_endpoint->resize(addr_len);
+    ancillary_data_access::set_received(control,
+        ec ? 0 : control_len, ec ? 0 : out_flags);
+
+    return bytes_recvd;
+  }
+
+  // Start an asynchronous receive of data together with any ancillary data.
+  // The buffer for the data being received, the sender_endpoint and the
+  // ancillary data storage must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_msg(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+      ancillary_data& control, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmsg_control_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    socket_ops::state_type state = receive_msg_state(impl, flags);
+    p.p = new (p.v) op(impl.socket_, state, buffers,
+        sender_endpoint, control, flags, handler, io_ex);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    if (flags & socket_base::message_error_queue)
+      p.p->held_errors_ = reactor_.held_errors(impl.reactor_data_);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_msg"));
+
+    // Queued errors are signalled as an error condition on the socket, rather
+    // than as readability.
+    start_op(impl,
+        (flags & (socket_base::message_out_of_band
+            | socket_base::message_error_queue))
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation,
+        (flags & socket_base::message_out_of_band) == 0,
+        ((state & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
+  // Send data together with ancillary data, optionally to the specified
+  // endpoint. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  size_t send_msg(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destination,
+      const ancillary_data& control, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return socket_ops::sync_sendmsg_control(impl.socket_, impl.state_,
+        bufs.buffers(), bufs.count(), flags,
+        destination ? destination->data() : 0,
+        destination ? destination->size() : 0,
+        control.data().data(), control.data().size(),
+        bufs.all_empty(), ec);
+  }
+
+  // Start an asynchronous send of data together with ancillary data. The data
+  // being sent and the ancillary data storage must be valid for the lifetime
+  // of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_msg(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destination,
+      const ancillary_data& control, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmsg_control_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        destination, control.data(), flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_msg"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && control.empty()
+          && buffer_sequence_adapter<asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type& impl,
@@ -493,6 +818,19 @@ public:
         peer_endpoint.data(), peer_endpoint.size());
     p.v = p.p = 0;
   }
+
+private:
+  // Get the state to use for a receive with ancillary data. Reads from the
+  // error queue are not part of the stream, so an empty read is not the end
+  // of the stream.
+  static socket_ops::state_type receive_msg_state(
+      const implementation_type& impl, socket_base::message_flags flags)
+  {
+    socket_ops::state_type state = impl.state_;
+    if (flags & socket_base::message_error_queue)
+      state &= ~socket_ops::stream_oriented;
+    return state;
+  }
 };
 
 } // namespace detail
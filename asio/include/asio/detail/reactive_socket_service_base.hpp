@@ -21,15 +21,21 @@
   && !defined(ASIO_WINDOWS_RUNTIME)
 
 #include "asio/buffer.hpp"
+#include "asio/buffer_pool.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/io_uring_socket_recv_op.hpp"
+#include "asio/detail/io_uring_socket_send_op.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
 #include "asio/detail/reactive_socket_recv_op.hpp"
+#include "asio/detail/reactive_socket_recv_pooled_op.hpp"
 #include "asio/detail/reactive_socket_recvmsg_op.hpp"
 #include "asio/detail/reactive_socket_send_op.hpp"
+#include "asio/detail/reactive_socket_send_zero_copy_op.hpp"
 #include "asio/detail/reactive_wait_op.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -59,6 +65,11 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if defined(ASIO_HAS_IO_URING)
+    // Per-I/O object data used by the io_uring service.
+    io_uring_service::per_io_object_data io_object_data_;
+#endif // defined(ASIO_HAS_IO_URING)
   };
 
   // Constructor.
@@ -264,6 +275,29 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_socket_send_op<
+          ConstBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(impl.socket_, io_uring_op_state(impl),
+          buffers, flags, handler, io_ex);
+
+      ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+            &impl, impl.socket_, "async_send"));
+
+      start_io_uring_op(impl, io_uring_service::write_op, p.p, is_continuation,
+          ((impl.state_ & socket_ops::stream_oriented)
+            && buffer_sequence_adapter<asio::const_buffer,
+              ConstBufferSequence>::all_empty(buffers)));
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_send_op<
         ConstBufferSequence, Handler, IoExecutor> op;
@@ -303,6 +337,38 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous send of all of the data, without copying it into the
+  // kernel where supported. The operation completes once the kernel no longer
+  // refers to the data. It always uses the reactor, as the release of the data
+  // is notified through the socket's error queue.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    enable_zero_copy(impl);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zero_copy_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_,
+        buffers, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_zero_copy"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
   // Receive some data from the peer. Returns the number of bytes received.
   template <typename MutableBufferSequence>
   size_t receive(base_implementation_type& impl,
@@ -337,6 +403,32 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+#if defined(ASIO_HAS_IO_URING)
+    if (io_uring_service_.is_enabled())
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_socket_recv_op<
+          MutableBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(impl.socket_, io_uring_op_state(impl),
+          buffers, flags, handler, io_ex);
+
+      ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+            &impl, impl.socket_, "async_receive"));
+
+      start_io_uring_op(impl,
+          (flags & socket_base::message_out_of_band)
+            ? io_uring_service::except_op : io_uring_service::read_op,
+          p.p, is_continuation,
+          ((impl.state_ & socket_ops::stream_oriented)
+            && buffer_sequence_adapter<asio::mutable_buffer,
+              MutableBufferSequence>::all_empty(buffers)));
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(ASIO_HAS_IO_URING)
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_recv_op<
         MutableBufferSequence, Handler, IoExecutor> op;
@@ -384,6 +476,38 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_MOVE)
+  // Start an asynchronous receive into a buffer taken from a pool. The buffer
+  // is taken only when the socket is ready to be read. The operation always
+  // waits for readiness using the reactor, as the buffer must be chosen before
+  // an io_uring receive could be submitted.
+  template <typename Handler, typename IoExecutor>
+  void async_receive(base_implementation_type& impl,
+      buffer_pool& pool, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_pooled_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_,
+        pool, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive(buffer_pool)"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation,
+        (flags & socket_base::message_out_of_band) == 0, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -486,10 +610,32 @@ protected:
       base_implementation_type& impl, int type,
       const native_handle_type& native_socket, asio::error_code& ec);
 
+  // Enable zero-copy sends on the socket, if they are supported.
+  ASIO_DECL void enable_zero_copy(base_implementation_type& impl);
+
   // Start the asynchronous read or write operation.
   ASIO_DECL void start_op(base_implementation_type& impl, int op_type,
       reactor_op* op, bool is_continuation, bool is_non_blocking, bool noop);
 
+#if defined(ASIO_HAS_IO_URING)
+  // Get the state to be captured by an io_uring operation. When the kernel
+  // can poll internally the operation is submitted directly, regardless of
+  // whether the socket is in non-blocking mode.
+  socket_ops::state_type io_uring_op_state(
+      const base_implementation_type& impl) const
+  {
+    if (io_uring_service_.supports_fast_poll())
+      return static_cast<socket_ops::state_type>(
+          impl.state_ & ~socket_ops::non_blocking);
+    return static_cast<socket_ops::state_type>(
+        impl.state_ | socket_ops::internal_non_blocking);
+  }
+
+  // Start the asynchronous read or write operation using io_uring.
+  ASIO_DECL void start_io_uring_op(base_implementation_type& impl,
+      int op_type, io_uring_operation* op, bool is_continuation, bool noop);
+#endif // defined(ASIO_HAS_IO_URING)
+
   // Start the asynchronous accept operation.
   ASIO_DECL void start_accept_op(base_implementation_type& impl,
       reactor_op* op, bool is_continuation, bool peer_is_open);
@@ -501,6 +647,11 @@ protected:
 
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
+
+#if defined(ASIO_HAS_IO_URING)
+  // The io_uring service used for reads and writes.
+  io_uring_service& io_uring_service_;
+#endif // defined(ASIO_HAS_IO_URING)
 };
 
 } // namespace detail
@@ -34,8 +34,10 @@ public:
   std::size_t bytes_transferred_;
 
   // Status returned by perform function. May be used to decide whether it is
-  // worth performing more operations on the descriptor immediately.
-  enum status { not_done, done, done_and_exhausted };
+  // worth performing more operations on the descriptor immediately. The
+  // done_pending_release status is returned only by a reactor_zero_copy_op
+  // that must wait for the kernel to release its buffers before completing.
+  enum status { not_done, done, done_and_exhausted, done_pending_release };
 
   // Perform the operation. Returns true if it is finished.
   status perform()
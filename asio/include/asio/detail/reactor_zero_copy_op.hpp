@@ -0,0 +1,77 @@
+//
+// detail/reactor_zero_copy_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTOR_ZERO_COPY_OP_HPP
+#define ASIO_DETAIL_REACTOR_ZERO_COPY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/reactor_op.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A reactor operation that sends data without copying it into the kernel. The
+// kernel identifies each such send by a sequence number, and notifies the
+// release of ranges of sends through the socket's error queue. Once its sends
+// are complete the operation returns done_pending_release, and the reactor
+// holds it until all of its sends have been released.
+class reactor_zero_copy_op
+  : public reactor_op
+{
+public:
+  // The number of zero-copy sends made by the operation.
+  uint32_t zero_copy_sends_;
+
+  // The sequence number of the operation's first zero-copy send, and the
+  // number of its sends not yet released. Assigned by the reactor once the
+  // operation has finished sending.
+  uint32_t zero_copy_first_;
+  uint32_t zero_copy_pending_;
+
+  // Record the release of the sends in the inclusive range [first, last].
+  // Returns true when all of the operation's sends have been released.
+  bool release(uint32_t first, uint32_t last)
+  {
+    // Sequence numbers wrap, so compare them relative to our first send.
+    int32_t lo = static_cast<int32_t>(first - zero_copy_first_);
+    int32_t hi = static_cast<int32_t>(last - zero_copy_first_);
+    if (lo < 0)
+      lo = 0;
+    if (hi > static_cast<int32_t>(zero_copy_sends_) - 1)
+      hi = static_cast<int32_t>(zero_copy_sends_) - 1;
+    if (hi >= lo)
+      zero_copy_pending_ -= static_cast<uint32_t>(hi - lo + 1);
+    return zero_copy_pending_ == 0;
+  }
+
+protected:
+  reactor_zero_copy_op(perform_func_type perform_func,
+      func_type complete_func)
+    : reactor_op(perform_func, complete_func),
+      zero_copy_sends_(0),
+      zero_copy_first_(0),
+      zero_copy_pending_(0)
+  {
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTOR_ZERO_COPY_OP_HPP
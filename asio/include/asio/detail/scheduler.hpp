@@ -19,6 +19,7 @@
 
 #include "asio/error_code.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/memory_resource.hpp"
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
@@ -43,9 +44,11 @@ public:
   typedef scheduler_operation operation;
 
   // Constructor. Specifies the number of concurrent threads that are likely to
-  // run the scheduler. If set to 1 certain optimisation are performed.
+  // run the scheduler. If set to 1 certain optimisation are performed. Memory
+  // for operations is allocated from the given resource, if any.
   ASIO_DECL scheduler(asio::execution_context& ctx,
-      int concurrency_hint = 0, bool own_thread = true);
+      int concurrency_hint = 0, bool own_thread = true,
+      memory_resource* resource = 0);
 
   // Destructor.
   ASIO_DECL ~scheduler();
@@ -131,6 +134,18 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the number of units of outstanding work.
+  std::size_t outstanding_work() const
+  {
+    return static_cast<std::size_t>(outstanding_work_);
+  }
+
+  // Get the memory resource used for internal allocations, if any.
+  memory_resource* get_memory_resource() const
+  {
+    return memory_resource_;
+  }
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -153,6 +168,48 @@ private:
   ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const asio::error_code& ec);
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // Run at most one operation using the per-thread queues. A negative timeout
+  // blocks, a zero timeout polls. Only used when work stealing is enabled.
+  ASIO_DECL std::size_t do_work_stealing_one(thread_info& this_thread,
+      long usec, const asio::error_code& ec);
+
+  // Find an operation on the per-thread queues, trying the calling thread's
+  // own queue first and then stealing from the others.
+  ASIO_DECL operation* dequeue_work_stealing(thread_info& this_thread);
+
+  // Enqueue an operation on the calling thread's queue, or on another thread's
+  // inbox if the calling thread has no queue, then wake an idle thread.
+  ASIO_DECL void enqueue_work_stealing(operation* op);
+
+  // Enqueue a list of operations as for enqueue_work_stealing.
+  ASIO_DECL void enqueue_work_stealing(op_queue<operation>& ops);
+
+  // Wake a single idle thread, if there is one, so that it looks for work.
+  ASIO_DECL void wake_idle_thread();
+
+  // Enqueue an operation on the lock-free queue, and interrupt the task if the
+  // queue was previously empty. Only used when lock-free posting is enabled.
+  ASIO_DECL void post_lock_free(operation* op);
+
+  // Enqueue a list of operations as for post_lock_free.
+  ASIO_DECL void post_lock_free(op_queue<operation>& ops);
+
+  // Wake the thread running the scheduler after a lock-free post or stop.
+  ASIO_DECL void interrupt_lock_free();
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+  // Move operations posted without locking on to the main queue, and apply any
+  // stop requested by another thread. Must be called with the lock held.
+  void take_lock_free_posts()
+  {
+    if (lock_free_post_)
+      do_take_lock_free_posts();
+  }
+
+  // Out-of-line part of take_lock_free_posts.
+  ASIO_DECL void do_take_lock_free_posts();
+
   // Stop the task and all idle threads.
   ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -172,6 +229,27 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // State used when work stealing is enabled.
+  struct work_stealing_state;
+
+  // State used when lock-free posting is enabled.
+  struct lock_free_post_state;
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // Helper class to claim and release a per-thread queue.
+  struct shard_claim;
+  friend struct shard_claim;
+
+  // Helper class to perform work stealing task-related operations on block
+  // exit.
+  struct work_stealing_task_cleanup;
+  friend struct work_stealing_task_cleanup;
+
+  // Helper class to call work stealing work-related operations on block exit.
+  struct work_stealing_cleanup;
+  friend struct work_stealing_cleanup;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -208,6 +286,16 @@ private:
   // The concurrency hint used to initialise the scheduler.
   const int concurrency_hint_;
 
+  // The memory resource used for internal allocations, if any.
+  memory_resource* const memory_resource_;
+
+  // The per-thread queues, if work stealing is enabled.
+  work_stealing_state* work_stealing_;
+
+  // The queue of operations posted from other threads, if lock-free posting
+  // is enabled.
+  lock_free_post_state* lock_free_post_;
+
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
 };
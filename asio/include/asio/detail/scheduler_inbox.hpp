@@ -0,0 +1,130 @@
+//
+// detail/scheduler_inbox.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SCHEDULER_INBOX_HPP
+#define ASIO_DETAIL_SCHEDULER_INBOX_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A lock-free intrusive queue of operations that may be pushed by any number
+// of threads. Operations are linked through their own next pointers into a
+// stack, which is taken as a whole and reversed by the consumer, so there is
+// no allocation and a push is a single compare-and-swap.
+class scheduler_inbox
+  : private noncopyable
+{
+public:
+  typedef scheduler_operation operation;
+
+  // Constructor.
+  scheduler_inbox()
+    : head_(0)
+  {
+  }
+
+  // Add an operation to the inbox. May be called by any thread. Returns true
+  // if the inbox was previously empty.
+  bool push(operation* op)
+  {
+    operation* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(op, head);
+    } while (!head_.compare_exchange_weak(head, op,
+          std::memory_order_seq_cst, std::memory_order_relaxed));
+    return head == 0;
+  }
+
+  // Add a list of operations to the inbox, preserving their order. May be
+  // called by any thread. Returns true if the inbox was previously empty.
+  bool push(op_queue<operation>& ops)
+  {
+    operation* first = 0;
+    operation* last = 0;
+    while (operation* op = ops.front())
+    {
+      ops.pop();
+      op_queue_access::next(op, first);
+      first = op;
+      if (!last)
+        last = op;
+    }
+
+    if (!first)
+      return false;
+
+    operation* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(last, head);
+    } while (!head_.compare_exchange_weak(head, first,
+          std::memory_order_seq_cst, std::memory_order_relaxed));
+    return head == 0;
+  }
+
+  // Remove all operations from the inbox, in the order they were added. May be
+  // called by any thread.
+  void take(op_queue<operation>& ops)
+  {
+    operation* op = head_.exchange(0, std::memory_order_acquire);
+
+    // The inbox is a stack, so reverse it to restore posting order.
+    operation* reversed = 0;
+    while (op)
+    {
+      operation* next = op_queue_access::next(op);
+      op_queue_access::next(op, reversed);
+      reversed = op;
+      op = next;
+    }
+
+    while (reversed)
+    {
+      operation* next = op_queue_access::next(reversed);
+      ops.push(reversed);
+      reversed = next;
+    }
+  }
+
+  // Determine whether the inbox has any operations queued.
+  bool empty() const
+  {
+    return head_.load(std::memory_order_seq_cst) == 0;
+  }
+
+private:
+  // Operations posted to the inbox, most recent first.
+  std::atomic<operation*> head_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#endif // ASIO_DETAIL_SCHEDULER_INBOX_HPP
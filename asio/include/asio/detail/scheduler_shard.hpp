@@ -0,0 +1,160 @@
+//
+// detail/scheduler_shard.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SCHEDULER_SHARD_HPP
+#define ASIO_DETAIL_SCHEDULER_SHARD_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/scheduler_inbox.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A per-thread run queue used by the scheduler when work stealing is enabled.
+//
+// The queue is a bounded ring buffer. Only the owning thread pushes on to the
+// tail, while the owner and any other thread may pop from the head, so
+// operations are run in the order in which they were posted regardless of
+// which thread runs them. Operations posted by threads that do not own a shard
+// go on to a lock-free intrusive inbox, which is taken as a whole by whichever
+// thread next drains it.
+class scheduler_shard
+  : private noncopyable
+{
+public:
+  typedef scheduler_operation operation;
+
+  // The number of operations that fit in the ring buffer.
+  enum { capacity = 256 };
+
+  // Constructor.
+  scheduler_shard()
+    : owned_(false),
+      head_(0),
+      tail_(0)
+  {
+    for (std::size_t i = 0; i < capacity; ++i)
+      buffer_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // Attempt to become the owner of the shard. Returns false if another thread
+  // already owns it.
+  bool try_claim()
+  {
+    bool expected = false;
+    return owned_.compare_exchange_strong(expected, true,
+        std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  // Give up ownership of the shard.
+  void release()
+  {
+    owned_.store(false, std::memory_order_release);
+  }
+
+  // Add an operation to the tail of the queue. Must only be called by the
+  // owning thread. Returns false if the queue is full.
+  bool push(operation* op)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    std::size_t head = head_.load(std::memory_order_acquire);
+    if (tail - head >= capacity)
+      return false;
+    buffer_[tail % capacity].store(op, std::memory_order_relaxed);
+    tail_.store(tail + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // Remove an operation from the head of the queue. May be called by any
+  // thread. Returns 0 if the queue is empty.
+  operation* pop()
+  {
+    std::size_t head = head_.load(std::memory_order_acquire);
+    for (;;)
+    {
+      std::size_t tail = tail_.load(std::memory_order_acquire);
+      if (tail == head)
+        return 0;
+      operation* op = buffer_[head % capacity].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, head + 1,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+        return op;
+    }
+  }
+
+  // Add an operation to the inbox. May be called by any thread.
+  void push_inbox(operation* op)
+  {
+    inbox_.push(op);
+  }
+
+  // Remove all operations from the inbox, in the order they were added. May be
+  // called by any thread.
+  void take_inbox(op_queue<operation>& ops)
+  {
+    inbox_.take(ops);
+  }
+
+  // Determine whether the shard has any operations queued.
+  bool has_work() const
+  {
+    return tail_.load(std::memory_order_seq_cst)
+      != head_.load(std::memory_order_seq_cst)
+      || !inbox_.empty();
+  }
+
+private:
+  // Whether a thread currently owns the shard.
+  std::atomic<bool> owned_;
+
+  // Keep the ends of the queue on separate cache lines.
+  char pad1_[64];
+
+  // The position of the next operation to be popped.
+  std::atomic<std::size_t> head_;
+
+  char pad2_[64];
+
+  // The position at which the next operation will be pushed.
+  std::atomic<std::size_t> tail_;
+
+  char pad3_[64];
+
+  // Operations posted from other threads.
+  scheduler_inbox inbox_;
+
+  char pad4_[64];
+
+  // The ring buffer of queued operations.
+  std::atomic<operation*> buffer_[capacity];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#endif // ASIO_DETAIL_SCHEDULER_SHARD_HPP
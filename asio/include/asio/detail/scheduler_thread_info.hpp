@@ -25,11 +25,13 @@ namespace detail {
 
 class scheduler;
 class scheduler_operation;
+class scheduler_shard;
 
 struct scheduler_thread_info : public thread_info_base
 {
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+  scheduler_shard* shard;
 };
 
 } // namespace detail
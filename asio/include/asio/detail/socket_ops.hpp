@@ -52,7 +52,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // Zero-copy sends have been enabled on the socket.
+  zero_copy_enabled = 128
 };
 
 typedef unsigned char state_type;
@@ -136,6 +139,18 @@ ASIO_DECL void init_buf(buf& b, void* data, size_t size);
 
 ASIO_DECL void init_buf(buf& b, const void* data, size_t size);
 
+// A single datagram in a batch transferred by recvmmsg or sendmmsg.
+struct mmsg_buf
+{
+  buf data;
+  socket_addr_type* addr;
+  std::size_t addrlen;
+  std::size_t bytes_transferred;
+};
+
+// The maximum number of datagrams transferred by a single batch.
+const std::size_t max_mmsg_count = 64;
+
 ASIO_DECL signed_size_type recv(socket_type s, buf* bufs,
     size_t count, int flags, asio::error_code& ec);
 
@@ -179,6 +194,20 @@ ASIO_DECL bool non_blocking_recvfrom(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+ASIO_DECL signed_size_type recvfrom_segments(socket_type s, buf* bufs,
+    size_t count, int flags, socket_addr_type* addr, std::size_t* addrlen,
+    std::size_t* segment_size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_recvfrom_segments(socket_type s, state_type state,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size,
+    asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recvfrom_segments(socket_type s,
+    buf* bufs, size_t count, int flags,
+    socket_addr_type* addr, std::size_t* addrlen, std::size_t* segment_size,
+    asio::error_code& ec, size_t& bytes_transferred);
+
 ASIO_DECL signed_size_type recvmsg(socket_type s, buf* bufs,
     size_t count, int in_flags, int& out_flags,
     asio::error_code& ec);
@@ -201,6 +230,32 @@ ASIO_DECL bool non_blocking_recvmsg(socket_type s,
 
 #endif // defined(ASIO_HAS_IOCP)
 
+ASIO_DECL signed_size_type recvmmsg(socket_type s, mmsg_buf* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL size_t sync_recvmmsg(socket_type s, state_type state,
+    mmsg_buf* msgs, size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    mmsg_buf* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred);
+
+ASIO_DECL signed_size_type recvmsg_control(socket_type s, buf* bufs,
+    size_t count, int in_flags, socket_addr_type* addr, std::size_t* addrlen,
+    void* control, std::size_t* control_len, int& out_flags,
+    asio::error_code& ec);
+
+ASIO_DECL size_t sync_recvmsg_control(socket_type s, state_type state,
+    buf* bufs, size_t count, int in_flags, socket_addr_type* addr,
+    std::size_t* addrlen, void* control, std::size_t* control_len,
+    int& out_flags, bool all_empty, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recvmsg_control(socket_type s,
+    buf* bufs, size_t count, int in_flags, bool is_stream,
+    socket_addr_type* addr, std::size_t* addrlen, void* control,
+    std::size_t* control_len, int& out_flags,
+    asio::error_code& ec, size_t& bytes_transferred);
+
 ASIO_DECL signed_size_type send(socket_type s, const buf* bufs,
     size_t count, int flags, asio::error_code& ec);
 
@@ -239,6 +294,46 @@ ASIO_DECL bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+ASIO_DECL signed_size_type sendto_segments(socket_type s, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendto_segments(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendto_segments(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* addr, std::size_t addrlen,
+    std::size_t segment_size, asio::error_code& ec,
+    size_t& bytes_transferred);
+
+ASIO_DECL signed_size_type sendmmsg(socket_type s, mmsg_buf* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendmmsg(socket_type s, state_type state,
+    mmsg_buf* msgs, size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    mmsg_buf* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred);
+
+ASIO_DECL signed_size_type sendmsg_control(socket_type s, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, const void* control, std::size_t control_len,
+    asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendmsg_control(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, const void* control, std::size_t control_len,
+    bool all_empty, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendmsg_control(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* addr, std::size_t addrlen,
+    const void* control, std::size_t control_len,
+    asio::error_code& ec, size_t& bytes_transferred);
+
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
@@ -81,6 +81,9 @@
 # if !defined(__SYMBIAN32__)
 #  include <netinet/tcp.h>
 # endif
+# if defined(__linux__)
+#  include <netinet/udp.h>
+# endif
 # include <arpa/inet.h>
 # include <netdb.h>
 # include <net/if.h>
@@ -142,6 +145,7 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_MSG_PEEK 0x2
 # define ASIO_OS_DEF_MSG_DONTROUTE 0x4
 # define ASIO_OS_DEF_MSG_EOR 0 // Not supported.
+# define ASIO_OS_DEF_MSG_ERRQUEUE 0 // Not supported.
 # define ASIO_OS_DEF_SHUT_RD 0x0
 # define ASIO_OS_DEF_SHUT_WR 0x1
 # define ASIO_OS_DEF_SHUT_RDWR 0x2
@@ -227,6 +231,7 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_MSG_PEEK MSG_PEEK
 # define ASIO_OS_DEF_MSG_DONTROUTE MSG_DONTROUTE
 # define ASIO_OS_DEF_MSG_EOR 0 // Not supported on Windows.
+# define ASIO_OS_DEF_MSG_ERRQUEUE 0 // Not supported on Windows.
 # define ASIO_OS_DEF_SHUT_RD SD_RECEIVE
 # define ASIO_OS_DEF_SHUT_WR SD_SEND
 # define ASIO_OS_DEF_SHUT_RDWR SD_BOTH
@@ -343,6 +348,11 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_MSG_PEEK MSG_PEEK
 # define ASIO_OS_DEF_MSG_DONTROUTE MSG_DONTROUTE
 # define ASIO_OS_DEF_MSG_EOR MSG_EOR
+# if defined(MSG_ERRQUEUE)
+#  define ASIO_OS_DEF_MSG_ERRQUEUE MSG_ERRQUEUE
+# else
+#  define ASIO_OS_DEF_MSG_ERRQUEUE 0 // Not supported.
+# endif
 # define ASIO_OS_DEF_SHUT_RD SHUT_RD
 # define ASIO_OS_DEF_SHUT_WR SHUT_WR
 # define ASIO_OS_DEF_SHUT_RDWR SHUT_RDWR
@@ -22,7 +22,7 @@
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/scheduler_operation.hpp"
-#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/strand_queue.hpp"
 #include "asio/execution_context.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -44,22 +44,12 @@ public:
   private:
     friend class strand_executor_service;
 
-    // Mutex to protect access to internal data.
-    mutex* mutex_;
-
-    // Indicates whether the strand is currently "locked" by a handler. This
-    // means that there is a handler upcall in progress, or that the strand
-    // itself has been scheduled in order to invoke some pending handlers.
-    bool locked_;
-
-    // Indicates that the strand has been shut down and will accept no further
-    // handlers.
-    bool shutdown_;
-
-    // The handlers that are waiting on the strand but should not be run until
-    // after the next time the strand is scheduled. This queue must only be
-    // modified while the mutex is locked.
-    op_queue<scheduler_operation> waiting_queue_;
+    // The strand's lock, and the handlers that are waiting on the strand but
+    // should not be run until after the next time the strand is scheduled.
+    // The strand is "locked" while there is a handler upcall in progress, or
+    // while the strand itself has been scheduled in order to invoke some
+    // pending handlers.
+    strand_queue<scheduler_operation> queue_;
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
@@ -115,16 +105,6 @@ private:
   // Mutex to protect access to the service-wide state.
   mutex mutex_;
 
-  // Number of mutexes shared between all strand objects.
-  enum { num_mutexes = 193 };
-
-  // Pool of mutexes.
-  scoped_ptr<mutex> mutexes_[num_mutexes];
-
-  // Extra value used when hashing to prevent recycled memory locations from
-  // getting the same mutex.
-  std::size_t salt_;
-
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
 };
@@ -0,0 +1,257 @@
+//
+// detail/strand_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_STRAND_QUEUE_HPP
+#define ASIO_DETAIL_STRAND_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#else // defined(ASIO_HAS_STD_ATOMIC)
+# include "asio/detail/mutex.hpp"
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+
+// The per-strand lock and queue of waiting operations. The whole state is held
+// in a single atomic word, which is null when the strand is unlocked, the
+// address of the queue itself when the strand is locked with no operations
+// waiting, and otherwise points to the most recently added waiting operation.
+// Waiting operations are linked through their own next pointers into a stack
+// that is taken as a whole, and reversed, when the lock holder finishes with
+// its ready operations. No mutex is used.
+template <typename Operation>
+class strand_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  strand_queue()
+    : state_(0),
+      shutdown_(false)
+  {
+  }
+
+  // Destructor destroys any operations that are still waiting.
+  ~strand_queue()
+  {
+    Operation* op = state_.load(std::memory_order_acquire);
+    while (op && op != locked_state())
+    {
+      Operation* next = op_queue_access::next(op);
+      op_queue_access::destroy(op);
+      op = next;
+    }
+  }
+
+  // Try to acquire the lock without adding an operation.
+  bool try_lock()
+  {
+    Operation* expected = 0;
+    return state_.compare_exchange_strong(expected,
+        locked_state(), std::memory_order_acq_rel);
+  }
+
+  // Add an operation. Returns true if the operation acquired the lock, in
+  // which case it is not queued and the caller is responsible for running it
+  // and scheduling the strand. Otherwise the operation waits until the lock
+  // holder next takes the waiting operations. Operations added after shutdown
+  // are destroyed.
+  bool push(Operation* op)
+  {
+    if (shutdown_.load(std::memory_order_acquire))
+    {
+      op_queue_access::destroy(op);
+      return false;
+    }
+
+    Operation* state = state_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      if (state == 0)
+      {
+        if (state_.compare_exchange_weak(state,
+              locked_state(), std::memory_order_acq_rel))
+          return true;
+      }
+      else
+      {
+        op_queue_access::next(op, state == locked_state() ? 0 : state);
+        if (state_.compare_exchange_weak(state,
+              op, std::memory_order_acq_rel))
+          return false;
+      }
+    }
+  }
+
+  // Called by the lock holder once it has finished running ready operations.
+  // Any waiting operations are moved to the ready queue, in the order in which
+  // they were added. The lock is released if the ready queue is then empty.
+  // Returns true if the lock is retained.
+  bool take_or_unlock(op_queue<Operation>& ready)
+  {
+    Operation* state = locked_state();
+    if (ready.empty() && state_.compare_exchange_strong(state,
+          0, std::memory_order_acq_rel))
+      return false;
+
+    Operation* op = state_.exchange(locked_state(), std::memory_order_acq_rel);
+    if (op == locked_state())
+      op = 0;
+
+    // The waiting operations form a stack, so reverse them to restore the
+    // order in which they were added.
+    Operation* reversed = 0;
+    while (op)
+    {
+      Operation* next = op_queue_access::next(op);
+      op_queue_access::next(op, reversed);
+      reversed = op;
+      op = next;
+    }
+
+    while (reversed)
+    {
+      Operation* next = op_queue_access::next(reversed);
+      ready.push(reversed);
+      reversed = next;
+    }
+
+    return true;
+  }
+
+  // Take all waiting operations and prevent any more from being added.
+  void shutdown(op_queue<Operation>& ops)
+  {
+    shutdown_.store(true, std::memory_order_release);
+    Operation* op = state_.exchange(locked_state(), std::memory_order_acq_rel);
+    while (op && op != locked_state())
+    {
+      Operation* next = op_queue_access::next(op);
+      ops.push(op);
+      op = next;
+    }
+  }
+
+private:
+  // The state value used when the strand is locked with nothing waiting.
+  Operation* locked_state()
+  {
+    return reinterpret_cast<Operation*>(this);
+  }
+
+  // The lock and waiting operations.
+  std::atomic<Operation*> state_;
+
+  // Whether the strand has been shut down.
+  std::atomic<bool> shutdown_;
+};
+
+#else // defined(ASIO_HAS_STD_ATOMIC)
+
+// The per-strand lock and queue of waiting operations, protected by a mutex
+// that belongs to the strand alone.
+template <typename Operation>
+class strand_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  strand_queue()
+    : locked_(false),
+      shutdown_(false)
+  {
+  }
+
+  // Try to acquire the lock without adding an operation.
+  bool try_lock()
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (locked_)
+      return false;
+    locked_ = true;
+    return true;
+  }
+
+  // Add an operation. Returns true if the operation acquired the lock.
+  bool push(Operation* op)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (shutdown_)
+    {
+      lock.unlock();
+      op_queue_access::destroy(op);
+      return false;
+    }
+    else if (locked_)
+    {
+      waiting_queue_.push(op);
+      return false;
+    }
+    else
+    {
+      locked_ = true;
+      return true;
+    }
+  }
+
+  // Move waiting operations to the ready queue. The lock is released if the
+  // ready queue is then empty. Returns true if the lock is retained.
+  bool take_or_unlock(op_queue<Operation>& ready)
+  {
+    mutex::scoped_lock lock(mutex_);
+    ready.push(waiting_queue_);
+    locked_ = !ready.empty();
+    return locked_;
+  }
+
+  // Take all waiting operations and prevent any more from being added.
+  void shutdown(op_queue<Operation>& ops)
+  {
+    mutex::scoped_lock lock(mutex_);
+    shutdown_ = true;
+    ops.push(waiting_queue_);
+  }
+
+private:
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // Whether the strand is locked by a handler.
+  bool locked_;
+
+  // Whether the strand has been shut down.
+  bool shutdown_;
+
+  // The operations waiting for the lock.
+  op_queue<Operation> waiting_queue_;
+};
+
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_STRAND_QUEUE_HPP
@@ -17,10 +17,11 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/io_context.hpp"
+#include "asio/detail/memory.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
-#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/strand_queue.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -38,6 +39,9 @@ private:
   // Helper class to re-post the strand on exit.
   struct on_dispatch_exit;
 
+  // The list of all implementations.
+  struct impl_list;
+
 public:
 
   // The underlying implementation of a strand.
@@ -46,6 +50,7 @@ public:
   {
   public:
     strand_impl();
+    ASIO_DECL ~strand_impl();
 
   private:
     // Only this service will have access to the internal values.
@@ -53,26 +58,32 @@ public:
     friend struct on_do_complete_exit;
     friend struct on_dispatch_exit;
 
-    // Mutex to protect access to internal data.
-    asio::detail::mutex mutex_;
-
-    // Indicates whether the strand is currently "locked" by a handler. This
-    // means that there is a handler upcall in progress, or that the strand
-    // itself has been scheduled in order to invoke some pending handlers.
-    bool locked_;
-
-    // The handlers that are waiting on the strand but should not be run until
-    // after the next time the strand is scheduled. This queue must only be
-    // modified while the mutex is locked.
-    op_queue<operation> waiting_queue_;
+    // The strand's lock, and the handlers that are waiting on the strand but
+    // should not be run until after the next time the strand is scheduled.
+    // The strand is "locked" while there is a handler upcall in progress, or
+    // while the strand itself has been scheduled in order to invoke some
+    // pending handlers.
+    strand_queue<operation> queue_;
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
-    // from within the strand and so may be accessed without locking the mutex.
+    // from within the strand and so may be accessed without locking.
     op_queue<operation> ready_queue_;
+
+    // Keeps the implementation alive while the strand is locked, as the last
+    // strand object that refers to it may be destroyed by a handler.
+    shared_ptr<strand_impl> self_;
+
+    // Pointers to adjacent handle implementations in linked list.
+    strand_impl* next_;
+    strand_impl* prev_;
+
+    // The list in which the implementation is held. This is shared with the
+    // service so that a strand may outlive the io_context.
+    shared_ptr<impl_list> list_;
   };
 
-  typedef strand_impl* implementation_type;
+  typedef shared_ptr<strand_impl> implementation_type;
 
   // Construct a new strand service for the specified io_context.
   ASIO_DECL explicit strand_service(asio::io_context& io_context);
@@ -96,6 +107,8 @@ public:
       const implementation_type& impl) const;
 
 private:
+  friend class strand_impl;
+
   // Helper function to dispatch a handler. Returns true if the handler should
   // be dispatched immediately.
   ASIO_DECL bool do_dispatch(implementation_type& impl, operation* op);
@@ -108,25 +121,27 @@ private:
       operation* base, const asio::error_code& ec,
       std::size_t bytes_transferred);
 
+  // Helper function to release the strand lock, or to schedule the strand
+  // again if more handlers are ready to run.
+  ASIO_DECL static void release(strand_impl* impl,
+      io_context_impl* owner, bool is_continuation);
+
   // The io_context implementation used to post completions.
   io_context_impl& io_context_;
 
-  // Mutex to protect access to the array of implementations.
-  asio::detail::mutex mutex_;
+  // The list of all implementations, shared with the implementations.
+  struct impl_list
+  {
+    impl_list() : head_(0) {}
 
-  // Number of implementations shared between all strand objects.
-#if defined(ASIO_STRAND_IMPLEMENTATIONS)
-  enum { num_implementations = ASIO_STRAND_IMPLEMENTATIONS };
-#else // defined(ASIO_STRAND_IMPLEMENTATIONS)
-  enum { num_implementations = 193 };
-#endif // defined(ASIO_STRAND_IMPLEMENTATIONS)
+    // Mutex to protect access to the linked list of implementations.
+    asio::detail::mutex mutex_;
 
-  // Pool of implementations.
-  scoped_ptr<strand_impl> implementations_[num_implementations];
+    // The head of a linked list of all implementations.
+    strand_impl* head_;
+  };
 
-  // Extra value used when hashing to prevent recycled memory locations from
-  // getting the same strand implementation.
-  std::size_t salt_;
+  shared_ptr<impl_list> impl_list_;
 };
 
 } // namespace detail
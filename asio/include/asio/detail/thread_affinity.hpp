@@ -0,0 +1,43 @@
+//
+// detail/thread_affinity.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_AFFINITY_HPP
+#define ASIO_DETAIL_THREAD_AFFINITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Bind the calling thread to the CPU with the given index, counting only those
+// CPUs on which the process is permitted to run. The index wraps around if it
+// exceeds the number of such CPUs. If numa_node is true, the thread is instead
+// bound to all permitted CPUs on the same NUMA node as the selected CPU.
+ASIO_DECL void bind_this_thread_to_cpu(std::size_t cpu_index,
+    bool numa_node, asio::error_code& ec);
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/thread_affinity.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_THREAD_AFFINITY_HPP
@@ -15,45 +15,83 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#include <climits>
+#include "asio/detail/config.hpp"
 #include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/memory_resource_allocator.hpp"
 #include "asio/detail/noncopyable.hpp"
 
+// The number of blocks of each size class that may be cached by a thread.
+#if !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+# define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 4
+#endif // !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+
+// The maximum number of bytes that may be held in a thread's cache.
+#if !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES)
+# define ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES 8192
+#endif // !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 namespace detail {
 
+// Per-thread state that includes a cache of memory blocks for recycling.
+// Requests are rounded up to one of a fixed set of power-of-two size classes,
+// and each size class keeps a small stack of freed blocks, so that several
+// operations of similar size may be in flight on the same thread without
+// falling back to the heap. Requests larger than the largest size class are
+// never cached.
+//
+// New blocks are allocated from the memory resource of the io_context that is
+// running on the thread, if it has one. As a block may be freed on a different
+// thread, each block records the resource it came from in a trailer. Only
+// blocks that came from the thread's current resource are cached, and others
+// are returned to their origin immediately.
 class thread_info_base
   : private noncopyable
 {
 public:
   struct default_tag
   {
-    enum { mem_index = 0 };
   };
 
   struct awaitable_frame_tag
   {
-    enum { mem_index = 1 };
   };
 
   struct executor_function_tag
   {
-    enum { mem_index = 2 };
   };
 
   thread_info_base()
+    : memory_resource_(0),
+      reusable_memory_(),
+      cached_blocks_(),
+      cached_bytes_(0),
+      hits_(0),
+      misses_(0),
+      discards_(0)
   {
-    for (int i = 0; i < max_mem_index; ++i)
-      reusable_memory_[i] = 0;
   }
 
   ~thread_info_base()
   {
-    for (int i = 0; i < max_mem_index; ++i)
-      if (reusable_memory_[i])
-        ::operator delete(reusable_memory_[i]);
+    for (int i = 0; i < num_size_classes; ++i)
+      while (cached_blocks_[i] > 0)
+        release(reusable_memory_[i][--cached_blocks_[i]], block_size(i));
+  }
+
+  // Set the memory resource used to allocate new blocks.
+  void set_memory_resource(memory_resource* resource)
+  {
+    memory_resource_ = resource;
+  }
+
+  // Get the memory resource used to allocate new blocks.
+  memory_resource* get_memory_resource() const
+  {
+    return memory_resource_;
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
@@ -71,51 +109,148 @@ public:
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size)
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    std::size_t total = total_size(size);
+    int size_class = size_class_of(total);
+    memory_resource* resource = this_thread ? this_thread->memory_resource_ : 0;
+    if (size_class == num_size_classes)
+      return acquire(resource, total);
 
-    if (this_thread && this_thread->reusable_memory_[Purpose::mem_index])
+    if (this_thread)
     {
-      void* const pointer = this_thread->reusable_memory_[Purpose::mem_index];
-      this_thread->reusable_memory_[Purpose::mem_index] = 0;
-
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= chunks)
+      if (this_thread->cached_blocks_[size_class] > 0)
       {
-        mem[size] = mem[0];
-        return pointer;
+        ++this_thread->hits_;
+        this_thread->cached_bytes_ -= block_size(size_class);
+        return this_thread->reusable_memory_[size_class][
+          --this_thread->cached_blocks_[size_class]];
       }
 
-      ::operator delete(pointer);
+      ++this_thread->misses_;
     }
 
-    void* const pointer = ::operator new(chunks * chunk_size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
-    return pointer;
+    // Blocks are always allocated with the full size of their class, as they
+    // may be returned to a different thread's cache.
+    return acquire(resource, block_size(size_class));
   }
 
   template <typename Purpose>
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    std::size_t total = total_size(size);
+    int size_class = size_class_of(total);
+    if (size_class < num_size_classes && this_thread
+        && *trailer(pointer, block_size(size_class))
+          == this_thread->memory_resource_)
     {
-      if (this_thread && this_thread->reusable_memory_[Purpose::mem_index] == 0)
+      if (this_thread->cached_blocks_[size_class] < cache_size
+          && this_thread->cached_bytes_ + block_size(size_class)
+            <= static_cast<std::size_t>(cache_bytes))
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_[Purpose::mem_index] = pointer;
+        this_thread->cached_bytes_ += block_size(size_class);
+        this_thread->reusable_memory_[size_class][
+          this_thread->cached_blocks_[size_class]++] = pointer;
         return;
       }
+
+      ++this_thread->discards_;
     }
 
-    ::operator delete(pointer);
+    release(pointer, size_class < num_size_classes
+        ? block_size(size_class) : total);
   }
 
+  // The number of allocations satisfied from the cache.
+  uint64_t cache_hits() const
+  {
+    return hits_;
+  }
+
+  // The number of cacheable allocations that needed a new block.
+  uint64_t cache_misses() const
+  {
+    return misses_;
+  }
+
+  // The number of cacheable blocks released because the cache was full.
+  uint64_t cache_discards() const
+  {
+    return discards_;
+  }
+
+  // The number of bytes currently held in the cache.
+  std::size_t cached_bytes() const
+  {
+    return cached_bytes_;
+  }
+
+private:
+  enum { min_block_size = 64 };
+  enum { num_size_classes = 6 };
+  enum { cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE };
+  enum { cache_bytes = ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES };
+
+public:
+  // The largest request that may be satisfied from the cache.
+  enum
+  {
+    max_cached_size = (min_block_size << (num_size_classes - 1))
+      - sizeof(memory_resource*)
+  };
+
 private:
-  enum { chunk_size = 4 };
-  enum { max_mem_index = 3 };
-  void* reusable_memory_[max_mem_index];
+
+  // The size of the blocks in a size class.
+  static std::size_t block_size(int size_class)
+  {
+    return static_cast<std::size_t>(min_block_size) << size_class;
+  }
+
+  // The size of a block, including its trailer, needed for a request.
+  static std::size_t total_size(std::size_t size)
+  {
+    const std::size_t align = sizeof(memory_resource*);
+    return (size + align - 1) / align * align + sizeof(memory_resource*);
+  }
+
+  // Allocate a block and record its origin in the trailer.
+  static void* acquire(memory_resource* resource, std::size_t total)
+  {
+    void* pointer = allocate_from_resource(resource, total);
+    *trailer(pointer, total) = resource;
+    return pointer;
+  }
+
+  // Return a block to the resource it came from.
+  static void release(void* pointer, std::size_t total)
+  {
+    deallocate_to_resource(*trailer(pointer, total), pointer, total);
+  }
+
+  // Get the trailer at the end of a block.
+  static memory_resource** trailer(void* pointer, std::size_t total)
+  {
+    return reinterpret_cast<memory_resource**>(static_cast<unsigned char*>(
+          pointer) + total - sizeof(memory_resource*));
+  }
+
+  // Find the smallest size class that can hold a request, or num_size_classes
+  // if the request is too large to be cached.
+  static int size_class_of(std::size_t size)
+  {
+    int size_class = 0;
+    while (size_class < num_size_classes && block_size(size_class) < size)
+      ++size_class;
+    return size_class;
+  }
+
+  memory_resource* memory_resource_;
+  void* reusable_memory_[num_size_classes][cache_size > 0 ? cache_size : 1];
+  int cached_blocks_[num_size_classes];
+  std::size_t cached_bytes_;
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t discards_;
 };
 
 } // namespace detail
@@ -21,8 +21,10 @@
 #include "asio/detail/cstdint.hpp"
 #include "asio/detail/date_time_fwd.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/memory_resource_allocator.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/timer_slack.hpp"
 #include "asio/detail/wait_op.hpp"
 #include "asio/error.hpp"
 
@@ -66,10 +68,11 @@ public:
     per_timer_data* prev_;
   };
 
-  // Constructor.
-  timer_queue()
+  // Constructor. The heap is allocated from the given memory resource, or
+  // from the heap if there is none.
+  explicit timer_queue(memory_resource* resource = 0)
     : timers_(),
-      heap_()
+      heap_(memory_resource_allocator<heap_entry>(resource))
   {
   }
 
@@ -107,8 +110,10 @@ public:
     // Enqueue the individual timer operation.
     timer.op_queue_.push(op);
 
-    // Interrupt reactor only if newly added timer is first to expire.
-    return timer.heap_index_ == 0 && timer.op_queue_.front() == op;
+    // Interrupt reactor only if newly added timer is first to expire, and the
+    // reactor is not already due to wake up at the same time for another timer.
+    return timer.heap_index_ == 0 && timer.op_queue_.front() == op
+      && !shares_wake_time_with_next();
   }
 
   // Whether there are no timers in the queue.
@@ -125,7 +130,9 @@ public:
 
     return this->to_msec(
         Time_Traits::to_posix_duration(
-          Time_Traits::subtract(heap_[0].time_, Time_Traits::now())),
+          Time_Traits::subtract(
+            timer_slack<Time_Traits>::wake_time(heap_[0].time_),
+            Time_Traits::now())),
         max_duration);
   }
 
@@ -137,7 +144,9 @@ public:
 
     return this->to_usec(
         Time_Traits::to_posix_duration(
-          Time_Traits::subtract(heap_[0].time_, Time_Traits::now())),
+          Time_Traits::subtract(
+            timer_slack<Time_Traits>::wake_time(heap_[0].time_),
+            Time_Traits::now())),
         max_duration);
   }
 
@@ -216,6 +225,21 @@ public:
   }
 
 private:
+  // Determine whether the timer at the front of the heap has the same wake up
+  // time as the timer that follows it, in which case the two timers' expiries
+  // are coalesced.
+  bool shares_wake_time_with_next() const
+  {
+    if (!timer_slack<Time_Traits>::enabled || heap_.size() < 2)
+      return false;
+
+    std::size_t next = (heap_.size() == 2
+        || Time_Traits::less_than(heap_[1].time_, heap_[2].time_)) ? 1 : 2;
+    return !Time_Traits::less_than(
+        timer_slack<Time_Traits>::wake_time(heap_[0].time_),
+        timer_slack<Time_Traits>::wake_time(heap_[next].time_));
+  }
+
   // Move the item at the given index up the heap to its correct position.
   void up_heap(std::size_t index)
   {
@@ -349,7 +373,7 @@ private:
   };
 
   // The heap of timers, with the earliest timer at the front.
-  std::vector<heap_entry> heap_;
+  std::vector<heap_entry, memory_resource_allocator<heap_entry> > heap_;
 };
 
 } // namespace detail
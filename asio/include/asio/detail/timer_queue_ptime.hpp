@@ -46,7 +46,7 @@ public:
     per_timer_data;
 
   // Constructor.
-  ASIO_DECL timer_queue();
+  ASIO_DECL explicit timer_queue(memory_resource* resource = 0);
 
   // Destructor.
   ASIO_DECL virtual ~timer_queue();
@@ -0,0 +1,89 @@
+//
+// detail/timer_slack.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMER_SLACK_HPP
+#define ASIO_DETAIL_TIMER_SLACK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+# include "asio/detail/chrono.hpp"
+# include "asio/detail/chrono_time_traits.hpp"
+#endif // defined(ASIO_HAS_CHRONO)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if defined(ASIO_HAS_CHRONO)
+template <typename Clock, long SlackUsec>
+struct slack_wait_traits;
+#endif // defined(ASIO_HAS_CHRONO)
+
+namespace detail {
+
+// Determines the time at which the reactor must wake up for a timer with a
+// given expiry. By default this is the expiry itself.
+template <typename Time_Traits>
+struct timer_slack
+{
+  enum { enabled = 0 };
+
+  static typename Time_Traits::time_type wake_time(
+      const typename Time_Traits::time_type& t)
+  {
+    return t;
+  }
+};
+
+#if defined(ASIO_HAS_CHRONO)
+
+// Timers that use the slack_wait_traits wake up at the next multiple of the
+// slack, measured from the clock's epoch, so that all timers expiring within
+// the same interval are handled by a single wake up.
+template <typename Clock, long SlackUsec>
+struct timer_slack<chrono_time_traits<Clock,
+    asio::slack_wait_traits<Clock, SlackUsec> > >
+{
+  enum { enabled = 1 };
+
+  static typename Clock::time_point wake_time(
+      const typename Clock::time_point& t)
+  {
+    typedef typename Clock::duration duration_type;
+    const duration_type slack = chrono::duration_cast<duration_type>(
+        chrono::microseconds(SlackUsec));
+    if (slack <= duration_type::zero())
+      return t;
+
+    // Round up to the next multiple of the slack. For a time before the epoch
+    // the remainder is not positive, and subtracting it rounds towards the
+    // epoch.
+    duration_type rem = t.time_since_epoch() % slack;
+    if (rem <= duration_type::zero())
+      return t - rem;
+    if ((Clock::time_point::max)() - t < slack - rem)
+      return (Clock::time_point::max)();
+    return t + (slack - rem);
+  }
+};
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMER_SLACK_HPP
@@ -0,0 +1,496 @@
+//
+// detail/timer_wheel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMER_WHEEL_HPP
+#define ASIO_DETAIL_TIMER_WHEEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/wait_op.hpp"
+#include "asio/error.hpp"
+#include "asio/memory_resource.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+# include "asio/detail/chrono_time_traits.hpp"
+# include "asio/detail/timer_queue.hpp"
+#endif // defined(ASIO_HAS_CHRONO)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if defined(ASIO_HAS_CHRONO)
+template <typename Clock, long GranularityUsec>
+struct timing_wheel_wait_traits;
+#endif // defined(ASIO_HAS_CHRONO)
+
+namespace detail {
+
+// A timer queue implemented as a hierarchical timing wheel. Expiry times are
+// rounded up to a whole number of ticks of Granularity_Usec microseconds. The
+// wheel has num_levels levels of num_slots slots each, where a slot on one
+// level spans a whole revolution of the level below it. A timer is linked into
+// the slot for its expiry tick on the lowest level that can hold it, and is
+// moved down the levels as the wheel turns, so that scheduling and cancelling
+// a timer are constant time operations regardless of the number of timers.
+template <typename Time_Traits, long Granularity_Usec>
+class timer_wheel
+  : public timer_queue_base
+{
+private:
+  enum
+  {
+    slot_bits = 6,
+    num_slots = 1 << slot_bits,
+    slot_mask = num_slots - 1,
+    num_levels = 8,
+    due_level = num_levels,
+    unlinked_level = num_levels + 1
+  };
+
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data() :
+      tick_(0),
+      level_(unlinked_level),
+      slot_(0),
+      next_(0), prev_(0)
+    {
+    }
+
+  private:
+    friend class timer_wheel;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The tick at which the timer expires.
+    uint64_t tick_;
+
+    // The level and slot of the wheel in which the timer is linked.
+    unsigned char level_;
+    unsigned char slot_;
+
+    // Pointers to adjacent timers in the slot's linked list.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  // Constructor.
+  timer_wheel()
+    : origin_(Time_Traits::now()),
+      current_tick_(0),
+      num_timers_(0),
+      due_(0)
+  {
+    for (int level = 0; level < num_levels; ++level)
+    {
+      occupied_[level] = 0;
+      for (int slot = 0; slot < num_slots; ++slot)
+        slots_[level][slot] = 0;
+    }
+  }
+
+  // Add a new timer to the queue. Returns true if this is the timer that is
+  // earliest in the queue, in which case the reactor's event demultiplexing
+  // function call may need to be interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    bool earliest = false;
+    if (timer.level_ == unlinked_level)
+    {
+      // Nothing needs to be done for the ticks that elapsed while the wheel
+      // was empty, so skip them.
+      if (num_timers_ == 0)
+      {
+        uint64_t now_tick = to_tick(Time_Traits::now(), false);
+        if (now_tick > current_tick_)
+          current_tick_ = now_tick;
+      }
+
+      timer.tick_ = to_tick(time, true);
+      earliest = due_ == 0 && timer.tick_ < next_tick();
+      link_timer(timer);
+      ++num_timers_;
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer is first to expire.
+    return earliest && timer.op_queue_.front() == op;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return num_timers_ == 0;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    return wait_duration(max_duration, 1000);
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    return wait_duration(max_duration, 1);
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (num_timers_ == 0)
+      return;
+
+    while (per_timer_data* timer = due_)
+    {
+      ops.push(timer->op_queue_);
+      remove_timer(*timer);
+    }
+
+    // Turn the wheel one event at a time, where an event is either the expiry
+    // of the timers in a first level slot, or the cascading of the timers in
+    // a higher level slot down to the lower levels. Empty ticks are skipped.
+    const uint64_t now_tick = to_tick(Time_Traits::now(), false);
+    while (num_timers_ != 0)
+    {
+      uint64_t tick = next_tick();
+      if (tick > now_tick)
+        break;
+
+      current_tick_ = tick;
+      for (int level = 1; level < num_levels; ++level)
+      {
+        if ((tick & low_mask(level)) != 0)
+          break;
+        cascade(level, slot_index(tick, level));
+      }
+
+      while (per_timer_data* timer = slots_[0][tick & slot_mask])
+      {
+        ops.push(timer->op_queue_);
+        remove_timer(*timer);
+      }
+
+      current_tick_ = tick + 1;
+    }
+
+    if (current_tick_ <= now_tick)
+      current_tick_ = now_tick + 1;
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    while (per_timer_data* timer = due_)
+    {
+      ops.push(timer->op_queue_);
+      remove_timer(*timer);
+    }
+
+    for (int level = 0; level < num_levels; ++level)
+    {
+      while (occupied_[level])
+      {
+        int slot = lowest_bit(occupied_[level]);
+        while (per_timer_data* timer = slots_[level][slot])
+        {
+          ops.push(timer->op_queue_);
+          remove_timer(*timer);
+        }
+      }
+    }
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.level_ != unlinked_level)
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+  // Move operations from one timer to another, empty timer.
+  void move_timer(per_timer_data& target, per_timer_data& source)
+  {
+    target.op_queue_.push(source.op_queue_);
+
+    target.tick_ = source.tick_;
+    target.level_ = source.level_;
+    target.slot_ = source.slot_;
+    source.level_ = unlinked_level;
+
+    if (target.level_ != unlinked_level)
+    {
+      per_timer_data*& head = list_head(target.level_, target.slot_);
+      if (head == &source)
+        head = &target;
+    }
+    if (source.prev_)
+      source.prev_->next_ = &target;
+    if (source.next_)
+      source.next_->prev_= &target;
+    target.next_ = source.next_;
+    target.prev_ = source.prev_;
+    source.next_ = 0;
+    source.prev_ = 0;
+  }
+
+private:
+  // The mask for the ticks spanned by a single slot on the given level.
+  static uint64_t low_mask(int level)
+  {
+    return (static_cast<uint64_t>(1) << (slot_bits * level)) - 1;
+  }
+
+  // The slot on the given level that holds the given tick.
+  static int slot_index(uint64_t tick, int level)
+  {
+    return static_cast<int>((tick >> (slot_bits * level)) & slot_mask);
+  }
+
+  // Find the index of the lowest set bit in a non-zero value.
+  static int lowest_bit(uint64_t bits)
+  {
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#else // defined(__GNUC__)
+    int index = 0;
+    while ((bits & 1) == 0)
+    {
+      bits >>= 1;
+      ++index;
+    }
+    return index;
+#endif // defined(__GNUC__)
+  }
+
+  // Convert a time to a number of ticks since the wheel's origin, rounding
+  // either up or down to a whole tick. Times before the origin map to zero.
+  uint64_t to_tick(const time_type& time, bool round_up) const
+  {
+    int64_t usec = Time_Traits::to_posix_duration(
+        Time_Traits::subtract(time, origin_)).total_microseconds();
+    if (usec <= 0)
+      return 0;
+    uint64_t tick = static_cast<uint64_t>(usec / Granularity_Usec);
+    if (round_up && usec % Granularity_Usec != 0)
+      ++tick;
+    return tick;
+  }
+
+  // Get the time until the next event on the wheel, rounded up to a whole
+  // number of units of the given number of microseconds.
+  long wait_duration(long max_duration, int64_t unit_usec) const
+  {
+    if (num_timers_ == 0)
+      return max_duration;
+    if (due_)
+      return 0;
+
+    uint64_t tick = next_tick();
+    int64_t now_usec = Time_Traits::to_posix_duration(
+        Time_Traits::subtract(Time_Traits::now(), origin_)).total_microseconds();
+    if (tick > static_cast<uint64_t>(
+          (std::numeric_limits<int64_t>::max)() / Granularity_Usec))
+      return max_duration;
+
+    int64_t usec = static_cast<int64_t>(tick) * Granularity_Usec - now_usec;
+    if (usec <= 0)
+      return 0;
+    int64_t units = (usec + unit_usec - 1) / unit_usec;
+    if (units > max_duration)
+      return max_duration;
+    return static_cast<long>(units);
+  }
+
+  // Get the tick of the next event on the wheel. This is a lower bound on the
+  // expiry of the earliest timer, as the event may only cascade timers down
+  // to a lower level.
+  uint64_t next_tick() const
+  {
+    uint64_t next = (std::numeric_limits<uint64_t>::max)();
+    for (int level = 0; level < num_levels; ++level)
+    {
+      uint64_t bits = occupied_[level];
+      if (bits == 0)
+        continue;
+
+      // A level's current slot is still to be processed only if the wheel is
+      // exactly at the start of that slot. Otherwise, it holds timers for the
+      // level's next revolution.
+      int index = slot_index(current_tick_, level);
+      if ((current_tick_ & low_mask(level)) != 0)
+        ++index;
+      uint64_t ahead = index < num_slots ? (bits >> index) << index : 0;
+
+      int shift = slot_bits * level;
+      uint64_t revolution = static_cast<uint64_t>(1) << (shift + slot_bits);
+      uint64_t tick = current_tick_ & ~(revolution - 1);
+      if (ahead)
+        tick += static_cast<uint64_t>(lowest_bit(ahead)) << shift;
+      else
+        tick += revolution + (static_cast<uint64_t>(lowest_bit(bits)) << shift);
+
+      if (tick < next)
+        next = tick;
+    }
+    return next;
+  }
+
+  // Get the head of the linked list for the given level and slot.
+  per_timer_data*& list_head(int level, int slot)
+  {
+    return level == due_level ? due_ : slots_[level][slot];
+  }
+
+  // Link a timer into the slot for its expiry tick.
+  void link_timer(per_timer_data& timer)
+  {
+    int level = due_level;
+    int slot = 0;
+    if (timer.tick_ >= current_tick_)
+    {
+      // Timers beyond the range of the wheel are placed in the highest level,
+      // and are linked again each time they reach the front of that level.
+      const uint64_t max_delta = (static_cast<uint64_t>(1)
+          << (slot_bits * num_levels)) - 1;
+      uint64_t delta = timer.tick_ - current_tick_;
+      if (delta > max_delta)
+        delta = max_delta;
+
+      level = 0;
+      while (level < num_levels - 1 && delta > low_mask(level + 1))
+        ++level;
+      slot = slot_index(current_tick_ + delta, level);
+      occupied_[level] |= static_cast<uint64_t>(1) << slot;
+    }
+
+    per_timer_data*& head = list_head(level, slot);
+    timer.level_ = static_cast<unsigned char>(level);
+    timer.slot_ = static_cast<unsigned char>(slot);
+    timer.next_ = head;
+    timer.prev_ = 0;
+    if (head)
+      head->prev_ = &timer;
+    head = &timer;
+  }
+
+  // Unlink a timer from its slot.
+  void unlink_timer(per_timer_data& timer)
+  {
+    per_timer_data*& head = list_head(timer.level_, timer.slot_);
+    if (head == &timer)
+      head = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_= timer.prev_;
+    if (head == 0 && timer.level_ < num_levels)
+      occupied_[timer.level_] &= ~(static_cast<uint64_t>(1) << timer.slot_);
+    timer.level_ = unlinked_level;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // Move all timers in a higher level slot down to the lower levels.
+  void cascade(int level, int slot)
+  {
+    while (per_timer_data* timer = slots_[level][slot])
+    {
+      unlink_timer(*timer);
+      link_timer(*timer);
+    }
+  }
+
+  // Remove a timer from the wheel.
+  void remove_timer(per_timer_data& timer)
+  {
+    unlink_timer(timer);
+    --num_timers_;
+  }
+
+  // The time corresponding to tick zero.
+  time_type origin_;
+
+  // The next tick to be processed. All earlier ticks have been processed.
+  uint64_t current_tick_;
+
+  // The number of timers in the wheel.
+  std::size_t num_timers_;
+
+  // Timers that expired before the current tick, and which are dequeued the
+  // next time the wheel is turned.
+  per_timer_data* due_;
+
+  // The slots on each level of the wheel, and a bitmask of non-empty slots.
+  per_timer_data* slots_[num_levels][num_slots];
+  uint64_t occupied_[num_levels];
+};
+
+#if defined(ASIO_HAS_CHRONO)
+
+// Timers that use the timing_wheel_wait_traits are held in a timing wheel.
+template <typename Clock, long GranularityUsec>
+class timer_queue<chrono_time_traits<Clock,
+    asio::timing_wheel_wait_traits<Clock, GranularityUsec> > >
+  : public timer_wheel<chrono_time_traits<Clock,
+      asio::timing_wheel_wait_traits<Clock, GranularityUsec> >,
+      GranularityUsec>
+{
+public:
+  // Constructor. The wheel does not allocate memory, so the resource is not
+  // used.
+  explicit timer_queue(memory_resource* = 0)
+  {
+  }
+};
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMER_WHEEL_HPP
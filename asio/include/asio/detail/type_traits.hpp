@@ -29,6 +29,7 @@
 # include <boost/type_traits/is_const.hpp>
 # include <boost/type_traits/is_convertible.hpp>
 # include <boost/type_traits/is_function.hpp>
+# include <boost/type_traits/is_nothrow_move_constructible.hpp>
 # include <boost/type_traits/is_same.hpp>
 # include <boost/type_traits/remove_pointer.hpp>
 # include <boost/type_traits/remove_reference.hpp>
@@ -52,6 +53,7 @@ using std::is_class;
 using std::is_const;
 using std::is_convertible;
 using std::is_function;
+using std::is_nothrow_move_constructible;
 using std::is_same;
 using std::remove_pointer;
 using std::remove_reference;
@@ -77,6 +79,7 @@ using boost::is_class;
 using boost::is_const;
 using boost::is_convertible;
 using boost::is_function;
+using boost::is_nothrow_move_constructible;
 using boost::is_same;
 using boost::remove_pointer;
 using boost::remove_reference;
@@ -32,6 +32,7 @@
 #include "asio/detail/win_iocp_operation.hpp"
 #include "asio/detail/win_iocp_thread_info.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/memory_resource.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -46,9 +47,11 @@ class win_iocp_io_context
 {
 public:
   // Constructor. Specifies a concurrency hint that is passed through to the
-  // underlying I/O completion port.
+  // underlying I/O completion port. Memory for operations is allocated from
+  // the given resource, if any.
   ASIO_DECL win_iocp_io_context(asio::execution_context& ctx,
-      int concurrency_hint = -1, bool own_thread = true);
+      int concurrency_hint = -1, bool own_thread = true,
+      memory_resource* resource = 0);
 
   // Destructor.
   ASIO_DECL ~win_iocp_io_context();
@@ -209,6 +212,18 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the memory resource used for internal allocations, if any.
+  memory_resource* get_memory_resource() const
+  {
+    return memory_resource_;
+  }
+
+  // Get the number of units of outstanding work.
+  std::size_t outstanding_work() const
+  {
+    return static_cast<std::size_t>(outstanding_work_);
+  }
+
 private:
 #if defined(WINVER) && (WINVER < 0x0500)
   typedef DWORD dword_ptr_t;
@@ -319,6 +334,9 @@ private:
   // The concurrency hint used to initialise the io_context.
   const int concurrency_hint_;
 
+  // The memory resource used for internal allocations, if any.
+  memory_resource* const memory_resource_;
+
   // The thread that is running the io_context.
   scoped_ptr<thread> thread_;
 };
@@ -0,0 +1,164 @@
+//
+// detail/win_iocp_socket_recv_pooled_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_WIN_IOCP_SOCKET_RECV_POOLED_OP_HPP
+#define ASIO_DETAIL_WIN_IOCP_SOCKET_RECV_POOLED_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IOCP) && defined(ASIO_HAS_MOVE)
+
+#include "asio/buffer_pool.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Waits for data using a zero-byte receive, and then reads the available data
+// into a buffer taken from the pool.
+template <typename Handler, typename IoExecutor>
+class win_iocp_socket_recv_pooled_op : public reactor_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(win_iocp_socket_recv_pooled_op);
+
+  win_iocp_socket_recv_pooled_op(socket_type socket,
+      socket_ops::state_type state,
+      socket_ops::weak_cancel_token_type cancel_token, buffer_pool& pool,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactor_op(&win_iocp_socket_recv_pooled_op::do_perform,
+        &win_iocp_socket_recv_pooled_op::do_complete),
+      socket_(socket),
+      state_(state),
+      cancel_token_(cancel_token),
+      pool_(pool),
+      flags_(flags),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static status do_perform(reactor_op*)
+  {
+    return done;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& result_ec,
+      std::size_t /*bytes_transferred*/)
+  {
+    asio::error_code ec(result_ec);
+
+    // Take ownership of the operation object.
+    win_iocp_socket_recv_pooled_op* o(
+        static_cast<win_iocp_socket_recv_pooled_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // The reactor may have stored a result in the operation object.
+    if (o->ec_)
+      ec = o->ec_;
+
+    // Map non-portable errors to their portable counterparts.
+    if (ec.value() == ERROR_NETNAME_DELETED)
+    {
+      if (o->cancel_token_.expired())
+        ec = asio::error::operation_aborted;
+      else
+        ec = asio::error::connection_reset;
+    }
+    else if (ec.value() == ERROR_PORT_UNREACHABLE)
+    {
+      ec = asio::error::connection_refused;
+    }
+
+    // Data is available, so take a buffer from the pool and read into it.
+    void* data = 0;
+    std::size_t bytes_transferred = 0;
+    if (owner && !ec)
+    {
+      data = buffer_pool_access::acquire(o->pool_);
+      if (!data)
+        ec = asio::error::no_buffer_space;
+      else
+      {
+        socket_ops::buf b;
+        socket_ops::init_buf(b, data, o->pool_.buffer_size());
+        signed_size_type result = socket_ops::recv(
+            o->socket_, &b, 1, o->flags_, ec);
+        if (result > 0)
+          bytes_transferred = static_cast<std::size_t>(result);
+        else
+        {
+          if (result == 0 && (o->state_ & socket_ops::stream_oriented) != 0)
+            ec = asio::error::eof;
+          buffer_pool_access::release(o->pool_, data);
+          data = 0;
+        }
+      }
+    }
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::move_binder2<Handler, asio::error_code, pooled_buffer>
+      handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), ec,
+          buffer_pool_access::make_buffer(o->pool_, data, bytes_transferred));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_.size()));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  socket_ops::weak_cancel_token_type cancel_token_;
+  buffer_pool& pool_;
+  socket_base::message_flags flags_;
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IOCP) && defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_WIN_IOCP_SOCKET_RECV_POOLED_OP_HPP
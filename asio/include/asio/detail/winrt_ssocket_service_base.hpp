@@ -20,6 +20,7 @@
 #if defined(ASIO_WINDOWS_RUNTIME)
 
 #include "asio/buffer.hpp"
+#include "asio/buffer_pool.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
@@ -281,6 +282,19 @@ public:
         detail::bind_handler(handler, ec, bytes_transferred));
   }
 
+#if defined(ASIO_HAS_MOVE)
+  // Start an asynchronous receive into a buffer taken from a pool.
+  template <typename Handler, typename IoExecutor>
+  void async_receive(base_implementation_type&, buffer_pool&,
+      socket_base::message_flags, Handler& handler, const IoExecutor& io_ex)
+  {
+    asio::error_code ec = asio::error::operation_not_supported;
+    asio::post(io_ex, detail::move_binder2<Handler,
+        asio::error_code, pooled_buffer>(0,
+          ASIO_MOVE_CAST(Handler)(handler), ec, pooled_buffer()));
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
 protected:
   // Helper function to obtain endpoints associated with the connection.
   ASIO_DECL std::size_t do_get_endpoint(
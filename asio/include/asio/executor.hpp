@@ -40,6 +40,16 @@ public:
 };
 
 /// Polymorphic wrapper for executors.
+/**
+ * Target executors that are small enough, such as io_context::executor_type,
+ * thread_pool::executor_type and strand objects that wrap them, are stored
+ * within the executor object itself. Constructing, copying and destroying a
+ * polymorphic wrapper for these executors does not allocate memory.
+ *
+ * Function objects that are small enough are likewise stored within the
+ * type-erased function object that is passed to the target executor's
+ * dispatch(), post() or defer() function.
+ */
 class executor
 {
 public:
@@ -57,16 +67,15 @@ public:
 
   /// Copy constructor.
   executor(const executor& other) ASIO_NOEXCEPT
-    : impl_(other.clone())
+    : impl_(other.clone(&storage_))
   {
   }
 
 #if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
   /// Move constructor.
   executor(executor&& other) ASIO_NOEXCEPT
-    : impl_(other.impl_)
+    : impl_(take(other))
   {
-    other.impl_ = 0;
   }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
@@ -88,8 +97,11 @@ public:
   /// Assignment operator.
   executor& operator=(const executor& other) ASIO_NOEXCEPT
   {
-    destroy();
-    impl_ = other.clone();
+    if (this != &other)
+    {
+      destroy();
+      impl_ = other.clone(&storage_);
+    }
     return *this;
   }
 
@@ -97,9 +109,11 @@ public:
   // Move assignment operator.
   executor& operator=(executor&& other) ASIO_NOEXCEPT
   {
-    destroy();
-    impl_ = other.impl_;
-    other.impl_ = 0;
+    if (this != &other)
+    {
+      destroy();
+      impl_ = take(other);
+    }
     return *this;
   }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
@@ -119,8 +133,7 @@ public:
   {
     executor tmp(ASIO_MOVE_CAST(Executor)(e));
     destroy();
-    impl_ = tmp.impl_;
-    tmp.impl_ = 0;
+    impl_ = take(tmp);
     return *this;
   }
 
@@ -255,6 +268,7 @@ private:
 #if !defined(GENERATING_DOCUMENTATION)
   class function;
   template <typename, typename> class impl;
+  template <typename, typename> class inline_impl;
 
 #if !defined(ASIO_NO_TYPEID)
   typedef const std::type_info& type_id_result_type;
@@ -273,11 +287,20 @@ private:
 #endif // !defined(ASIO_NO_TYPEID)
   }
 
+  // Storage for target executors that are small enough to be held inline.
+  union storage_type
+  {
+    void* pointer_;
+    double number_;
+    unsigned char data_[6 * sizeof(void*)];
+  };
+
   // Base class for all polymorphic executor implementations.
   class impl_base
   {
   public:
-    virtual impl_base* clone() const ASIO_NOEXCEPT = 0;
+    // Copy the implementation, using the buffer if it is held inline.
+    virtual impl_base* clone(void* buffer) const ASIO_NOEXCEPT = 0;
     virtual void destroy() ASIO_NOEXCEPT = 0;
     virtual execution_context& context() ASIO_NOEXCEPT = 0;
     virtual void on_work_started() ASIO_NOEXCEPT = 0;
@@ -311,9 +334,30 @@ private:
   }
 
   // Helper function to clone another implementation.
-  impl_base* clone() const ASIO_NOEXCEPT
+  impl_base* clone(void* buffer) const ASIO_NOEXCEPT
+  {
+    return impl_ ? impl_->clone(buffer) : 0;
+  }
+
+  // Helper function to take the implementation from another executor. An
+  // implementation held inline is copied into this object's storage.
+  impl_base* take(executor& other) ASIO_NOEXCEPT
+  {
+    impl_base* i = other.impl_;
+    if (i && other.is_inline())
+    {
+      i = i->clone(&storage_);
+      other.impl_->destroy();
+    }
+    other.impl_ = 0;
+    return i;
+  }
+
+  // Helper function to determine whether the implementation is held inline.
+  bool is_inline() const ASIO_NOEXCEPT
   {
-    return impl_ ? impl_->clone() : 0;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(impl_);
+    return p >= storage_.data_ && p < storage_.data_ + sizeof(storage_);
   }
 
   // Helper function to destroy an implementation.
@@ -324,6 +368,7 @@ private:
   }
 
   impl_base* impl_;
+  storage_type storage_;
 #endif // !defined(GENERATING_DOCUMENTATION)
 };
 
@@ -0,0 +1,121 @@
+//
+// handler_memory_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_HANDLER_MEMORY_STATISTICS_HPP
+#define ASIO_HANDLER_MEMORY_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Counters describing how a thread's handler memory cache is used.
+/**
+ * Threads that run an io_context keep a cache of recently freed memory blocks,
+ * which is used for the default allocation of handlers and asynchronous
+ * operations. The cache holds up to @c ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+ * blocks of each size class, and no more than
+ * @c ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES bytes in total. A steady stream of
+ * misses() or discards() indicates that these limits are too small for the
+ * number of operations that are in flight on the thread.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class handler_memory_statistics
+{
+public:
+  /// Construct with all counters set to zero.
+  handler_memory_statistics()
+    : hits_(0),
+      misses_(0),
+      discards_(0),
+      cached_bytes_(0)
+  {
+  }
+
+  /// Construct with the specified counter values.
+  handler_memory_statistics(uint64_t hits, uint64_t misses,
+      uint64_t discards, std::size_t cached_bytes)
+    : hits_(hits),
+      misses_(misses),
+      discards_(discards),
+      cached_bytes_(cached_bytes)
+  {
+  }
+
+  /// The number of allocations satisfied from the cache.
+  uint64_t hits() const
+  {
+    return hits_;
+  }
+
+  /// The number of allocations small enough to be cached that were passed to
+  /// the heap because the cache held no suitable block.
+  uint64_t misses() const
+  {
+    return misses_;
+  }
+
+  /// The number of deallocations small enough to be cached that were passed
+  /// to the heap because the cache was full.
+  uint64_t discards() const
+  {
+    return discards_;
+  }
+
+  /// The number of bytes currently held in the cache.
+  std::size_t cached_bytes() const
+  {
+    return cached_bytes_;
+  }
+
+private:
+  uint64_t hits_;
+  uint64_t misses_;
+  uint64_t discards_;
+  std::size_t cached_bytes_;
+};
+
+/// Obtain the handler memory counters for the calling thread.
+/**
+ * The counters are kept for each call to a run function, such as
+ * io_context::run(), and start at zero each time the function is called.
+ *
+ * @returns The current counter values. All counters are zero if the calling
+ * thread is not running an io_context.
+ */
+inline handler_memory_statistics get_handler_memory_statistics()
+{
+  typedef detail::thread_context::thread_call_stack call_stack;
+  if (detail::thread_info_base* this_thread = call_stack::top())
+  {
+    return handler_memory_statistics(this_thread->cache_hits(),
+        this_thread->cache_misses(), this_thread->cache_discards(),
+        this_thread->cached_bytes());
+  }
+  return handler_memory_statistics();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_HANDLER_MEMORY_STATISTICS_HPP
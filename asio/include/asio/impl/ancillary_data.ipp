@@ -0,0 +1,157 @@
+//
+// impl/ancillary_data.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_ANCILLARY_DATA_IPP
+#define ASIO_IMPL_ANCILLARY_DATA_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include "asio/ancillary_data.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+namespace detail {
+
+// Used to determine the alignment of a control message header.
+struct cmsghdr_alignment
+{
+  char c;
+  cmsghdr h;
+};
+
+// Build a message header that refers to the control messages, as required by
+// the CMSG_FIRSTHDR and CMSG_NXTHDR macros.
+inline msghdr make_cmsg_msghdr(void* data, std::size_t size)
+{
+  msghdr msg = msghdr();
+  msg.msg_control = data;
+  msg.msg_controllen = size;
+  return msg;
+}
+
+} // namespace detail
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+ancillary_data::ancillary_data(const mutable_buffer& storage) ASIO_NOEXCEPT
+  : data_(0),
+    capacity_(0),
+    size_(0),
+    flags_(0)
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  std::size_t alignment = offsetof(detail::cmsghdr_alignment, h);
+  std::size_t addr = reinterpret_cast<std::size_t>(storage.data());
+  std::size_t padding = (alignment - addr % alignment) % alignment;
+  if (storage.size() > padding)
+  {
+    data_ = static_cast<char*>(storage.data()) + padding;
+    capacity_ = storage.size() - padding;
+  }
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)storage;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+bool ancillary_data::truncated() const ASIO_NOEXCEPT
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  return (flags_ & MSG_CTRUNC) != 0;
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  return false;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+bool ancillary_data::push_back(int level, int type,
+    const void* data, std::size_t size) ASIO_NOEXCEPT
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  std::size_t space = CMSG_SPACE(size);
+  if (space > capacity_ - size_)
+    return false;
+
+  // Each message occupies the aligned space that CMSG_NXTHDR expects.
+  cmsghdr* cmsg = reinterpret_cast<cmsghdr*>(
+      static_cast<char*>(data_) + size_);
+  std::memset(cmsg, 0, space);
+  cmsg->cmsg_level = level;
+  cmsg->cmsg_type = type;
+  cmsg->cmsg_len = CMSG_LEN(size);
+  if (size)
+    std::memcpy(CMSG_DATA(cmsg), data, size);
+  size_ += space;
+  return true;
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)level;
+  (void)type;
+  (void)data;
+  (void)size;
+  return false;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+ancillary_data::const_iterator ancillary_data::begin() const ASIO_NOEXCEPT
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  msghdr msg = detail::make_cmsg_msghdr(data_, size_);
+  return const_iterator(this, size_ ? CMSG_FIRSTHDR(&msg) : 0);
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  return const_iterator(this, 0);
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+std::size_t ancillary_data::space(std::size_t data_size) ASIO_NOEXCEPT
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  return CMSG_SPACE(data_size);
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  return data_size;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+const void* ancillary_data::next(const void* header) const ASIO_NOEXCEPT
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  msghdr msg = detail::make_cmsg_msghdr(data_, size_);
+  return CMSG_NXTHDR(&msg,
+      const_cast<cmsghdr*>(static_cast<const cmsghdr*>(header)));
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)header;
+  return 0;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+void ancillary_data::load(const void* header, message& m) ASIO_NOEXCEPT
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  cmsghdr* cmsg = const_cast<cmsghdr*>(static_cast<const cmsghdr*>(header));
+  m.level_ = cmsg->cmsg_level;
+  m.type_ = cmsg->cmsg_type;
+  m.data_ = CMSG_DATA(cmsg);
+  m.size_ = cmsg->cmsg_len - CMSG_LEN(0);
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)header;
+  m = message();
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_ANCILLARY_DATA_IPP
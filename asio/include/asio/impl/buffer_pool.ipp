@@ -0,0 +1,103 @@
+//
+// impl/buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_BUFFER_POOL_IPP
+#define ASIO_IMPL_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include "asio/buffer_pool.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+buffer_pool::buffer_pool(std::size_t buffer_size, std::size_t buffer_count)
+  : region_(0),
+    buffer_size_(buffer_size),
+    stride_(0),
+    buffer_count_(buffer_count),
+    free_list_(0),
+    available_(buffer_count)
+{
+  // Each buffer starts on a cache line boundary, and is large enough to hold
+  // the link to the next free buffer. The region is over-allocated so that
+  // the first buffer can be aligned.
+  enum { line_size = 64 };
+  const std::size_t max_size = (std::numeric_limits<std::size_t>::max)();
+  stride_ = buffer_size < sizeof(void*) ? sizeof(void*) : buffer_size;
+  if (stride_ > max_size - (line_size - 1))
+  {
+    std::length_error ex("asio::buffer_pool too large");
+    asio::detail::throw_exception(ex);
+  }
+  stride_ = (stride_ + line_size - 1) / line_size * line_size;
+  if (buffer_count > (max_size - (line_size - 1)) / stride_)
+  {
+    std::length_error ex("asio::buffer_pool too large");
+    asio::detail::throw_exception(ex);
+  }
+  region_ = static_cast<unsigned char*>(
+      ::operator new(stride_ * buffer_count + (line_size - 1)));
+  std::size_t misalignment = reinterpret_cast<std::size_t>(region_) % line_size;
+  unsigned char* base = region_ + (misalignment ? line_size - misalignment : 0);
+
+  // Link the buffers in address order.
+  for (std::size_t i = buffer_count; i > 0; --i)
+  {
+    void* p = base + (i - 1) * stride_;
+    *static_cast<void**>(p) = free_list_;
+    free_list_ = p;
+  }
+}
+
+buffer_pool::~buffer_pool()
+{
+  ::operator delete(region_);
+}
+
+std::size_t buffer_pool::available() const
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  return available_;
+}
+
+void* buffer_pool::acquire()
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  void* p = free_list_;
+  if (p)
+  {
+    free_list_ = *static_cast<void**>(p);
+    --available_;
+  }
+  return p;
+}
+
+void buffer_pool::release(void* p)
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  *static_cast<void**>(p) = free_list_;
+  free_list_ = p;
+  ++available_;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_BUFFER_POOL_IPP
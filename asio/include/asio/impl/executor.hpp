@@ -21,6 +21,7 @@
 #include "asio/detail/global.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/type_traits.hpp"
 #include "asio/executor.hpp"
 #include "asio/system_executor.hpp"
 
@@ -32,36 +33,47 @@ namespace asio {
 
 #if defined(ASIO_HAS_MOVE)
 
-// Lightweight, move-only function object wrapper.
+// Lightweight, move-only function object wrapper. Function objects that are
+// small enough, and that cannot throw when moved, are held inline. Others are
+// wrapped in an operation allocated using the supplied allocator.
 class executor::function
 {
 public:
   template <typename F, typename Alloc>
   explicit function(F f, const Alloc& a)
+    : func_(0),
+      inline_ops_(0)
   {
-    // Allocate and construct an operation to wrap the function.
-    typedef detail::executor_function<F, Alloc> func_type;
-    typename func_type::ptr p = {
-      detail::addressof(a), func_type::ptr::allocate(a), 0 };
-    func_ = new (p.v) func_type(ASIO_MOVE_CAST(F)(f), a);
-    p.v = 0;
+    this->init(f, a, use_inline_storage<F>());
   }
 
   function(function&& other) ASIO_NOEXCEPT
-    : func_(other.func_)
+    : func_(other.func_),
+      inline_ops_(other.inline_ops_)
   {
+    if (inline_ops_)
+      inline_ops_->move(&other.storage_, &storage_);
     other.func_ = 0;
+    other.inline_ops_ = 0;
   }
 
   ~function()
   {
-    if (func_)
+    if (inline_ops_)
+      inline_ops_->complete(&storage_, false);
+    else if (func_)
       func_->destroy();
   }
 
   void operator()()
   {
-    if (func_)
+    if (inline_ops_)
+    {
+      const inline_ops* ops = inline_ops_;
+      inline_ops_ = 0;
+      ops->complete(&storage_, true);
+    }
+    else if (func_)
     {
       detail::executor_function_base* func = func_;
       func_ = 0;
@@ -70,7 +82,85 @@ public:
   }
 
 private:
+  // Storage for function objects that are small enough to be held inline.
+  union storage_type
+  {
+    void* pointer_;
+    double number_;
+    unsigned char data_[6 * sizeof(void*)];
+  };
+
+  // Operations on a function object held inline.
+  struct inline_ops
+  {
+    // Move the function object to new storage, destroying the original.
+    void (*move)(void* from, void* to);
+
+    // Destroy the function object, first invoking it if required.
+    void (*complete)(void* storage, bool call);
+  };
+
+  // Determine whether a function object may be held inline.
+  template <typename F>
+  struct use_inline_storage
+    : integral_constant<bool,
+#if defined(ASIO_HAS_ALIGNOF)
+        sizeof(F) <= sizeof(storage_type)
+          && ASIO_ALIGNOF(F) <= ASIO_ALIGNOF(storage_type)
+          && is_nothrow_move_constructible<F>::value
+#else // defined(ASIO_HAS_ALIGNOF)
+        false
+#endif // defined(ASIO_HAS_ALIGNOF)
+      >
+  {
+  };
+
+  template <typename F, typename Alloc>
+  void init(F& f, const Alloc&, true_type)
+  {
+    static const inline_ops ops = { &function::move<F>, &function::complete<F> };
+    new (&storage_) F(ASIO_MOVE_CAST(F)(f));
+    inline_ops_ = &ops;
+  }
+
+  template <typename F, typename Alloc>
+  void init(F& f, const Alloc& a, false_type)
+  {
+    // Allocate and construct an operation to wrap the function.
+    typedef detail::executor_function<F, Alloc> func_type;
+    typename func_type::ptr p = {
+      detail::addressof(a), func_type::ptr::allocate(a), 0 };
+    func_ = new (p.v) func_type(ASIO_MOVE_CAST(F)(f), a);
+    p.v = 0;
+  }
+
+  template <typename F>
+  static void move(void* from, void* to)
+  {
+    F* f = static_cast<F*>(from);
+    new (to) F(ASIO_MOVE_CAST(F)(*f));
+    f->~F();
+  }
+
+  template <typename F>
+  static void complete(void* storage, bool call)
+  {
+    // Move the function out of the storage before the upcall is made, so that
+    // the wrapper no longer owns it if the upcall throws.
+    F* f = static_cast<F*>(storage);
+    F function(ASIO_MOVE_CAST(F)(*f));
+    f->~F();
+
+    // Make the upcall if required.
+    if (call)
+    {
+      function();
+    }
+  }
+
   detail::executor_function_base* func_;
+  const inline_ops* inline_ops_;
+  storage_type storage_;
 };
 
 #else // defined(ASIO_HAS_MOVE)
@@ -122,6 +212,90 @@ private:
 
 #endif // defined(ASIO_HAS_MOVE)
 
+// Polymorphic implementation for executors that are held inline.
+template <typename Executor, typename Allocator>
+class executor::inline_impl
+  : public executor::impl_base
+{
+public:
+  inline_impl(const Executor& e, const Allocator& a) ASIO_NOEXCEPT
+    : impl_base(false),
+      allocator_(a),
+      executor_(e)
+  {
+  }
+
+  impl_base* clone(void* buffer) const ASIO_NOEXCEPT
+  {
+    return new (buffer) inline_impl(executor_, allocator_);
+  }
+
+  void destroy() ASIO_NOEXCEPT
+  {
+    this->~inline_impl();
+  }
+
+  void on_work_started() ASIO_NOEXCEPT
+  {
+    executor_.on_work_started();
+  }
+
+  void on_work_finished() ASIO_NOEXCEPT
+  {
+    executor_.on_work_finished();
+  }
+
+  execution_context& context() ASIO_NOEXCEPT
+  {
+    return executor_.context();
+  }
+
+  void dispatch(ASIO_MOVE_ARG(function) f)
+  {
+    executor_.dispatch(ASIO_MOVE_CAST(function)(f), allocator_);
+  }
+
+  void post(ASIO_MOVE_ARG(function) f)
+  {
+    executor_.post(ASIO_MOVE_CAST(function)(f), allocator_);
+  }
+
+  void defer(ASIO_MOVE_ARG(function) f)
+  {
+    executor_.defer(ASIO_MOVE_CAST(function)(f), allocator_);
+  }
+
+  type_id_result_type target_type() const ASIO_NOEXCEPT
+  {
+    return type_id<Executor>();
+  }
+
+  void* target() ASIO_NOEXCEPT
+  {
+    return &executor_;
+  }
+
+  const void* target() const ASIO_NOEXCEPT
+  {
+    return &executor_;
+  }
+
+  bool equals(const impl_base* e) const ASIO_NOEXCEPT
+  {
+    if (this == e)
+      return true;
+    if (target_type() != e->target_type())
+      return false;
+    return executor_ == *static_cast<const Executor*>(e->target());
+  }
+
+private:
+  // The allocator is declared first so that, when it is empty, it may occupy
+  // the padding at the end of the base class.
+  Allocator allocator_;
+  Executor executor_;
+};
+
 // Default polymorphic allocator implementation.
 template <typename Executor, typename Allocator>
 class executor::impl
@@ -130,12 +304,10 @@ class executor::impl
 public:
   typedef ASIO_REBIND_ALLOC(Allocator, impl) allocator_type;
 
-  static impl_base* create(const Executor& e, Allocator a = Allocator())
+  static impl_base* create(const Executor& e,
+      const Allocator& a, void* buffer)
   {
-    raw_mem mem(a);
-    impl* p = new (mem.ptr_) impl(e, a);
-    mem.ptr_ = 0;
-    return p;
+    return create(e, a, buffer, use_inline_storage());
   }
 
   impl(const Executor& e, const Allocator& a) ASIO_NOEXCEPT
@@ -146,7 +318,7 @@ public:
   {
   }
 
-  impl_base* clone() const ASIO_NOEXCEPT
+  impl_base* clone(void*) const ASIO_NOEXCEPT
   {
     ++ref_count_;
     return const_cast<impl_base*>(static_cast<const impl_base*>(this));
@@ -218,6 +390,32 @@ public:
   }
 
 private:
+  // Determine whether the executor may be held inline.
+  typedef inline_impl<Executor, Allocator> inline_impl_type;
+  typedef integral_constant<bool,
+#if defined(ASIO_HAS_ALIGNOF)
+    sizeof(inline_impl_type) <= sizeof(storage_type)
+      && ASIO_ALIGNOF(inline_impl_type) <= ASIO_ALIGNOF(storage_type)
+#else // defined(ASIO_HAS_ALIGNOF)
+    false
+#endif // defined(ASIO_HAS_ALIGNOF)
+    > use_inline_storage;
+
+  static impl_base* create(const Executor& e,
+      const Allocator& a, void* buffer, true_type)
+  {
+    return new (buffer) inline_impl_type(e, a);
+  }
+
+  static impl_base* create(const Executor& e,
+      const Allocator& a, void*, false_type)
+  {
+    raw_mem mem(a);
+    impl* p = new (mem.ptr_) impl(e, a);
+    mem.ptr_ = 0;
+    return p;
+  }
+
   mutable detail::atomic_count ref_count_;
   Executor executor_;
   Allocator allocator_;
@@ -253,7 +451,7 @@ class executor::impl<system_executor, Allocator>
 {
 public:
   static impl_base* create(const system_executor&,
-      const Allocator& = Allocator())
+      const Allocator&, void*)
   {
     return &detail::global<impl<system_executor, std::allocator<void> > >();
   }
@@ -263,7 +461,7 @@ public:
   {
   }
 
-  impl_base* clone() const ASIO_NOEXCEPT
+  impl_base* clone(void*) const ASIO_NOEXCEPT
   {
     return const_cast<impl_base*>(static_cast<const impl_base*>(this));
   }
@@ -329,13 +527,14 @@ private:
 
 template <typename Executor>
 executor::executor(Executor e)
-  : impl_(impl<Executor, std::allocator<void> >::create(e))
+  : impl_(impl<Executor, std::allocator<void> >::create(
+        e, std::allocator<void>(), &storage_))
 {
 }
 
 template <typename Executor, typename Allocator>
 executor::executor(allocator_arg_t, const Allocator& a, Executor e)
-  : impl_(impl<Executor, Allocator>::create(e, a))
+  : impl_(impl<Executor, Allocator>::create(e, a, &storage_))
 {
 }
 
@@ -45,10 +45,28 @@ io_context::io_context(int concurrency_hint)
 {
 }
 
+io_context::io_context(memory_resource& resource)
+  : impl_(add_impl(new impl_type(*this,
+          ASIO_CONCURRENCY_HINT_DEFAULT, false, &resource)))
+{
+}
+
+io_context::io_context(int concurrency_hint, memory_resource& resource)
+  : impl_(add_impl(new impl_type(*this, concurrency_hint == 1
+          ? ASIO_CONCURRENCY_HINT_1 : concurrency_hint, false, &resource)))
+{
+}
+
 io_context::impl_type& io_context::add_impl(io_context::impl_type* impl)
 {
   asio::detail::scoped_ptr<impl_type> scoped_impl(impl);
   asio::add_service<impl_type>(*this, scoped_impl.get());
+#if !defined(ASIO_HAS_IOCP)
+  // Threads that post without locking wake the running thread by interrupting
+  // the task, so it must exist before the io_context is shared.
+  if (ASIO_CONCURRENCY_HINT_IS_LOCK_FREE_POST(impl->concurrency_hint()))
+    impl->init_task();
+#endif // !defined(ASIO_HAS_IOCP)
   return *scoped_impl.release();
 }
 
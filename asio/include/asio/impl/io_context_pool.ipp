@@ -0,0 +1,145 @@
+//
+// impl/io_context_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_IO_CONTEXT_POOL_IPP
+#define ASIO_IMPL_IO_CONTEXT_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/io_context_pool.hpp"
+#include "asio/detail/thread.hpp"
+#include "asio/detail/thread_affinity.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+struct io_context_pool::thread_function
+{
+  io_context* io_context_;
+  std::size_t cpu_index_;
+  affinity_type affinity_;
+
+  void operator()()
+  {
+    if (affinity_ != no_affinity)
+    {
+      asio::error_code ec;
+      detail::bind_this_thread_to_cpu(cpu_index_,
+          affinity_ == numa_affinity, ec);
+    }
+
+    io_context_->run();
+  }
+};
+
+io_context_pool::io_context_pool()
+  : next_context_(0)
+{
+  start(0, cpu_affinity, ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST);
+}
+
+io_context_pool::io_context_pool(std::size_t num_contexts)
+  : next_context_(0)
+{
+  start(num_contexts, cpu_affinity,
+      ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST);
+}
+
+io_context_pool::io_context_pool(std::size_t num_contexts,
+    affinity_type affinity, int concurrency_hint)
+  : next_context_(0)
+{
+  start(num_contexts, affinity, concurrency_hint);
+}
+
+io_context_pool::~io_context_pool()
+{
+  stop();
+  join();
+}
+
+io_context_pool::executor_type io_context_pool::get_executor() ASIO_NOEXCEPT
+{
+  std::size_t index = static_cast<std::size_t>(++next_context_ - 1);
+  return contexts_[index % contexts_.size()]->get_executor();
+}
+
+io_context_pool::executor_type
+io_context_pool::get_least_loaded_executor() ASIO_NOEXCEPT
+{
+  std::size_t best_index = 0;
+  std::size_t best_load = ~static_cast<std::size_t>(0);
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+  {
+    std::size_t load = use_service<detail::io_context_impl>(
+        *contexts_[i]).outstanding_work();
+    if (load < best_load)
+    {
+      best_index = i;
+      best_load = load;
+    }
+  }
+  return contexts_[best_index]->get_executor();
+}
+
+io_context_pool::executor_type
+io_context_pool::get_executor_for_key(std::size_t key) ASIO_NOEXCEPT
+{
+  return contexts_[key % contexts_.size()]->get_executor();
+}
+
+void io_context_pool::stop()
+{
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    contexts_[i]->stop();
+}
+
+void io_context_pool::join()
+{
+  if (!threads_.empty())
+  {
+    for (std::size_t i = 0; i < contexts_.size(); ++i)
+      contexts_[i]->get_executor().on_work_finished();
+    threads_.join();
+  }
+}
+
+void io_context_pool::start(std::size_t num_contexts,
+    affinity_type affinity, int concurrency_hint)
+{
+  if (num_contexts == 0)
+    num_contexts = detail::thread::hardware_concurrency();
+  if (num_contexts == 0)
+    num_contexts = 1;
+
+  contexts_.reserve(num_contexts);
+  for (std::size_t i = 0; i < num_contexts; ++i)
+  {
+    contexts_.push_back(detail::shared_ptr<io_context>(
+          new io_context(concurrency_hint)));
+    contexts_.back()->get_executor().on_work_started();
+  }
+
+  for (std::size_t i = 0; i < num_contexts; ++i)
+  {
+    thread_function f = { contexts_[i].get(), i, affinity };
+    threads_.create_thread(f);
+  }
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_IO_CONTEXT_POOL_IPP
@@ -0,0 +1,116 @@
+//
+// impl/packet_timestamp.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_PACKET_TIMESTAMP_IPP
+#define ASIO_IMPL_PACKET_TIMESTAMP_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/packet_timestamp.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#if defined(__linux__)
+# include <linux/errqueue.h>
+#endif // defined(__linux__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+namespace detail {
+
+inline int64_t timespec_to_ns(const timespec& ts)
+{
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// The timestamps delivered with SCM_TIMESTAMPING: a software timestamp, an
+// unused legacy value, and a hardware timestamp.
+struct timestamping_data
+{
+  timespec ts[3];
+};
+
+} // namespace detail
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+packet_timestamp::packet_timestamp(
+    const ancillary_data& control) ASIO_NOEXCEPT
+  : event_(none),
+    software_(0),
+    hardware_(0),
+    id_(0)
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  for (ancillary_data::const_iterator i = control.begin();
+      i != control.end(); ++i)
+  {
+    if (i->level() == SOL_SOCKET)
+    {
+#if defined(SCM_TIMESTAMPING)
+      if (i->type() == SCM_TIMESTAMPING)
+      {
+        detail::timestamping_data data
+          = i->data_as<detail::timestamping_data>();
+        software_ = detail::timespec_to_ns(data.ts[0]);
+        hardware_ = detail::timespec_to_ns(data.ts[2]);
+      }
+#endif // defined(SCM_TIMESTAMPING)
+#if defined(SCM_TIMESTAMPNS)
+      if (i->type() == SCM_TIMESTAMPNS)
+        software_ = detail::timespec_to_ns(i->data_as<timespec>());
+#endif // defined(SCM_TIMESTAMPNS)
+#if defined(SCM_TIMESTAMP)
+      if (i->type() == SCM_TIMESTAMP && software_ == 0)
+      {
+        timeval tv = i->data_as<timeval>();
+        software_ = static_cast<int64_t>(tv.tv_sec) * 1000000000
+          + static_cast<int64_t>(tv.tv_usec) * 1000;
+      }
+#endif // defined(SCM_TIMESTAMP)
+    }
+#if defined(SO_EE_ORIGIN_TIMESTAMPING) && defined(IP_RECVERR)
+    else if ((i->level() == IPPROTO_IP && i->type() == IP_RECVERR)
+        || (i->level() == IPPROTO_IPV6 && i->type() == IPV6_RECVERR))
+    {
+      // A transmit timestamp read from the error queue identifies the packet
+      // and the event at which the timestamp was taken.
+      sock_extended_err err = i->data_as<sock_extended_err>();
+      if (err.ee_origin == SO_EE_ORIGIN_TIMESTAMPING)
+      {
+        id_ = err.ee_data;
+        switch (err.ee_info)
+        {
+        case SCM_TSTAMP_SCHED: event_ = scheduled; break;
+        case SCM_TSTAMP_SND: event_ = sent; break;
+        case SCM_TSTAMP_ACK: event_ = acknowledged; break;
+        default: break;
+        }
+      }
+    }
+#endif // defined(SO_EE_ORIGIN_TIMESTAMPING) && defined(IP_RECVERR)
+  }
+
+  if (event_ == none && (software_ != 0 || hardware_ != 0))
+    event_ = received;
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  (void)control;
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_PACKET_TIMESTAMP_IPP
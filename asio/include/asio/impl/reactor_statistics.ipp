@@ -0,0 +1,43 @@
+//
+// impl/reactor_statistics.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_REACTOR_STATISTICS_IPP
+#define ASIO_IMPL_REACTOR_STATISTICS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/reactor_statistics.hpp"
+
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/reactor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+reactor_statistics get_reactor_statistics(execution_context& ctx)
+{
+#if defined(ASIO_HAS_EPOLL)
+  if (has_service<detail::epoll_reactor>(ctx))
+    return use_service<detail::epoll_reactor>(ctx).statistics();
+#else // defined(ASIO_HAS_EPOLL)
+  (void)ctx;
+#endif // defined(ASIO_HAS_EPOLL)
+  return reactor_statistics();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_REACTOR_STATISTICS_IPP
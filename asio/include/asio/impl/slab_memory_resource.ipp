@@ -0,0 +1,233 @@
+//
+// impl/slab_memory_resource.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SLAB_MEMORY_RESOURCE_IPP
+#define ASIO_IMPL_SLAB_MEMORY_RESOURCE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <new>
+#include "asio/detail/throw_exception.hpp"
+#include "asio/slab_memory_resource.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+slab_memory_resource::slab_memory_resource(std::size_t capacity)
+  : region_(0),
+    owned_(0),
+    num_units_(0),
+    links_(0),
+    next_unit_(0),
+    heap_allocations_(0)
+{
+  // The region and the links are held in a single allocation, with room to
+  // align the start of the region.
+  std::size_t num_units = capacity / unit_size;
+  if (num_units > max_units)
+    num_units = max_units;
+  std::size_t region_size = num_units * unit_size + unit_size;
+  owned_ = ::operator new(region_size + num_units * sizeof(*links_));
+  init(owned_, region_size, num_units,
+      static_cast<unsigned char*>(owned_) + region_size);
+}
+
+slab_memory_resource::slab_memory_resource(void* buffer, std::size_t size)
+  : region_(0),
+    owned_(0),
+    num_units_(0),
+    links_(0),
+    next_unit_(0),
+    heap_allocations_(0)
+{
+  std::size_t num_units = size / unit_size;
+  if (num_units > max_units)
+    num_units = max_units;
+  owned_ = ::operator new(num_units * sizeof(*links_));
+  init(buffer, size, num_units, owned_);
+}
+
+slab_memory_resource::~slab_memory_resource()
+{
+  ::operator delete(owned_);
+}
+
+uint64_t slab_memory_resource::heap_allocations() const
+{
+#if defined(ASIO_HAS_STD_ATOMIC)
+  return heap_allocations_.load(std::memory_order_relaxed);
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  detail::mutex::scoped_lock lock(mutex_);
+  return heap_allocations_;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+}
+
+void* slab_memory_resource::do_allocate(
+    std::size_t bytes, std::size_t alignment)
+{
+  if (alignment > unit_size)
+    detail::throw_exception(std::bad_alloc());
+
+  int size_class = size_class_of(bytes);
+  if (size_class < num_size_classes)
+  {
+    if (void* p = pop(size_class))
+      return p;
+    if (void* p = carve(size_class))
+      return p;
+  }
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+  heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    ++heap_allocations_;
+  }
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+  return ::operator new(bytes);
+}
+
+void slab_memory_resource::do_deallocate(
+    void* p, std::size_t bytes, std::size_t /*alignment*/)
+{
+  unsigned char* mem = static_cast<unsigned char*>(p);
+  if (mem >= region_ && mem < region_ + num_units_ * unit_size)
+    push(size_class_of(bytes), p);
+  else
+    ::operator delete(p);
+}
+
+bool slab_memory_resource::do_is_equal(
+    const memory_resource& other) const ASIO_NOEXCEPT
+{
+  return this == &other;
+}
+
+void slab_memory_resource::init(void* buffer, std::size_t size,
+    std::size_t max_num_units, void* links_memory)
+{
+  std::size_t address = reinterpret_cast<std::size_t>(buffer);
+  std::size_t offset = (unit_size - address % unit_size) % unit_size;
+  std::size_t num_units = size > offset ? (size - offset) / unit_size : 0;
+  if (num_units > max_num_units)
+    num_units = max_num_units;
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+  links_ = static_cast<std::atomic<uint32_t>*>(links_memory);
+  for (std::size_t i = 0; i < num_units; ++i)
+    new (links_ + i) std::atomic<uint32_t>;
+  for (int i = 0; i < num_size_classes; ++i)
+    free_lists_[i].store(0, std::memory_order_relaxed);
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  links_ = static_cast<uint32_t*>(links_memory);
+  for (int i = 0; i < num_size_classes; ++i)
+    free_lists_[i] = 0;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+  region_ = static_cast<unsigned char*>(buffer) + offset;
+  num_units_ = num_units;
+}
+
+void* slab_memory_resource::pop(int size_class)
+{
+#if defined(ASIO_HAS_STD_ATOMIC)
+  // The modification count prevents a concurrent pop and push of the head
+  // block from going unnoticed. A stale link may be read from a block that has
+  // been taken by another thread, but the exchange then fails.
+  std::atomic<uint64_t>& head = free_lists_[size_class];
+  uint64_t old_head = head.load(std::memory_order_acquire);
+  for (;;)
+  {
+    uint32_t index = static_cast<uint32_t>(old_head);
+    if (index == 0)
+      return 0;
+
+    uint64_t new_head = (((old_head >> 32) + 1) << 32)
+      | links_[index - 1].load(std::memory_order_relaxed);
+    if (head.compare_exchange_weak(old_head, new_head,
+          std::memory_order_acquire, std::memory_order_acquire))
+      return region_ + (index - 1) * static_cast<std::size_t>(unit_size);
+  }
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  detail::mutex::scoped_lock lock(mutex_);
+  uint32_t index = free_lists_[size_class];
+  if (index == 0)
+    return 0;
+  free_lists_[size_class] = links_[index - 1];
+  return region_ + (index - 1) * static_cast<std::size_t>(unit_size);
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+}
+
+void slab_memory_resource::push(int size_class, void* p)
+{
+  uint32_t index = static_cast<uint32_t>(
+      (static_cast<unsigned char*>(p) - region_) / unit_size) + 1;
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+  std::atomic<uint64_t>& head = free_lists_[size_class];
+  uint64_t old_head = head.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    links_[index - 1].store(static_cast<uint32_t>(old_head),
+        std::memory_order_relaxed);
+    uint64_t new_head = (((old_head >> 32) + 1) << 32) | index;
+    if (head.compare_exchange_weak(old_head, new_head,
+          std::memory_order_release, std::memory_order_relaxed))
+      return;
+  }
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  detail::mutex::scoped_lock lock(mutex_);
+  links_[index - 1] = free_lists_[size_class];
+  free_lists_[size_class] = index;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+}
+
+void* slab_memory_resource::carve(int size_class)
+{
+  std::size_t units = static_cast<std::size_t>(1) << size_class;
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+  std::size_t unit = next_unit_.load(std::memory_order_relaxed);
+  do
+  {
+    if (num_units_ - unit < units)
+      return 0;
+  } while (!next_unit_.compare_exchange_weak(unit,
+        unit + units, std::memory_order_relaxed));
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  detail::mutex::scoped_lock lock(mutex_);
+  std::size_t unit = next_unit_;
+  if (num_units_ - unit < units)
+    return 0;
+  next_unit_ += units;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+  return region_ + unit * unit_size;
+}
+
+int slab_memory_resource::size_class_of(std::size_t bytes)
+{
+  int size_class = 0;
+  while (size_class < num_size_classes
+      && (static_cast<std::size_t>(unit_size) << size_class) < bytes)
+    ++size_class;
+  return size_class;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SLAB_MEMORY_RESOURCE_IPP
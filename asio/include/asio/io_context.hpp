@@ -20,10 +20,12 @@
 #include <stdexcept>
 #include <typeinfo>
 #include "asio/async_result.hpp"
+#include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/wrapped_handler.hpp"
 #include "asio/error_code.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/memory_resource.hpp"
 
 #if defined(ASIO_HAS_CHRONO)
 # include "asio/detail/chrono.hpp"
@@ -214,6 +216,38 @@ public:
    */
   ASIO_DECL explicit io_context(int concurrency_hint);
 
+  /// Constructor.
+  /**
+   * Construct with a memory resource for internal allocations.
+   *
+   * @param resource The memory resource from which the io_context allocates
+   * its per-descriptor state and timer queues. Threads that are running the
+   * io_context also allocate from it the memory used for handlers and
+   * asynchronous operations, unless a handler has its own associated allocator
+   * or allocation hooks. The resource must be safe for use from multiple
+   * threads, and must remain valid until the io_context has been destroyed and
+   * every handler that was allocated from the resource has been destroyed.
+   */
+  ASIO_DECL explicit io_context(memory_resource& resource);
+
+  /// Constructor.
+  /**
+   * Construct with a hint about the required level of concurrency and a
+   * memory resource for internal allocations.
+   *
+   * @param concurrency_hint A suggestion to the implementation on how many
+   * threads it should allow to run simultaneously.
+   *
+   * @param resource The memory resource from which the io_context allocates
+   * its per-descriptor state and timer queues. Threads that are running the
+   * io_context also allocate from it the memory used for handlers and
+   * asynchronous operations, unless a handler has its own associated allocator
+   * or allocation hooks. The resource must be safe for use from multiple
+   * threads, and must remain valid until the io_context has been destroyed and
+   * every handler that was allocated from the resource has been destroyed.
+   */
+  ASIO_DECL io_context(int concurrency_hint, memory_resource& resource);
+
   /// Destructor.
   /**
    * On destruction, the io_context performs the following sequence of
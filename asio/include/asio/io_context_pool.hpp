@@ -0,0 +1,237 @@
+//
+// io_context_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IO_CONTEXT_POOL_HPP
+#define ASIO_IO_CONTEXT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/concurrency_hint.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_group.hpp"
+#include "asio/io_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A pool of single-threaded I/O execution contexts.
+/**
+ * The io_context_pool class owns a fixed number of io_context objects and
+ * runs each of them on a thread of its own, optionally bound to a CPU. This
+ * "thread-per-core" arrangement avoids contention between threads on a shared
+ * scheduler, at the cost of requiring each connection, and all of the work
+ * associated with it, to stay on the io_context that it was assigned to.
+ *
+ * By default, the io_context objects are constructed with the concurrency
+ * hint @c ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST. This disables locking
+ * in the reactor I/O, and so I/O objects must only be used from within the
+ * thread that runs their io_context. Functions may still be submitted to any
+ * of the io_context objects from any thread, and are handed over to the
+ * io_context's thread through a lock-free queue.
+ *
+ * @par Selecting an io_context
+ *
+ * New work may be assigned to an io_context by obtaining one of its executors
+ * from the pool in one of three ways:
+ *
+ * @li @c get_executor() cycles through the io_context objects in turn.
+ *
+ * @li @c get_least_loaded_executor() selects the io_context that has the
+ * fewest units of outstanding work.
+ *
+ * @li @c get_executor_for_key() always selects the same io_context for a
+ * given key, so that related work is kept together.
+ *
+ * For example:
+ *
+ * @code asio::io_context_pool pool;
+ *
+ * // Accept connections on the first io_context, and spread them across the
+ * // pool. The acceptor is only used from within its io_context's thread.
+ * asio::ip::tcp::acceptor acceptor(pool.get_io_context(0), endpoint);
+ * asio::post(pool.get_io_context(0).get_executor(),
+ *     [&]{ start_accept(acceptor, pool); });
+ *
+ * ...
+ *
+ * void start_accept(asio::ip::tcp::acceptor& acceptor,
+ *     asio::io_context_pool& pool)
+ * {
+ *   acceptor.async_accept(pool.get_least_loaded_executor(),
+ *       [&](asio::error_code ec, asio::ip::tcp::socket socket)
+ *       {
+ *         if (!ec)
+ *           start_session(std::move(socket));
+ *         start_accept(acceptor, pool);
+ *       });
+ * }
+ *
+ * // Submit a function to the io_context responsible for a session.
+ * asio::post(pool.get_executor_for_key(session_id), my_task);
+ *
+ * ...
+ *
+ * // Wait for all work in the pool to complete.
+ * pool.join(); @endcode
+ */
+class io_context_pool
+  : private noncopyable
+{
+public:
+  /// The type of the executors associated with the pool's io_context objects.
+  typedef io_context::executor_type executor_type;
+
+  /// Determines how the pool's threads are bound to CPUs.
+  enum affinity_type
+  {
+    /// The threads are not bound to any CPU.
+    no_affinity,
+
+    /// Each thread is bound to a single CPU.
+    cpu_affinity,
+
+    /// Each thread is bound to all CPUs on the NUMA node of the CPU that it
+    /// would otherwise be bound to.
+    numa_affinity
+  };
+
+  /// Constructs a pool with one io_context per CPU.
+  /**
+   * Each thread is bound to a single CPU. The io_context objects are
+   * constructed with the concurrency hint
+   * @c ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST, and so socket and other
+   * I/O object operations must not be performed from any thread other than
+   * the one running the object's io_context.
+   */
+  ASIO_DECL io_context_pool();
+
+  /// Constructs a pool with a specified number of io_context objects.
+  /**
+   * Each thread is bound to a single CPU. The io_context objects are
+   * constructed with the concurrency hint
+   * @c ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST, and so socket and other
+   * I/O object operations must not be performed from any thread other than
+   * the one running the object's io_context.
+   *
+   * @param num_contexts The number of io_context objects and threads. If
+   * zero, the number of CPUs is used.
+   */
+  ASIO_DECL explicit io_context_pool(std::size_t num_contexts);
+
+  /// Constructs a pool with a specified number of io_context objects.
+  /**
+   * @param num_contexts The number of io_context objects and threads. If
+   * zero, the number of CPUs is used.
+   *
+   * @param affinity Determines how the threads are bound to CPUs. The thread
+   * for the io_context with index @c i is bound to the <tt>i</tt>th CPU that
+   * the process is permitted to run on, wrapping around if there are more
+   * io_context objects than CPUs. Binding is performed on a best effort basis,
+   * and failures are ignored.
+   *
+   * @param concurrency_hint The concurrency hint used to construct each
+   * io_context. The hint must not disable locking in the scheduler, as is
+   * done by @c ASIO_CONCURRENCY_HINT_UNSAFE, unless it also enables lock-free
+   * posting, as is done by @c ASIO_CONCURRENCY_HINT_UNSAFE_LOCK_FREE_POST.
+   * With the default hint, socket and other I/O object operations must not be
+   * performed from any thread other than the one running the object's
+   * io_context.
+   */
+  ASIO_DECL io_context_pool(std::size_t num_contexts, affinity_type affinity,
+      int concurrency_hint = ASIO_CONCURRENCY_HINT_UNSAFE_IO_LOCK_FREE_POST);
+
+  /// Destructor.
+  /**
+   * Automatically stops and joins the pool, if not explicitly done beforehand.
+   */
+  ASIO_DECL ~io_context_pool();
+
+  /// Get the number of io_context objects in the pool.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return contexts_.size();
+  }
+
+  /// Get the io_context with the specified index.
+  io_context& get_io_context(std::size_t index)
+  {
+    return *contexts_[index];
+  }
+
+  /// Obtain an executor, cycling through the io_context objects in turn.
+  ASIO_DECL executor_type get_executor() ASIO_NOEXCEPT;
+
+  /// Obtain an executor for the io_context with the least outstanding work.
+  /**
+   * The load of an io_context is measured by the number of unfinished
+   * asynchronous operations and queued functions associated with it. When
+   * several io_context objects are equally loaded, the one with the lowest
+   * index is selected.
+   */
+  ASIO_DECL executor_type get_least_loaded_executor() ASIO_NOEXCEPT;
+
+  /// Obtain an executor for the io_context associated with a key.
+  /**
+   * The same key always selects the same io_context.
+   *
+   * @param key A value that identifies the work, such as a hash of a
+   * connection's remote endpoint or a session identifier.
+   */
+  ASIO_DECL executor_type get_executor_for_key(std::size_t key) ASIO_NOEXCEPT;
+
+  /// Stops the threads.
+  /**
+   * This function stops each io_context as soon as possible. As a result of
+   * calling @c stop(), pending function objects may never be invoked.
+   */
+  ASIO_DECL void stop();
+
+  /// Joins the threads.
+  /**
+   * This function blocks until the threads in the pool have completed. If @c
+   * stop() is not called prior to @c join(), the @c join() call will wait
+   * until none of the io_context objects has any more outstanding work.
+   */
+  ASIO_DECL void join();
+
+private:
+  struct thread_function;
+
+  // Helper function to create the io_context objects and start the threads.
+  ASIO_DECL void start(std::size_t num_contexts,
+      affinity_type affinity, int concurrency_hint);
+
+  // The io_context objects in the pool.
+  std::vector<detail::shared_ptr<io_context> > contexts_;
+
+  // The next io_context to be selected by get_executor().
+  detail::atomic_count next_context_;
+
+  // The threads in the pool.
+  detail::thread_group threads_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/io_context_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IO_CONTEXT_POOL_HPP
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/basic_sharded_acceptor.hpp"
 #include "asio/basic_socket_acceptor.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_stream_socket.hpp"
@@ -84,6 +85,9 @@ public:
   /// The TCP acceptor type.
   typedef basic_socket_acceptor<tcp> acceptor;
 
+  /// The TCP sharded acceptor type.
+  typedef basic_sharded_acceptor<tcp> sharded_acceptor;
+
   /// The TCP resolver type.
   typedef basic_resolver<tcp> resolver;
 
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/basic_datagram_socket.hpp"
+#include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_endpoint.hpp"
 #include "asio/ip/basic_resolver.hpp"
@@ -81,6 +82,92 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+  /// Socket option for the size of the datagrams into which sent data is
+  /// divided.
+  /**
+   * Implements the IPPROTO_UDP/UDP_SEGMENT socket option. When set to a
+   * non-zero value, the payload of each send on the socket is divided into
+   * datagrams of this size by the kernel or the network interface, so that a
+   * single system call sends many datagrams. The size may also be given for
+   * an individual send using basic_datagram_socket::send_segments_to().
+   *
+   * On platforms without UDP segmentation offload, setting the option fails.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option(1200);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option;
+   * socket.get_option(option);
+   * int size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#elif defined(UDP_SEGMENT)
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_UDP), UDP_SEGMENT> segment_size;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> segment_size;
+#endif
+
+  /// Socket option to permit received datagrams to be coalesced.
+  /**
+   * Implements the IPPROTO_UDP/UDP_GRO socket option. When enabled, several
+   * datagrams of the same size from the same sender may be delivered to a
+   * single receive. Use basic_datagram_socket::receive_segments_from() to
+   * obtain the size of the individual datagrams.
+   *
+   * On platforms without UDP receive offload, setting the option fails.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_offload option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::receive_offload option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined receive_offload;
+#elif defined(UDP_GRO)
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_UDP), UDP_GRO> receive_offload;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> receive_offload;
+#endif
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
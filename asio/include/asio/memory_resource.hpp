@@ -0,0 +1,84 @@
+//
+// memory_resource.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_MEMORY_RESOURCE_HPP
+#define ASIO_MEMORY_RESOURCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// An abstract interface to a source of memory.
+/**
+ * The memory_resource class has the same interface as the C++17
+ * @c std::pmr::memory_resource class. An io_context may be constructed with a
+ * memory resource, which is then used for the memory that the io_context
+ * allocates internally on behalf of asynchronous operations.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Depends on the derived class. A memory resource that
+ * is used by an io_context must be safe for use from multiple threads.
+ */
+class memory_resource
+{
+public:
+  /// Destructor.
+  virtual ~memory_resource()
+  {
+  }
+
+  /// Allocate memory of at least the specified size and alignment.
+  void* allocate(std::size_t bytes,
+      std::size_t alignment = ASIO_DEFAULT_ALIGN)
+  {
+    return do_allocate(bytes, alignment);
+  }
+
+  /// Deallocate memory obtained from a previous call to allocate().
+  void deallocate(void* p, std::size_t bytes,
+      std::size_t alignment = ASIO_DEFAULT_ALIGN)
+  {
+    do_deallocate(p, bytes, alignment);
+  }
+
+  /// Determine whether memory allocated from one resource may be deallocated
+  /// by another.
+  bool is_equal(const memory_resource& other) const ASIO_NOEXCEPT
+  {
+    return do_is_equal(other);
+  }
+
+private:
+  /// Implements allocate(). Throws an exception if the memory cannot be
+  /// allocated.
+  virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+  /// Implements deallocate().
+  virtual void do_deallocate(void* p,
+      std::size_t bytes, std::size_t alignment) = 0;
+
+  /// Implements is_equal().
+  virtual bool do_is_equal(
+      const memory_resource& other) const ASIO_NOEXCEPT = 0;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_MEMORY_RESOURCE_HPP
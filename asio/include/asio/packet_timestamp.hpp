@@ -0,0 +1,154 @@
+//
+// packet_timestamp.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PACKET_TIMESTAMP_HPP
+#define ASIO_PACKET_TIMESTAMP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/ancillary_data.hpp"
+#include "asio/detail/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// The kernel or hardware timestamps of a received or transmitted packet.
+/**
+ * The packet_timestamp class extracts the timestamps that the operating system
+ * delivers as ancillary data, either with a received packet, when the
+ * socket_base::timestamp or socket_base::timestamping option is enabled, or
+ * with a transmit notification read from the socket's error queue.
+ *
+ * Software timestamps are taken from the system's real-time clock, and so may
+ * be compared with the current time to measure the delay between the arrival
+ * of a packet and its processing by the application. Hardware timestamps are
+ * taken from the clock of the network interface.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code unsigned char storage[128];
+ * asio::ancillary_data control(asio::buffer(storage));
+ * socket.set_option(asio::socket_base::timestamp(true));
+ * ...
+ * socket.receive_msg_from(asio::buffer(data), sender, control);
+ * asio::packet_timestamp ts(control);
+ * if (ts.has_software())
+ *   record_latency(now_in_nanoseconds() - ts.software());
+ * @endcode
+ */
+class packet_timestamp
+{
+public:
+  /// The events at which timestamps are taken.
+  enum event_type
+  {
+    /// No timestamp is available.
+    none,
+
+    /// The packet was received.
+    received,
+
+    /// The packet entered the packet scheduler for transmission.
+    scheduled,
+
+    /// The packet was passed to the network interface for transmission.
+    sent,
+
+    /// The peer acknowledged all data up to and including the packet.
+    acknowledged
+  };
+
+  /// Construct an object that holds no timestamps.
+  packet_timestamp() ASIO_NOEXCEPT
+    : event_(none),
+      software_(0),
+      hardware_(0),
+      id_(0)
+  {
+  }
+
+  /// Extract the timestamps from the ancillary data of a packet.
+  ASIO_DECL explicit packet_timestamp(
+      const ancillary_data& control) ASIO_NOEXCEPT;
+
+  /// Get the event at which the timestamps were taken.
+  event_type event() const ASIO_NOEXCEPT
+  {
+    return event_;
+  }
+
+  /// Determine whether a software timestamp is available.
+  bool has_software() const ASIO_NOEXCEPT
+  {
+    return software_ != 0;
+  }
+
+  /// Get the software timestamp, in nanoseconds since the epoch of the
+  /// system's real-time clock.
+  int64_t software() const ASIO_NOEXCEPT
+  {
+    return software_;
+  }
+
+  /// Determine whether a hardware timestamp is available.
+  bool has_hardware() const ASIO_NOEXCEPT
+  {
+    return hardware_ != 0;
+  }
+
+  /// Get the hardware timestamp, in nanoseconds, as given by the clock of the
+  /// network interface.
+  int64_t hardware() const ASIO_NOEXCEPT
+  {
+    return hardware_;
+  }
+
+  /// Get the identifier of the transmitted packet to which the timestamps
+  /// refer.
+  /**
+   * For a datagram socket with the @c SOF_TIMESTAMPING_OPT_ID flag set, this
+   * is a counter of the packets sent. For a stream socket, it is the offset
+   * in the stream of the last byte of the packet.
+   */
+  uint32_t id() const ASIO_NOEXCEPT
+  {
+    return id_;
+  }
+
+private:
+  // The event at which the timestamps were taken.
+  event_type event_;
+
+  // The software timestamp, in nanoseconds, or 0 if there is none.
+  int64_t software_;
+
+  // The hardware timestamp, in nanoseconds, or 0 if there is none.
+  int64_t hardware_;
+
+  // The identifier of a transmitted packet.
+  uint32_t id_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/packet_timestamp.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_PACKET_TIMESTAMP_HPP
@@ -0,0 +1,109 @@
+//
+// reactor_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_REACTOR_STATISTICS_HPP
+#define ASIO_REACTOR_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Counters describing how a reactor harvests events from the operating
+/// system.
+/**
+ * The counters are maintained by the @c epoll based reactor, and may be used
+ * to tune the event batch size and re-polling behaviour selected by the
+ * @c ASIO_CONCURRENCY_HINT_REACTOR_BATCH concurrency hint. Dividing events()
+ * by wakeups() gives the average number of events harvested per wakeup, while
+ * a large number of full_batches() indicates that the batch size is too small.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class reactor_statistics
+{
+public:
+  /// Construct with all counters set to zero.
+  reactor_statistics()
+    : wakeups_(0),
+      polls_(0),
+      events_(0),
+      full_batches_(0)
+  {
+  }
+
+  /// Construct with the specified counter values.
+  reactor_statistics(uint64_t wakeups, uint64_t polls,
+      uint64_t events, uint64_t full_batches)
+    : wakeups_(wakeups),
+      polls_(polls),
+      events_(events),
+      full_batches_(full_batches)
+  {
+  }
+
+  /// The number of times the reactor has been run to harvest events.
+  uint64_t wakeups() const
+  {
+    return wakeups_;
+  }
+
+  /// The number of system calls made to harvest events. This exceeds wakeups()
+  /// when re-polling is enabled.
+  uint64_t polls() const
+  {
+    return polls_;
+  }
+
+  /// The total number of events harvested.
+  uint64_t events() const
+  {
+    return events_;
+  }
+
+  /// The number of system calls that returned a full batch of events.
+  uint64_t full_batches() const
+  {
+    return full_batches_;
+  }
+
+private:
+  uint64_t wakeups_;
+  uint64_t polls_;
+  uint64_t events_;
+  uint64_t full_batches_;
+};
+
+/// Obtain the event harvesting counters for an execution context's reactor.
+/**
+ * @returns The current counter values. All counters are zero if the execution
+ * context has not yet created a reactor, or if the reactor implementation in
+ * use does not maintain them.
+ */
+ASIO_DECL reactor_statistics get_reactor_statistics(execution_context& ctx);
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/reactor_statistics.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_REACTOR_STATISTICS_HPP
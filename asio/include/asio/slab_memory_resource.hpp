@@ -0,0 +1,174 @@
+//
+// slab_memory_resource.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SLAB_MEMORY_RESOURCE_HPP
+#define ASIO_SLAB_MEMORY_RESOURCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/memory_resource.hpp"
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#else // defined(ASIO_HAS_STD_ATOMIC)
+# include "asio/detail/mutex.hpp"
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A memory resource that carves blocks from a single pre-reserved region.
+/**
+ * The slab_memory_resource class divides a contiguous region of memory into
+ * blocks with power-of-two sizes, from 64 bytes to 64 kilobytes. Blocks are
+ * carved from the region as they are first needed, and freed blocks are kept
+ * on a free list for each size, to be reused by later allocations of the same
+ * size class. Memory is never returned to the region until the resource is
+ * destroyed.
+ *
+ * Allocation and deallocation do not use locks where @c std::atomic is
+ * available. Requests that are larger than the largest block, and requests
+ * made when the region has been used up, are passed to the global
+ * <tt>operator new</tt>.
+ *
+ * The region may be supplied by the caller, for example so that it is local to
+ * the NUMA node of the threads that will run an io_context.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code asio::slab_memory_resource resource(16 * 1024 * 1024);
+ * asio::io_context io_context(resource); @endcode
+ */
+class slab_memory_resource
+  : public memory_resource,
+    private detail::noncopyable
+{
+public:
+  /// Construct with a region of the specified size, allocated from the heap.
+  ASIO_DECL explicit slab_memory_resource(std::size_t capacity);
+
+  /// Construct with a region supplied by the caller.
+  /**
+   * @param buffer The start of the region. Ownership of the region is not
+   * transferred, and it must remain valid until the resource is destroyed.
+   *
+   * @param size The size of the region, in bytes.
+   */
+  ASIO_DECL slab_memory_resource(void* buffer, std::size_t size);
+
+  /// Destructor. Releases the region, if it was allocated by the resource.
+  ASIO_DECL ~slab_memory_resource();
+
+  /// Get the number of bytes in the region that may be carved into blocks.
+  std::size_t capacity() const
+  {
+    return num_units_ * unit_size;
+  }
+
+  /// Get the number of allocations that were passed to the heap.
+  ASIO_DECL uint64_t heap_allocations() const;
+
+private:
+  // Implements allocate().
+  ASIO_DECL void* do_allocate(std::size_t bytes, std::size_t alignment);
+
+  // Implements deallocate().
+  ASIO_DECL void do_deallocate(void* p,
+      std::size_t bytes, std::size_t alignment);
+
+  // Implements is_equal().
+  ASIO_DECL bool do_is_equal(
+      const memory_resource& other) const ASIO_NOEXCEPT;
+
+  // Initialise the region and the links between free blocks.
+  ASIO_DECL void init(void* buffer, std::size_t size,
+      std::size_t max_num_units, void* links_memory);
+
+  // Take a block from a free list, or return null if the list is empty.
+  ASIO_DECL void* pop(int size_class);
+
+  // Return a block to a free list.
+  ASIO_DECL void push(int size_class, void* p);
+
+  // Carve a new block from the region, or return null if it is used up.
+  ASIO_DECL void* carve(int size_class);
+
+  // Find the smallest size class that can hold a request.
+  ASIO_DECL static int size_class_of(std::size_t bytes);
+
+  // The size of the smallest block. Blocks are aligned to this size.
+  enum { unit_size = 64 };
+
+  // The number of block sizes.
+  enum { num_size_classes = 11 };
+
+  // The maximum number of units in the region. Block indexes are 32 bits.
+  enum { max_units = 0x7FFFFFFF };
+
+  // The region from which blocks are carved.
+  unsigned char* region_;
+
+  // The memory allocated by the resource, holding the links and, unless it
+  // was supplied by the caller, the region.
+  void* owned_;
+
+  // The number of unit-sized pieces in the region.
+  std::size_t num_units_;
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+  // For each free block, the index plus one of the next block in its list.
+  std::atomic<uint32_t>* links_;
+
+  // The head of each free list, as the index plus one of the first block in
+  // the low 32 bits and a modification count in the high 32 bits.
+  std::atomic<uint64_t> free_lists_[num_size_classes];
+
+  // The index of the first unit that has not yet been carved.
+  std::atomic<std::size_t> next_unit_;
+
+  // The number of allocations passed to the heap.
+  std::atomic<uint64_t> heap_allocations_;
+#else // defined(ASIO_HAS_STD_ATOMIC)
+  // Mutex to protect access to internal data.
+  mutable detail::mutex mutex_;
+
+  // For each free block, the index plus one of the next block in its list.
+  uint32_t* links_;
+
+  // The index plus one of the first block in each free list.
+  uint32_t free_lists_[num_size_classes];
+
+  // The index of the first unit that has not yet been carved.
+  std::size_t next_unit_;
+
+  // The number of allocations passed to the heap.
+  uint64_t heap_allocations_;
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/slab_memory_resource.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SLAB_MEMORY_RESOURCE_HPP
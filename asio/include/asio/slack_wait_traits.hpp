@@ -0,0 +1,66 @@
+//
+// slack_wait_traits.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SLACK_WAIT_TRAITS_HPP
+#define ASIO_SLACK_WAIT_TRAITS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/detail/timer_slack.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Wait traits that allow timer expiries to be deferred and coalesced.
+/**
+ * When the basic_waitable_timer class template is instantiated with these
+ * wait traits, a wait on the timer may complete at any time in the interval
+ * [expiry, expiry + slack), where the slack is @c SlackUsec microseconds.
+ * The reactor wakes up only at multiples of the slack, measured from the
+ * clock's epoch, so that timers whose expiries fall within the same interval
+ * are all handled by a single wake up. Starting a wait that is to expire
+ * first does not require the reactor's timeout to be changed if the reactor is
+ * already due to wake up at the end of the same interval.
+ *
+ * @par Example
+ * @code typedef asio::basic_waitable_timer<
+ *     asio::chrono::steady_clock,
+ *     asio::slack_wait_traits<asio::chrono::steady_clock, 10000> >
+ *   lazy_timer;
+ *
+ * // Expires after between 100 and 110 milliseconds.
+ * lazy_timer timer(my_context, asio::chrono::milliseconds(100)); @endcode
+ */
+template <typename Clock, long SlackUsec = 1000>
+struct slack_wait_traits
+  : wait_traits<Clock>
+{
+  /// The slack allowed in a timer's expiry, in microseconds.
+  static const long slack_usec = SlackUsec;
+};
+
+template <typename Clock, long SlackUsec>
+const long slack_wait_traits<Clock, SlackUsec>::slack_usec;
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SLACK_WAIT_TRAITS_HPP
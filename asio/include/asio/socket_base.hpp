@@ -64,6 +64,9 @@ public:
 
   /// Specifies that the data marks the end of a record.
   static const int message_end_of_record = implementation_defined;
+
+  /// Receive queued errors, such as transmit timestamps, rather than data.
+  static const int message_error_queue = implementation_defined;
 #else
   ASIO_STATIC_CONSTANT(int,
       message_peek = ASIO_OS_DEF(MSG_PEEK));
@@ -73,6 +76,8 @@ public:
       message_do_not_route = ASIO_OS_DEF(MSG_DONTROUTE));
   ASIO_STATIC_CONSTANT(int,
       message_end_of_record = ASIO_OS_DEF(MSG_EOR));
+  ASIO_STATIC_CONSTANT(int,
+      message_error_queue = ASIO_OS_DEF(MSG_ERRQUEUE));
 #endif
 
   /// Wait types.
@@ -503,6 +508,97 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to receive a timestamp with each packet.
+  /**
+   * Implements the SOL_SOCKET/SO_TIMESTAMPNS socket option. When enabled, the
+   * time at which the kernel received each packet is delivered as ancillary
+   * data with the packet. Use a receive function that accepts an
+   * ancillary_data object, and packet_timestamp to extract the time.
+   *
+   * On platforms that do not support nanosecond receive timestamps, setting
+   * the option fails.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamp option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamp option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined timestamp;
+#elif defined(SO_TIMESTAMPNS)
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), SO_TIMESTAMPNS> timestamp;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> timestamp;
+#endif
+
+  /// Socket option to generate software or hardware timestamps for received
+  /// and transmitted packets.
+  /**
+   * Implements the SOL_SOCKET/SO_TIMESTAMPING socket option. The value is a
+   * combination of the @c SOF_TIMESTAMPING_ flags defined by the operating
+   * system in @c <linux/net_tstamp.h>. Receive timestamps are delivered as
+   * ancillary data with each packet. Transmit timestamps are queued on the
+   * socket's error queue, from which they are read by a receive function that
+   * accepts an ancillary_data object, using the message_error_queue flag. Use
+   * packet_timestamp to extract the times.
+   *
+   * On platforms that do not support timestamping, setting the option fails.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamping option(
+   *     SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE
+   *     | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_TSONLY);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamping option;
+   * socket.get_option(option);
+   * int flags = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined timestamping;
+#elif defined(SO_TIMESTAMPING)
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), SO_TIMESTAMPING> timestamping;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> timestamping;
+#endif
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
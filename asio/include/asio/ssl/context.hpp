@@ -19,6 +19,8 @@
 
 #include <string>
 #include "asio/buffer.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/executor.hpp"
 #include "asio/io_context.hpp"
 #include "asio/ssl/context_base.hpp"
 #include "asio/ssl/detail/openssl_types.hpp"
@@ -708,6 +710,216 @@ public:
   ASIO_SYNC_OP_VOID set_password_callback(PasswordCallback callback,
       asio::error_code& ec);
 
+  /// Enable the caching of client sessions for resumption.
+  /**
+   * This function is used to keep the sessions established by client streams
+   * using this context, so that later connections to the same server may
+   * resume them with an abbreviated handshake. Sessions are cached under the
+   * key set using stream::set_session_cache_key, or otherwise under the server
+   * name, and are not cached for streams that have neither. A TLS 1.3 session
+   * is used for only one resumption.
+   *
+   * @param max_sessions The maximum number of sessions held. When the cache is
+   * full, the least recently used session is discarded. A value of 0 disables
+   * the cache and discards its sessions.
+   *
+   * @param timeout The maximum number of seconds for which a session is held.
+   * A session is never held beyond the lifetime set by the server. A value of 0
+   * means that only the server's lifetime applies. A session cannot be resumed
+   * unless the connection on which it was established was shut down.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_session_cache_mode and
+   * @c SSL_CTX_sess_set_new_cb. The SSL implementation's own session cache is
+   * disabled, so a context used for client sessions should not also be used by
+   * servers.
+   */
+  ASIO_DECL void set_client_session_cache(
+      std::size_t max_sessions, long timeout);
+
+  /// Enable the caching of client sessions for resumption.
+  /**
+   * This function is used to keep the sessions established by client streams
+   * using this context, so that later connections to the same server may
+   * resume them with an abbreviated handshake. Sessions are cached under the
+   * key set using stream::set_session_cache_key, or otherwise under the server
+   * name, and are not cached for streams that have neither. A TLS 1.3 session
+   * is used for only one resumption.
+   *
+   * @param max_sessions The maximum number of sessions held. When the cache is
+   * full, the least recently used session is discarded. A value of 0 disables
+   * the cache and discards its sessions.
+   *
+   * @param timeout The maximum number of seconds for which a session is held.
+   * A session is never held beyond the lifetime set by the server. A value of 0
+   * means that only the server's lifetime applies. A session cannot be resumed
+   * unless the connection on which it was established was shut down.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set_session_cache_mode and
+   * @c SSL_CTX_sess_set_new_cb. The SSL implementation's own session cache is
+   * disabled, so a context used for client sessions should not also be used by
+   * servers.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_client_session_cache(
+      std::size_t max_sessions, long timeout, asio::error_code& ec);
+
+  /// Start protecting session tickets with a new random key.
+  /**
+   * This function is used by servers to generate a new key for protecting the
+   * session tickets issued to clients. Tickets protected by the two previous
+   * keys continue to be accepted, and clients presenting them are issued new
+   * tickets. It should be called periodically, so that a compromised key
+   * exposes only a limited number of sessions.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_tlsext_ticket_key_evp_cb or
+   * @c SSL_CTX_set_tlsext_ticket_key_cb.
+   */
+  ASIO_DECL void rotate_session_ticket_key();
+
+  /// Start protecting session tickets with a new random key.
+  /**
+   * This function is used by servers to generate a new key for protecting the
+   * session tickets issued to clients. Tickets protected by the two previous
+   * keys continue to be accepted, and clients presenting them are issued new
+   * tickets. It should be called periodically, so that a compromised key
+   * exposes only a limited number of sessions.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set_tlsext_ticket_key_evp_cb or
+   * @c SSL_CTX_set_tlsext_ticket_key_cb.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID rotate_session_ticket_key(
+      asio::error_code& ec);
+
+  /// Start protecting session tickets with the specified key.
+  /**
+   * This function is used by servers to install a new key for protecting the
+   * session tickets issued to clients. Tickets protected by the two previous
+   * keys continue to be accepted, and clients presenting them are issued new
+   * tickets. Installing the same key on several servers allows a session
+   * established with one server to be resumed with another.
+   *
+   * @param key A buffer containing the 80 byte key: a 16 byte key name,
+   * followed by a 32 byte HMAC-SHA256 key and a 32 byte AES-256 key.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_tlsext_ticket_key_evp_cb or
+   * @c SSL_CTX_set_tlsext_ticket_key_cb.
+   */
+  ASIO_DECL void rotate_session_ticket_key(const const_buffer& key);
+
+  /// Start protecting session tickets with the specified key.
+  /**
+   * This function is used by servers to install a new key for protecting the
+   * session tickets issued to clients. Tickets protected by the two previous
+   * keys continue to be accepted, and clients presenting them are issued new
+   * tickets. Installing the same key on several servers allows a session
+   * established with one server to be resumed with another.
+   *
+   * @param key A buffer containing the 80 byte key: a 16 byte key name,
+   * followed by a 32 byte HMAC-SHA256 key and a 32 byte AES-256 key.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set_tlsext_ticket_key_evp_cb or
+   * @c SSL_CTX_set_tlsext_ticket_key_cb.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID rotate_session_ticket_key(
+      const const_buffer& key, asio::error_code& ec);
+
+  /// Set the maximum amount of TLS 1.3 early data accepted by servers.
+  /**
+   * This function is used by servers to allow clients to send early data when
+   * resuming a session, using stream::write_early_data. The early data is
+   * received using stream::read_early_data.
+   *
+   * @param size The maximum number of bytes of early data. A value of 0
+   * disables early data.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_max_early_data and
+   * @c SSL_CTX_set_recv_max_early_data.
+   */
+  ASIO_DECL void set_max_early_data(std::size_t size);
+
+  /// Set the maximum amount of TLS 1.3 early data accepted by servers.
+  /**
+   * This function is used by servers to allow clients to send early data when
+   * resuming a session, using stream::write_early_data. The early data is
+   * received using stream::read_early_data.
+   *
+   * @param size The maximum number of bytes of early data. A value of 0
+   * disables early data.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c SSL_CTX_set_max_early_data and
+   * @c SSL_CTX_set_recv_max_early_data.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_max_early_data(
+      std::size_t size, asio::error_code& ec);
+
+  /// Set the executor on which the steps of asynchronous handshakes are
+  /// performed.
+  /**
+   * This function is used to move the CPU-intensive work of asynchronous
+   * handshakes, such as key exchange and signing, off the executors used for
+   * I/O. Each step of the handshake performed by a stream using this context is
+   * run on the specified executor, typically that of a @c thread_pool, after
+   * which the operation continues on the stream's executor. Blocking handshakes
+   * are unaffected.
+   *
+   * @param ex The executor. An empty executor means that the steps of the
+   * handshake are performed on the stream's executor.
+   *
+   * @note While a step is being performed, no other operation may be started on
+   * the stream. Verification callbacks are run on the specified executor.
+   */
+  ASIO_DECL void set_handshake_executor(const executor& ex);
+
+  /// Counters of the handshakes performed by streams using a context.
+  struct session_statistics
+  {
+    /// The number of buckets in the histogram of handshake latencies.
+    enum { latency_buckets = 24 };
+
+    /// The number of completed handshakes.
+    uint64_t handshakes;
+
+    /// The number of completed handshakes that resumed a previous session.
+    uint64_t resumed;
+
+    /// The number of client handshakes that found a session in the cache.
+    uint64_t cache_hits;
+
+    /// The number of client handshakes that found no session in the cache.
+    uint64_t cache_misses;
+
+    /// The number of completed handshakes in which early data was accepted.
+    uint64_t early_data_accepted;
+
+    /// The number of completed handshakes in which early data was rejected.
+    uint64_t early_data_rejected;
+
+    /// The histogram of handshake latencies, from the start of the handshake
+    /// to its completion. Element @c i counts the handshakes that took at least
+    /// 2^i microseconds and less than 2^(i+1) microseconds. The first element
+    /// also counts shorter handshakes, and the last element longer ones.
+    uint64_t handshake_latency[latency_buckets];
+  };
+
+  /// Get the counters of the handshakes performed by streams using the
+  /// context.
+  ASIO_DECL session_statistics get_session_statistics() const;
+
 private:
   struct bio_cleanup;
   struct x509_cleanup;
@@ -17,8 +17,11 @@
 
 #include "asio/detail/config.hpp"
 
+#include <string>
 #include "asio/buffer.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/static_mutex.hpp"
+#include "asio/executor.hpp"
 #include "asio/ssl/detail/openssl_types.hpp"
 #include "asio/ssl/detail/verify_callback.hpp"
 #include "asio/ssl/stream_base.hpp"
@@ -92,6 +95,33 @@ public:
   ASIO_DECL want read(const asio::mutable_buffer& data,
       asio::error_code& ec, std::size_t& bytes_transferred);
 
+  // Get the executor on which the steps of the handshake are to be performed.
+  // Returns an empty executor if the handshake has completed, or if its steps
+  // are to be performed inline.
+  ASIO_DECL asio::executor handshake_executor() const;
+
+  // Determine whether the handshake is still in progress.
+  ASIO_DECL bool in_handshake() const;
+
+  // Set the key under which a client's sessions are cached for resumption.
+  ASIO_DECL void set_session_cache_key(const std::string& key);
+
+  // Determine whether the handshake resumed a previous session.
+  ASIO_DECL bool session_resumed() const;
+
+  // Write early data to be sent with the client's first handshake message. No
+  // bytes are transferred if the session does not allow early data.
+  ASIO_DECL want write_early_data(const asio::const_buffer& data,
+      asio::error_code& ec, std::size_t& bytes_transferred);
+
+  // Read early data received with the client's first handshake message. No
+  // bytes are transferred once all early data has been read.
+  ASIO_DECL want read_early_data(const asio::mutable_buffer& data,
+      asio::error_code& ec, std::size_t& bytes_transferred);
+
+  // Determine whether the early data was accepted by the server.
+  ASIO_DECL bool early_data_accepted() const;
+
   // Get output data to be written to the transport.
   ASIO_DECL asio::mutable_buffer get_output(
       const asio::mutable_buffer& data);
@@ -106,6 +136,31 @@ public:
   ASIO_DECL const asio::error_code& map_error_code(
       asio::error_code& ec) const;
 
+  // Request that the session be offloaded to the kernel once the handshake
+  // has completed. Must be called before the handshake is started.
+  ASIO_DECL void enable_kernel_tls();
+
+  // Determine whether offload has been requested, the handshake has completed,
+  // and offload has not yet been attempted.
+  ASIO_DECL bool kernel_tls_ready() const;
+
+  // Attempt to offload the session to the kernel TLS implementation of the
+  // specified socket. A negative descriptor marks the attempt as made without
+  // offloading. Receive is not offloaded if input remains buffered in user
+  // space.
+  ASIO_DECL void start_kernel_tls(int descriptor, bool input_buffered);
+
+  // Determine whether records are being encrypted by the kernel.
+  ASIO_DECL bool kernel_tls_send() const;
+
+  // Determine whether records are being decrypted by the kernel.
+  ASIO_DECL bool kernel_tls_receive() const;
+
+  // Record that a close_notify alert was sent or received by the kernel, where
+  // mode is SSL_SENT_SHUTDOWN or SSL_RECEIVED_SHUTDOWN. Returns true if alerts
+  // have then been both sent and received.
+  ASIO_DECL bool mark_shutdown(int mode);
+
 private:
   // Disallow copying and assignment.
   engine(const engine&);
@@ -143,8 +198,92 @@ private:
   // Adapt the SSL_write function to the signature needed for perform().
   ASIO_DECL int do_write(void* data, std::size_t length);
 
+  // Offer a cached session to the server, if one has not yet been offered.
+  ASIO_DECL void prepare_client_session();
+
+  // Record the time at which the handshake started, if not already recorded.
+  ASIO_DECL void start_handshake_clock();
+
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  // Adapt the SSL_write_early_data function to the signature needed for
+  // perform().
+  ASIO_DECL int do_write_early_data(void* data, std::size_t length);
+
+  // Adapt the SSL_read_early_data function to the signature needed for
+  // perform().
+  ASIO_DECL int do_read_early_data(void* data, std::size_t length);
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+  // The crypto state for one direction of the session, as handed by the SSL
+  // implementation to a BIO that claims kernel support, together with the
+  // framing state needed to count the records that have since passed through.
+  struct kernel_tls_state
+  {
+    union
+    {
+      tls_crypto_info base;
+      tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+      tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+      tls12_crypto_info_aes_ccm_128 aes_ccm_128;
+# if defined(TLS_CIPHER_CHACHA20_POLY1305)
+      tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+# endif // defined(TLS_CIPHER_CHACHA20_POLY1305)
+    } info;
+    std::size_t info_size;
+    unsigned char header[5];
+    std::size_t header_size;
+    std::size_t body_remaining;
+    uint64_t records;
+  };
+
+  // Callbacks for the filter BIO that sits between the SSL implementation and
+  // the BIO pair, capturing the crypto state and counting records.
+  ASIO_DECL static int kernel_tls_bio_create(BIO* b);
+  ASIO_DECL static int kernel_tls_bio_write(BIO* b, const char* data, int size);
+  ASIO_DECL static int kernel_tls_bio_read(BIO* b, char* data, int size);
+  ASIO_DECL static long kernel_tls_bio_ctrl(
+      BIO* b, int cmd, long larg, void* parg);
+
+  // Update the framing state for data written or read by the SSL
+  // implementation.
+  ASIO_DECL static void kernel_tls_count(kernel_tls_state& state,
+      const unsigned char* data, std::size_t size);
+
+  // Install the crypto state for one direction into the kernel, advancing the
+  // record sequence number by the records counted since it was captured.
+  ASIO_DECL static bool kernel_tls_install(int descriptor,
+      int direction, kernel_tls_state& state);
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+
+  enum
+  {
+    kernel_tls_requested = 1,
+    kernel_tls_attempted = 2,
+    kernel_tls_sending = 4,
+    kernel_tls_receiving = 8
+  };
+
+  enum
+  {
+    session_prepared = 1,
+    session_recorded = 2,
+    early_data_finished = 4
+  };
+
   SSL* ssl_;
   BIO* ext_bio_;
+  int kernel_tls_flags_;
+  int session_flags_;
+  std::string session_cache_key_;
+  std::size_t early_data_written_;
+  uint64_t handshake_start_;
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+  BIO_METHOD* kernel_tls_method_;
+  kernel_tls_state kernel_tls_send_;
+  kernel_tls_state kernel_tls_receive_;
+#endif // defined(ASIO_HAS_KERNEL_TLS)
 };
 
 } // namespace detail
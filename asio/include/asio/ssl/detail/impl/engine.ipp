@@ -17,9 +17,11 @@
 
 #include "asio/detail/config.hpp"
 
+#include <cstring>
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/ssl/detail/engine.hpp"
+#include "asio/ssl/detail/session_state.hpp"
 #include "asio/ssl/error.hpp"
 #include "asio/ssl/verify_context.hpp"
 
@@ -30,7 +32,14 @@ namespace ssl {
 namespace detail {
 
 engine::engine(SSL_CTX* context)
-  : ssl_(::SSL_new(context))
+  : ssl_(::SSL_new(context)),
+    kernel_tls_flags_(0),
+    session_flags_(0),
+    early_data_written_(0),
+    handshake_start_(0)
+#if defined(ASIO_HAS_KERNEL_TLS)
+    , kernel_tls_method_(0)
+#endif // defined(ASIO_HAS_KERNEL_TLS)
 {
   if (!ssl_)
   {
@@ -65,6 +74,15 @@ engine::~engine()
 
   ::BIO_free(ext_bio_);
   ::SSL_free(ssl_);
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+  if (kernel_tls_method_)
+  {
+    ::OPENSSL_cleanse(&kernel_tls_send_, sizeof(kernel_tls_send_));
+    ::OPENSSL_cleanse(&kernel_tls_receive_, sizeof(kernel_tls_receive_));
+    ::BIO_meth_free(kernel_tls_method_);
+  }
+#endif // defined(ASIO_HAS_KERNEL_TLS)
 }
 
 SSL* engine::native_handle()
@@ -131,8 +149,23 @@ int engine::verify_callback_function(int preverified, X509_STORE_CTX* ctx)
 engine::want engine::handshake(
     stream_base::handshake_type type, asio::error_code& ec)
 {
-  return perform((type == asio::ssl::stream_base::client)
+  start_handshake_clock();
+  if (type == asio::ssl::stream_base::client)
+    prepare_client_session();
+
+  want w = perform((type == asio::ssl::stream_base::client)
       ? &engine::do_connect : &engine::do_accept, 0, 0, ec, 0);
+
+  // Record the outcome once the handshake has completed.
+  if (!ec && (w == want_nothing || w == want_output)
+      && (session_flags_ & session_recorded) == 0)
+  {
+    session_flags_ |= session_recorded;
+    if (session_state* state = session_state::get(::SSL_get_SSL_CTX(ssl_)))
+      state->handshake_completed(ssl_, handshake_start_);
+  }
+
+  return w;
 }
 
 engine::want engine::shutdown(asio::error_code& ec)
@@ -167,12 +200,121 @@ engine::want engine::read(const asio::mutable_buffer& data,
       data.size(), ec, &bytes_transferred);
 }
 
+asio::executor engine::handshake_executor() const
+{
+  if (::SSL_in_init(ssl_))
+    if (session_state* state = session_state::get(::SSL_get_SSL_CTX(ssl_)))
+      return state->get_handshake_executor();
+  return asio::executor();
+}
+
+bool engine::in_handshake() const
+{
+  return ::SSL_in_init(ssl_) != 0;
+}
+
+void engine::set_session_cache_key(const std::string& key)
+{
+  session_cache_key_ = key;
+  session_state::set_cache_key(ssl_, &session_cache_key_);
+}
+
+bool engine::session_resumed() const
+{
+  return ::SSL_session_reused(ssl_) != 0;
+}
+
+engine::want engine::write_early_data(const asio::const_buffer& data,
+    asio::error_code& ec, std::size_t& bytes_transferred)
+{
+  bytes_transferred = 0;
+
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  if (::SSL_in_before(ssl_))
+  {
+    ::SSL_set_connect_state(ssl_);
+    start_handshake_clock();
+    prepare_client_session();
+  }
+
+  // Early data may only be sent before the handshake has completed, and no
+  // more may be sent than the server advertised in the session ticket.
+  std::size_t max_size = 0;
+  if (::SSL_in_init(ssl_))
+    if (SSL_SESSION* session = ::SSL_get_session(ssl_))
+      max_size = ::SSL_SESSION_get_max_early_data(session);
+  std::size_t length = data.size();
+  if (early_data_written_ + length > max_size)
+    length = max_size > early_data_written_
+      ? max_size - early_data_written_ : 0;
+
+  if (length == 0)
+  {
+    ec = asio::error_code();
+    return engine::want_nothing;
+  }
+
+  want w = perform(&engine::do_write_early_data,
+      const_cast<void*>(data.data()), length, ec, &bytes_transferred);
+  early_data_written_ += bytes_transferred;
+  return w;
+#else // defined(ASIO_HAS_SSL_EARLY_DATA)
+  (void)data;
+  ec = asio::error_code();
+  return engine::want_nothing;
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+}
+
+engine::want engine::read_early_data(const asio::mutable_buffer& data,
+    asio::error_code& ec, std::size_t& bytes_transferred)
+{
+  bytes_transferred = 0;
+
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  if (::SSL_in_before(ssl_))
+  {
+    ::SSL_set_accept_state(ssl_);
+    start_handshake_clock();
+  }
+
+  if (data.size() == 0 || (session_flags_ & early_data_finished) != 0)
+  {
+    ec = asio::error_code();
+    return engine::want_nothing;
+  }
+
+  want w = perform(&engine::do_read_early_data,
+      data.data(), data.size(), ec, &bytes_transferred);
+  if (session_flags_ & early_data_finished)
+    bytes_transferred = 0;
+  return w;
+#else // defined(ASIO_HAS_SSL_EARLY_DATA)
+  (void)data;
+  ec = asio::error_code();
+  return engine::want_nothing;
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+}
+
+bool engine::early_data_accepted() const
+{
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  return ::SSL_get_early_data_status(ssl_) == SSL_EARLY_DATA_ACCEPTED;
+#else // defined(ASIO_HAS_SSL_EARLY_DATA)
+  return false;
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+}
+
 asio::mutable_buffer engine::get_output(
     const asio::mutable_buffer& data)
 {
   int length = ::BIO_read(ext_bio_,
       data.data(), static_cast<int>(data.size()));
 
+  // Once the kernel is encrypting records, any output generated by the engine
+  // would use a stale record sequence number, and so is discarded.
+  if (kernel_tls_flags_ & kernel_tls_sending)
+    length = 0;
+
   return asio::buffer(data,
       length > 0 ? static_cast<std::size_t>(length) : 0);
 }
@@ -217,6 +359,260 @@ const asio::error_code& engine::map_error_code(
   return ec;
 }
 
+void engine::enable_kernel_tls()
+{
+#if defined(ASIO_HAS_KERNEL_TLS)
+  if (kernel_tls_flags_ & kernel_tls_requested)
+    return;
+
+  kernel_tls_method_ = ::BIO_meth_new(
+      BIO_TYPE_FILTER, "asio kernel tls filter");
+  if (!kernel_tls_method_)
+    return;
+  ::BIO_meth_set_create(kernel_tls_method_, &engine::kernel_tls_bio_create);
+  ::BIO_meth_set_write(kernel_tls_method_, &engine::kernel_tls_bio_write);
+  ::BIO_meth_set_read(kernel_tls_method_, &engine::kernel_tls_bio_read);
+  ::BIO_meth_set_ctrl(kernel_tls_method_, &engine::kernel_tls_bio_ctrl);
+
+  ::BIO* filter_bio = ::BIO_new(kernel_tls_method_);
+  if (!filter_bio)
+    return;
+  ::BIO_set_data(filter_bio, this);
+
+  // Insert the filter in front of the internal half of the BIO pair. The SSL
+  // object then owns the whole chain.
+  ::BIO* int_bio = ::SSL_get_rbio(ssl_);
+  ::BIO_up_ref(int_bio);
+  ::BIO_push(filter_bio, int_bio);
+  ::SSL_set_bio(ssl_, filter_bio, filter_bio);
+
+  std::memset(&kernel_tls_send_, 0, sizeof(kernel_tls_send_));
+  std::memset(&kernel_tls_receive_, 0, sizeof(kernel_tls_receive_));
+
+  // Ask the SSL implementation to hand the negotiated keys to the BIO.
+  ::SSL_set_options(ssl_, SSL_OP_ENABLE_KTLS);
+
+  kernel_tls_flags_ |= kernel_tls_requested;
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+}
+
+bool engine::kernel_tls_ready() const
+{
+  return (kernel_tls_flags_ & (kernel_tls_requested | kernel_tls_attempted))
+    == kernel_tls_requested && ::SSL_is_init_finished(ssl_);
+}
+
+void engine::start_kernel_tls(int descriptor, bool input_buffered)
+{
+  kernel_tls_flags_ |= kernel_tls_attempted;
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+  // Sending can be offloaded only if the keys were captured and all output
+  // produced by the engine has been written to the transport.
+  if (descriptor >= 0 && kernel_tls_send_.info_size != 0
+      && kernel_tls_send_.header_size == 0
+      && ::BIO_ctrl_pending(ext_bio_) == 0
+      && ::setsockopt(descriptor, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0
+      && kernel_tls_install(descriptor, TLS_TX, kernel_tls_send_))
+  {
+    kernel_tls_flags_ |= kernel_tls_sending;
+    ::SSL_set_options(ssl_, SSL_OP_NO_RENEGOTIATION);
+
+    // Receiving can be offloaded only if no records have been read from the
+    // transport beyond those consumed by the engine.
+    if (!input_buffered && kernel_tls_receive_.info_size != 0
+        && kernel_tls_receive_.header_size == 0
+        && BIO_wpending(ext_bio_) == 0 && !::SSL_has_pending(ssl_)
+        && kernel_tls_install(descriptor, TLS_RX, kernel_tls_receive_))
+    {
+      kernel_tls_flags_ |= kernel_tls_receiving;
+    }
+  }
+
+  // The keys are no longer needed.
+  ::OPENSSL_cleanse(&kernel_tls_send_, sizeof(kernel_tls_send_));
+  ::OPENSSL_cleanse(&kernel_tls_receive_, sizeof(kernel_tls_receive_));
+#else // defined(ASIO_HAS_KERNEL_TLS)
+  (void)descriptor;
+  (void)input_buffered;
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+}
+
+bool engine::kernel_tls_send() const
+{
+  return (kernel_tls_flags_ & kernel_tls_sending) != 0;
+}
+
+bool engine::kernel_tls_receive() const
+{
+  return (kernel_tls_flags_ & kernel_tls_receiving) != 0;
+}
+
+bool engine::mark_shutdown(int mode)
+{
+  int state = ::SSL_get_shutdown(ssl_) | mode;
+  ::SSL_set_shutdown(ssl_, state);
+  return (state & (SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN))
+    == (SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+}
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+int engine::kernel_tls_bio_create(BIO* b)
+{
+  ::BIO_set_init(b, 1);
+  return 1;
+}
+
+int engine::kernel_tls_bio_write(BIO* b, const char* data, int size)
+{
+  ::BIO_clear_retry_flags(b);
+  int result = ::BIO_write(::BIO_next(b), data, size);
+  ::BIO_copy_next_retry(b);
+
+  if (result > 0)
+  {
+    engine* e = static_cast<engine*>(::BIO_get_data(b));
+    kernel_tls_count(e->kernel_tls_send_,
+        reinterpret_cast<const unsigned char*>(data),
+        static_cast<std::size_t>(result));
+  }
+
+  return result;
+}
+
+int engine::kernel_tls_bio_read(BIO* b, char* data, int size)
+{
+  ::BIO_clear_retry_flags(b);
+  int result = ::BIO_read(::BIO_next(b), data, size);
+  ::BIO_copy_next_retry(b);
+
+  if (result > 0)
+  {
+    engine* e = static_cast<engine*>(::BIO_get_data(b));
+    kernel_tls_count(e->kernel_tls_receive_,
+        reinterpret_cast<const unsigned char*>(data),
+        static_cast<std::size_t>(result));
+  }
+
+  return result;
+}
+
+long engine::kernel_tls_bio_ctrl(BIO* b, int cmd, long larg, void* parg)
+{
+  // The control used by the SSL implementation to pass the crypto state to a
+  // BIO. It is not part of the public OpenSSL API.
+  const int set_kernel_tls = 72;
+
+  if (cmd != set_kernel_tls || !parg)
+    return ::BIO_ctrl(::BIO_next(b), cmd, larg, parg);
+
+  engine* e = static_cast<engine*>(::BIO_get_data(b));
+  kernel_tls_state& state = larg ? e->kernel_tls_send_ : e->kernel_tls_receive_;
+
+  std::size_t size = 0;
+  switch (static_cast<const tls_crypto_info*>(parg)->cipher_type)
+  {
+  case TLS_CIPHER_AES_GCM_128:
+    size = sizeof(state.info.aes_gcm_128);
+    break;
+  case TLS_CIPHER_AES_GCM_256:
+    size = sizeof(state.info.aes_gcm_256);
+    break;
+  case TLS_CIPHER_AES_CCM_128:
+    size = sizeof(state.info.aes_ccm_128);
+    break;
+# if defined(TLS_CIPHER_CHACHA20_POLY1305)
+  case TLS_CIPHER_CHACHA20_POLY1305:
+    size = sizeof(state.info.chacha20_poly1305);
+    break;
+# endif // defined(TLS_CIPHER_CHACHA20_POLY1305)
+  default:
+    break;
+  }
+
+  // The keys take effect from the next record, so they are only usable if
+  // they arrive on a record boundary.
+  if (size != 0 && state.header_size == 0)
+  {
+    std::memcpy(&state.info, parg, size);
+    state.info_size = size;
+    state.records = 0;
+  }
+
+  // Decline, so that the SSL implementation continues to perform encryption
+  // until the handshake has completed.
+  return 0;
+}
+
+void engine::kernel_tls_count(kernel_tls_state& state,
+    const unsigned char* data, std::size_t size)
+{
+  while (size > 0)
+  {
+    if (state.header_size < sizeof(state.header))
+    {
+      state.header[state.header_size++] = *data++;
+      --size;
+      if (state.header_size == sizeof(state.header))
+      {
+        ++state.records;
+        state.body_remaining = (state.header[3] << 8) | state.header[4];
+        if (state.body_remaining == 0)
+          state.header_size = 0;
+      }
+    }
+    else
+    {
+      std::size_t length = size < state.body_remaining
+        ? size : state.body_remaining;
+      data += length;
+      size -= length;
+      state.body_remaining -= length;
+      if (state.body_remaining == 0)
+        state.header_size = 0;
+    }
+  }
+}
+
+bool engine::kernel_tls_install(int descriptor,
+    int direction, kernel_tls_state& state)
+{
+  unsigned char* sequence = 0;
+  switch (state.info.base.cipher_type)
+  {
+  case TLS_CIPHER_AES_GCM_128:
+    sequence = state.info.aes_gcm_128.rec_seq;
+    break;
+  case TLS_CIPHER_AES_GCM_256:
+    sequence = state.info.aes_gcm_256.rec_seq;
+    break;
+  case TLS_CIPHER_AES_CCM_128:
+    sequence = state.info.aes_ccm_128.rec_seq;
+    break;
+# if defined(TLS_CIPHER_CHACHA20_POLY1305)
+  case TLS_CIPHER_CHACHA20_POLY1305:
+    sequence = state.info.chacha20_poly1305.rec_seq;
+    break;
+# endif // defined(TLS_CIPHER_CHACHA20_POLY1305)
+  default:
+    return false;
+  }
+
+  // The big-endian sequence number must account for the records that the
+  // engine has processed using these keys.
+  uint64_t carry = state.records;
+  for (int i = 7; i >= 0 && carry != 0; --i)
+  {
+    carry += sequence[i];
+    sequence[i] = static_cast<unsigned char>(carry & 0xFF);
+    carry >>= 8;
+  }
+
+  return ::setsockopt(descriptor, SOL_TLS, direction, &state.info,
+      static_cast<socklen_t>(state.info_size)) == 0;
+}
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+
 #if (OPENSSL_VERSION_NUMBER < 0x10000000L)
 asio::detail::static_mutex& engine::accept_mutex()
 {
@@ -327,6 +723,50 @@ int engine::do_write(void* data, std::size_t length)
       length < INT_MAX ? static_cast<int>(length) : INT_MAX);
 }
 
+void engine::prepare_client_session()
+{
+  if ((session_flags_ & session_prepared) == 0)
+  {
+    session_flags_ |= session_prepared;
+    if (session_state* state = session_state::get(::SSL_get_SSL_CTX(ssl_)))
+      state->prepare_client(ssl_);
+  }
+}
+
+void engine::start_handshake_clock()
+{
+  if (handshake_start_ == 0)
+    handshake_start_ = session_state::now();
+}
+
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+int engine::do_write_early_data(void* data, std::size_t length)
+{
+  std::size_t written = 0;
+  int result = ::SSL_write_early_data(ssl_, data,
+      length < INT_MAX ? length : INT_MAX, &written);
+  return result > 0 ? static_cast<int>(written) : result;
+}
+
+int engine::do_read_early_data(void* data, std::size_t length)
+{
+  std::size_t bytes_read = 0;
+  switch (::SSL_read_early_data(ssl_, data,
+        length < INT_MAX ? length : INT_MAX, &bytes_read))
+  {
+  case SSL_READ_EARLY_DATA_SUCCESS:
+    return static_cast<int>(bytes_read);
+  case SSL_READ_EARLY_DATA_FINISH:
+    // Report success so that any handshake output is written. The caller
+    // sees that no bytes were transferred.
+    session_flags_ |= early_data_finished;
+    return 1;
+  default:
+    return 0;
+  }
+}
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+
 } // namespace detail
 } // namespace ssl
 } // namespace asio
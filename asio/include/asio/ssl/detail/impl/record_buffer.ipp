@@ -0,0 +1,98 @@
+//
+// ssl/detail/impl/record_buffer.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_IMPL_RECORD_BUFFER_IPP
+#define ASIO_SSL_DETAIL_IMPL_RECORD_BUFFER_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <new>
+#include "asio/detail/mutex.hpp"
+#include "asio/ssl/detail/record_buffer.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+struct record_buffer::cache
+{
+  cache()
+    : free_list_(0),
+      count_(0)
+  {
+  }
+
+  asio::detail::mutex mutex_;
+
+  // The first unused buffer. Each unused buffer holds a pointer to the next.
+  void* free_list_;
+
+  // The number of unused buffers.
+  std::size_t count_;
+};
+
+record_buffer::cache* record_buffer::get_cache()
+{
+  // The cache is never destroyed, so that buffers may still be returned to it
+  // by streams that are destroyed during static destruction.
+  static cache* c = new cache;
+  return c;
+}
+
+std::size_t record_buffer::cached()
+{
+  cache* c = get_cache();
+  asio::detail::mutex::scoped_lock lock(c->mutex_);
+  return c->count_;
+}
+
+void* record_buffer::allocate()
+{
+  cache* c = get_cache();
+  asio::detail::mutex::scoped_lock lock(c->mutex_);
+  if (void* p = c->free_list_)
+  {
+    c->free_list_ = *static_cast<void**>(p);
+    --c->count_;
+    return p;
+  }
+  lock.unlock();
+
+  return ::operator new(max_tls_record_size);
+}
+
+void record_buffer::deallocate(void* p)
+{
+  cache* c = get_cache();
+  asio::detail::mutex::scoped_lock lock(c->mutex_);
+  if (c->count_ < ASIO_SSL_RECORD_BUFFER_CACHE_SIZE)
+  {
+    *static_cast<void**>(p) = c->free_list_;
+    c->free_list_ = p;
+    ++c->count_;
+    return;
+  }
+  lock.unlock();
+
+  ::operator delete(p);
+}
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_IMPL_RECORD_BUFFER_IPP
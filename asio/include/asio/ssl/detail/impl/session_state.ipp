@@ -0,0 +1,447 @@
+//
+// ssl/detail/impl/session_state.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_IMPL_SESSION_STATE_IPP
+#define ASIO_SSL_DETAIL_IMPL_SESSION_STATE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstring>
+#include "asio/detail/chrono.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/detail/session_state.hpp"
+#include "asio/ssl/error.hpp"
+#include <openssl/rand.h>
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+# include <openssl/core_names.h>
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+session_state* session_state::get(SSL_CTX* ctx)
+{
+  return static_cast<session_state*>(
+      ::SSL_CTX_get_ex_data(ctx, context_index()));
+}
+
+session_state& session_state::attach(SSL_CTX* ctx)
+{
+  session_state* state = get(ctx);
+  if (!state)
+  {
+    state = new session_state;
+    ::SSL_CTX_set_ex_data(ctx, context_index(), state);
+  }
+  return *state;
+}
+
+void session_state::set_cache_key(SSL* ssl, const std::string* key)
+{
+  ::SSL_set_ex_data(ssl, cache_key_index(), const_cast<std::string*>(key));
+}
+
+void session_state::set_cache(SSL_CTX* ctx,
+    std::size_t max_sessions, long timeout)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  max_sessions_ = max_sessions;
+  timeout_ = timeout;
+  if (max_sessions_ == 0)
+  {
+    clear();
+    lock.unlock();
+
+    // Restore the default, which caches server sessions only.
+    ::SSL_CTX_sess_set_new_cb(ctx, 0);
+    ::SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+  }
+  else
+  {
+    while (cache_.size() > max_sessions_)
+    {
+      ::SSL_SESSION_free(cache_.back().session);
+      cache_index_.erase(cache_.back().key);
+      cache_.pop_back();
+    }
+    lock.unlock();
+
+    // Sessions are kept here rather than in the SSL implementation's own
+    // cache, which is keyed by session id and so cannot be searched by peer.
+    ::SSL_CTX_sess_set_new_cb(ctx, &session_state::new_session_callback);
+    ::SSL_CTX_set_session_cache_mode(ctx,
+        SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  }
+}
+
+std::size_t session_state::cache_size() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return cache_.size();
+}
+
+void session_state::prepare_client(SSL* ssl)
+{
+  std::string key = get_cache_key(ssl);
+  if (key.empty())
+    return;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (max_sessions_ == 0)
+    return;
+
+  SSL_SESSION* session = take(key);
+  if (session)
+    ++counters_.cache_hits;
+  else
+    ++counters_.cache_misses;
+  lock.unlock();
+
+  if (session)
+  {
+    ::SSL_set_session(ssl, session);
+    ::SSL_SESSION_free(session);
+  }
+}
+
+uint64_t session_state::now()
+{
+#if defined(ASIO_HAS_CHRONO)
+  return static_cast<uint64_t>(
+      chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+#else // defined(ASIO_HAS_CHRONO)
+  return 0;
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+void session_state::handshake_completed(SSL* ssl, uint64_t start)
+{
+  std::size_t bucket = 0;
+  if (start != 0)
+  {
+    uint64_t latency = now() - start;
+    while (bucket + 1 < latency_buckets && (latency >> (bucket + 1)) != 0)
+      ++bucket;
+  }
+
+  bool resumed = ::SSL_session_reused(ssl) != 0;
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  int early_data = ::SSL_get_early_data_status(ssl);
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  ++counters_.handshakes;
+  if (start != 0)
+    ++counters_.latency[bucket];
+  if (resumed)
+    ++counters_.resumed;
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  if (early_data == SSL_EARLY_DATA_ACCEPTED)
+    ++counters_.early_data_accepted;
+  else if (early_data == SSL_EARLY_DATA_REJECTED)
+    ++counters_.early_data_rejected;
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+}
+
+void session_state::set_handshake_executor(const asio::executor& ex)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  handshake_executor_ = ex;
+}
+
+asio::executor session_state::get_handshake_executor() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return handshake_executor_;
+}
+
+asio::error_code session_state::add_ticket_key(SSL_CTX* ctx,
+    const unsigned char* key, asio::error_code& ec)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  bool first = (ticket_key_count_ == 0);
+  for (std::size_t i = max_ticket_keys - 1; i > 0; --i)
+    ticket_keys_[i] = ticket_keys_[i - 1];
+  std::memcpy(ticket_keys_[0].name, key, 16);
+  std::memcpy(ticket_keys_[0].hmac_key, key + 16, 32);
+  std::memcpy(ticket_keys_[0].aes_key, key + 48, 32);
+  if (ticket_key_count_ < max_ticket_keys)
+    ++ticket_key_count_;
+  lock.unlock();
+
+  if (first)
+  {
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+    if (::SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx,
+          &session_state::ticket_key_callback) != 1)
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+    if (SSL_CTX_set_tlsext_ticket_key_cb(ctx,
+          &session_state::ticket_key_callback) != 1)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+    {
+      ec = asio::error_code(
+          static_cast<int>(::ERR_get_error()),
+          asio::error::get_ssl_category());
+      return ec;
+    }
+  }
+
+  ec = asio::error_code();
+  return ec;
+}
+
+session_state::counters session_state::get_counters() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return counters_;
+}
+
+session_state::session_state()
+  : max_sessions_(0),
+    timeout_(0),
+    ticket_key_count_(0)
+{
+  std::memset(ticket_keys_, 0, sizeof(ticket_keys_));
+  std::memset(&counters_, 0, sizeof(counters_));
+}
+
+session_state::~session_state()
+{
+  clear();
+  ::OPENSSL_cleanse(ticket_keys_, sizeof(ticket_keys_));
+}
+
+int session_state::context_index()
+{
+  static int index = ::SSL_CTX_get_ex_new_index(
+      0, 0, 0, 0, &session_state::free_callback);
+  return index;
+}
+
+int session_state::cache_key_index()
+{
+  static int index = ::SSL_get_ex_new_index(0, 0, 0, 0, 0);
+  return index;
+}
+
+void session_state::free_callback(void*, void* ptr,
+    CRYPTO_EX_DATA*, int, long, void*)
+{
+  delete static_cast<session_state*>(ptr);
+}
+
+int session_state::new_session_callback(SSL* ssl, SSL_SESSION* session)
+{
+  if (::SSL_is_server(ssl))
+    return 0;
+
+  session_state* state = get(::SSL_get_SSL_CTX(ssl));
+  if (!state)
+    return 0;
+
+  std::string key = get_cache_key(ssl);
+  if (key.empty())
+    return 0;
+
+  asio::detail::mutex::scoped_lock lock(state->mutex_);
+  if (state->max_sessions_ == 0)
+    return 0;
+
+  // Returning 1 transfers the caller's reference to the cache.
+  state->insert(key, session);
+  return 1;
+}
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+int session_state::ticket_key_callback(SSL* ssl, unsigned char* name,
+    unsigned char* iv, EVP_CIPHER_CTX* ctx, EVP_MAC_CTX* hctx, int enc)
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+int session_state::ticket_key_callback(SSL* ssl, unsigned char* name,
+    unsigned char* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hctx, int enc)
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+{
+  session_state* state = get(::SSL_get_SSL_CTX(ssl));
+  if (!state)
+    return enc ? -1 : 0;
+
+  ticket_key key;
+  int result = state->find_ticket_key(name, enc, key);
+  if (result == 0)
+    return enc ? -1 : 0;
+
+  const EVP_CIPHER* cipher = ::EVP_aes_256_cbc();
+  if (enc)
+  {
+    if (::RAND_bytes(iv, ::EVP_CIPHER_iv_length(cipher)) != 1)
+    {
+      ::OPENSSL_cleanse(&key, sizeof(key));
+      return -1;
+    }
+    std::memcpy(name, key.name, sizeof(key.name));
+  }
+
+  int ok = enc
+    ? ::EVP_EncryptInit_ex(ctx, cipher, 0, key.aes_key, iv)
+    : ::EVP_DecryptInit_ex(ctx, cipher, 0, key.aes_key, iv);
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+  OSSL_PARAM params[2];
+  params[0] = ::OSSL_PARAM_construct_utf8_string(
+      OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0);
+  params[1] = ::OSSL_PARAM_construct_end();
+  if (ok == 1)
+    ok = ::EVP_MAC_init(hctx, key.hmac_key, sizeof(key.hmac_key), params);
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+  if (ok == 1)
+    ok = ::HMAC_Init_ex(hctx, key.hmac_key,
+        sizeof(key.hmac_key), ::EVP_sha256(), 0);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+
+  ::OPENSSL_cleanse(&key, sizeof(key));
+  if (ok != 1)
+    return -1;
+
+  // A ticket protected by an older key is accepted, but the client is sent a
+  // new ticket that is protected by the current key. A TLS 1.3 client uses a
+  // ticket only once, and so is always sent a new one.
+#if defined(TLS1_3_VERSION)
+  if (!enc && ::SSL_version(ssl) >= TLS1_3_VERSION)
+    result = 2;
+#endif // defined(TLS1_3_VERSION)
+  return result;
+}
+
+std::string session_state::get_cache_key(SSL* ssl)
+{
+  if (const std::string* key = static_cast<const std::string*>(
+        ::SSL_get_ex_data(ssl, cache_key_index())))
+    if (!key->empty())
+      return *key;
+
+  if (const char* name = ::SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name))
+    return name;
+
+  return std::string();
+}
+
+void session_state::insert(const std::string& key, SSL_SESSION* session)
+{
+  std::time_t now = std::time(0);
+  std::time_t expiry = static_cast<std::time_t>(::SSL_SESSION_get_time(session)
+      + ::SSL_SESSION_get_timeout(session));
+  if (timeout_ > 0 && now + timeout_ < expiry)
+    expiry = now + timeout_;
+
+  cache_map::iterator iter = cache_index_.find(key);
+  if (iter != cache_index_.end())
+  {
+    ::SSL_SESSION_free(iter->second->session);
+    iter->second->session = session;
+    iter->second->expiry = expiry;
+    cache_.splice(cache_.begin(), cache_, iter->second);
+    return;
+  }
+
+  cache_entry entry = { key, session, expiry };
+  cache_.push_front(entry);
+  cache_index_[key] = cache_.begin();
+
+  while (cache_.size() > max_sessions_)
+  {
+    ::SSL_SESSION_free(cache_.back().session);
+    cache_index_.erase(cache_.back().key);
+    cache_.pop_back();
+  }
+}
+
+SSL_SESSION* session_state::take(const std::string& key)
+{
+  cache_map::iterator iter = cache_index_.find(key);
+  if (iter == cache_index_.end())
+    return 0;
+
+  cache_list::iterator entry = iter->second;
+  SSL_SESSION* session = entry->session;
+
+  if (std::time(0) >= entry->expiry)
+  {
+    ::SSL_SESSION_free(session);
+    cache_.erase(entry);
+    cache_index_.erase(iter);
+    return 0;
+  }
+
+#if defined(TLS1_3_VERSION) && (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  // A TLS 1.3 ticket should be used only once, so the session is handed over
+  // to the caller and removed from the cache.
+  if (::SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION)
+  {
+    cache_.erase(entry);
+    cache_index_.erase(iter);
+    return session;
+  }
+#endif // defined(TLS1_3_VERSION) && (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ::SSL_SESSION_up_ref(session);
+#else // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  ::CRYPTO_add(&session->references, 1, CRYPTO_LOCK_SSL_SESSION);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+  cache_.splice(cache_.begin(), cache_, entry);
+  return session;
+}
+
+void session_state::clear()
+{
+  for (cache_list::iterator iter = cache_.begin(); iter != cache_.end(); ++iter)
+    ::SSL_SESSION_free(iter->session);
+  cache_.clear();
+  cache_index_.clear();
+}
+
+int session_state::find_ticket_key(const unsigned char* name,
+    int enc, ticket_key& key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (ticket_key_count_ == 0)
+    return 0;
+
+  if (enc)
+  {
+    key = ticket_keys_[0];
+    return 1;
+  }
+
+  for (std::size_t i = 0; i < ticket_key_count_; ++i)
+  {
+    if (std::memcmp(name, ticket_keys_[i].name, 16) == 0)
+    {
+      key = ticket_keys_[i];
+      return i == 0 ? 1 : 2;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_IMPL_SESSION_STATE_IPP
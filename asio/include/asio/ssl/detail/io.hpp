@@ -17,6 +17,13 @@
 
 #include "asio/detail/config.hpp"
 
+#include "asio/basic_stream_socket.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/executor.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
 #include "asio/ssl/detail/engine.hpp"
 #include "asio/ssl/detail/stream_core.hpp"
 #include "asio/write.hpp"
@@ -41,14 +48,15 @@ std::size_t io(Stream& next_layer, stream_core& core,
     // the underlying transport.
     if (core.input_.size() == 0)
     {
-      core.input_ = asio::buffer(core.input_buffer_,
-          next_layer.read_some(core.input_buffer_, io_ec));
+      asio::mutable_buffer buffer = core.input_buffer();
+      core.input_ = asio::buffer(buffer,
+          next_layer.read_some(buffer, io_ec));
       if (!ec)
         ec = io_ec;
     }
 
     // Pass the new input data to the engine.
-    core.input_ = core.engine_.put_input(core.input_);
+    core.put_input();
 
     // Try the operation again.
     continue;
@@ -57,8 +65,8 @@ std::size_t io(Stream& next_layer, stream_core& core,
 
     // Get output data from the engine and write it to the underlying
     // transport.
-    asio::write(next_layer,
-        core.engine_.get_output(core.output_buffer_), io_ec);
+    asio::write(next_layer, core.get_output(), io_ec);
+    core.release_output_buffer();
     if (!ec)
       ec = io_ec;
 
@@ -69,8 +77,8 @@ std::size_t io(Stream& next_layer, stream_core& core,
 
     // Get output data from the engine and write it to the underlying
     // transport.
-    asio::write(next_layer,
-        core.engine_.get_output(core.output_buffer_), io_ec);
+    asio::write(next_layer, core.get_output(), io_ec);
+    core.release_output_buffer();
     if (!ec)
       ec = io_ec;
 
@@ -91,6 +99,98 @@ std::size_t io(Stream& next_layer, stream_core& core,
   return 0;
 }
 
+// Holds an io_op while it waits for a read or write on the underlying
+// transport to complete.
+template <typename Handler, typename Executor>
+class pending_io_op : public stream_core::pending_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(pending_io_op);
+
+  pending_io_op(Handler& handler, const Executor& ex)
+    : stream_core::pending_op(&pending_io_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      executor_(ex)
+  {
+  }
+
+  static void do_complete(stream_core::pending_op* base, bool resume)
+  {
+    // Take ownership of the handler object.
+    pending_io_op* o(static_cast<pending_io_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the operation is resumed.
+    Handler handler(ASIO_MOVE_CAST(Handler)(o->handler_));
+    Executor ex(o->executor_);
+    p.h = asio::detail::addressof(handler);
+    p.reset();
+
+    // The operation is resumed with a byte count that no transport read or
+    // write can produce, so that it knows to try again.
+    if (resume)
+    {
+      asio::post(ex, asio::detail::bind_handler(
+            ASIO_MOVE_CAST(Handler)(handler),
+            asio::error_code(), ~std::size_t(0)));
+    }
+  }
+
+private:
+  Handler handler_;
+  Executor executor_;
+};
+
+// Performs a step of an io_op's handshake on the handshake executor, and then
+// returns the io_op to the executor of the underlying transport. The work
+// guard keeps the transport's executor running in the meantime.
+template <typename IoOp, typename Executor>
+class handshake_step
+{
+public:
+  handshake_step(IoOp& op, const Executor& ex)
+    : op_(ASIO_MOVE_CAST(IoOp)(op)),
+      work_(ex)
+  {
+  }
+
+  void operator()()
+  {
+    asio::error_code ec;
+    op_.want_ = op_.op_(op_.core_.engine_, ec, op_.bytes_transferred_);
+    op_.offloaded_ = true;
+
+    // The result is passed back as the error code.
+    Executor ex(work_.get_executor());
+    asio::post(ex, asio::detail::bind_handler(
+          ASIO_MOVE_CAST(IoOp)(op_), ec, ~std::size_t(0)));
+    work_.reset();
+  }
+
+private:
+  IoOp op_;
+  executor_work_guard<Executor> work_;
+};
+
+// Only sockets can wait for readability. Other streams are read into the
+// input buffer directly, and so hold it while the read waits for data.
+
+template <typename Stream, typename Handler>
+inline bool async_wait_for_input(Stream&, Handler&)
+{
+  return false;
+}
+
+template <typename Protocol, typename Executor, typename Handler>
+inline bool async_wait_for_input(
+    basic_stream_socket<Protocol, Executor>& socket, Handler& handler)
+{
+  socket.async_wait(socket_base::wait_read,
+      ASIO_MOVE_CAST(Handler)(handler));
+  return true;
+}
+
 template <typename Stream, typename Operation, typename Handler>
 class io_op
 {
@@ -103,6 +203,9 @@ public:
       start_(0),
       want_(engine::want_nothing),
       bytes_transferred_(0),
+      handshake_executor_(core.engine_.handshake_executor()),
+      offloaded_(false),
+      waiting_for_input_(false),
       handler_(ASIO_MOVE_CAST(Handler)(handler))
   {
   }
@@ -116,6 +219,9 @@ public:
       want_(other.want_),
       ec_(other.ec_),
       bytes_transferred_(other.bytes_transferred_),
+      handshake_executor_(other.handshake_executor_),
+      offloaded_(other.offloaded_),
+      waiting_for_input_(other.waiting_for_input_),
       handler_(other.handler_)
   {
   }
@@ -128,6 +234,10 @@ public:
       want_(other.want_),
       ec_(other.ec_),
       bytes_transferred_(other.bytes_transferred_),
+      handshake_executor_(
+          ASIO_MOVE_CAST(asio::executor)(other.handshake_executor_)),
+      offloaded_(other.offloaded_),
+      waiting_for_input_(other.waiting_for_input_),
       handler_(ASIO_MOVE_CAST(Handler)(other.handler_))
   {
   }
@@ -141,7 +251,27 @@ public:
     case 1: // Called after at least one async operation.
       do
       {
-        switch (want_ = op_(core_.engine_, ec_, bytes_transferred_))
+        if (offloaded_)
+        {
+          // The step was performed on the handshake executor, which passed
+          // the result back as the error code.
+          offloaded_ = false;
+          ec_ = ec;
+        }
+        else if (handshake_executor_ && core_.engine_.in_handshake())
+        {
+          // Perform the step on the handshake executor, keeping the CPU-heavy
+          // work of the handshake off the transport's executor. Control
+          // resumes at the "default:" label below.
+          offload();
+          return;
+        }
+        else
+        {
+          want_ = op_(core_.engine_, ec_, bytes_transferred_);
+        }
+
+        switch (want_)
         {
         case engine::want_input_and_retry:
 
@@ -149,28 +279,33 @@ public:
           // engine and then retry the operation immediately.
           if (core_.input_.size() != 0)
           {
-            core_.input_ = core_.engine_.put_input(core_.input_);
+            core_.put_input();
             continue;
           }
 
           // The engine wants more data to be read from input. However, we
           // cannot allow more than one read operation at a time on the
-          // underlying transport. The pending_read_ timer's expiry is set to
-          // pos_infin if a read is in progress, and neg_infin otherwise.
-          if (core_.expiry(core_.pending_read_) == core_.neg_infin())
+          // underlying transport.
+          if (!core_.read_in_progress_)
           {
             // Prevent other read operations from being started.
-            core_.pending_read_.expires_at(core_.pos_infin());
+            core_.read_in_progress_ = true;
+
+            // Wait until the underlying transport is readable, if it can, so
+            // that an idle stream does not hold the input buffer.
+            waiting_for_input_ = true;
+            if (async_wait_for_input(next_layer_, *this))
+              return;
+            waiting_for_input_ = false;
 
             // Start reading some data from the underlying transport.
-            next_layer_.async_read_some(
-                asio::buffer(core_.input_buffer_),
+            next_layer_.async_read_some(core_.input_buffer(),
                 ASIO_MOVE_CAST(io_op)(*this));
           }
           else
           {
             // Wait until the current read operation completes.
-            core_.pending_read_.async_wait(ASIO_MOVE_CAST(io_op)(*this));
+            wait(core_.pending_reads_);
           }
 
           // Yield control until asynchronous operation completes. Control
@@ -182,22 +317,20 @@ public:
 
           // The engine wants some data to be written to the output. However, we
           // cannot allow more than one write operation at a time on the
-          // underlying transport. The pending_write_ timer's expiry is set to
-          // pos_infin if a write is in progress, and neg_infin otherwise.
-          if (core_.expiry(core_.pending_write_) == core_.neg_infin())
+          // underlying transport.
+          if (!core_.write_in_progress_)
           {
             // Prevent other write operations from being started.
-            core_.pending_write_.expires_at(core_.pos_infin());
+            core_.write_in_progress_ = true;
 
             // Start writing all the data to the underlying transport.
-            asio::async_write(next_layer_,
-                core_.engine_.get_output(core_.output_buffer_),
+            asio::async_write(next_layer_, core_.get_output(),
                 ASIO_MOVE_CAST(io_op)(*this));
           }
           else
           {
             // Wait until the current write operation completes.
-            core_.pending_write_.async_wait(ASIO_MOVE_CAST(io_op)(*this));
+            wait(core_.pending_writes_);
           }
 
           // Yield control until asynchronous operation completes. Control
@@ -213,8 +346,7 @@ public:
           // read so the handler runs "as-if" posted using io_context::post().
           if (start)
           {
-            next_layer_.async_read_some(
-                asio::buffer(core_.input_buffer_, 0),
+            next_layer_.async_read_some(asio::mutable_buffer(),
                 ASIO_MOVE_CAST(io_op)(*this));
 
             // Yield control until asynchronous operation completes. Control
@@ -229,8 +361,29 @@ public:
         }
 
         default:
+        if (waiting_for_input_)
+        {
+          waiting_for_input_ = false;
+          if (!ec)
+          {
+            // The underlying transport is readable, so the input buffer is
+            // needed only briefly.
+            next_layer_.async_read_some(core_.input_buffer(),
+                ASIO_MOVE_CAST(io_op)(*this));
+            return;
+          }
+
+          // The wait failed, so no data was read.
+          bytes_transferred = 0;
+        }
+
         if (bytes_transferred == ~std::size_t(0))
-          bytes_transferred = 0; // Timer cancellation, no data transferred.
+        {
+          // Resumed after waiting, with no data transferred. Try the
+          // operation again.
+          bytes_transferred = 0;
+          continue;
+        }
         else if (!ec_)
           ec_ = ec;
 
@@ -239,28 +392,33 @@ public:
         case engine::want_input_and_retry:
 
           // Add received data to the engine's input.
+          core_.read_in_progress_ = false;
           core_.input_ = asio::buffer(
-              core_.input_buffer_, bytes_transferred);
-          core_.input_ = core_.engine_.put_input(core_.input_);
+              core_.input_buffer(), bytes_transferred);
+          core_.put_input();
 
-          // Release any waiting read operations.
-          core_.pending_read_.expires_at(core_.neg_infin());
+          // Resume any waiting read operations.
+          stream_core::resume(core_.pending_reads_);
 
           // Try the operation again.
           continue;
 
         case engine::want_output_and_retry:
 
-          // Release any waiting write operations.
-          core_.pending_write_.expires_at(core_.neg_infin());
+          // Resume any waiting write operations.
+          core_.write_in_progress_ = false;
+          core_.release_output_buffer();
+          stream_core::resume(core_.pending_writes_);
 
           // Try the operation again.
           continue;
 
         case engine::want_output:
 
-          // Release any waiting write operations.
-          core_.pending_write_.expires_at(core_.neg_infin());
+          // Resume any waiting write operations.
+          core_.write_in_progress_ = false;
+          core_.release_output_buffer();
+          stream_core::resume(core_.pending_writes_);
 
           // Fall through to call handler.
 
@@ -281,6 +439,28 @@ public:
     }
   }
 
+  // Perform the next step of the operation on the handshake executor.
+  void offload()
+  {
+    // The executor is copied, as the operation is moved into the step.
+    typedef typename Stream::lowest_layer_type::executor_type executor_type;
+    asio::executor ex(handshake_executor_);
+    asio::post(ex, handshake_step<io_op, executor_type>(
+          *this, next_layer_.lowest_layer().get_executor()));
+  }
+
+  // Queue the operation until the current read or write completes.
+  void wait(asio::detail::op_queue<stream_core::pending_op>& ops)
+  {
+    typedef typename Stream::lowest_layer_type::executor_type executor_type;
+    typedef pending_io_op<io_op, executor_type> op;
+    typename op::ptr p = { asio::detail::addressof(*this),
+      op::ptr::allocate(*this), 0 };
+    p.p = new (p.v) op(*this, next_layer_.lowest_layer().get_executor());
+    ops.push(p.p);
+    p.v = p.p = 0;
+  }
+
 //private:
   Stream& next_layer_;
   stream_core& core_;
@@ -289,6 +469,9 @@ public:
   engine::want want_;
   asio::error_code ec_;
   std::size_t bytes_transferred_;
+  asio::executor handshake_executor_;
+  bool offloaded_;
+  bool waiting_for_input_;
   Handler handler_;
 };
 
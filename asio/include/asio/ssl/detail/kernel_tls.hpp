@@ -0,0 +1,546 @@
+//
+// ssl/detail/kernel_tls.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_KERNEL_TLS_HPP
+#define ASIO_SSL_DETAIL_KERNEL_TLS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/ssl/detail/io.hpp"
+#include "asio/ssl/detail/read_op.hpp"
+#include "asio/ssl/detail/shutdown_op.hpp"
+#include "asio/ssl/detail/stream_core.hpp"
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+# include "asio/basic_stream_socket.hpp"
+# include "asio/ssl/error.hpp"
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Only sockets can be offloaded to the kernel. For other streams the attempt
+// is recorded without offloading, so the remaining functions, which are used
+// only once offload is in effect, simply defer to the engine.
+
+template <typename Stream>
+inline void start_kernel_tls(Stream&, stream_core& core)
+{
+  core.engine_.start_kernel_tls(-1, true);
+}
+
+template <typename Stream, typename MutableBufferSequence>
+inline std::size_t kernel_tls_read(Stream& next_layer, stream_core& core,
+    const MutableBufferSequence& buffers, asio::error_code& ec)
+{
+  return io(next_layer, core, read_op<MutableBufferSequence>(buffers), ec);
+}
+
+template <typename Stream, typename MutableBufferSequence, typename Handler>
+inline void async_kernel_tls_read(Stream& next_layer, stream_core& core,
+    const MutableBufferSequence& buffers, Handler& handler)
+{
+  async_io(next_layer, core, read_op<MutableBufferSequence>(buffers), handler);
+}
+
+template <typename Stream>
+inline void kernel_tls_shutdown(Stream& next_layer,
+    stream_core& core, asio::error_code& ec)
+{
+  io(next_layer, core, shutdown_op(), ec);
+}
+
+template <typename Stream, typename Handler>
+inline void async_kernel_tls_shutdown(Stream& next_layer,
+    stream_core& core, Handler& handler)
+{
+  async_io(next_layer, core, shutdown_op(), handler);
+}
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+
+enum kernel_tls_content_type
+{
+  kernel_tls_alert = 21,
+  kernel_tls_handshake = 22,
+  kernel_tls_application_data = 23
+};
+
+template <typename Protocol, typename Executor>
+inline void start_kernel_tls(
+    basic_stream_socket<Protocol, Executor>& socket, stream_core& core)
+{
+  core.engine_.start_kernel_tls(
+      socket.native_handle(), core.input_.size() != 0);
+}
+
+// Check the type of a record received from the kernel. Returns false if the
+// record is to be ignored, and otherwise true, with ec set if the record ends
+// the session.
+template <typename MutableBufferSequence>
+bool kernel_tls_check_record(stream_core& core,
+    const MutableBufferSequence& buffers, std::size_t bytes_transferred,
+    asio::error_code& ec)
+{
+  if (ec || bytes_transferred == 0)
+  {
+    core.engine_.map_error_code(ec);
+    return true;
+  }
+
+  unsigned char type = kernel_tls_application_data;
+  for (ancillary_data::const_iterator iter = core.kernel_tls_control_.begin();
+      iter != core.kernel_tls_control_.end(); ++iter)
+  {
+    if (iter->level() == SOL_TLS && iter->type() == TLS_GET_RECORD_TYPE)
+      type = iter->data_as<unsigned char>();
+  }
+
+  if (type == kernel_tls_application_data)
+    return true;
+
+  unsigned char content[2] = { 0, 0 };
+  asio::buffer_copy(asio::buffer(content), buffers, bytes_transferred);
+
+  switch (type)
+  {
+  case kernel_tls_alert:
+    if (bytes_transferred >= 2 && content[1] == 0) // close_notify
+    {
+      core.engine_.mark_shutdown(SSL_RECEIVED_SHUTDOWN);
+      ec = asio::error::eof;
+    }
+    else
+    {
+      ec = asio::ssl::error::unexpected_result;
+    }
+    return true;
+
+  case kernel_tls_handshake:
+    // A hello request or a new session ticket requires no response.
+    if (content[0] == 0 || content[0] == 4)
+      return false;
+    ec = asio::ssl::error::unexpected_result;
+    return true;
+
+  default:
+    ec = asio::ssl::error::unexpected_result;
+    return true;
+  }
+}
+
+// Prepare the control message that makes the kernel send an alert record.
+inline const ancillary_data& kernel_tls_alert_control(stream_core& core)
+{
+  core.kernel_tls_alert_control_.clear();
+  core.kernel_tls_alert_control_.push_back(SOL_TLS, TLS_SET_RECORD_TYPE,
+      static_cast<unsigned char>(kernel_tls_alert));
+  return core.kernel_tls_alert_control_;
+}
+
+// The content of a close_notify alert.
+inline asio::const_buffer kernel_tls_close_notify()
+{
+  static const unsigned char alert[2] = { 1, 0 }; // warning, close_notify
+  return asio::buffer(alert);
+}
+
+template <typename Protocol, typename Executor, typename MutableBufferSequence>
+std::size_t kernel_tls_read(basic_stream_socket<Protocol, Executor>& socket,
+    stream_core& core, const MutableBufferSequence& buffers,
+    asio::error_code& ec)
+{
+  // A zero-sized read completes immediately without reading a record.
+  if (asio::buffer_size(buffers) == 0)
+    return socket.read_some(buffers, ec);
+
+  for (;;)
+  {
+    std::size_t bytes_transferred = socket.receive_msg(
+        buffers, core.kernel_tls_control_, 0, ec);
+    if (kernel_tls_check_record(core, buffers, bytes_transferred, ec))
+      return ec ? 0 : bytes_transferred;
+  }
+}
+
+template <typename Protocol, typename Executor>
+void kernel_tls_shutdown(basic_stream_socket<Protocol, Executor>& socket,
+    stream_core& core, asio::error_code& ec)
+{
+  // The kernel sends the close_notify alert as a record of its own.
+  socket.send_msg(kernel_tls_close_notify(),
+      kernel_tls_alert_control(core), 0, ec);
+  if (ec || core.engine_.mark_shutdown(SSL_SENT_SHUTDOWN))
+    return;
+
+  // If the engine is decrypting records it waits for the peer's alert.
+  if (!core.engine_.kernel_tls_receive())
+  {
+    io(socket, core, shutdown_op(), ec);
+    return;
+  }
+
+  // Otherwise discard application data until the peer's alert arrives.
+  while (!ec)
+  {
+    std::size_t bytes_transferred = socket.receive_msg(
+        core.input_buffer(), core.kernel_tls_control_, 0, ec);
+    kernel_tls_check_record(core,
+        core.input_buffer(), bytes_transferred, ec);
+  }
+  core.release_input_buffer();
+
+  if (ec == asio::error::eof)
+    ec = asio::error_code();
+}
+
+template <typename Socket, typename MutableBufferSequence, typename Handler>
+class kernel_tls_read_op
+{
+public:
+  kernel_tls_read_op(Socket& socket, stream_core& core,
+      const MutableBufferSequence& buffers, Handler& handler)
+    : socket_(socket),
+      core_(core),
+      buffers_(buffers),
+      start_(0),
+      handler_(ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  kernel_tls_read_op(const kernel_tls_read_op& other)
+    : socket_(other.socket_),
+      core_(other.core_),
+      buffers_(other.buffers_),
+      start_(other.start_),
+      handler_(other.handler_)
+  {
+  }
+
+  kernel_tls_read_op(kernel_tls_read_op&& other)
+    : socket_(other.socket_),
+      core_(other.core_),
+      buffers_(ASIO_MOVE_CAST(MutableBufferSequence)(other.buffers_)),
+      start_(other.start_),
+      handler_(ASIO_MOVE_CAST(Handler)(other.handler_))
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  void operator()(asio::error_code ec,
+      std::size_t bytes_transferred = 0, int start = 0)
+  {
+    switch (start_ = start)
+    {
+    case 1:
+      // A zero-sized read completes immediately without reading a record.
+      if (asio::buffer_size(buffers_) == 0)
+      {
+        socket_.async_read_some(buffers_,
+            ASIO_MOVE_CAST(kernel_tls_read_op)(*this));
+        return;
+      }
+
+      for (;;)
+      {
+        socket_.async_receive_msg(buffers_, core_.kernel_tls_control_,
+            ASIO_MOVE_CAST(kernel_tls_read_op)(*this));
+        return;
+
+      default:
+        if (kernel_tls_check_record(core_, buffers_, bytes_transferred, ec))
+          break;
+      }
+
+      handler_(static_cast<const asio::error_code&>(ec),
+          static_cast<const std::size_t&>(ec ? 0 : bytes_transferred));
+    }
+  }
+
+//private:
+  Socket& socket_;
+  stream_core& core_;
+  MutableBufferSequence buffers_;
+  int start_;
+  Handler handler_;
+};
+
+template <typename Socket, typename Handler>
+class kernel_tls_shutdown_op
+{
+public:
+  kernel_tls_shutdown_op(Socket& socket, stream_core& core, Handler& handler)
+    : socket_(socket),
+      core_(core),
+      start_(0),
+      sent_(false),
+      handler_(ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  kernel_tls_shutdown_op(const kernel_tls_shutdown_op& other)
+    : socket_(other.socket_),
+      core_(other.core_),
+      start_(other.start_),
+      sent_(other.sent_),
+      handler_(other.handler_)
+  {
+  }
+
+  kernel_tls_shutdown_op(kernel_tls_shutdown_op&& other)
+    : socket_(other.socket_),
+      core_(other.core_),
+      start_(other.start_),
+      sent_(other.sent_),
+      handler_(ASIO_MOVE_CAST(Handler)(other.handler_))
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  void operator()(asio::error_code ec,
+      std::size_t bytes_transferred = 0, int start = 0)
+  {
+    switch (start_ = start)
+    {
+    case 1:
+      // The kernel sends the close_notify alert as a record of its own.
+      socket_.async_send_msg(kernel_tls_close_notify(),
+          kernel_tls_alert_control(core_),
+          ASIO_MOVE_CAST(kernel_tls_shutdown_op)(*this));
+      return;
+
+    default:
+      if (!sent_)
+      {
+        sent_ = true;
+        if (ec || core_.engine_.mark_shutdown(SSL_SENT_SHUTDOWN))
+          break;
+
+        // If the engine is decrypting records it waits for the peer's alert.
+        if (!core_.engine_.kernel_tls_receive())
+        {
+          async_io(socket_, core_, shutdown_op(), handler_);
+          return;
+        }
+      }
+      else
+      {
+        kernel_tls_check_record(core_,
+            core_.input_buffer(), bytes_transferred, ec);
+        if (ec)
+        {
+          core_.release_input_buffer();
+          if (ec == asio::error::eof)
+            ec = asio::error_code();
+          break;
+        }
+      }
+
+      // Discard application data until the peer's alert arrives.
+      socket_.async_receive_msg(core_.input_buffer(),
+          core_.kernel_tls_control_,
+          ASIO_MOVE_CAST(kernel_tls_shutdown_op)(*this));
+      return;
+    }
+
+    handler_(static_cast<const asio::error_code&>(ec));
+  }
+
+//private:
+  Socket& socket_;
+  stream_core& core_;
+  int start_;
+  bool sent_;
+  Handler handler_;
+};
+
+template <typename Socket, typename MutableBufferSequence, typename Handler>
+inline void* asio_handler_allocate(std::size_t size,
+    kernel_tls_read_op<Socket, MutableBufferSequence, Handler>* this_handler)
+{
+  return asio_handler_alloc_helpers::allocate(
+      size, this_handler->handler_);
+}
+
+template <typename Socket, typename MutableBufferSequence, typename Handler>
+inline void asio_handler_deallocate(void* pointer, std::size_t size,
+    kernel_tls_read_op<Socket, MutableBufferSequence, Handler>* this_handler)
+{
+  asio_handler_alloc_helpers::deallocate(
+      pointer, size, this_handler->handler_);
+}
+
+template <typename Socket, typename MutableBufferSequence, typename Handler>
+inline bool asio_handler_is_continuation(
+    kernel_tls_read_op<Socket, MutableBufferSequence, Handler>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+template <typename Function, typename Socket,
+    typename MutableBufferSequence, typename Handler>
+inline void asio_handler_invoke(Function& function,
+    kernel_tls_read_op<Socket, MutableBufferSequence, Handler>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename Function, typename Socket,
+    typename MutableBufferSequence, typename Handler>
+inline void asio_handler_invoke(const Function& function,
+    kernel_tls_read_op<Socket, MutableBufferSequence, Handler>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename Socket, typename Handler>
+inline void* asio_handler_allocate(std::size_t size,
+    kernel_tls_shutdown_op<Socket, Handler>* this_handler)
+{
+  return asio_handler_alloc_helpers::allocate(
+      size, this_handler->handler_);
+}
+
+template <typename Socket, typename Handler>
+inline void asio_handler_deallocate(void* pointer, std::size_t size,
+    kernel_tls_shutdown_op<Socket, Handler>* this_handler)
+{
+  asio_handler_alloc_helpers::deallocate(
+      pointer, size, this_handler->handler_);
+}
+
+template <typename Socket, typename Handler>
+inline bool asio_handler_is_continuation(
+    kernel_tls_shutdown_op<Socket, Handler>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : asio_handler_cont_helpers::is_continuation(this_handler->handler_);
+}
+
+template <typename Function, typename Socket, typename Handler>
+inline void asio_handler_invoke(Function& function,
+    kernel_tls_shutdown_op<Socket, Handler>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename Function, typename Socket, typename Handler>
+inline void asio_handler_invoke(const Function& function,
+    kernel_tls_shutdown_op<Socket, Handler>* this_handler)
+{
+  asio_handler_invoke_helpers::invoke(
+      function, this_handler->handler_);
+}
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename Handler>
+inline void async_kernel_tls_read(
+    basic_stream_socket<Protocol, Executor>& socket, stream_core& core,
+    const MutableBufferSequence& buffers, Handler& handler)
+{
+  kernel_tls_read_op<basic_stream_socket<Protocol, Executor>,
+    MutableBufferSequence, Handler>(socket, core, buffers, handler)(
+      asio::error_code(), 0, 1);
+}
+
+template <typename Protocol, typename Executor, typename Handler>
+inline void async_kernel_tls_shutdown(
+    basic_stream_socket<Protocol, Executor>& socket,
+    stream_core& core, Handler& handler)
+{
+  kernel_tls_shutdown_op<basic_stream_socket<Protocol, Executor>,
+    Handler>(socket, core, handler)(asio::error_code(), 0, 1);
+}
+
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+
+} // namespace detail
+} // namespace ssl
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+
+template <typename Socket, typename MutableBufferSequence,
+    typename Handler, typename Allocator>
+struct associated_allocator<
+    ssl::detail::kernel_tls_read_op<Socket, MutableBufferSequence, Handler>,
+    Allocator>
+{
+  typedef typename associated_allocator<Handler, Allocator>::type type;
+
+  static type get(const ssl::detail::kernel_tls_read_op<
+        Socket, MutableBufferSequence, Handler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<Handler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Socket, typename MutableBufferSequence,
+    typename Handler, typename Executor>
+struct associated_executor<
+    ssl::detail::kernel_tls_read_op<Socket, MutableBufferSequence, Handler>,
+    Executor>
+{
+  typedef typename associated_executor<Handler, Executor>::type type;
+
+  static type get(const ssl::detail::kernel_tls_read_op<
+        Socket, MutableBufferSequence, Handler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<Handler, Executor>::get(h.handler_, ex);
+  }
+};
+
+template <typename Socket, typename Handler, typename Allocator>
+struct associated_allocator<
+    ssl::detail::kernel_tls_shutdown_op<Socket, Handler>, Allocator>
+{
+  typedef typename associated_allocator<Handler, Allocator>::type type;
+
+  static type get(const ssl::detail::kernel_tls_shutdown_op<Socket, Handler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<Handler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Socket, typename Handler, typename Executor>
+struct associated_executor<
+    ssl::detail::kernel_tls_shutdown_op<Socket, Handler>, Executor>
+{
+  typedef typename associated_executor<Handler, Executor>::type type;
+
+  static type get(const ssl::detail::kernel_tls_shutdown_op<Socket, Handler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<Handler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_KERNEL_TLS_HPP
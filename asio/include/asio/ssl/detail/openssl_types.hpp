@@ -30,4 +30,37 @@
 #include <openssl/rsa.h>
 #include <openssl/x509v3.h>
 
+// Linux kernel TLS offload, using the crypto state exposed by OpenSSL 3.
+#if !defined(ASIO_HAS_KERNEL_TLS)
+# if !defined(ASIO_DISABLE_KERNEL_TLS)
+#  if defined(__linux__) && !defined(ASIO_USE_WOLFSSL)
+#   if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#    define ASIO_HAS_KERNEL_TLS 1
+#   endif // defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#  endif // defined(__linux__) && !defined(ASIO_USE_WOLFSSL)
+# endif // !defined(ASIO_DISABLE_KERNEL_TLS)
+#endif // !defined(ASIO_HAS_KERNEL_TLS)
+
+// TLS 1.3 early data, as provided by OpenSSL 1.1.1 and later.
+#if !defined(ASIO_HAS_SSL_EARLY_DATA)
+# if !defined(ASIO_DISABLE_SSL_EARLY_DATA)
+#  if (OPENSSL_VERSION_NUMBER >= 0x10101000L) \
+    && !defined(LIBRESSL_VERSION_NUMBER) \
+    && !defined(OPENSSL_IS_BORINGSSL) \
+    && !defined(ASIO_USE_WOLFSSL)
+#   define ASIO_HAS_SSL_EARLY_DATA 1
+#  endif // (OPENSSL_VERSION_NUMBER >= 0x10101000L) && ...
+# endif // !defined(ASIO_DISABLE_SSL_EARLY_DATA)
+#endif // !defined(ASIO_HAS_SSL_EARLY_DATA)
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+# include <linux/tls.h>
+# if !defined(SOL_TLS)
+#  define SOL_TLS 282
+# endif // !defined(SOL_TLS)
+# if !defined(TCP_ULP)
+#  define TCP_ULP 31
+# endif // !defined(TCP_ULP)
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+
 #endif // ASIO_SSL_DETAIL_OPENSSL_TYPES_HPP
@@ -0,0 +1,106 @@
+//
+// ssl/detail/record_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_RECORD_BUFFER_HPP
+#define ASIO_SSL_DETAIL_RECORD_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+// The number of unused record buffers that are kept for reuse.
+#if !defined(ASIO_SSL_RECORD_BUFFER_CACHE_SIZE)
+# define ASIO_SSL_RECORD_BUFFER_CACHE_SIZE 64
+#endif // !defined(ASIO_SSL_RECORD_BUFFER_CACHE_SIZE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// A buffer that is large enough to hold the largest possible TLS record. The
+// memory is only held while the buffer is in use, and is taken from and
+// returned to a cache that is shared by all streams.
+class record_buffer
+  : private asio::detail::noncopyable
+{
+public:
+  // According to the OpenSSL documentation, this is the buffer size that is
+  // sufficient to hold the largest possible TLS record.
+  enum { max_tls_record_size = 17 * 1024 };
+
+  record_buffer()
+    : data_(0)
+  {
+  }
+
+  ~record_buffer()
+  {
+    release();
+  }
+
+  // Determine whether the buffer currently holds memory.
+  bool empty() const
+  {
+    return data_ == 0;
+  }
+
+  // Get the buffer, taking memory from the cache if necessary.
+  asio::mutable_buffer get()
+  {
+    if (data_ == 0)
+      data_ = allocate();
+    return asio::mutable_buffer(data_, max_tls_record_size);
+  }
+
+  // Return the memory to the cache.
+  void release()
+  {
+    if (data_)
+    {
+      deallocate(data_);
+      data_ = 0;
+    }
+  }
+
+  // Get the number of unused buffers held by the cache.
+  ASIO_DECL static std::size_t cached();
+
+private:
+  // The shared cache of unused buffers.
+  struct cache;
+  ASIO_DECL static cache* get_cache();
+
+  // Take a buffer from the cache, or allocate a new one.
+  ASIO_DECL static void* allocate();
+
+  // Return a buffer to the cache, or free it if the cache is full.
+  ASIO_DECL static void deallocate(void* p);
+
+  void* data_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/detail/impl/record_buffer.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_DETAIL_RECORD_BUFFER_HPP
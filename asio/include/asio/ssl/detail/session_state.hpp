@@ -0,0 +1,201 @@
+//
+// ssl/detail/session_state.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_SESSION_STATE_HPP
+#define ASIO_SSL_DETAIL_SESSION_STATE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error_code.hpp"
+#include "asio/executor.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// The handshake state of a context: the cache of client sessions, the keys
+// used to protect session tickets, the executor on which handshakes are
+// performed, and the counters of handshakes and their outcomes. The state is
+// attached to the SSL_CTX, and is destroyed along with it.
+class session_state
+  : private asio::detail::noncopyable
+{
+public:
+  // The number of buckets in the histogram of handshake latencies. Bucket i
+  // counts latencies of at least 2^i microseconds and less than 2^(i+1), with
+  // the first and last buckets also counting shorter and longer latencies.
+  enum { latency_buckets = 24 };
+
+  struct counters
+  {
+    uint64_t handshakes;
+    uint64_t resumed;
+    uint64_t cache_hits;
+    uint64_t cache_misses;
+    uint64_t early_data_accepted;
+    uint64_t early_data_rejected;
+    uint64_t latency[latency_buckets];
+  };
+
+  // The size of a session ticket key: a 16 byte name, followed by a 32 byte
+  // HMAC key and a 32 byte AES key.
+  enum { ticket_key_size = 80 };
+
+  // The number of ticket keys retained, including the current key. Tickets
+  // protected by an older key are accepted and then renewed.
+  enum { max_ticket_keys = 3 };
+
+  // Get the state attached to a context, or 0 if there is none.
+  ASIO_DECL static session_state* get(SSL_CTX* ctx);
+
+  // Get the state attached to a context, attaching new state if necessary.
+  ASIO_DECL static session_state& attach(SSL_CTX* ctx);
+
+  // Set the key under which the sessions of a client connection are cached,
+  // overriding the server name. The string must outlive the connection.
+  ASIO_DECL static void set_cache_key(SSL* ssl, const std::string* key);
+
+  // Enable the client session cache, or disable it if max_sessions is 0.
+  ASIO_DECL void set_cache(SSL_CTX* ctx,
+      std::size_t max_sessions, long timeout);
+
+  // Get the number of sessions held by the client session cache.
+  ASIO_DECL std::size_t cache_size() const;
+
+  // Offer a cached session, if there is one, to a client connection that has
+  // not yet started its handshake.
+  ASIO_DECL void prepare_client(SSL* ssl);
+
+  // Get the current time in microseconds, for measuring handshake latency.
+  // Returns 0 if no monotonic clock is available.
+  ASIO_DECL static uint64_t now();
+
+  // Record the outcome of a completed handshake, which started at the given
+  // time.
+  ASIO_DECL void handshake_completed(SSL* ssl, uint64_t start);
+
+  // Set the executor on which the steps of handshakes are performed. An empty
+  // executor means that they are performed inline.
+  ASIO_DECL void set_handshake_executor(const asio::executor& ex);
+
+  // Get the executor on which the steps of handshakes are performed.
+  ASIO_DECL asio::executor get_handshake_executor() const;
+
+  // Make the given key the current key for protecting session tickets.
+  ASIO_DECL asio::error_code add_ticket_key(SSL_CTX* ctx,
+      const unsigned char* key, asio::error_code& ec);
+
+  // Get a snapshot of the counters.
+  ASIO_DECL counters get_counters() const;
+
+private:
+  ASIO_DECL session_state();
+  ASIO_DECL ~session_state();
+
+  // The ex_data indexes used to attach state to contexts and cache keys to
+  // connections.
+  ASIO_DECL static int context_index();
+  ASIO_DECL static int cache_key_index();
+
+  // Called when a context is freed.
+  ASIO_DECL static void free_callback(void* parent, void* ptr,
+      CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  // Called when a client connection receives a new session.
+  ASIO_DECL static int new_session_callback(SSL* ssl, SSL_SESSION* session);
+
+  // Called to protect or unprotect a session ticket.
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+  ASIO_DECL static int ticket_key_callback(SSL* ssl, unsigned char* name,
+      unsigned char* iv, EVP_CIPHER_CTX* ctx, EVP_MAC_CTX* hctx, int enc);
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+  ASIO_DECL static int ticket_key_callback(SSL* ssl, unsigned char* name,
+      unsigned char* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hctx, int enc);
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L) && !defined(ASIO_USE_WOLFSSL)
+
+  // Get the key under which the sessions of a connection are cached. Returns
+  // an empty string if the sessions are not to be cached.
+  ASIO_DECL static std::string get_cache_key(SSL* ssl);
+
+  // Add a session to the cache, taking ownership of it.
+  ASIO_DECL void insert(const std::string& key, SSL_SESSION* session);
+
+  // Remove a session from the cache, returning it with a reference held for
+  // the caller, or 0 if there is no usable session.
+  ASIO_DECL SSL_SESSION* take(const std::string& key);
+
+  // Remove all sessions from the cache.
+  ASIO_DECL void clear();
+
+  struct ticket_key
+  {
+    unsigned char name[16];
+    unsigned char hmac_key[32];
+    unsigned char aes_key[32];
+  };
+
+  // Find the key to be used for a ticket. When encrypting, the current key is
+  // returned. Returns 0 if no key is found, 1 if the current key was found,
+  // and 2 if an older key was found.
+  ASIO_DECL int find_ticket_key(const unsigned char* name,
+      int enc, ticket_key& key);
+
+  struct cache_entry
+  {
+    std::string key;
+    SSL_SESSION* session;
+    std::time_t expiry;
+  };
+
+  typedef std::list<cache_entry> cache_list;
+  typedef std::map<std::string, cache_list::iterator> cache_map;
+
+  mutable asio::detail::mutex mutex_;
+
+  // The cached sessions, most recently used first, and an index by key.
+  cache_list cache_;
+  cache_map cache_index_;
+  std::size_t max_sessions_;
+  long timeout_;
+
+  // The ticket keys, most recent first.
+  ticket_key ticket_keys_[max_ticket_keys];
+  std::size_t ticket_key_count_;
+
+  asio::executor handshake_executor_;
+
+  counters counters_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/detail/impl/session_state.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_DETAIL_SESSION_STATE_HPP
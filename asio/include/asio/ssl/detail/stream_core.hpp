@@ -17,13 +17,13 @@
 
 #include "asio/detail/config.hpp"
 
-#if defined(ASIO_HAS_BOOST_DATE_TIME)
-# include "asio/deadline_timer.hpp"
-#else // defined(ASIO_HAS_BOOST_DATE_TIME)
-# include "asio/steady_timer.hpp"
-#endif // defined(ASIO_HAS_BOOST_DATE_TIME)
+#include "asio/detail/op_queue.hpp"
 #include "asio/ssl/detail/engine.hpp"
+#include "asio/ssl/detail/record_buffer.hpp"
 #include "asio/buffer.hpp"
+#if defined(ASIO_HAS_KERNEL_TLS)
+# include "asio/ancillary_data.hpp"
+#endif // defined(ASIO_HAS_KERNEL_TLS)
 
 #include "asio/detail/push_options.hpp"
 
@@ -33,97 +33,148 @@ namespace detail {
 
 struct stream_core
 {
-  // According to the OpenSSL documentation, this is the buffer size that is
-  // sufficient to hold the largest possible TLS record.
-  enum { max_tls_record_size = 17 * 1024 };
+  // An operation that is waiting for a read or write on the underlying
+  // transport to complete. Waiting operations are linked into a queue.
+  class pending_op
+  {
+  public:
+    // Post the operation so that it tries again.
+    void resume()
+    {
+      func_(this, true);
+    }
+
+    // Destroy the operation without running it.
+    void destroy()
+    {
+      func_(this, false);
+    }
+
+  protected:
+    typedef void (*func_type)(pending_op*, bool);
+
+    pending_op(func_type func)
+      : next_(0),
+        func_(func)
+    {
+    }
+
+    // Prevents deletion through this type.
+    ~pending_op()
+    {
+    }
+
+  private:
+    friend class asio::detail::op_queue_access;
+    pending_op* next_;
+    func_type func_;
+  };
 
   template <typename Executor>
-  stream_core(SSL_CTX* context, const Executor& ex)
+  stream_core(SSL_CTX* context, const Executor&)
     : engine_(context),
-      pending_read_(ex),
-      pending_write_(ex),
-      output_buffer_space_(max_tls_record_size),
-      output_buffer_(asio::buffer(output_buffer_space_)),
-      input_buffer_space_(max_tls_record_size),
-      input_buffer_(asio::buffer(input_buffer_space_))
+      read_in_progress_(false),
+      write_in_progress_(false)
+#if defined(ASIO_HAS_KERNEL_TLS)
+      , kernel_tls_control_(asio::buffer(kernel_tls_control_space_)),
+      kernel_tls_alert_control_(asio::buffer(kernel_tls_alert_control_space_))
+#endif // defined(ASIO_HAS_KERNEL_TLS)
   {
-    pending_read_.expires_at(neg_infin());
-    pending_write_.expires_at(neg_infin());
   }
 
   ~stream_core()
   {
   }
 
-  // The SSL engine.
-  engine engine_;
-
-#if defined(ASIO_HAS_BOOST_DATE_TIME)
-  // Timer used for storing queued read operations.
-  asio::deadline_timer pending_read_;
-
-  // Timer used for storing queued write operations.
-  asio::deadline_timer pending_write_;
-
-  // Helper function for obtaining a time value that always fires.
-  static asio::deadline_timer::time_type neg_infin()
+  // Get a buffer that may be used to read input intended for the engine.
+  asio::mutable_buffer input_buffer()
   {
-    return boost::posix_time::neg_infin;
+    return input_buffer_space_.get();
   }
 
-  // Helper function for obtaining a time value that never fires.
-  static asio::deadline_timer::time_type pos_infin()
+  // Pass unconsumed input to the engine. The input buffer is given back once
+  // the engine has consumed all of the input and no read is in progress.
+  void put_input()
   {
-    return boost::posix_time::pos_infin;
+    input_ = engine_.put_input(input_);
+    if (input_.size() == 0 && !read_in_progress_)
+      input_buffer_space_.release();
   }
 
-  // Helper function to get a timer's expiry time.
-  static asio::deadline_timer::time_type expiry(
-      const asio::deadline_timer& timer)
+  // Give back the input buffer if it holds no unconsumed input.
+  void release_input_buffer()
   {
-    return timer.expires_at();
+    if (input_.size() == 0 && !read_in_progress_)
+      input_buffer_space_.release();
   }
-#else // defined(ASIO_HAS_BOOST_DATE_TIME)
-  // Timer used for storing queued read operations.
-  asio::steady_timer pending_read_;
 
-  // Timer used for storing queued write operations.
-  asio::steady_timer pending_write_;
-
-  // Helper function for obtaining a time value that always fires.
-  static asio::steady_timer::time_point neg_infin()
+  // Get output data from the engine, to be written to the underlying
+  // transport. The buffer holding the output must be given back, using
+  // release_output_buffer(), once the write has completed.
+  asio::mutable_buffer get_output()
   {
-    return (asio::steady_timer::time_point::min)();
+    return engine_.get_output(output_buffer_space_.get());
   }
 
-  // Helper function for obtaining a time value that never fires.
-  static asio::steady_timer::time_point pos_infin()
+  // Give back the output buffer.
+  void release_output_buffer()
   {
-    return (asio::steady_timer::time_point::max)();
+    output_buffer_space_.release();
   }
 
-  // Helper function to get a timer's expiry time.
-  static asio::steady_timer::time_point expiry(
-      const asio::steady_timer& timer)
+  // Resume all operations in a queue of waiting operations.
+  static void resume(asio::detail::op_queue<pending_op>& ops)
   {
-    return timer.expiry();
+    asio::detail::op_queue<pending_op> resumed;
+    resumed.push(ops);
+    while (pending_op* op = resumed.front())
+    {
+      resumed.pop();
+      op->resume();
+    }
   }
-#endif // defined(ASIO_HAS_BOOST_DATE_TIME)
 
-  // Buffer space used to prepare output intended for the transport.
-  std::vector<unsigned char> output_buffer_space_;
+  // The SSL engine.
+  engine engine_;
+
+  // Whether a read is in progress on the underlying transport.
+  bool read_in_progress_;
+
+  // Operations waiting for the current read to complete.
+  asio::detail::op_queue<pending_op> pending_reads_;
+
+  // Whether a write is in progress on the underlying transport.
+  bool write_in_progress_;
 
-  // A buffer that may be used to prepare output intended for the transport.
-  const asio::mutable_buffer output_buffer_;
+  // Operations waiting for the current write to complete.
+  asio::detail::op_queue<pending_op> pending_writes_;
 
-  // Buffer space used to read input intended for the engine.
-  std::vector<unsigned char> input_buffer_space_;
+  // Buffer space used to prepare output intended for the transport. Memory is
+  // held only while output is being written.
+  record_buffer output_buffer_space_;
 
-  // A buffer that may be used to read input intended for the engine.
-  const asio::mutable_buffer input_buffer_;
+  // Buffer space used to read input intended for the engine. Memory is held
+  // only while a read is in progress or there is unconsumed input.
+  record_buffer input_buffer_space_;
 
   // The buffer pointing to the engine's unconsumed input.
   asio::const_buffer input_;
+
+#if defined(ASIO_HAS_KERNEL_TLS)
+  // Storage for the control message that identifies the type of each record
+  // received when the kernel is decrypting records.
+  unsigned char kernel_tls_control_space_[64];
+
+  // The control message received with each record.
+  asio::ancillary_data kernel_tls_control_;
+
+  // Storage for the control message used to send an alert record when the
+  // kernel is encrypting records.
+  unsigned char kernel_tls_alert_control_space_[64];
+
+  // The control message sent with an alert record.
+  asio::ancillary_data kernel_tls_alert_control_;
+#endif // defined(ASIO_HAS_KERNEL_TLS)
 };
 
 } // namespace detail
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/type_traits.hpp"
 #include "asio/ssl/detail/engine.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -39,11 +40,9 @@ public:
       asio::error_code& ec,
       std::size_t& bytes_transferred) const
   {
-    asio::const_buffer buffer =
-      asio::detail::buffer_sequence_adapter<asio::const_buffer,
-        ConstBufferSequence>::first(buffers_);
-
-    return eng.write(buffer, ec, bytes_transferred);
+    return this->write(eng, ec, bytes_transferred,
+        asio::integral_constant<bool,
+          adapter_type::is_single_buffer>());
   }
 
   template <typename Handler>
@@ -55,6 +54,29 @@ public:
   }
 
 private:
+  typedef asio::detail::buffer_sequence_adapter<
+    asio::const_buffer, ConstBufferSequence> adapter_type;
+
+  // Write a sequence that is known to hold a single buffer.
+  engine::want write(engine& eng, asio::error_code& ec,
+      std::size_t& bytes_transferred, asio::true_type) const
+  {
+    return eng.write(adapter_type::first(buffers_), ec, bytes_transferred);
+  }
+
+  // Write a sequence that may hold several buffers.
+  engine::want write(engine& eng, asio::error_code& ec,
+      std::size_t& bytes_transferred, asio::false_type) const
+  {
+    // Coalesce as many of the buffers as fit into a full record, so that a
+    // sequence of small buffers is not written one record at a time.
+    unsigned char storage[
+      asio::detail::buffer_sequence_adapter_base::linearisation_storage_size];
+
+    return eng.write(adapter_type::linearise(buffers_, asio::buffer(storage)),
+        ec, bytes_transferred);
+  }
+
   ConstBufferSequence buffers_;
 };
 
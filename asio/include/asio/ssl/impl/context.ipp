@@ -22,7 +22,9 @@
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/ssl/context.hpp"
+#include "asio/ssl/detail/session_state.hpp"
 #include "asio/ssl/error.hpp"
+#include <openssl/rand.h>
 
 #include "asio/detail/push_options.hpp"
 
@@ -363,6 +365,8 @@ context::context(context::method m)
     asio::detail::throw_error(ec, "context");
   }
 
+  detail::session_state::attach(handle_);
+
   set_options(no_compression);
 }
 
@@ -1087,6 +1091,141 @@ ASIO_SYNC_OP_VOID context::use_tmp_dh_file(
   ASIO_SYNC_OP_VOID_RETURN(ec);
 }
 
+void context::set_client_session_cache(
+    std::size_t max_sessions, long timeout)
+{
+  asio::error_code ec;
+  set_client_session_cache(max_sessions, timeout, ec);
+  asio::detail::throw_error(ec, "set_client_session_cache");
+}
+
+ASIO_SYNC_OP_VOID context::set_client_session_cache(
+    std::size_t max_sessions, long timeout, asio::error_code& ec)
+{
+  if (timeout < 0)
+  {
+    ec = asio::error::invalid_argument;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  detail::session_state::attach(handle_).set_cache(
+      handle_, max_sessions, timeout);
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void context::rotate_session_ticket_key()
+{
+  asio::error_code ec;
+  rotate_session_ticket_key(ec);
+  asio::detail::throw_error(ec, "rotate_session_ticket_key");
+}
+
+ASIO_SYNC_OP_VOID context::rotate_session_ticket_key(asio::error_code& ec)
+{
+  ::ERR_clear_error();
+
+  unsigned char key[detail::session_state::ticket_key_size];
+  if (::RAND_bytes(key, sizeof(key)) != 1)
+  {
+    ec = asio::error_code(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  detail::session_state::attach(handle_).add_ticket_key(handle_, key, ec);
+  ::OPENSSL_cleanse(key, sizeof(key));
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void context::rotate_session_ticket_key(const const_buffer& key)
+{
+  asio::error_code ec;
+  rotate_session_ticket_key(key, ec);
+  asio::detail::throw_error(ec, "rotate_session_ticket_key");
+}
+
+ASIO_SYNC_OP_VOID context::rotate_session_ticket_key(
+    const const_buffer& key, asio::error_code& ec)
+{
+  if (key.size() != detail::session_state::ticket_key_size)
+  {
+    ec = asio::error::invalid_argument;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ::ERR_clear_error();
+
+  detail::session_state::attach(handle_).add_ticket_key(handle_,
+      static_cast<const unsigned char*>(key.data()), ec);
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void context::set_max_early_data(std::size_t size)
+{
+  asio::error_code ec;
+  set_max_early_data(size, ec);
+  asio::detail::throw_error(ec, "set_max_early_data");
+}
+
+ASIO_SYNC_OP_VOID context::set_max_early_data(
+    std::size_t size, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_EARLY_DATA)
+  if (static_cast<uint64_t>(size) > 0xFFFFFFFFu)
+  {
+    ec = asio::error::invalid_argument;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ::ERR_clear_error();
+
+  if (::SSL_CTX_set_max_early_data(handle_,
+        static_cast<uint32_t>(size)) != 1
+      || ::SSL_CTX_set_recv_max_early_data(handle_,
+        static_cast<uint32_t>(size)) != 1)
+  {
+    ec = asio::error_code(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  ec = asio::error_code();
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+#else // defined(ASIO_HAS_SSL_EARLY_DATA)
+  (void)size;
+  ec = asio::error::operation_not_supported;
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+#endif // defined(ASIO_HAS_SSL_EARLY_DATA)
+}
+
+void context::set_handshake_executor(const executor& ex)
+{
+  detail::session_state::attach(handle_).set_handshake_executor(ex);
+}
+
+context::session_statistics context::get_session_statistics() const
+{
+  session_statistics stats = session_statistics();
+  if (detail::session_state* state = detail::session_state::get(handle_))
+  {
+    detail::session_state::counters c = state->get_counters();
+    stats.handshakes = c.handshakes;
+    stats.resumed = c.resumed;
+    stats.cache_hits = c.cache_hits;
+    stats.cache_misses = c.cache_misses;
+    stats.early_data_accepted = c.early_data_accepted;
+    stats.early_data_rejected = c.early_data_rejected;
+    for (std::size_t i = 0; i < session_statistics::latency_buckets
+        && i < detail::session_state::latency_buckets; ++i)
+      stats.handshake_latency[i] = c.latency[i];
+  }
+  return stats;
+}
+
 ASIO_SYNC_OP_VOID context::do_use_tmp_dh(
     BIO* bio, asio::error_code& ec)
 {
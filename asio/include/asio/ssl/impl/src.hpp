@@ -23,6 +23,8 @@
 #include "asio/ssl/impl/error.ipp"
 #include "asio/ssl/detail/impl/engine.ipp"
 #include "asio/ssl/detail/impl/openssl_init.ipp"
+#include "asio/ssl/detail/impl/record_buffer.ipp"
+#include "asio/ssl/detail/impl/session_state.ipp"
 #include "asio/ssl/impl/rfc2818_verification.ipp"
 
 #endif // ASIO_SSL_IMPL_SRC_HPP
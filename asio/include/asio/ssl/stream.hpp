@@ -27,9 +27,12 @@
 #include "asio/ssl/detail/buffered_handshake_op.hpp"
 #include "asio/ssl/detail/handshake_op.hpp"
 #include "asio/ssl/detail/io.hpp"
+#include "asio/ssl/detail/kernel_tls.hpp"
+#include "asio/ssl/detail/read_early_data_op.hpp"
 #include "asio/ssl/detail/read_op.hpp"
 #include "asio/ssl/detail/shutdown_op.hpp"
 #include "asio/ssl/detail/stream_core.hpp"
+#include "asio/ssl/detail/write_early_data_op.hpp"
 #include "asio/ssl/detail/write_op.hpp"
 #include "asio/ssl/stream_base.hpp"
 
@@ -340,6 +343,82 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Request that the SSL session be offloaded to the kernel.
+  /**
+   * This function requests that, once the handshake has completed, records be
+   * encrypted and decrypted by the operating system's TLS implementation, so
+   * that reads and writes pass directly to the underlying socket. It must be
+   * called before the handshake is performed.
+   *
+   * Offload is attempted by the first read, write or shutdown operation after
+   * the handshake. It is only available on Linux, for a stream whose next layer
+   * is a stream socket, and for cipher suites supported by the kernel. In all
+   * other cases the stream continues to perform encryption itself. Receive may
+   * remain in user space when send is offloaded, for example for TLS 1.3 or if
+   * data arrived together with the end of the handshake. Use kernel_tls_send()
+   * and kernel_tls_receive() to determine whether offload is in effect.
+   *
+   * @note Once offloaded, the session cannot be renegotiated and its keys
+   * cannot be updated. Post-handshake messages other than hello requests and
+   * session tickets, which are ignored, cause reads to fail. A shutdown must
+   * not be performed while a read is outstanding.
+   */
+  void enable_kernel_tls()
+  {
+    core_.engine_.enable_kernel_tls();
+  }
+
+  /// Determine whether records sent on the stream are encrypted by the kernel.
+  bool kernel_tls_send() const
+  {
+    return core_.engine_.kernel_tls_send();
+  }
+
+  /// Determine whether records received on the stream are decrypted by the
+  /// kernel.
+  bool kernel_tls_receive() const
+  {
+    return core_.engine_.kernel_tls_receive();
+  }
+
+  /// Set the key under which the client's sessions are cached.
+  /**
+   * This function sets the key used to find a session to resume in, and to
+   * store new sessions into, the context's client session cache. If no key is
+   * set, the server name set using @c SSL_set_tlsext_host_name is used. It
+   * must be called before the handshake is performed.
+   *
+   * @param key The key, typically identifying the server's host and port.
+   *
+   * @sa context::set_client_session_cache
+   */
+  void set_session_cache_key(const std::string& key)
+  {
+    core_.engine_.set_session_cache_key(key);
+  }
+
+  /// Determine whether the handshake resumed a previous session.
+  /**
+   * @note Calls @c SSL_session_reused.
+   */
+  bool session_resumed() const
+  {
+    return core_.engine_.session_resumed();
+  }
+
+  /// Determine whether early data sent by the client was accepted.
+  /**
+   * This function may be used on either side of the connection once the
+   * handshake has completed. If the server rejected the early data, the client
+   * must send it again.
+   *
+   * @note Calls @c SSL_get_early_data_status.
+   */
+  bool early_data_accepted() const
+  {
+    return core_.engine_.early_data_accepted();
+  }
+
   /// Perform SSL handshaking.
   /**
    * This function is used to perform SSL handshaking on the stream. The
@@ -504,7 +583,11 @@ public:
    */
   ASIO_SYNC_OP_VOID shutdown(asio::error_code& ec)
   {
-    detail::io(next_layer_, core_, detail::shutdown_op(), ec);
+    start_kernel_tls();
+    if (core_.engine_.kernel_tls_send())
+      detail::kernel_tls_shutdown(next_layer_, core_, ec);
+    else
+      detail::io(next_layer_, core_, detail::shutdown_op(), ec);
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
@@ -580,6 +663,9 @@ public:
   std::size_t write_some(const ConstBufferSequence& buffers,
       asio::error_code& ec)
   {
+    start_kernel_tls();
+    if (core_.engine_.kernel_tls_send())
+      return next_layer_.write_some(buffers, ec);
     return detail::io(next_layer_, core_,
         detail::write_op<ConstBufferSequence>(buffers), ec);
   }
@@ -667,6 +753,9 @@ public:
   std::size_t read_some(const MutableBufferSequence& buffers,
       asio::error_code& ec)
   {
+    start_kernel_tls();
+    if (core_.engine_.kernel_tls_receive())
+      return detail::kernel_tls_read(next_layer_, core_, buffers, ec);
     return detail::io(next_layer_, core_,
         detail::read_op<MutableBufferSequence>(buffers), ec);
   }
@@ -709,6 +798,193 @@ public:
         initiate_async_read_some(this), handler, buffers);
   }
 
+  /// Write early data to the stream.
+  /**
+   * This function is used by a client to send TLS 1.3 early data along with
+   * the first message of a handshake that resumes a cached session. It must be
+   * called before the handshake is performed. The function call will block
+   * until the data has been written, or until an error occurs.
+   *
+   * @param buffers The data to be written.
+   *
+   * @returns The number of bytes written. Returns 0 if the session does not
+   * allow early data to be sent, or if the limit advertised by the server has
+   * been reached.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Early data may be replayed by an attacker, and so must only be used
+   * for requests that are safe to repeat. The handshake must be performed after
+   * writing early data, and early_data_accepted() then used to determine
+   * whether the data must be written again.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_early_data(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = write_early_data(buffers, ec);
+    asio::detail::throw_error(ec, "write_early_data");
+    return n;
+  }
+
+  /// Write early data to the stream.
+  /**
+   * This function is used by a client to send TLS 1.3 early data along with
+   * the first message of a handshake that resumes a cached session. It must be
+   * called before the handshake is performed. The function call will block
+   * until the data has been written, or until an error occurs.
+   *
+   * @param buffers The data to be written.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes written. Returns 0 if the session does not
+   * allow early data to be sent, if the limit advertised by the server has
+   * been reached, or if an error occurred.
+   *
+   * @note Early data may be replayed by an attacker, and so must only be used
+   * for requests that are safe to repeat. The handshake must be performed after
+   * writing early data, and early_data_accepted() then used to determine
+   * whether the data must be written again.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t write_early_data(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return detail::io(next_layer_, core_,
+        detail::write_early_data_op<ConstBufferSequence>(buffers), ec);
+  }
+
+  /// Start an asynchronous write of early data.
+  /**
+   * This function is used by a client to asynchronously send TLS 1.3 early
+   * data along with the first message of a handshake that resumes a cached
+   * session. It must be called before the handshake is performed. The function
+   * call always returns immediately.
+   *
+   * @param buffers The data to be written to the stream. Although the buffers
+   * object may be copied as necessary, ownership of the underlying buffers is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param handler The handler to be called when the write operation completes.
+   * Copies will be made of the handler as required. The equivalent function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes written.
+   * ); @endcode
+   *
+   * @note The number of bytes written is 0 if the session does not allow early
+   * data to be sent, or if the limit advertised by the server has been reached.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_write_early_data(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_write_early_data(this), handler, buffers);
+  }
+
+  /// Read early data from the stream.
+  /**
+   * This function is used by a server to receive the TLS 1.3 early data sent
+   * by a client. It must be called before the handshake is performed, and
+   * should be called repeatedly until it returns 0. The function call will
+   * block until some early data has been read, until it is known that there is
+   * no more early data, or until an error occurs.
+   *
+   * @param buffers The buffers into which the data will be read.
+   *
+   * @returns The number of bytes read. Returns 0 if there is no more early
+   * data.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Early data is only accepted if a maximum size has been set using
+   * context::set_max_early_data. Early data may be replayed by an attacker,
+   * and so must only be used for requests that are safe to repeat.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read_early_data(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = read_early_data(buffers, ec);
+    asio::detail::throw_error(ec, "read_early_data");
+    return n;
+  }
+
+  /// Read early data from the stream.
+  /**
+   * This function is used by a server to receive the TLS 1.3 early data sent
+   * by a client. It must be called before the handshake is performed, and
+   * should be called repeatedly until it returns 0. The function call will
+   * block until some early data has been read, until it is known that there is
+   * no more early data, or until an error occurs.
+   *
+   * @param buffers The buffers into which the data will be read.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes read. Returns 0 if there is no more early
+   * data, or if an error occurred.
+   *
+   * @note Early data is only accepted if a maximum size has been set using
+   * context::set_max_early_data. Early data may be replayed by an attacker,
+   * and so must only be used for requests that are safe to repeat.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t read_early_data(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return detail::io(next_layer_, core_,
+        detail::read_early_data_op<MutableBufferSequence>(buffers), ec);
+  }
+
+  /// Start an asynchronous read of early data.
+  /**
+   * This function is used by a server to asynchronously receive the TLS 1.3
+   * early data sent by a client. It must be called before the handshake is
+   * performed, and should be called repeatedly until it completes with 0 bytes.
+   * The function call always returns immediately.
+   *
+   * @param buffers The buffers into which the data will be read. Although the
+   * buffers object may be copied as necessary, ownership of the underlying
+   * buffers is retained by the caller, which must guarantee that they remain
+   * valid until the handler is called.
+   *
+   * @param handler The handler to be called when the read operation completes.
+   * Copies will be made of the handler as required. The equivalent function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes read.
+   * ); @endcode
+   *
+   * @note The number of bytes read is 0 if there is no more early data.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_read_early_data(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_read_early_data(this), handler, buffers);
+  }
+
 private:
   class initiate_async_handshake
   {
@@ -801,8 +1077,17 @@ private:
       ASIO_HANDSHAKE_HANDLER_CHECK(ShutdownHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<ShutdownHandler> handler2(handler);
-      detail::async_io(self_->next_layer_, self_->core_,
-          detail::shutdown_op(), handler2.value);
+      self_->start_kernel_tls();
+      if (self_->core_.engine_.kernel_tls_send())
+      {
+        detail::async_kernel_tls_shutdown(self_->next_layer_,
+            self_->core_, handler2.value);
+      }
+      else
+      {
+        detail::async_io(self_->next_layer_, self_->core_,
+            detail::shutdown_op(), handler2.value);
+      }
     }
 
   private:
@@ -833,8 +1118,18 @@ private:
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
-      detail::async_io(self_->next_layer_, self_->core_,
-          detail::write_op<ConstBufferSequence>(buffers), handler2.value);
+      self_->start_kernel_tls();
+      if (self_->core_.engine_.kernel_tls_send())
+      {
+        self_->next_layer_.async_write_some(buffers,
+            ASIO_MOVE_CAST(typename decay<WriteHandler>::type)(
+              handler2.value));
+      }
+      else
+      {
+        detail::async_io(self_->next_layer_, self_->core_,
+            detail::write_op<ConstBufferSequence>(buffers), handler2.value);
+      }
     }
 
   private:
@@ -865,14 +1160,97 @@ private:
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->start_kernel_tls();
+      if (self_->core_.engine_.kernel_tls_receive())
+      {
+        detail::async_kernel_tls_read(self_->next_layer_,
+            self_->core_, buffers, handler2.value);
+      }
+      else
+      {
+        detail::async_io(self_->next_layer_, self_->core_,
+            detail::read_op<MutableBufferSequence>(buffers), handler2.value);
+      }
+    }
+
+  private:
+    stream* self_;
+  };
+
+  class initiate_async_write_early_data
+  {
+  public:
+    typedef typename stream::executor_type executor_type;
+
+    explicit initiate_async_write_early_data(stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
       detail::async_io(self_->next_layer_, self_->core_,
-          detail::read_op<MutableBufferSequence>(buffers), handler2.value);
+          detail::write_early_data_op<ConstBufferSequence>(buffers),
+          handler2.value);
     }
 
   private:
     stream* self_;
   };
 
+  class initiate_async_read_early_data
+  {
+  public:
+    typedef typename stream::executor_type executor_type;
+
+    explicit initiate_async_read_early_data(stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      detail::async_io(self_->next_layer_, self_->core_,
+          detail::read_early_data_op<MutableBufferSequence>(buffers),
+          handler2.value);
+    }
+
+  private:
+    stream* self_;
+  };
+
+  // Offload the session to the kernel, if requested, once the handshake has
+  // completed.
+  void start_kernel_tls()
+  {
+    if (core_.engine_.kernel_tls_ready())
+      detail::start_kernel_tls(next_layer_, core_);
+  }
+
   Stream next_layer_;
   detail::stream_core core_;
 };
@@ -0,0 +1,70 @@
+//
+// timing_wheel_wait_traits.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_TIMING_WHEEL_WAIT_TRAITS_HPP
+#define ASIO_TIMING_WHEEL_WAIT_TRAITS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/detail/timer_wheel.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Wait traits that store timers in a hierarchical timing wheel.
+/**
+ * By default, the pending timers of a given type are kept in a binary heap,
+ * so that starting or cancelling a wait takes time that grows logarithmically
+ * with the number of timers. When the basic_waitable_timer class template is
+ * instantiated with these wait traits, its timers are instead kept in a
+ * hierarchical timing wheel, where starting and cancelling a wait take
+ * constant time. This suits programs that have very large numbers of
+ * outstanding timers, most of which are cancelled before they expire, such as
+ * per-connection idle timeouts.
+ *
+ * The wheel measures time in ticks of @c GranularityUsec microseconds, and
+ * expiry times are rounded up to a whole tick. A timer therefore never expires
+ * early, but may expire up to one tick late.
+ *
+ * @par Example
+ * @code typedef asio::basic_waitable_timer<
+ *     asio::chrono::steady_clock,
+ *     asio::timing_wheel_wait_traits<asio::chrono::steady_clock, 10000> >
+ *   idle_timer;
+ *
+ * // Times out after 30 seconds, with a resolution of 10 milliseconds.
+ * idle_timer timer(my_context, asio::chrono::seconds(30)); @endcode
+ */
+template <typename Clock, long GranularityUsec = 1000>
+struct timing_wheel_wait_traits
+  : wait_traits<Clock>
+{
+  /// The granularity of the timing wheel, in microseconds.
+  static const long granularity_usec = GranularityUsec;
+};
+
+template <typename Clock, long GranularityUsec>
+const long timing_wheel_wait_traits<Clock, GranularityUsec>::granularity_usec;
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_TIMING_WHEEL_WAIT_TRAITS_HPP
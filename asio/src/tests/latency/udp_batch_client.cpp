@@ -0,0 +1,118 @@
+//
+// udp_batch_client.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/ip/udp.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "high_res_clock.hpp"
+
+using asio::ip::udp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+const int num_samples = 10000;
+
+int main(int argc, char* argv[])
+{
+  if (argc != 7)
+  {
+    std::fprintf(stderr,
+        "Usage: udp_batch_client <ip> <port1> "
+        "<nports> <bufsize> <batchsize> {spin|block}\n");
+    return 1;
+  }
+
+  const char* ip = argv[1];
+  unsigned short first_port = static_cast<unsigned short>(std::atoi(argv[2]));
+  unsigned short num_ports = static_cast<unsigned short>(std::atoi(argv[3]));
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[4]));
+  std::size_t batch_size = static_cast<std::size_t>(std::atoi(argv[5]));
+  bool spin = (std::strcmp(argv[6], "spin") == 0);
+
+  asio::io_context io_context;
+
+  udp::socket socket(io_context, udp::endpoint(udp::v4(), 0));
+
+  if (spin)
+  {
+    socket.non_blocking(true);
+  }
+
+  udp::endpoint target(asio::ip::make_address(ip), first_port);
+  unsigned short last_port = first_port + num_ports - 1;
+  std::vector<unsigned char> write_buf(buf_size);
+  std::vector<unsigned char> read_buf(buf_size * batch_size);
+  std::vector<asio::const_buffer> write_buffers(batch_size,
+      asio::buffer(write_buf));
+  std::vector<asio::mutable_buffer> read_buffers(batch_size);
+  for (std::size_t i = 0; i < batch_size; ++i)
+    read_buffers[i] = asio::buffer(&read_buf[i * buf_size], buf_size);
+  std::vector<udp::endpoint> targets(batch_size);
+  std::vector<std::size_t> sizes(batch_size);
+
+  ptime start = microsec_clock::universal_time();
+  boost::uint64_t start_hr = high_res_clock();
+
+  // Each sample is the round trip time for a whole batch of datagrams.
+  std::vector<boost::uint64_t> samples(num_samples);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    std::fill(targets.begin(), targets.end(), target);
+
+    boost::uint64_t t = high_res_clock();
+
+    asio::error_code ec;
+    for (std::size_t sent = 0; sent < batch_size; )
+    {
+      sent += socket.send_many(&write_buffers[sent],
+          &targets[sent], batch_size - sent, 0, ec);
+    }
+
+    for (std::size_t recvd = 0; recvd < batch_size; )
+    {
+      recvd += socket.receive_many(&read_buffers[recvd],
+          0, &sizes[recvd], batch_size - recvd, 0, ec);
+    }
+
+    samples[i] = high_res_clock() - t;
+
+    if (target.port() == last_port)
+      target.port(first_port);
+    else
+      target.port(target.port() + 1);
+  }
+
+  ptime stop = microsec_clock::universal_time();
+  boost::uint64_t stop_hr = high_res_clock();
+  boost::uint64_t elapsed_usec = (stop - start).total_microseconds();
+  boost::uint64_t elapsed_hr = stop_hr - start_hr;
+  double scale = 1.0 * elapsed_usec / elapsed_hr;
+
+  std::sort(samples.begin(), samples.end());
+  std::printf("  0.0%%\t%f\n", samples[0] * scale);
+  std::printf("  0.1%%\t%f\n", samples[num_samples / 1000 - 1] * scale);
+  std::printf("  1.0%%\t%f\n", samples[num_samples / 100 - 1] * scale);
+  std::printf(" 10.0%%\t%f\n", samples[num_samples / 10 - 1] * scale);
+  std::printf(" 50.0%%\t%f\n", samples[num_samples * 5 / 10 - 1] * scale);
+  std::printf(" 90.0%%\t%f\n", samples[num_samples * 9 / 10 - 1] * scale);
+  std::printf(" 99.0%%\t%f\n", samples[num_samples * 99 / 100 - 1] * scale);
+  std::printf(" 99.9%%\t%f\n", samples[num_samples * 999 / 1000 - 1] * scale);
+  std::printf("100.0%%\t%f\n", samples[num_samples - 1] * scale);
+
+  double total = 0.0;
+  for (int i = 0; i < num_samples; ++i) total += samples[i] * scale;
+  std::printf("  mean\t%f\n", total / num_samples);
+  std::printf("  msg/s\t%f\n",
+      1000000.0 * num_samples * batch_size / elapsed_usec);
+}
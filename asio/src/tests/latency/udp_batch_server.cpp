@@ -0,0 +1,146 @@
+//
+// udp_batch_server.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/io_context.hpp>
+#include <asio/ip/udp.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "allocator.hpp"
+
+using asio::ip::udp;
+
+#include <asio/yield.hpp>
+
+class udp_batch_server : asio::coroutine
+{
+public:
+  udp_batch_server(asio::io_context& io_context, unsigned short port,
+      std::size_t buf_size, std::size_t batch_size) :
+    socket_(io_context, udp::endpoint(udp::v4(), port)),
+    data_(buf_size * batch_size),
+    recv_buffers_(batch_size),
+    send_buffers_(batch_size),
+    senders_(batch_size),
+    sizes_(batch_size),
+    buf_size_(buf_size)
+  {
+    for (std::size_t i = 0; i < batch_size; ++i)
+      recv_buffers_[i] = asio::buffer(&data_[i * buf_size], buf_size);
+  }
+
+  void operator()(asio::error_code ec, std::size_t n = 0)
+  {
+    reenter (this) for (;;)
+    {
+      yield socket_.async_receive_many(&recv_buffers_[0],
+          &senders_[0], &sizes_[0], recv_buffers_.size(), ref(this));
+
+      if (!ec)
+      {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          unsigned char* p = &data_[i * buf_size_];
+          for (std::size_t j = 0; j < sizes_[i]; ++j) p[j] = ~p[j];
+          send_buffers_[i] = asio::buffer(p, sizes_[i]);
+        }
+
+        for (std::size_t sent = 0; sent < n && !ec; )
+          sent += socket_.send_many(&send_buffers_[sent],
+              &senders_[sent], n - sent, 0, ec);
+      }
+    }
+  }
+
+  friend void* asio_handler_allocate(std::size_t n, udp_batch_server* s)
+  {
+    return s->allocator_.allocate(n);
+  }
+
+  friend void asio_handler_deallocate(void* p, std::size_t,
+      udp_batch_server* s)
+  {
+    s->allocator_.deallocate(p);
+  }
+
+  struct ref
+  {
+    explicit ref(udp_batch_server* p)
+      : p_(p)
+    {
+    }
+
+    void operator()(asio::error_code ec, std::size_t n = 0)
+    {
+      (*p_)(ec, n);
+    }
+
+  private:
+    udp_batch_server* p_;
+
+    friend void* asio_handler_allocate(std::size_t n, ref* r)
+    {
+      return asio_handler_allocate(n, r->p_);
+    }
+
+    friend void asio_handler_deallocate(void* p, std::size_t n, ref* r)
+    {
+      asio_handler_deallocate(p, n, r->p_);
+    }
+  };
+
+private:
+  udp::socket socket_;
+  std::vector<unsigned char> data_;
+  std::vector<asio::mutable_buffer> recv_buffers_;
+  std::vector<asio::const_buffer> send_buffers_;
+  std::vector<udp::endpoint> senders_;
+  std::vector<std::size_t> sizes_;
+  std::size_t buf_size_;
+  allocator allocator_;
+};
+
+#include <asio/unyield.hpp>
+
+int main(int argc, char* argv[])
+{
+  if (argc != 6)
+  {
+    std::fprintf(stderr,
+        "Usage: udp_batch_server <port1> <nports> "
+        "<bufsize> <batchsize> {spin|block}\n");
+    return 1;
+  }
+
+  unsigned short first_port = static_cast<unsigned short>(std::atoi(argv[1]));
+  unsigned short num_ports = static_cast<unsigned short>(std::atoi(argv[2]));
+  std::size_t buf_size = std::atoi(argv[3]);
+  std::size_t batch_size = std::atoi(argv[4]);
+  bool spin = (std::strcmp(argv[5], "spin") == 0);
+
+  asio::io_context io_context(1);
+  std::vector<boost::shared_ptr<udp_batch_server> > servers;
+
+  for (unsigned short i = 0; i < num_ports; ++i)
+  {
+    unsigned short port = first_port + i;
+    boost::shared_ptr<udp_batch_server> s(
+        new udp_batch_server(io_context, port, buf_size, batch_size));
+    servers.push_back(s);
+    (*s)(asio::error_code());
+  }
+
+  if (spin)
+    for (;;) io_context.poll();
+  else
+    io_context.run();
+}
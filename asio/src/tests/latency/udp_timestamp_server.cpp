@@ -0,0 +1,238 @@
+//
+// udp_timestamp_server.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <asio/ancillary_data.hpp>
+#include <asio/io_context.hpp>
+#include <asio/ip/udp.hpp>
+#include <asio/packet_timestamp.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+
+#include <time.h>
+#include <linux/net_tstamp.h>
+
+using asio::ip::udp;
+
+const int num_samples = 100000;
+
+// Echoes datagrams, and uses kernel timestamps to split the time each datagram
+// spends in the server into:
+//
+// - dispatch: from the kernel receiving the datagram to the handler starting;
+// - application: from the handler starting to the reply being sent;
+// - transmit: from the reply being sent to the kernel transmitting it.
+class udp_timestamp_server
+{
+public:
+  udp_timestamp_server(asio::io_context& io_context,
+      unsigned short port, std::size_t buf_size)
+    : socket_(io_context, udp::endpoint(udp::v4(), port)),
+      buffer_(buf_size),
+      control_(asio::buffer(control_storage_)),
+      error_control_(asio::buffer(error_control_storage_)),
+      send_times_(num_samples),
+      dispatch_(num_samples),
+      application_(num_samples),
+      transmit_(num_samples),
+      sent_(0),
+      received_(0),
+      transmitted_(0)
+  {
+    socket_.set_option(asio::socket_base::timestamping(
+          SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE
+          | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_ID
+          | SOF_TIMESTAMPING_OPT_TSONLY));
+  }
+
+  void start()
+  {
+    start_receive();
+    start_receive_error();
+  }
+
+  bool done() const
+  {
+    return received_ == num_samples && transmitted_ == num_samples;
+  }
+
+  void report()
+  {
+    std::printf("dispatch (usec)\n");
+    print(dispatch_);
+    std::printf("application (usec)\n");
+    print(application_);
+    std::printf("transmit (usec)\n");
+    print(transmit_);
+  }
+
+private:
+  static asio::int64_t now()
+  {
+    timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<asio::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+  static void print(std::vector<asio::int64_t>& samples)
+  {
+    std::sort(samples.begin(), samples.end());
+    const double scale = 0.001;
+    std::printf("  0.0%%\t%f\n", samples[0] * scale);
+    std::printf("  0.1%%\t%f\n", samples[num_samples / 1000 - 1] * scale);
+    std::printf("  1.0%%\t%f\n", samples[num_samples / 100 - 1] * scale);
+    std::printf(" 10.0%%\t%f\n", samples[num_samples / 10 - 1] * scale);
+    std::printf(" 50.0%%\t%f\n", samples[num_samples * 5 / 10 - 1] * scale);
+    std::printf(" 90.0%%\t%f\n", samples[num_samples * 9 / 10 - 1] * scale);
+    std::printf(" 99.0%%\t%f\n", samples[num_samples * 99 / 100 - 1] * scale);
+    std::printf(" 99.9%%\t%f\n", samples[num_samples * 999 / 1000 - 1] * scale);
+    std::printf("100.0%%\t%f\n", samples[num_samples - 1] * scale);
+
+    double total = 0.0;
+    for (int i = 0; i < num_samples; ++i) total += samples[i] * scale;
+    std::printf("  mean\t%f\n", total / num_samples);
+  }
+
+  void start_receive()
+  {
+    socket_.async_receive_msg_from(asio::buffer(buffer_),
+        sender_, control_, receive_handler(this));
+  }
+
+  void handle_receive(const asio::error_code& ec, std::size_t n)
+  {
+    asio::int64_t entered = now();
+
+    if (!ec && sent_ < num_samples)
+    {
+      asio::packet_timestamp ts(control_);
+
+      for (std::size_t i = 0; i < n; ++i) buffer_[i] = ~buffer_[i];
+
+      // The transmit timestamp for this datagram is identified by the number
+      // of datagrams previously sent on the socket.
+      asio::error_code send_ec;
+      asio::int64_t sending = now();
+      send_times_[sent_++] = sending;
+      socket_.send_to(asio::buffer(buffer_, n), sender_, 0, send_ec);
+
+      if (ts.has_software())
+      {
+        dispatch_[received_] = entered - ts.software();
+        application_[received_] = sending - entered;
+        ++received_;
+      }
+    }
+
+    start_receive();
+  }
+
+  void start_receive_error()
+  {
+    socket_.async_receive_msg(asio::mutable_buffer(), error_control_,
+        asio::socket_base::message_error_queue, error_handler(this));
+  }
+
+  void handle_receive_error(const asio::error_code& ec, std::size_t)
+  {
+    if (ec)
+      return;
+
+    asio::packet_timestamp ts(error_control_);
+    if (ts.event() == asio::packet_timestamp::sent
+        && ts.id() < static_cast<asio::uint32_t>(sent_)
+        && transmitted_ < num_samples)
+    {
+      transmit_[transmitted_++] = ts.software() - send_times_[ts.id()];
+    }
+
+    if (!done())
+      start_receive_error();
+  }
+
+  struct receive_handler
+  {
+    explicit receive_handler(udp_timestamp_server* p) : p_(p) {}
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      p_->handle_receive(ec, n);
+    }
+
+    udp_timestamp_server* p_;
+  };
+
+  struct error_handler
+  {
+    explicit error_handler(udp_timestamp_server* p) : p_(p) {}
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      p_->handle_receive_error(ec, n);
+    }
+
+    udp_timestamp_server* p_;
+  };
+
+  udp::socket socket_;
+  std::vector<unsigned char> buffer_;
+  unsigned char control_storage_[256];
+  asio::ancillary_data control_;
+  unsigned char error_control_storage_[256];
+  asio::ancillary_data error_control_;
+  udp::endpoint sender_;
+  std::vector<asio::int64_t> send_times_;
+  std::vector<asio::int64_t> dispatch_;
+  std::vector<asio::int64_t> application_;
+  std::vector<asio::int64_t> transmit_;
+  int sent_;
+  int received_;
+  int transmitted_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: udp_timestamp_server <port> <bufsize> {spin|block}\n");
+    return 1;
+  }
+
+  unsigned short port = static_cast<unsigned short>(std::atoi(argv[1]));
+  std::size_t buf_size = std::atoi(argv[2]);
+  bool spin = (std::strcmp(argv[3], "spin") == 0);
+
+  asio::io_context io_context(1);
+  udp_timestamp_server s(io_context, port, buf_size);
+  s.start();
+
+  if (spin)
+    while (!s.done()) io_context.poll();
+  else
+    while (!s.done()) io_context.run_one();
+
+  s.report();
+}
+
+#else // defined(__linux__)
+
+int main()
+{
+  std::fprintf(stderr,
+      "udp_timestamp_server: not supported on this platform\n");
+  return 1;
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,126 @@
+//
+// executor.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Measures the cost of posting handlers through the polymorphic executor
+// wrapper, compared with posting them directly to the target executor. Each
+// handler reposts itself, optionally through a newly constructed polymorphic
+// wrapper, and every allocation made through the global operator new while the
+// handlers run is counted.
+
+static asio::detail::atomic_count allocation_count(0);
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+template <typename Executor>
+class chain
+{
+public:
+  chain(const Executor& ex, bool polymorphic, long& count, long hops)
+    : executor_(ex),
+      polymorphic_(polymorphic),
+      count_(&count),
+      hops_(hops)
+  {
+  }
+
+  void operator()()
+  {
+    ++*count_;
+    if (--hops_ > 0)
+    {
+      if (polymorphic_)
+        asio::post(asio::executor(executor_), *this);
+      else
+        asio::post(executor_, *this);
+    }
+  }
+
+private:
+  Executor executor_;
+  bool polymorphic_;
+  long* count_;
+  long hops_;
+};
+
+template <typename Executor>
+void run_test(asio::io_context& ioc, const Executor& ex, bool polymorphic,
+    const char* name, int chains, long hops)
+{
+  long count = 0;
+  for (int c = 0; c < chains; ++c)
+    asio::post(ex, chain<Executor>(ex, polymorphic, count, hops));
+
+  // Run the first handlers to warm up the thread's handler memory cache.
+  for (int c = 0; c < chains; ++c)
+    ioc.run_one();
+  long allocations = allocation_count;
+
+  boost::posix_time::ptime start =
+    boost::posix_time::microsec_clock::universal_time();
+
+  ioc.run();
+
+  boost::posix_time::ptime stop =
+    boost::posix_time::microsec_clock::universal_time();
+
+  allocations = allocation_count - allocations;
+  long usec = (stop - start).total_microseconds();
+  ioc.restart();
+
+  std::printf("%-20s %ld handlers in %.3f s, %.0f handlers/s, "
+      "%.3f allocations/handler\n", name, count, usec / 1000000.0,
+      usec ? count * 1000000.0 / usec : 0.0,
+      count ? static_cast<double>(allocations) / count : 0.0);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    std::fprintf(stderr, "Usage: executor [<chains> [<hops>]]\n");
+    return 1;
+  }
+
+  int chains = argc > 1 ? std::atoi(argv[1]) : 4;
+  long hops = argc > 2 ? std::atol(argv[2]) : 1000000;
+
+  asio::io_context ioc(1);
+  asio::strand<asio::io_context::executor_type> s(ioc.get_executor());
+
+  run_test(ioc, ioc.get_executor(), false, "io_context", chains, hops);
+  run_test(ioc, ioc.get_executor(), true,
+      "executor(io_context)", chains, hops);
+  run_test(ioc, s, false, "strand", chains, hops);
+  run_test(ioc, s, true, "executor(strand)", chains, hops);
+
+  return 0;
+}
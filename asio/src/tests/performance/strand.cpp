@@ -0,0 +1,140 @@
+//
+// strand.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <vector>
+
+// Measures the throughput of handlers posted to a large number of strands that
+// are run by a pool of threads. Each strand has several chains of handlers
+// that repost themselves, so that the strand is contended by the threads
+// running the chains. Each handler increments a counter that is not otherwise
+// synchronised, and the final counts show whether the strands serialised the
+// handlers correctly.
+
+template <typename Strand>
+class chain
+{
+public:
+  chain(Strand& strand, long& count, int hops)
+    : strand_(&strand),
+      count_(&count),
+      hops_(hops)
+  {
+  }
+
+  void operator()()
+  {
+    ++*count_;
+    if (--hops_ > 0)
+      asio::post(*strand_, *this);
+  }
+
+private:
+  Strand* strand_;
+  long* count_;
+  int hops_;
+};
+
+template <typename Strand>
+long run_test(asio::io_context& ioc, std::vector<Strand*>& strands,
+    int thread_count, int chains, int hops)
+{
+  std::vector<long> counts(strands.size());
+
+  for (int c = 0; c < chains; ++c)
+    for (std::size_t i = 0; i < strands.size(); ++i)
+      asio::post(*strands[i], chain<Strand>(*strands[i], counts[i], hops));
+
+  boost::posix_time::ptime start =
+    boost::posix_time::microsec_clock::universal_time();
+
+  std::list<asio::thread*> threads;
+  while (--thread_count > 0)
+  {
+    asio::thread* new_thread = new asio::thread(
+        boost::bind(&asio::io_context::run, &ioc));
+    threads.push_back(new_thread);
+  }
+
+  ioc.run();
+
+  while (!threads.empty())
+  {
+    threads.front()->join();
+    delete threads.front();
+    threads.pop_front();
+  }
+
+  boost::posix_time::ptime stop =
+    boost::posix_time::microsec_clock::universal_time();
+
+  long errors = 0;
+  for (std::size_t i = 0; i < counts.size(); ++i)
+    if (counts[i] != static_cast<long>(chains) * hops)
+      ++errors;
+  if (errors != 0)
+    std::fprintf(stderr, "%ld strands ran handlers concurrently\n", errors);
+
+  return (stop - start).total_microseconds();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 6 || (argc > 1 && std::strcmp(argv[1], "executor") != 0
+        && std::strcmp(argv[1], "io_context") != 0))
+  {
+    std::fprintf(stderr,
+        "Usage: strand [{executor|io_context}] "
+        "[<strands> [<threads> [<chains> [<hops>]]]]\n");
+    return 1;
+  }
+
+  bool executor = (argc < 2 || std::strcmp(argv[1], "executor") == 0);
+  int strand_count = argc > 2 ? std::atoi(argv[2]) : 100000;
+  int thread_count = argc > 3 ? std::atoi(argv[3]) : 32;
+  int chains = argc > 4 ? std::atoi(argv[4]) : 2;
+  int hops = argc > 5 ? std::atoi(argv[5]) : 10;
+
+  asio::io_context ioc;
+  long usec = 0;
+
+  if (executor)
+  {
+    typedef asio::strand<asio::io_context::executor_type> strand_type;
+    std::vector<strand_type*> strands;
+    for (int i = 0; i < strand_count; ++i)
+      strands.push_back(new strand_type(ioc.get_executor()));
+    usec = run_test(ioc, strands, thread_count, chains, hops);
+    for (int i = 0; i < strand_count; ++i)
+      delete strands[i];
+  }
+  else
+  {
+    std::vector<asio::io_context::strand*> strands;
+    for (int i = 0; i < strand_count; ++i)
+      strands.push_back(new asio::io_context::strand(ioc));
+    usec = run_test(ioc, strands, thread_count, chains, hops);
+    for (int i = 0; i < strand_count; ++i)
+      delete strands[i];
+  }
+
+  double handlers = static_cast<double>(strand_count) * chains * hops;
+  std::printf("%d strands, %d threads: %.0f handlers in %.3f s, "
+      "%.0f handlers/s\n", strand_count, thread_count, handlers,
+      usec / 1000000.0, usec ? handlers * 1000000.0 / usec : 0.0);
+
+  return 0;
+}
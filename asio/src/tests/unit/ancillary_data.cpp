@@ -0,0 +1,407 @@
+//
+// ancillary_data.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ancillary_data.hpp"
+
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+//------------------------------------------------------------------------------
+
+// ancillary_data_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ancillary_data, and the socket functions that accept an ancillary_data
+// object, compile and link correctly. Runtime failures are ignored.
+
+namespace ancillary_data_compile {
+
+struct io_handler
+{
+  void operator()(const asio::error_code&, std::size_t)
+  {
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    unsigned char storage[256];
+    ancillary_data d1;
+    ancillary_data d2(buffer(storage));
+    const ancillary_data& cd = d2;
+
+    std::size_t size = cd.capacity();
+    size = cd.size();
+    (void)size;
+
+    bool b = cd.empty();
+    b = cd.truncated();
+    (void)b;
+
+    const_buffer cb = cd.data();
+    (void)cb;
+
+    socket_base::message_flags f = cd.flags();
+    (void)f;
+
+    int value = 0;
+    b = d2.push_back(SOL_SOCKET, 1, &value, sizeof(value));
+    b = d2.push_back(SOL_SOCKET, 1, value);
+
+    for (ancillary_data::const_iterator i = cd.begin(); i != cd.end(); ++i)
+    {
+      int level = i->level();
+      int type = (*i).type();
+      const_buffer data = i->data();
+      value = i->data_as<int>();
+      (void)level;
+      (void)type;
+      (void)data;
+    }
+
+    size = ancillary_data::space(sizeof(int));
+
+    d2.clear();
+
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    ip::tcp::socket tcp_socket(ioc);
+
+    size = tcp_socket.receive_msg(buffer(mutable_char_buffer), d2);
+    size = tcp_socket.receive_msg(buffer(mutable_char_buffer), d2, 0);
+    size = tcp_socket.receive_msg(buffer(mutable_char_buffer), d2, 0, ec);
+    tcp_socket.async_receive_msg(buffer(mutable_char_buffer), d2,
+        io_handler());
+    tcp_socket.async_receive_msg(buffer(mutable_char_buffer), d2, 0,
+        io_handler());
+    int i1 = tcp_socket.async_receive_msg(
+        buffer(mutable_char_buffer), d2, lazy);
+    (void)i1;
+
+    size = tcp_socket.send_msg(buffer(const_char_buffer), cd);
+    size = tcp_socket.send_msg(buffer(const_char_buffer), cd, 0);
+    size = tcp_socket.send_msg(buffer(const_char_buffer), cd, 0, ec);
+    tcp_socket.async_send_msg(buffer(const_char_buffer), cd, io_handler());
+    tcp_socket.async_send_msg(buffer(const_char_buffer), cd, 0,
+        io_handler());
+    int i2 = tcp_socket.async_send_msg(buffer(const_char_buffer), cd, lazy);
+    (void)i2;
+
+    ip::udp::socket udp_socket(ioc);
+    ip::udp::endpoint endpoint;
+
+    size = udp_socket.receive_msg_from(
+        buffer(mutable_char_buffer), endpoint, d2);
+    size = udp_socket.receive_msg_from(
+        buffer(mutable_char_buffer), endpoint, d2, 0);
+    size = udp_socket.receive_msg_from(
+        buffer(mutable_char_buffer), endpoint, d2, 0, ec);
+    udp_socket.async_receive_msg_from(buffer(mutable_char_buffer),
+        endpoint, d2, io_handler());
+    udp_socket.async_receive_msg_from(buffer(mutable_char_buffer),
+        endpoint, d2, 0, io_handler());
+    int i3 = udp_socket.async_receive_msg_from(
+        buffer(mutable_char_buffer), endpoint, d2, lazy);
+    (void)i3;
+
+    size = udp_socket.send_msg_to(buffer(const_char_buffer), endpoint, cd);
+    size = udp_socket.send_msg_to(
+        buffer(const_char_buffer), endpoint, cd, 0);
+    size = udp_socket.send_msg_to(
+        buffer(const_char_buffer), endpoint, cd, 0, ec);
+    udp_socket.async_send_msg_to(buffer(const_char_buffer),
+        endpoint, cd, io_handler());
+    udp_socket.async_send_msg_to(buffer(const_char_buffer),
+        endpoint, cd, 0, io_handler());
+    int i4 = udp_socket.async_send_msg_to(
+        buffer(const_char_buffer), endpoint, cd, lazy);
+    (void)i4;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ancillary_data_compile
+
+//------------------------------------------------------------------------------
+
+// ancillary_data_messages test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that control messages may be appended to and
+// iterated over, and that an append fails when there is not enough storage.
+
+namespace ancillary_data_messages {
+
+void test()
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  unsigned char storage[128];
+  asio::ancillary_data d(asio::buffer(storage));
+  ASIO_CHECK(d.capacity() > 0 && d.capacity() <= sizeof(storage));
+  ASIO_CHECK(d.empty());
+  ASIO_CHECK(d.begin() == d.end());
+
+  int a = 42;
+  ASIO_CHECK(d.push_back(SOL_SOCKET, 1, a));
+  short b = 7;
+  ASIO_CHECK(d.push_back(IPPROTO_IP, 2, b));
+  ASIO_CHECK(!d.empty());
+  ASIO_CHECK(d.size() == asio::ancillary_data::space(sizeof(int))
+      + asio::ancillary_data::space(sizeof(short)));
+
+  asio::ancillary_data::const_iterator i = d.begin();
+  ASIO_CHECK(i != d.end());
+  ASIO_CHECK(i->level() == SOL_SOCKET);
+  ASIO_CHECK(i->type() == 1);
+  ASIO_CHECK(i->data().size() == sizeof(int));
+  ASIO_CHECK(i->data_as<int>() == 42);
+  ++i;
+  ASIO_CHECK(i != d.end());
+  ASIO_CHECK(i->level() == IPPROTO_IP);
+  ASIO_CHECK(i->type() == 2);
+  ASIO_CHECK(i->data().size() == sizeof(short));
+  ASIO_CHECK(i->data_as<short>() == 7);
+  i++;
+  ASIO_CHECK(i == d.end());
+
+  char large[128] = "";
+  ASIO_CHECK(!d.push_back(SOL_SOCKET, 3, large, sizeof(large)));
+  ASIO_CHECK(d.size() == asio::ancillary_data::space(sizeof(int))
+      + asio::ancillary_data::space(sizeof(short)));
+
+  d.clear();
+  ASIO_CHECK(d.empty());
+  ASIO_CHECK(d.begin() == d.end());
+
+  asio::ancillary_data none;
+  ASIO_CHECK(none.capacity() == 0);
+  ASIO_CHECK(!none.push_back(SOL_SOCKET, 1, a));
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace ancillary_data_messages
+
+//------------------------------------------------------------------------------
+
+// ancillary_data_rights test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that file descriptors may be passed over a local
+// stream socket, both synchronously and asynchronously, and that control
+// messages that do not fit in the receiver's storage are reported as
+// truncated.
+
+namespace ancillary_data_rights {
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) && defined(SCM_RIGHTS)
+
+struct io_handler
+{
+  io_handler(asio::error_code* ec, std::size_t* bytes)
+    : ec_(ec), bytes_(bytes)
+  {
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t bytes)
+  {
+    *ec_ = ec;
+    *bytes_ = bytes;
+  }
+
+  asio::error_code* ec_;
+  std::size_t* bytes_;
+};
+
+// Check that the descriptor received refers to the write end of the pipe.
+bool is_pipe_writer(int fd, int read_fd)
+{
+  if (::write(fd, "z", 1) != 1)
+    return false;
+  char c = 0;
+  return ::read(read_fd, &c, 1) == 1 && c == 'z';
+}
+
+int received_descriptor(const asio::ancillary_data& d)
+{
+  for (asio::ancillary_data::const_iterator i = d.begin(); i != d.end(); ++i)
+    if (i->level() == SOL_SOCKET && i->type() == SCM_RIGHTS)
+      return i->data_as<int>();
+  return -1;
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS) && defined(SCM_RIGHTS)
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) && defined(SCM_RIGHTS)
+  typedef asio::local::stream_protocol::socket socket_type;
+
+  asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+
+  unsigned char send_storage[64];
+  asio::ancillary_data out(asio::buffer(send_storage));
+  ASIO_CHECK(out.push_back(SOL_SOCKET, SCM_RIGHTS, fds[1]));
+
+  // Synchronous send and receive.
+  std::size_t n = s1.send_msg(asio::buffer("a", 1), out);
+  ASIO_CHECK(n == 1);
+
+  char data[16] = "";
+  unsigned char recv_storage[64];
+  asio::ancillary_data in(asio::buffer(recv_storage));
+  n = s2.receive_msg(asio::buffer(data), in);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(data[0] == 'a');
+  ASIO_CHECK(!in.truncated());
+  int fd = received_descriptor(in);
+  ASIO_CHECK(fd >= 0 && fd != fds[1]);
+  ASIO_CHECK(is_pipe_writer(fd, fds[0]));
+  ::close(fd);
+
+  // Asynchronous send and receive.
+  asio::error_code send_ec, recv_ec;
+  std::size_t send_bytes = 0, recv_bytes = 0;
+  s2.async_receive_msg(asio::buffer(data), in,
+      io_handler(&recv_ec, &recv_bytes));
+  s1.async_send_msg(asio::buffer("b", 1), out,
+      io_handler(&send_ec, &send_bytes));
+  ioc.run();
+  ASIO_CHECK(!send_ec && send_bytes == 1);
+  ASIO_CHECK(!recv_ec && recv_bytes == 1);
+  ASIO_CHECK(data[0] == 'b');
+  fd = received_descriptor(in);
+  ASIO_CHECK(fd >= 0);
+  ASIO_CHECK(is_pipe_writer(fd, fds[0]));
+  ::close(fd);
+
+  // Ordinary data is received with no control messages.
+  s1.send_msg(asio::buffer("c", 1), asio::ancillary_data());
+  n = s2.receive_msg(asio::buffer(data), in);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(data[0] == 'c');
+  ASIO_CHECK(in.empty());
+
+  // Storage too small for the control message.
+  s1.send_msg(asio::buffer("d", 1), out);
+  unsigned char small_storage[sizeof(void*)];
+  asio::ancillary_data small(asio::buffer(small_storage));
+  n = s2.receive_msg(asio::buffer(data), small);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(data[0] == 'd');
+  ASIO_CHECK(small.truncated());
+
+  // End of file.
+  asio::error_code ec;
+  s1.close();
+  n = s2.receive_msg(asio::buffer(data), in, 0, ec);
+  ASIO_CHECK(n == 0);
+  ASIO_CHECK(ec == asio::error::eof);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS) && defined(SCM_RIGHTS)
+}
+
+} // namespace ancillary_data_rights
+
+//------------------------------------------------------------------------------
+
+// ancillary_data_pktinfo test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a datagram is received with the endpoint of
+// its sender and the packet information requested by a socket option.
+
+namespace ancillary_data_pktinfo {
+
+void test()
+{
+#if defined(IP_PKTINFO) && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::udp::endpoint loopback(ip::address_v4::loopback(), 0);
+
+  ip::udp::socket receiver(ioc, loopback);
+  int on = 1;
+  ASIO_CHECK(::setsockopt(receiver.native_handle(),
+        IPPROTO_IP, IP_PKTINFO, &on, sizeof(on)) == 0);
+
+  ip::udp::socket sender(ioc, loopback);
+  ancillary_data none;
+  std::size_t n = sender.send_msg_to(
+      buffer("hello", 5), receiver.local_endpoint(), none);
+  ASIO_CHECK(n == 5);
+
+  char data[16] = "";
+  unsigned char storage[128];
+  ancillary_data in(buffer(storage));
+  ip::udp::endpoint sender_endpoint;
+  n = receiver.receive_msg_from(buffer(data), sender_endpoint, in);
+  ASIO_CHECK(n == 5);
+  ASIO_CHECK(std::memcmp(data, "hello", 5) == 0);
+  ASIO_CHECK(sender_endpoint == sender.local_endpoint());
+
+  bool found = false;
+  for (ancillary_data::const_iterator i = in.begin(); i != in.end(); ++i)
+  {
+    if (i->level() == IPPROTO_IP && i->type() == IP_PKTINFO)
+    {
+      in_pktinfo info = i->data_as<in_pktinfo>();
+      found = (ntohl(info.ipi_addr.s_addr) == 0x7F000001);
+    }
+  }
+  ASIO_CHECK(found);
+#endif // defined(IP_PKTINFO)
+       //   && !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace ancillary_data_pktinfo
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ancillary_data",
+  ASIO_TEST_CASE(ancillary_data_compile::test)
+  ASIO_TEST_CASE(ancillary_data_messages::test)
+  ASIO_TEST_CASE(ancillary_data_rights::test)
+  ASIO_TEST_CASE(ancillary_data_pktinfo::test)
+)
@@ -0,0 +1,253 @@
+//
+// basic_sharded_acceptor.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/basic_sharded_acceptor.hpp"
+
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/post.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// basic_sharded_acceptor_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// basic_sharded_acceptor compile and link correctly. Runtime failures are
+// ignored.
+
+namespace basic_sharded_acceptor_compile {
+
+struct move_accept_handler
+{
+  template <typename Socket>
+  void operator()(const asio::error_code&, ASIO_MOVE_ARG(Socket)) {}
+#if defined(ASIO_HAS_MOVE)
+  move_accept_handler() {}
+  move_accept_handler(move_accept_handler&&) {}
+private:
+  move_accept_handler(const move_accept_handler&);
+#endif // defined(ASIO_HAS_MOVE)
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc1;
+    io_context ioc2;
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    std::vector<io_context::executor_type> ioc_executors;
+    ioc_executors.push_back(ioc1.get_executor());
+    ioc_executors.push_back(ioc2.get_executor());
+
+    std::vector<executor> executors;
+    executors.push_back(ioc1.get_executor());
+    executors.push_back(ioc2.get_executor());
+
+    // basic_sharded_acceptor constructors.
+
+    basic_sharded_acceptor<ip::tcp, io_context::executor_type> acceptor1(
+        ioc_executors.begin(), ioc_executors.end(),
+        ip::tcp::endpoint(ip::tcp::v4(), 0));
+    ip::tcp::sharded_acceptor acceptor2(executors.begin(), executors.end(),
+        ip::tcp::endpoint(ip::tcp::v6(), 0), false);
+
+    // basic_sharded_acceptor functions.
+
+    std::size_t size = acceptor1.size();
+    (void)size;
+
+    basic_sharded_acceptor<ip::tcp,
+      io_context::executor_type>::acceptor_type& shard1 = acceptor1.shard(0);
+    (void)shard1;
+    const ip::tcp::sharded_acceptor& const_acceptor2 = acceptor2;
+    const ip::tcp::acceptor& shard2 = const_acceptor2.shard(0);
+    (void)shard2;
+
+    ip::tcp::acceptor& shard3 = acceptor2.select_shard();
+    (void)shard3;
+
+    bool is_open = acceptor1.is_open();
+    (void)is_open;
+
+    ip::tcp::endpoint endpoint1 = acceptor1.local_endpoint();
+    (void)endpoint1;
+    ip::tcp::endpoint endpoint2 = acceptor1.local_endpoint(ec);
+    (void)endpoint2;
+
+    acceptor1.set_option(ip::tcp::no_delay(true));
+    acceptor1.set_option(ip::tcp::no_delay(true), ec);
+
+    acceptor1.cancel();
+    acceptor1.cancel(ec);
+
+    acceptor1.async_accept(move_accept_handler());
+    acceptor2.async_accept(move_accept_handler());
+    int i = acceptor1.async_accept(lazy);
+    (void)i;
+
+    acceptor1.close();
+    acceptor1.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace basic_sharded_acceptor_compile
+
+//------------------------------------------------------------------------------
+
+// basic_sharded_acceptor_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// basic_sharded_acceptor class template.
+
+namespace basic_sharded_acceptor_runtime {
+
+#if defined(ASIO_HAS_MOVE)
+
+const int connection_count = 8;
+
+struct accept_state
+{
+  asio::ip::tcp::sharded_acceptor* acceptor;
+  int accepted[2];
+  int wrong_shard;
+  int aborted;
+};
+
+struct accept_handler
+{
+  accept_state* state;
+
+  void operator()(const asio::error_code& err, asio::ip::tcp::socket peer)
+  {
+    if (err)
+    {
+      ASIO_CHECK(err == asio::error::operation_aborted);
+      ++state->aborted;
+      return;
+    }
+
+    // The handler runs on the io_context of the shard that accepted the
+    // connection, and the socket is associated with the same io_context.
+    for (std::size_t i = 0; i < state->acceptor->size(); ++i)
+    {
+      if (state->acceptor->shard(i).get_executor()
+          .target<asio::io_context::executor_type>()->running_in_this_thread())
+      {
+        ++state->accepted[i];
+        if (!(peer.get_executor() == state->acceptor->shard(i).get_executor()))
+          ++state->wrong_shard;
+      }
+    }
+
+    // Restarting the accept from within the handler uses the same shard.
+    state->acceptor->async_accept(*this);
+  }
+};
+
+struct start_accept
+{
+  accept_state* state;
+
+  void operator()()
+  {
+    accept_handler handler = { state };
+    state->acceptor->async_accept(handler);
+  }
+};
+
+#endif // defined(ASIO_HAS_MOVE)
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc1;
+  io_context ioc2;
+  io_context client_ioc;
+
+  std::vector<executor> executors;
+  executors.push_back(ioc1.get_executor());
+  executors.push_back(ioc2.get_executor());
+
+  ip::tcp::sharded_acceptor acceptor(executors.begin(), executors.end(),
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ASIO_CHECK(acceptor.size() == 2);
+  ASIO_CHECK(acceptor.is_open());
+
+  ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+  ASIO_CHECK(endpoint.port() != 0);
+  ASIO_CHECK(acceptor.shard(1).local_endpoint() == endpoint);
+
+  // Start an accept loop on each shard.
+  accept_state state = { &acceptor, { 0, 0 }, 0, 0 };
+  start_accept starter = { &state };
+  for (std::size_t i = 0; i < acceptor.size(); ++i)
+    asio::post(acceptor.shard(i).get_executor(), starter);
+
+  std::vector<ip::tcp::socket*> clients;
+  for (int i = 0; i < connection_count; ++i)
+  {
+    clients.push_back(new ip::tcp::socket(client_ioc));
+    clients.back()->connect(endpoint);
+  }
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (state.accepted[0] + state.accepted[1] == connection_count)
+      break;
+    ioc1.run_one_for(asio::chrono::milliseconds(1));
+    ioc2.run_one_for(asio::chrono::milliseconds(1));
+  }
+
+  ASIO_CHECK(state.accepted[0] + state.accepted[1] == connection_count);
+  ASIO_CHECK(state.wrong_shard == 0);
+
+  // Closing the acceptor aborts the outstanding accept on each shard.
+  acceptor.close();
+  ASIO_CHECK(!acceptor.is_open());
+  ioc1.poll();
+  ioc2.poll();
+  ASIO_CHECK(state.aborted == 2);
+
+  for (std::size_t i = 0; i < clients.size(); ++i)
+    delete clients[i];
+#endif // defined(ASIO_HAS_MOVE)
+}
+
+} // namespace basic_sharded_acceptor_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "basic_sharded_acceptor",
+  ASIO_TEST_CASE(basic_sharded_acceptor_compile::test)
+  ASIO_TEST_CASE(basic_sharded_acceptor_runtime::test)
+)
@@ -0,0 +1,330 @@
+//
+// buffer_pool.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/buffer_pool.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// buffer_pool_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the classes
+// buffer_pool and pooled_buffer, and the socket functions that accept a
+// buffer_pool, compile and link correctly. Runtime failures are ignored.
+
+namespace buffer_pool_compile {
+
+#if defined(ASIO_HAS_MOVE)
+
+struct read_handler
+{
+  void operator()(const asio::error_code&, asio::pooled_buffer)
+  {
+  }
+};
+
+#endif // defined(ASIO_HAS_MOVE)
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    buffer_pool pool(1024, 16);
+
+    std::size_t size = pool.buffer_size();
+    (void)size;
+
+    std::size_t count = pool.buffer_count();
+    (void)count;
+
+    std::size_t available = pool.available();
+    (void)available;
+
+#if defined(ASIO_HAS_MOVE)
+    pooled_buffer b1;
+    pooled_buffer b2(ASIO_MOVE_CAST(pooled_buffer)(b1));
+    b1 = ASIO_MOVE_CAST(pooled_buffer)(b2);
+
+    mutable_buffer mb = b1.data();
+    (void)mb;
+
+    const_buffer cb = b1.data();
+    (void)cb;
+
+    size = b1.size();
+    bool empty = b1.empty();
+    (void)empty;
+
+    b1.reset();
+
+    io_context ioc;
+    ip::tcp::socket socket(ioc);
+    socket.async_read_some(pool, read_handler());
+#endif // defined(ASIO_HAS_MOVE)
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace buffer_pool_compile
+
+//------------------------------------------------------------------------------
+
+// buffer_pool_construct test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that buffers start on a cache line boundary, and
+// that a pool whose total size cannot be represented is rejected.
+
+namespace buffer_pool_construct {
+
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+struct read_handler
+{
+  explicit read_handler(asio::pooled_buffer* data) : data_(data) {}
+
+  void operator()(const asio::error_code&, asio::pooled_buffer data)
+  {
+    *data_ = ASIO_MOVE_CAST(asio::pooled_buffer)(data);
+  }
+
+  asio::pooled_buffer* data_;
+};
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+  for (std::size_t size = 1; size <= 200; size += 33)
+  {
+    asio::buffer_pool pool(size, 3);
+    asio::io_context ioc;
+    for (int i = 0; i < 3; ++i)
+    {
+      asio::local::stream_protocol::socket reader(ioc), writer(ioc);
+      asio::local::connect_pair(reader, writer);
+      asio::write(writer, asio::buffer("x", 1));
+      asio::pooled_buffer data;
+      reader.async_read_some(pool, read_handler(&data));
+      ioc.restart();
+      ioc.run();
+      ASIO_CHECK(data.size() == 1);
+      ASIO_CHECK(reinterpret_cast<std::size_t>(data.data().data()) % 64 == 0);
+    }
+  }
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+  const std::size_t max_size = (std::numeric_limits<std::size_t>::max)();
+
+  bool thrown = false;
+  try
+  {
+    asio::buffer_pool pool(max_size / 2, 4);
+  }
+  catch (std::length_error&)
+  {
+    thrown = true;
+  }
+  ASIO_CHECK(thrown);
+
+  thrown = false;
+  try
+  {
+    asio::buffer_pool pool(max_size - 1, 1);
+  }
+  catch (std::length_error&)
+  {
+    thrown = true;
+  }
+  ASIO_CHECK(thrown);
+}
+
+} // namespace buffer_pool_construct
+
+//------------------------------------------------------------------------------
+
+// buffer_pool_receive test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that reads from a pool take a buffer only when data
+// arrives, that an exhausted pool fails only reads for which data has arrived,
+// that the buffer is returned when the pooled_buffer is released, and that
+// errors are reported without consuming buffers.
+
+namespace buffer_pool_receive {
+
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+struct result
+{
+  result() : called(false) {}
+  bool called;
+  asio::error_code ec;
+  asio::pooled_buffer data;
+};
+
+struct read_handler
+{
+  explicit read_handler(result* r) : result_(r) {}
+
+  void operator()(const asio::error_code& ec, asio::pooled_buffer data)
+  {
+    result_->called = true;
+    result_->ec = ec;
+    result_->data = ASIO_MOVE_CAST(asio::pooled_buffer)(data);
+  }
+
+  result* result_;
+};
+
+bool data_equals(const asio::pooled_buffer& b, const char* s)
+{
+  return b.size() == std::strlen(s)
+    && std::memcmp(b.data().data(), s, b.size()) == 0;
+}
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+  asio::buffer_pool pool(64, 2);
+  ASIO_CHECK(pool.buffer_size() == 64);
+  ASIO_CHECK(pool.buffer_count() == 2);
+  ASIO_CHECK(pool.available() == 2);
+
+  {
+    asio::io_context ioc;
+
+    const int num_pairs = 5;
+    socket_type readers[num_pairs] = { socket_type(ioc), socket_type(ioc),
+      socket_type(ioc), socket_type(ioc), socket_type(ioc) };
+    socket_type writers[num_pairs] = { socket_type(ioc), socket_type(ioc),
+      socket_type(ioc), socket_type(ioc), socket_type(ioc) };
+    result results[num_pairs];
+    for (int i = 0; i < num_pairs; ++i)
+    {
+      asio::local::connect_pair(readers[i], writers[i]);
+      readers[i].async_read_some(pool, read_handler(&results[i]));
+    }
+
+    // Idle reads do not hold buffers.
+    ioc.poll();
+    for (int i = 0; i < num_pairs; ++i)
+      ASIO_CHECK(!results[i].called);
+    ASIO_CHECK(pool.available() == 2);
+
+    // Data is delivered in buffers taken from the pool.
+    asio::write(writers[0], asio::buffer("hello", 5));
+    asio::write(writers[1], asio::buffer("world", 5));
+    ioc.run_one();
+    ioc.run_one();
+    ASIO_CHECK(results[0].called && !results[0].ec);
+    ASIO_CHECK(data_equals(results[0].data, "hello"));
+    ASIO_CHECK(results[1].called && !results[1].ec);
+    ASIO_CHECK(data_equals(results[1].data, "world"));
+    ASIO_CHECK(pool.available() == 0);
+
+    // An exhausted pool causes the read to fail.
+    asio::write(writers[2], asio::buffer("again", 5));
+    ioc.run_one();
+    ASIO_CHECK(results[2].called);
+    ASIO_CHECK(results[2].ec == asio::error::no_buffer_space);
+    ASIO_CHECK(results[2].data.empty());
+
+    // An exhausted pool does not cause a read on an idle socket to fail, and
+    // the read takes a buffer that is released before data arrives.
+    results[0].data.reset();
+    ASIO_CHECK(results[0].data.empty());
+    ASIO_CHECK(pool.available() == 1);
+
+    results[2] = result();
+    readers[2].async_read_some(pool, read_handler(&results[2]));
+    ioc.run_one();
+    ASIO_CHECK(results[2].called && !results[2].ec);
+    ASIO_CHECK(data_equals(results[2].data, "again"));
+    ASIO_CHECK(pool.available() == 0);
+
+    results[0] = result();
+    readers[0].async_read_some(pool, read_handler(&results[0]));
+    ioc.poll();
+    ASIO_CHECK(!results[0].called);
+
+    // Releasing the data returns the buffers to the pool.
+    results[1].data = asio::pooled_buffer();
+    ASIO_CHECK(pool.available() == 1);
+    results[2].data.reset();
+    ASIO_CHECK(pool.available() == 2);
+
+    asio::write(writers[0], asio::buffer("later", 5));
+    ioc.run_one();
+    ASIO_CHECK(results[0].called && !results[0].ec);
+    ASIO_CHECK(data_equals(results[0].data, "later"));
+    results[0].data.reset();
+
+    // End of file does not consume a buffer.
+    writers[3].close();
+    ioc.run_one();
+    ASIO_CHECK(results[3].called);
+    ASIO_CHECK(results[3].ec == asio::error::eof);
+    ASIO_CHECK(results[3].data.empty());
+    ASIO_CHECK(pool.available() == 2);
+
+    // Nor does cancellation.
+    readers[4].cancel();
+    ioc.run_one();
+    ASIO_CHECK(results[4].called);
+    ASIO_CHECK(results[4].ec == asio::error::operation_aborted);
+    ASIO_CHECK(results[4].data.empty());
+    ASIO_CHECK(pool.available() == 2);
+
+    // Buffers are returned to the pool when the sockets, results and
+    // io_context are destroyed, whether or not the last handler has run.
+    results[0] = result();
+    readers[0].async_read_some(pool, read_handler(&results[0]));
+    asio::write(writers[0], asio::buffer("lost", 4));
+    ioc.poll_one();
+  }
+
+  ASIO_CHECK(pool.available() == 2);
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace buffer_pool_receive
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "buffer_pool",
+  ASIO_TEST_CASE(buffer_pool_compile::test)
+  ASIO_TEST_CASE(buffer_pool_construct::test)
+  ASIO_TEST_CASE(buffer_pool_receive::test)
+)
@@ -0,0 +1,102 @@
+//
+// coarse_steady_timer.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/coarse_steady_timer.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/io_context.hpp"
+
+//------------------------------------------------------------------------------
+
+// coarse_steady_timer_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the coarse clock is monotonic, and that a
+// wait on a coarse_steady_timer does not complete before the expiry time as
+// measured by the coarse clock.
+
+namespace coarse_steady_timer_runtime {
+
+typedef asio::coarse_steady_timer::clock_type clock_type;
+
+struct wait_handler
+{
+  wait_handler(asio::coarse_steady_timer* timer, int* count)
+    : timer_(timer),
+      count_(count)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(timer_->expiry() <= clock_type::now());
+    if (++(*count_) < 3)
+    {
+      timer_->expires_after(asio::chrono::milliseconds(5));
+      timer_->async_wait(*this);
+    }
+  }
+
+  asio::coarse_steady_timer* timer_;
+  int* count_;
+};
+
+void test()
+{
+  using namespace asio;
+
+  clock_type::time_point t1 = clock_type::now();
+  clock_type::time_point t2 = clock_type::now();
+  ASIO_CHECK(t1 <= t2);
+  ASIO_CHECK(clock_type::resolution() >= clock_type::duration::zero());
+
+  io_context ioc;
+  int count = 0;
+
+  coarse_steady_timer t(ioc, chrono::milliseconds(5));
+  t.async_wait(wait_handler(&t, &count));
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+}
+
+} // namespace coarse_steady_timer_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "coarse_steady_timer",
+  ASIO_TEST_CASE(coarse_steady_timer_runtime::test)
+)
+
+#else // defined(ASIO_HAS_CHRONO)
+
+ASIO_TEST_SUITE
+(
+  "coarse_steady_timer",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_CHRONO)
@@ -16,10 +16,371 @@
 // Test that header file is self-contained.
 #include "asio/executor.hpp"
 
+#include <cstddef>
+#include <new>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/strand.hpp"
+#include "asio/thread_pool.hpp"
 #include "unit_test.hpp"
 
+// An allocator that counts the allocations made through it.
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef counting_allocator<U> other;
+  };
+
+  explicit counting_allocator(long* count)
+    : count_(count)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : count_(other.count_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++(*count_);
+    return static_cast<T*>(::operator new(sizeof(T) * n));
+  }
+
+  void deallocate(T* p, std::size_t)
+  {
+    ::operator delete(p);
+  }
+
+  friend bool operator==(const counting_allocator& a,
+      const counting_allocator& b)
+  {
+    return a.count_ == b.count_;
+  }
+
+  friend bool operator!=(const counting_allocator& a,
+      const counting_allocator& b)
+  {
+    return a.count_ != b.count_;
+  }
+
+private:
+  template <typename> friend class counting_allocator;
+  long* count_;
+};
+
+//------------------------------------------------------------------------------
+
+// executor_storage test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that common executors are held inline by the
+// polymorphic wrapper, and that executors which are held inline, and those
+// which are not, are copied, moved and compared correctly.
+
+namespace executor_storage {
+
+// An executor that is too large to be held inline.
+class large_executor
+{
+public:
+  explicit large_executor(asio::io_context& ioc)
+    : executor_(ioc.get_executor())
+  {
+  }
+
+  asio::execution_context& context() const ASIO_NOEXCEPT
+  {
+    return executor_.context();
+  }
+
+  void on_work_started() const ASIO_NOEXCEPT
+  {
+    executor_.on_work_started();
+  }
+
+  void on_work_finished() const ASIO_NOEXCEPT
+  {
+    executor_.on_work_finished();
+  }
+
+  template <typename Function, typename Allocator>
+  void dispatch(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.dispatch(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  template <typename Function, typename Allocator>
+  void post(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.post(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  template <typename Function, typename Allocator>
+  void defer(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.defer(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  friend bool operator==(const large_executor& a,
+      const large_executor& b) ASIO_NOEXCEPT
+  {
+    return a.executor_ == b.executor_;
+  }
+
+  friend bool operator!=(const large_executor& a,
+      const large_executor& b) ASIO_NOEXCEPT
+  {
+    return a.executor_ != b.executor_;
+  }
+
+private:
+  asio::io_context::executor_type executor_;
+  char padding_[256];
+};
+
+struct increment
+{
+  explicit increment(int* count)
+    : count_(count)
+  {
+  }
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+
+  int* count_;
+};
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  thread_pool pool(1);
+  strand<io_context::executor_type> s(ioc.get_executor());
+
+  // Wrapping, copying, moving and assigning common executors does not
+  // allocate.
+  long allocation_count = 0;
+  counting_allocator<void> alloc(&allocation_count);
+  {
+    executor e1(allocator_arg_t(), alloc, ioc.get_executor());
+    executor e2(allocator_arg_t(), alloc, s);
+    executor e3(allocator_arg_t(), alloc, pool.get_executor());
+    executor e4(e2);
+    executor e5(ASIO_MOVE_CAST(executor)(e4));
+    e4 = e3;
+    e3 = e5;
+    e5 = s;
+    e1 = e1;
+
+    ASIO_CHECK(e1.target<io_context::executor_type>() != 0);
+    ASIO_CHECK(*e1.target<io_context::executor_type>() == ioc.get_executor());
+    ASIO_CHECK(e2.target<strand<io_context::executor_type> >() != 0);
+    ASIO_CHECK(*e2.target<strand<io_context::executor_type> >() == s);
+    ASIO_CHECK(e3 == e2);
+    ASIO_CHECK(e4.target<thread_pool::executor_type>() != 0);
+    ASIO_CHECK(e4 != e3);
+    ASIO_CHECK(e5 == e2);
+#if defined(ASIO_HAS_MOVE)
+    ASIO_CHECK(!e4.target<io_context::executor_type>());
+#endif // defined(ASIO_HAS_MOVE)
+    ASIO_CHECK(&e1.context() == &ioc);
+    ASIO_CHECK(&e4.context() == &pool);
+  }
+#if defined(ASIO_HAS_ALIGNOF)
+  ASIO_CHECK(allocation_count == 0);
+#endif // defined(ASIO_HAS_ALIGNOF)
+
+  // Executors that are too large are allocated, and shared between copies.
+  {
+    long before = allocation_count;
+    executor e1(allocator_arg_t(), alloc, large_executor(ioc));
+    ASIO_CHECK(allocation_count == before + 1);
+    executor e2(e1);
+    executor e3;
+    e3 = e2;
+    ASIO_CHECK(allocation_count == before + 1);
+    ASIO_CHECK(e1 == e2);
+    ASIO_CHECK(e3.target<large_executor>() == e1.target<large_executor>());
+
+    executor e4(ioc.get_executor());
+    e4 = e3;
+    ASIO_CHECK(e4 == e1);
+    ASIO_CHECK(e4 != executor(ioc.get_executor()));
+  }
+
+  // All kinds of executor can be used.
+  int count = 0;
+  executor e1(ioc.get_executor());
+  executor e2(s);
+  executor e3((large_executor(ioc)));
+  e1.post(increment(&count), std::allocator<void>());
+  e2.post(increment(&count), std::allocator<void>());
+  e3.post(increment(&count), std::allocator<void>());
+  e2.defer(increment(&count), std::allocator<void>());
+  e3.dispatch(increment(&count), std::allocator<void>());
+  ioc.run();
+  ASIO_CHECK(count == 5);
+}
+
+} // namespace executor_storage
+
+//------------------------------------------------------------------------------
+
+// executor_function test
+// ~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that small function objects posted through the
+// polymorphic wrapper are not allocated separately, and that function objects
+// are destroyed correctly whether or not they are invoked.
+
+namespace executor_function {
+
+struct small_handler
+{
+  small_handler(asio::executor* e, int* count, int limit,
+      const counting_allocator<void>& a)
+    : executor_(e),
+      count_(count),
+      limit_(limit),
+      allocator_(a)
+  {
+  }
+
+  void operator()()
+  {
+    if (++(*count_) < limit_)
+      executor_->post(*this, allocator_);
+  }
+
+  asio::executor* executor_;
+  int* count_;
+  int limit_;
+  counting_allocator<void> allocator_;
+};
+
+struct large_handler
+{
+  large_handler(int* calls, int* destructions)
+    : calls_(calls),
+      destructions_(destructions)
+  {
+  }
+
+  large_handler(const large_handler& other)
+    : calls_(other.calls_),
+      destructions_(other.destructions_)
+  {
+  }
+
+  ~large_handler()
+  {
+    ++(*destructions_);
+  }
+
+  void operator()()
+  {
+    ++(*calls_);
+  }
+
+  int* calls_;
+  int* destructions_;
+  char padding_[256];
+};
+
+struct counted_handler
+{
+  counted_handler(int* calls, int* instances)
+    : calls_(calls),
+      instances_(instances)
+  {
+    ++(*instances_);
+  }
+
+  counted_handler(const counted_handler& other)
+    : calls_(other.calls_),
+      instances_(other.instances_)
+  {
+    ++(*instances_);
+  }
+
+  ~counted_handler()
+  {
+    --(*instances_);
+  }
+
+  void operator()()
+  {
+    ++(*calls_);
+  }
+
+  int* calls_;
+  int* instances_;
+};
+
+void test()
+{
+  using namespace asio;
+
+  // Posting a small function object through the polymorphic wrapper does not
+  // allocate it separately.
+  {
+    io_context ioc;
+    executor e(ioc.get_executor());
+    int count = 0;
+    long allocation_count = 0;
+    counting_allocator<void> alloc(&allocation_count);
+    e.post(small_handler(&e, &count, 1000, alloc), alloc);
+    ioc.run();
+    ASIO_CHECK(count == 1000);
+    ASIO_CHECK(allocation_count == 0);
+  }
+
+  // Small and large function objects are invoked once, and destroyed.
+  {
+    int calls = 0, instances = 0, destructions = 0;
+    io_context ioc;
+    executor e(ioc.get_executor());
+    e.post(counted_handler(&calls, &instances), std::allocator<void>());
+    e.post(large_handler(&calls, &destructions), std::allocator<void>());
+    ioc.run();
+    ASIO_CHECK(calls == 2);
+    ASIO_CHECK(instances == 0);
+    ASIO_CHECK(destructions > 0);
+  }
+
+  // Function objects that are not invoked are destroyed.
+  {
+    int calls = 0, instances = 0, destructions = 0;
+    {
+      io_context ioc;
+      executor e(ioc.get_executor());
+      e.post(counted_handler(&calls, &instances), std::allocator<void>());
+      e.post(large_handler(&calls, &destructions), std::allocator<void>());
+      destructions = 0;
+    }
+    ASIO_CHECK(calls == 0);
+    ASIO_CHECK(instances == 0);
+    ASIO_CHECK(destructions > 0);
+  }
+}
+
+} // namespace executor_function
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "executor",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(executor_storage::test)
+  ASIO_TEST_CASE(executor_function::test)
 )
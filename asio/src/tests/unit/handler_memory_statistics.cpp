@@ -0,0 +1,239 @@
+//
+// handler_memory_statistics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/handler_memory_statistics.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// handler_memory_statistics_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// handler_memory_statistics compile and link correctly. Runtime failures are
+// ignored.
+
+namespace handler_memory_statistics_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    handler_memory_statistics stats1;
+    handler_memory_statistics stats2(1, 2, 3, 4);
+    handler_memory_statistics stats3 = get_handler_memory_statistics();
+
+    uint64_t hits = stats1.hits();
+    (void)hits;
+    uint64_t misses = stats2.misses();
+    (void)misses;
+    uint64_t discards = stats3.discards();
+    (void)discards;
+    std::size_t cached_bytes = stats3.cached_bytes();
+    (void)cached_bytes;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace handler_memory_statistics_compile
+
+//------------------------------------------------------------------------------
+
+// handler_memory_cache test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the per-thread cache holds several blocks of
+// each size class, and that it is bounded by the configured limits.
+
+namespace handler_memory_cache {
+
+void test()
+{
+  using asio::detail::thread_info_base;
+
+  thread_info_base this_thread;
+  const int n = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE;
+
+  // Several blocks of the same size class are recycled.
+  void* blocks[n + 1];
+  for (int i = 0; i < n + 1; ++i)
+    blocks[i] = thread_info_base::allocate(&this_thread, 100);
+  ASIO_CHECK(this_thread.cache_hits() == 0);
+  ASIO_CHECK(this_thread.cache_misses() == static_cast<asio::uint64_t>(n + 1));
+
+  for (int i = 0; i < n + 1; ++i)
+    thread_info_base::deallocate(&this_thread, blocks[i], 100);
+  ASIO_CHECK(this_thread.cache_discards() == 1);
+  ASIO_CHECK(this_thread.cached_bytes() == static_cast<std::size_t>(n) * 128);
+
+  // Any size within the class may use a cached block.
+  for (int i = 0; i < n; ++i)
+    blocks[i] = thread_info_base::allocate(&this_thread, 65 + i);
+  ASIO_CHECK(this_thread.cache_hits() == static_cast<asio::uint64_t>(n));
+  ASIO_CHECK(this_thread.cached_bytes() == 0);
+  for (int i = 0; i < n; ++i)
+    thread_info_base::deallocate(&this_thread, blocks[i], 65 + i);
+
+  // A different size class does not.
+  void* small = thread_info_base::allocate(
+      thread_info_base::executor_function_tag(), &this_thread, 16);
+  ASIO_CHECK(this_thread.cache_misses() == static_cast<asio::uint64_t>(n + 2));
+  thread_info_base::deallocate(
+      thread_info_base::executor_function_tag(), &this_thread, small, 16);
+
+  // Large blocks are never cached and are not counted.
+  void* large = thread_info_base::allocate(&this_thread, 100000);
+  thread_info_base::deallocate(&this_thread, large, 100000);
+  ASIO_CHECK(this_thread.cache_misses() == static_cast<asio::uint64_t>(n + 2));
+  ASIO_CHECK(this_thread.cache_discards() == 1);
+
+  // The cache does not grow beyond its byte limit.
+  const int big_count = ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES / 2048 + 1;
+  void* big[big_count];
+  for (int i = 0; i < big_count; ++i)
+    big[i] = thread_info_base::allocate(&this_thread, 2000);
+  for (int i = 0; i < big_count; ++i)
+    thread_info_base::deallocate(&this_thread, big[i], 2000);
+  ASIO_CHECK(this_thread.cached_bytes() <= ASIO_RECYCLING_ALLOCATOR_CACHE_BYTES);
+  ASIO_CHECK(this_thread.cache_discards() > 1);
+
+  // Blocks allocated without a cache may be returned to one.
+  void* orphan = thread_info_base::allocate(0, 200);
+  thread_info_base::deallocate(&this_thread, orphan, 200);
+}
+
+} // namespace handler_memory_cache
+
+//------------------------------------------------------------------------------
+
+// handler_memory_duplex test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a session with a read, a write and a timer
+// wait in flight at the same time reaches a steady state in which handler
+// memory is always taken from the cache.
+
+namespace handler_memory_duplex {
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+struct session;
+
+struct round_handler
+{
+  explicit round_handler(session* s) : session_(s) {}
+  void operator()(const asio::error_code& ec, std::size_t = 0);
+  session* session_;
+};
+
+struct session
+{
+  session(asio::io_context& ioc)
+    : reader_(ioc),
+      writer_(ioc),
+      timer_(ioc),
+      pending_(0),
+      rounds_(0)
+  {
+    asio::local::connect_pair(reader_, writer_);
+  }
+
+  void start_round()
+  {
+    if (rounds_ == 10)
+      warm_ = asio::get_handler_memory_statistics();
+
+    if (++rounds_ > 200)
+    {
+      done_ = asio::get_handler_memory_statistics();
+      return;
+    }
+
+    pending_ = 3;
+    reader_.async_read_some(asio::buffer(read_data_), round_handler(this));
+    writer_.async_write_some(asio::buffer("x", 1), round_handler(this));
+    timer_.expires_after(asio::chrono::milliseconds(0));
+    timer_.async_wait(round_handler(this));
+  }
+
+  socket_type reader_;
+  socket_type writer_;
+  asio::steady_timer timer_;
+  char read_data_[1];
+  int pending_;
+  int rounds_;
+  asio::handler_memory_statistics warm_;
+  asio::handler_memory_statistics done_;
+};
+
+void round_handler::operator()(const asio::error_code& ec, std::size_t)
+{
+  ASIO_CHECK(!ec);
+  if (--session_->pending_ == 0)
+    session_->start_round();
+}
+
+struct start_handler
+{
+  explicit start_handler(session* s) : session_(s) {}
+  void operator()() { session_->start_round(); }
+  session* session_;
+};
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+  // Outside a run function there is no cache.
+  asio::handler_memory_statistics stats = asio::get_handler_memory_statistics();
+  ASIO_CHECK(stats.hits() == 0);
+  ASIO_CHECK(stats.misses() == 0);
+  ASIO_CHECK(stats.discards() == 0);
+  ASIO_CHECK(stats.cached_bytes() == 0);
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  asio::io_context ioc;
+  session s(ioc);
+  asio::post(ioc, start_handler(&s));
+  ioc.run();
+
+  ASIO_CHECK(s.rounds_ == 201);
+  ASIO_CHECK(s.done_.hits() > s.warm_.hits());
+  ASIO_CHECK(s.done_.misses() == s.warm_.misses());
+  ASIO_CHECK(s.done_.discards() == s.warm_.discards());
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace handler_memory_duplex
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "handler_memory_statistics",
+  ASIO_TEST_CASE(handler_memory_statistics_compile::test)
+  ASIO_TEST_CASE(handler_memory_cache::test)
+  ASIO_TEST_CASE(handler_memory_duplex::test)
+)
@@ -17,6 +17,9 @@
 #include "asio/io_context.hpp"
 
 #include <sstream>
+#if defined(ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#endif // defined(ASIO_HAS_STD_ATOMIC)
 #include "asio/bind_executor.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
@@ -284,6 +287,167 @@ void io_context_test()
   ASIO_CHECK(exception_count == 2);
 }
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+void atomic_increment(std::atomic<int>* count)
+{
+  ++(*count);
+}
+
+void atomic_decrement_to_zero(io_context* ioc, std::atomic<int>* count,
+    std::atomic<int>* total)
+{
+  ++(*total);
+  if (--(*count) > 0)
+  {
+    asio::post(*ioc,
+        bindns::bind(atomic_decrement_to_zero, ioc, count, total));
+  }
+}
+
+void post_atomic_increments(io_context* ioc, std::atomic<int>* count)
+{
+  for (int i = 0; i < 1000; ++i)
+    asio::post(*ioc, bindns::bind(atomic_increment, count));
+}
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+void io_context_work_stealing_test()
+{
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  io_context ioc(ASIO_CONCURRENCY_HINT_WORK_STEALING_SAFE(2));
+  std::atomic<int> count(0);
+
+  asio::post(ioc, bindns::bind(atomic_increment, &count));
+  asio::post(ioc, bindns::bind(atomic_increment, &count));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ASIO_CHECK(ioc.poll_one() == 1);
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ioc.poll() == 1);
+  ASIO_CHECK(count == 2);
+
+  // The poll() call ran the last of the work.
+  ASIO_CHECK(ioc.stopped());
+
+  // Handlers posted from within handlers, and handlers posted from outside the
+  // io_context, are all run when more threads than queues are running it.
+  std::atomic<int> chain_counts[4];
+  std::atomic<int> total(0);
+  count = 0;
+  ioc.restart();
+  for (int i = 0; i < 4; ++i)
+  {
+    chain_counts[i] = 100;
+    asio::post(ioc, bindns::bind(atomic_decrement_to_zero,
+          &ioc, &chain_counts[i], &total));
+  }
+  timer t(ioc, chronons::milliseconds(10));
+  t.async_wait(bindns::bind(atomic_increment, &count));
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  thread thread3(bindns::bind(io_context_run, &ioc));
+  thread poster(bindns::bind(post_atomic_increments, &ioc, &count));
+  poster.join();
+  w.reset();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  // The run() calls will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1001);
+  ASIO_CHECK(total == 400);
+
+  // Stopping the io_context leaves pending handlers to a later run.
+  count = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  asio::post(ioc, bindns::bind(atomic_increment, &count));
+  ioc.run();
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+}
+
+void io_context_lock_free_post_test()
+{
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  io_context ioc(ASIO_CONCURRENCY_HINT_UNSAFE_LOCK_FREE_POST);
+  std::atomic<int> count(0);
+
+  asio::post(ioc, bindns::bind(atomic_increment, &count));
+  asio::post(ioc, bindns::bind(atomic_increment, &count));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ASIO_CHECK(ioc.poll_one() == 1);
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ioc.poll() == 1);
+  ASIO_CHECK(count == 2);
+
+  // The poll() call ran the last of the work.
+  ASIO_CHECK(ioc.stopped());
+
+  // Handlers posted from other threads wake the thread blocked in run(), and
+  // handlers posted from within handlers are run by the same thread.
+  std::atomic<int> chain_count(100);
+  std::atomic<int> total(0);
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  thread runner(bindns::bind(io_context_run, &ioc));
+  thread poster1(bindns::bind(post_atomic_increments, &ioc, &count));
+  thread poster2(bindns::bind(post_atomic_increments, &ioc, &count));
+  asio::post(ioc, bindns::bind(atomic_decrement_to_zero,
+        &ioc, &chain_count, &total));
+  poster1.join();
+  poster2.join();
+  w.reset();
+  runner.join();
+
+  // The run() call will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 2000);
+  ASIO_CHECK(total == 100);
+
+  // A stop from another thread wakes the thread blocked in run().
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc);
+  thread runner2(bindns::bind(io_context_run, &ioc));
+  ioc.stop();
+  runner2.join();
+  ASIO_CHECK(ioc.stopped());
+
+  // Stopping the io_context leaves pending handlers to a later run.
+  count = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  asio::post(ioc, bindns::bind(atomic_increment, &count));
+  ioc.run();
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  w2.reset();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+}
+
 class test_service : public asio::io_context::service
 {
 public:
@@ -358,5 +522,7 @@ ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
+  ASIO_TEST_CASE(io_context_work_stealing_test)
+  ASIO_TEST_CASE(io_context_lock_free_post_test)
   ASIO_TEST_CASE(io_context_service_test)
 )
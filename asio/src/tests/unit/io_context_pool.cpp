@@ -0,0 +1,148 @@
+//
+// io_context_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/io_context_pool.hpp"
+
+#include "asio/detail/atomic_count.hpp"
+#include "asio/post.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+//------------------------------------------------------------------------------
+
+// io_context_pool_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// io_context_pool compile and link correctly. Runtime failures are ignored.
+
+namespace io_context_pool_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context_pool pool1;
+    io_context_pool pool2(2);
+    io_context_pool pool3(2, io_context_pool::no_affinity);
+    io_context_pool pool4(2, io_context_pool::numa_affinity,
+        ASIO_CONCURRENCY_HINT_UNSAFE_LOCK_FREE_POST);
+
+    std::size_t size = pool1.size();
+    (void)size;
+
+    io_context& ioc = pool2.get_io_context(0);
+    (void)ioc;
+
+    io_context_pool::executor_type ex1 = pool1.get_executor();
+    (void)ex1;
+    io_context_pool::executor_type ex2 = pool2.get_least_loaded_executor();
+    (void)ex2;
+    io_context_pool::executor_type ex3 = pool3.get_executor_for_key(42);
+    (void)ex3;
+
+    pool3.stop();
+    pool3.join();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace io_context_pool_compile
+
+//------------------------------------------------------------------------------
+
+// io_context_pool_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the io_context_pool
+// class.
+
+namespace io_context_pool_runtime {
+
+void count_if_running(asio::io_context_pool::executor_type ex,
+    asio::detail::atomic_count* count)
+{
+  if (ex.running_in_this_thread())
+    ++(*count);
+}
+
+void test()
+{
+  using namespace asio;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+  io_context_pool pool(2, io_context_pool::cpu_affinity);
+  ASIO_CHECK(pool.size() == 2);
+
+  io_context_pool::executor_type ex0 = pool.get_io_context(0).get_executor();
+  io_context_pool::executor_type ex1 = pool.get_io_context(1).get_executor();
+  ASIO_CHECK(ex0 != ex1);
+
+  // Round-robin selection cycles through the io_context objects.
+  io_context_pool::executor_type rr1 = pool.get_executor();
+  io_context_pool::executor_type rr2 = pool.get_executor();
+  io_context_pool::executor_type rr3 = pool.get_executor();
+  ASIO_CHECK(rr1 != rr2);
+  ASIO_CHECK(rr1 == rr3);
+
+  // Key-based selection is stable.
+  ASIO_CHECK(pool.get_executor_for_key(0) == ex0);
+  ASIO_CHECK(pool.get_executor_for_key(1) == ex1);
+  ASIO_CHECK(pool.get_executor_for_key(7) == ex1);
+  ASIO_CHECK(pool.get_executor_for_key(7) == pool.get_executor_for_key(7));
+
+  // Least-loaded selection avoids an io_context with outstanding work.
+  ex0.on_work_started();
+  ASIO_CHECK(pool.get_least_loaded_executor() == ex1);
+  ex0.on_work_finished();
+  ex1.on_work_started();
+  ASIO_CHECK(pool.get_least_loaded_executor() == ex0);
+  ex1.on_work_finished();
+
+  // Functions run on the thread belonging to the selected io_context.
+  asio::detail::atomic_count count(0);
+  for (int i = 0; i < 100; ++i)
+  {
+    io_context_pool::executor_type ex = pool.get_executor_for_key(i);
+    asio::post(ex, bindns::bind(count_if_running, ex, &count));
+  }
+
+  pool.join();
+  ASIO_CHECK(count == 100);
+}
+
+} // namespace io_context_pool_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "io_context_pool",
+  ASIO_TEST_CASE(io_context_pool_compile::test)
+  ASIO_TEST_CASE(io_context_pool_runtime::test)
+)
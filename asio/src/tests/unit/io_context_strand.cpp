@@ -317,9 +317,32 @@ void strand_wrap_test()
 #endif // !defined(ASIO_NO_DEPRECATED)
 }
 
+void strand_outlives_io_context_test()
+{
+  int count = 0;
+
+  io_context::strand* s1 = 0;
+  io_context::strand* s2 = 0;
+  {
+    io_context ioc;
+    s1 = new io_context::strand(ioc);
+    s2 = new io_context::strand(ioc);
+
+    // Leave a handler waiting on one of the strands.
+    s2->post(bindns::bind(increment, &count));
+  }
+
+  // The handler is destroyed without being invoked when the io_context is
+  // destroyed, and the strands may still be destroyed afterwards.
+  ASIO_CHECK(count == 0);
+  delete s1;
+  delete s2;
+}
+
 ASIO_TEST_SUITE
 (
   "strand",
   ASIO_TEST_CASE(strand_test)
   ASIO_TEST_CASE(strand_wrap_test)
+  ASIO_TEST_CASE(strand_outlives_io_context_test)
 )
@@ -0,0 +1,361 @@
+//
+// io_uring_service.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// The io_uring backend is opt-in, so enable it here when the library is not
+// separately compiled. A small ring is used so that the submission queue and
+// the completion queue both fill up.
+#if !defined(ASIO_SEPARATE_COMPILATION) && defined(__linux__)
+# if defined(__has_include)
+#  if __has_include(<linux/io_uring.h>)
+#   if !defined(ASIO_HAS_IO_URING)
+#    define ASIO_HAS_IO_URING 1
+#   endif // !defined(ASIO_HAS_IO_URING)
+#   define ASIO_IO_URING_ENTRIES 4
+#  endif // __has_include(<linux/io_uring.h>)
+# endif // defined(__has_include)
+#endif // !defined(ASIO_SEPARATE_COMPILATION) && defined(__linux__)
+
+#include <cstddef>
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/random_access_file.hpp"
+#include "asio/read.hpp"
+#include "asio/read_at.hpp"
+#include "asio/write.hpp"
+#include "asio/write_at.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+# include <linux/filter.h>
+# include <linux/seccomp.h>
+# include <sys/prctl.h>
+# include <sys/syscall.h>
+# include <sys/wait.h>
+# include <cstdio>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_IO_URING)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+void handle_read(const asio::error_code& err,
+    std::size_t bytes_transferred, asio::error_code* out_err,
+    std::size_t* out_bytes, int* count)
+{
+  *out_err = err;
+  *out_bytes = bytes_transferred;
+  ++(*count);
+}
+
+//------------------------------------------------------------------------------
+
+// io_uring_service_full_queue test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that starting more operations than fit in the
+// submission queue flushes the queue, and that completions which overflow the
+// completion queue are still delivered.
+
+namespace io_uring_service_full_queue {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+const int pair_count = 16;
+
+struct fixture
+{
+  socket_type* readers[pair_count];
+  socket_type* writers[pair_count];
+  char data[pair_count][8];
+  asio::error_code errors[pair_count];
+  std::size_t bytes[pair_count];
+  int count;
+};
+
+void start_reads(fixture* f)
+{
+  // Inside the scheduler, submissions are deferred until the handler returns,
+  // so every read here needs a submission queue entry at the same time.
+  for (int i = 0; i < pair_count; ++i)
+  {
+    f->readers[i]->async_read_some(asio::buffer(f->data[i]),
+        bindns::bind(handle_read, _1, _2,
+          &f->errors[i], &f->bytes[i], &f->count));
+  }
+}
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  if (!use_service<detail::io_uring_service>(ioc).is_enabled())
+    return;
+
+  fixture f;
+  f.count = 0;
+  for (int i = 0; i < pair_count; ++i)
+  {
+    f.readers[i] = new socket_type(ioc);
+    f.writers[i] = new socket_type(ioc);
+    local::connect_pair(*f.readers[i], *f.writers[i]);
+    f.bytes[i] = 0;
+  }
+
+  asio::post(ioc, bindns::bind(start_reads, &f));
+  ioc.poll();
+  ASIO_CHECK(f.count == 0);
+
+  // Complete all of the reads at once, so that there are more completions than
+  // fit in the completion queue.
+  for (int i = 0; i < pair_count; ++i)
+  {
+    char message[8] = "data";
+    message[4] = static_cast<char>('a' + i);
+    asio::write(*f.writers[i], asio::buffer(message, 5));
+  }
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(f.count == pair_count);
+
+  for (int i = 0; i < pair_count; ++i)
+  {
+    ASIO_CHECK(!f.errors[i]);
+    ASIO_CHECK(f.bytes[i] == 5);
+    ASIO_CHECK(std::memcmp(f.data[i], "data", 4) == 0);
+    ASIO_CHECK(f.data[i][4] == static_cast<char>('a' + i));
+    delete f.readers[i];
+    delete f.writers[i];
+  }
+}
+
+} // namespace io_uring_service_full_queue
+
+//------------------------------------------------------------------------------
+
+// io_uring_service_cancel test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that operations in flight in the kernel, and those
+// queued behind them, complete with operation_aborted when cancelled or when
+// the socket is closed, and that the socket remains usable after cancel.
+
+namespace io_uring_service_cancel {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  if (!use_service<detail::io_uring_service>(ioc).is_enabled())
+    return;
+
+  socket_type reader(ioc), writer(ioc);
+  local::connect_pair(reader, writer);
+
+  char data1[8], data2[8];
+  asio::error_code err1, err2;
+  std::size_t bytes1 = 0, bytes2 = 0;
+  int count = 0;
+
+  // The first read is submitted to the kernel. The second waits behind it.
+  reader.async_read_some(asio::buffer(data1),
+      bindns::bind(handle_read, _1, _2, &err1, &bytes1, &count));
+  reader.async_read_some(asio::buffer(data2),
+      bindns::bind(handle_read, _1, _2, &err2, &bytes2, &count));
+  ioc.poll();
+  ASIO_CHECK(count == 0);
+
+  reader.cancel();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(err1 == asio::error::operation_aborted);
+  ASIO_CHECK(err2 == asio::error::operation_aborted);
+
+  // The socket can still be used.
+  count = 0;
+  reader.async_read_some(asio::buffer(data1),
+      bindns::bind(handle_read, _1, _2, &err1, &bytes1, &count));
+  asio::write(writer, asio::buffer("hello", 5));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(!err1);
+  ASIO_CHECK(bytes1 == 5);
+  ASIO_CHECK(std::memcmp(data1, "hello", 5) == 0);
+
+  // Closing the socket aborts the operation in flight.
+  count = 0;
+  reader.async_read_some(asio::buffer(data1),
+      bindns::bind(handle_read, _1, _2, &err1, &bytes1, &count));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(count == 0);
+  reader.close();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(err1 == asio::error::operation_aborted);
+}
+
+} // namespace io_uring_service_cancel
+
+//------------------------------------------------------------------------------
+
+// io_uring_service_fallback test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that when the kernel refuses to create a ring,
+// sockets perform their operations through the reactor instead, and files on
+// the internal thread pool. The refusal is
+// simulated in a child process by filtering the io_uring_setup system call.
+
+namespace io_uring_service_fallback {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+using std::placeholders::_1;
+using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+bool deny_io_uring_setup()
+{
+  struct sock_filter filter[] =
+  {
+    BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr)),
+    BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_io_uring_setup, 0, 1),
+    BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | (ENOSYS & SECCOMP_RET_DATA)),
+    BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW)
+  };
+  struct sock_fprog program =
+  {
+    static_cast<unsigned short>(sizeof(filter) / sizeof(filter[0])), filter
+  };
+  return ::prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0
+    && ::prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) == 0;
+}
+
+// Returns 0 if the operations were performed without io_uring, 1 if the system
+// call could not be filtered, and 2 on failure.
+int run_child()
+{
+  using namespace asio;
+
+  if (!deny_io_uring_setup())
+    return 1;
+
+  io_context ioc;
+  if (use_service<detail::io_uring_service>(ioc).is_enabled())
+    return 2;
+
+  socket_type reader(ioc), writer(ioc);
+  local::connect_pair(reader, writer);
+
+  char data[8];
+  asio::error_code err;
+  std::size_t bytes = 0;
+  int count = 0;
+  asio::async_read(reader, asio::buffer(data, 5),
+      bindns::bind(handle_read, _1, _2, &err, &bytes, &count));
+  asio::async_write(writer, asio::buffer("hello", 5),
+      bindns::bind(handle_read, _1, _2, &err, &bytes, &count));
+  ioc.run();
+
+  if (count != 2 || err || bytes != 5 || std::memcmp(data, "hello", 5) != 0)
+    return 2;
+
+#if defined(ASIO_HAS_FILE)
+  const char* path = "io_uring_service_fallback.tmp";
+  random_access_file file(ioc, path,
+      random_access_file::read_write
+        | random_access_file::create
+        | random_access_file::truncate);
+
+  count = 0;
+  asio::async_write_at(file, 0, asio::buffer("world", 5),
+      bindns::bind(handle_read, _1, _2, &err, &bytes, &count));
+  ioc.restart();
+  ioc.run();
+  if (count != 1 || err || bytes != 5)
+    return 2;
+
+  asio::async_read_at(file, 0, asio::buffer(data, 5),
+      bindns::bind(handle_read, _1, _2, &err, &bytes, &count));
+  ioc.restart();
+  ioc.run();
+  file.close();
+  std::remove(path);
+  if (count != 2 || err || bytes != 5 || std::memcmp(data, "world", 5) != 0)
+    return 2;
+#endif // defined(ASIO_HAS_FILE)
+
+  return 0;
+}
+
+void test()
+{
+  pid_t pid = ::fork();
+  ASIO_CHECK(pid != -1);
+  if (pid == 0)
+    ::_exit(run_child());
+
+  int status = 0;
+  ASIO_CHECK(::waitpid(pid, &status, 0) == pid);
+  ASIO_CHECK(WIFEXITED(status));
+  ASIO_CHECK(WEXITSTATUS(status) != 2);
+}
+
+} // namespace io_uring_service_fallback
+
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_LOCAL_SOCKETS)
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "io_uring_service",
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_LOCAL_SOCKETS)
+  ASIO_TEST_CASE(io_uring_service_full_queue::test)
+  ASIO_TEST_CASE(io_uring_service_cancel::test)
+  ASIO_TEST_CASE(io_uring_service_fallback::test)
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_LOCAL_SOCKETS)
+  ASIO_TEST_CASE(null_test)
+)
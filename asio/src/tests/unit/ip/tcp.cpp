@@ -20,6 +20,7 @@
 #include "asio/ip/tcp.hpp"
 
 #include <cstring>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
 #include "asio/write.hpp"
@@ -442,6 +443,18 @@ void test()
     int i13 = socket1.async_send(null_buffers(), in_flags, lazy);
     (void)i13;
 
+    socket1.async_send_zero_copy(buffer(mutable_char_buffer), send_handler());
+    socket1.async_send_zero_copy(buffer(const_char_buffer), send_handler());
+    socket1.async_send_zero_copy(mutable_buffers, send_handler());
+    socket1.async_send_zero_copy(const_buffers, send_handler());
+    socket1.async_send_zero_copy(buffer(const_char_buffer),
+        in_flags, send_handler());
+    socket1.async_send_zero_copy(const_buffers, in_flags, send_handler());
+    int i28 = socket1.async_send_zero_copy(buffer(const_char_buffer), lazy);
+    (void)i28;
+    int i29 = socket1.async_send_zero_copy(const_buffers, in_flags, lazy);
+    (void)i29;
+
     socket1.receive(buffer(mutable_char_buffer));
     socket1.receive(mutable_buffers);
     socket1.receive(null_buffers());
@@ -567,6 +580,22 @@ void handle_write(const asio::error_code& err,
   ASIO_CHECK(bytes_transferred == sizeof(write_data));
 }
 
+void handle_zero_copy_read(const asio::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes);
+}
+
+void handle_zero_copy_write(const asio::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes);
+}
+
 void handle_read_cancel(const asio::error_code& err,
     size_t bytes_transferred, bool* called)
 {
@@ -653,6 +682,45 @@ void test()
   ASIO_CHECK(write_completed);
   ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+  // Zero-copy writes of more data than the socket buffers can hold are
+  // received intact and in order.
+
+  std::vector<char> zero_copy_data(4 * 1024 * 1024);
+  for (std::size_t i = 0; i < zero_copy_data.size(); ++i)
+    zero_copy_data[i] = static_cast<char>(i * 7);
+  std::vector<const_buffer> zero_copy_buffers;
+  zero_copy_buffers.push_back(asio::buffer(
+        &zero_copy_data[0], zero_copy_data.size() / 2));
+  zero_copy_buffers.push_back(asio::buffer(
+        &zero_copy_data[zero_copy_data.size() / 2],
+        zero_copy_data.size() / 2));
+
+  std::vector<char> zero_copy_read_buffer(zero_copy_data.size() * 2);
+  bool zero_copy_read_completed = false;
+  asio::async_read(client_side_socket,
+      asio::buffer(zero_copy_read_buffer),
+      bindns::bind(handle_zero_copy_read, _1, _2,
+        zero_copy_read_buffer.size(), &zero_copy_read_completed));
+
+  bool zero_copy_write_completed[2] = { false, false };
+  server_side_socket.async_send_zero_copy(
+      asio::buffer(zero_copy_data),
+      bindns::bind(handle_zero_copy_write, _1, _2,
+        zero_copy_data.size(), &zero_copy_write_completed[0]));
+  server_side_socket.async_send_zero_copy(zero_copy_buffers,
+      bindns::bind(handle_zero_copy_write, _1, _2,
+        zero_copy_data.size(), &zero_copy_write_completed[1]));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(zero_copy_read_completed);
+  ASIO_CHECK(zero_copy_write_completed[0]);
+  ASIO_CHECK(zero_copy_write_completed[1]);
+  ASIO_CHECK(memcmp(&zero_copy_read_buffer[0],
+        &zero_copy_data[0], zero_copy_data.size()) == 0);
+  ASIO_CHECK(memcmp(&zero_copy_read_buffer[zero_copy_data.size()],
+        &zero_copy_data[0], zero_copy_data.size()) == 0);
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
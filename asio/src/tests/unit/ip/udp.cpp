@@ -440,6 +440,84 @@ void test()
     int i29 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i29;
+
+    const_buffer const_buffers[2] = { buffer(const_char_buffer),
+      buffer(const_char_buffer) };
+    mutable_buffer mutable_buffers[2] = { buffer(mutable_char_buffer),
+      buffer(mutable_char_buffer) };
+    ip::udp::endpoint endpoints[2];
+    std::size_t sizes[2];
+
+    socket1.send_many(const_buffers, endpoints, 2);
+    socket1.send_many(const_buffers, endpoints, 2, in_flags, ec);
+    socket1.async_send_many(const_buffers, endpoints, 2, send_handler());
+    socket1.async_send_many(const_buffers, endpoints, 2,
+        in_flags, send_handler());
+    int i30 = socket1.async_send_many(const_buffers, endpoints, 2, lazy);
+    (void)i30;
+    int i31 = socket1.async_send_many(const_buffers,
+        endpoints, 2, in_flags, lazy);
+    (void)i31;
+
+    socket1.receive_many(mutable_buffers, endpoints, sizes, 2);
+    socket1.receive_many(mutable_buffers, endpoints, sizes, 2, in_flags, ec);
+    socket1.async_receive_many(mutable_buffers,
+        endpoints, sizes, 2, receive_handler());
+    socket1.async_receive_many(mutable_buffers,
+        endpoints, sizes, 2, in_flags, receive_handler());
+    int i32 = socket1.async_receive_many(mutable_buffers,
+        endpoints, sizes, 2, lazy);
+    (void)i32;
+    int i33 = socket1.async_receive_many(mutable_buffers,
+        endpoints, sizes, 2, in_flags, lazy);
+    (void)i33;
+
+    std::size_t segment_size = 0;
+
+    socket1.send_segments_to(buffer(const_char_buffer), endpoint, 64);
+    socket1.send_segments_to(buffer(const_char_buffer),
+        endpoint, 64, in_flags, ec);
+    socket1.async_send_segments_to(buffer(const_char_buffer),
+        endpoint, 64, send_handler());
+    socket1.async_send_segments_to(buffer(const_char_buffer),
+        endpoint, 64, in_flags, send_handler());
+    int i34 = socket1.async_send_segments_to(buffer(const_char_buffer),
+        endpoint, 64, lazy);
+    (void)i34;
+    int i35 = socket1.async_send_segments_to(buffer(const_char_buffer),
+        endpoint, 64, in_flags, lazy);
+    (void)i35;
+
+    socket1.receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, segment_size);
+    socket1.receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, ec);
+    socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, segment_size, receive_handler());
+    socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, receive_handler());
+    int i36 = socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, segment_size, lazy);
+    (void)i36;
+    int i37 = socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, lazy);
+    (void)i37;
+
+    // ip::udp socket options.
+
+    ip::udp::segment_size segment_size1(1200);
+    socket1.set_option(segment_size1, ec);
+    ip::udp::segment_size segment_size2;
+    socket1.get_option(segment_size2, ec);
+    int segment_size_value = segment_size2.value();
+    (void)segment_size_value;
+
+    ip::udp::receive_offload receive_offload1(true);
+    socket1.set_option(receive_offload1, ec);
+    ip::udp::receive_offload receive_offload2;
+    socket1.get_option(receive_offload2, ec);
+    bool receive_offload_value = receive_offload2.value();
+    (void)receive_offload_value;
   }
   catch (std::exception&)
   {
@@ -521,6 +599,215 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_udp_socket_batch_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that batches of datagrams are sent and received
+// with the correct sizes and sender endpoints.
+
+namespace ip_udp_socket_batch_runtime {
+
+void handle_batch(std::size_t* result,
+    const asio::error_code& err, std::size_t n)
+{
+  ASIO_CHECK(!err);
+  *result = n;
+}
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s3(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  const char send_msg[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+  const std::size_t num_msgs = 8;
+
+  // Each datagram has a different length.
+  const_buffer send_buffers[num_msgs];
+  ip::udp::endpoint destinations[num_msgs];
+  for (std::size_t i = 0; i < num_msgs; ++i)
+  {
+    send_buffers[i] = buffer(send_msg, i + 1);
+    destinations[i] = s1.local_endpoint();
+  }
+
+  char recv_msgs[num_msgs][sizeof(send_msg)];
+  mutable_buffer recv_buffers[num_msgs];
+  ip::udp::endpoint senders[num_msgs];
+  std::size_t sizes[num_msgs];
+  for (std::size_t i = 0; i < num_msgs; ++i)
+    recv_buffers[i] = buffer(recv_msgs[i]);
+
+  // Send the first half from one socket and the rest from another. The
+  // datagrams are received in the order they were sent.
+  std::size_t sent = 0;
+  while (sent < num_msgs / 2)
+    sent += s2.send_many(send_buffers + sent, destinations + sent,
+        num_msgs / 2 - sent);
+  while (sent < num_msgs)
+    sent += s3.send_many(send_buffers + sent, destinations + sent,
+        num_msgs - sent);
+
+  std::size_t recvd = 0;
+  while (recvd < num_msgs)
+    recvd += s1.receive_many(recv_buffers + recvd, senders + recvd,
+        sizes + recvd, num_msgs - recvd);
+
+  for (std::size_t i = 0; i < num_msgs; ++i)
+  {
+    ASIO_CHECK(sizes[i] == i + 1);
+    ASIO_CHECK(memcmp(recv_msgs[i], send_msg, i + 1) == 0);
+    ASIO_CHECK(senders[i] == (i < num_msgs / 2
+          ? s2.local_endpoint() : s3.local_endpoint()));
+  }
+
+  // Asynchronous operations, on a connected socket and with the sender
+  // endpoints omitted.
+  s2.connect(s1.local_endpoint());
+  memset(recv_msgs, 0, sizeof(recv_msgs));
+  memset(sizes, 0, sizeof(sizes));
+
+  std::size_t async_sent = 0;
+  std::size_t async_recvd = 0;
+  s1.async_receive_many(recv_buffers, 0, sizes, num_msgs,
+      bindns::bind(handle_batch, &async_recvd, _1, _2));
+  s2.async_send_many(send_buffers, 0, num_msgs,
+      bindns::bind(handle_batch, &async_sent, _1, _2));
+  ioc.run();
+
+  ASIO_CHECK(async_sent > 0);
+  ASIO_CHECK(async_recvd > 0);
+  ASIO_CHECK(async_recvd <= async_sent);
+  for (std::size_t i = 0; i < async_recvd; ++i)
+  {
+    ASIO_CHECK(sizes[i] == i + 1);
+    ASIO_CHECK(memcmp(recv_msgs[i], send_msg, i + 1) == 0);
+  }
+
+  // An empty batch completes immediately.
+  async_recvd = 1;
+  s1.async_receive_many(recv_buffers, senders, sizes, 0,
+      bindns::bind(handle_batch, &async_recvd, _1, _2));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(async_recvd == 0);
+}
+
+} // namespace ip_udp_socket_batch_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_udp_socket_segments_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a payload sent with a segment size arrives
+// as datagrams of that size, whether or not the receiver coalesces them.
+
+namespace ip_udp_socket_segments_runtime {
+
+void handle_segments(std::size_t* result,
+    const asio::error_code& err, std::size_t n)
+{
+  ASIO_CHECK(!err);
+  *result = n;
+}
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  // Receive offload is not available everywhere.
+  asio::error_code ec;
+  s1.set_option(ip::udp::receive_offload(true), ec);
+
+  char send_msg[950];
+  for (std::size_t i = 0; i < sizeof(send_msg); ++i)
+    send_msg[i] = static_cast<char>(i % 251);
+  static char recv_msg[65536];
+  const std::size_t seg = 100;
+
+  // A payload that fits in a single segment can be sent everywhere.
+  std::size_t segment_size = 0;
+  ip::udp::endpoint sender;
+  std::size_t n = s2.send_segments_to(buffer(send_msg, 80),
+      s1.local_endpoint(), seg);
+  ASIO_CHECK(n == 80);
+  n = s1.receive_segments_from(buffer(recv_msg), sender, segment_size);
+  ASIO_CHECK(n == 80);
+  ASIO_CHECK(segment_size == 80);
+  ASIO_CHECK(sender == s2.local_endpoint());
+  ASIO_CHECK(memcmp(recv_msg, send_msg, 80) == 0);
+
+#if defined(UDP_SEGMENT)
+  // Ten datagrams, the last of which is shorter, sent in one call.
+  n = s2.send_segments_to(buffer(send_msg), s1.local_endpoint(), seg);
+  ASIO_CHECK(n == sizeof(send_msg));
+
+  std::size_t total = 0;
+  while (total < sizeof(send_msg))
+  {
+    n = s1.receive_segments_from(buffer(recv_msg), sender, segment_size);
+    ASIO_CHECK(n > 0);
+    ASIO_CHECK(sender == s2.local_endpoint());
+    ASIO_CHECK(segment_size == (n > seg ? seg : n));
+    ASIO_CHECK(memcmp(recv_msg, send_msg + total, n) == 0);
+    total += n;
+  }
+  ASIO_CHECK(total == sizeof(send_msg));
+
+  // The same, asynchronously.
+  std::size_t async_sent = 0;
+  std::size_t async_recvd = 0;
+  segment_size = 0;
+  s2.async_send_segments_to(buffer(send_msg), s1.local_endpoint(), seg,
+      bindns::bind(handle_segments, &async_sent, _1, _2));
+  s1.async_receive_segments_from(buffer(recv_msg), sender, segment_size,
+      bindns::bind(handle_segments, &async_recvd, _1, _2));
+  ioc.run();
+
+  ASIO_CHECK(async_sent == sizeof(send_msg));
+  ASIO_CHECK(async_recvd > 0);
+  ASIO_CHECK(segment_size == (async_recvd > seg ? seg : async_recvd));
+  ASIO_CHECK(memcmp(recv_msg, send_msg, async_recvd) == 0);
+#else // defined(UDP_SEGMENT)
+  // Without segmentation offload, larger payloads are rejected.
+  s2.send_segments_to(buffer(send_msg), s1.local_endpoint(), seg, 0, ec);
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+#endif // defined(UDP_SEGMENT)
+}
+
+} // namespace ip_udp_socket_segments_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_udp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -669,5 +956,7 @@ ASIO_TEST_SUITE
   "ip/udp",
   ASIO_TEST_CASE(ip_udp_socket_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_batch_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_segments_runtime::test)
   ASIO_TEST_CASE(ip_udp_resolver_compile::test)
 )
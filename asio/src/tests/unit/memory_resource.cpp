@@ -0,0 +1,334 @@
+//
+// memory_resource.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/memory_resource.hpp"
+
+#include <new>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "unit_test.hpp"
+
+// A memory resource that counts the allocations made through it.
+class counting_resource : public asio::memory_resource
+{
+public:
+  counting_resource()
+    : allocations_(0),
+      outstanding_(0)
+  {
+  }
+
+  long allocations() const
+  {
+    return allocations_;
+  }
+
+  long outstanding() const
+  {
+    return outstanding_;
+  }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t)
+  {
+    ++allocations_;
+    ++outstanding_;
+    return ::operator new(bytes);
+  }
+
+  void do_deallocate(void* p, std::size_t, std::size_t)
+  {
+    --outstanding_;
+    ::operator delete(p);
+  }
+
+  bool do_is_equal(const asio::memory_resource& other) const ASIO_NOEXCEPT
+  {
+    return this == &other;
+  }
+
+  asio::detail::atomic_count allocations_;
+  asio::detail::atomic_count outstanding_;
+};
+
+//------------------------------------------------------------------------------
+
+// memory_resource_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// memory_resource, and the io_context constructors that accept one, compile
+// and link correctly. Runtime failures are ignored.
+
+namespace memory_resource_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    counting_resource r1, r2;
+    memory_resource& r = r1;
+
+    void* p = r.allocate(32);
+    r.deallocate(p, 32);
+    p = r.allocate(32, 8);
+    r.deallocate(p, 32, 8);
+
+    bool b = r.is_equal(r2);
+    (void)b;
+
+    io_context ioc1(r1);
+    io_context ioc2(1, r2);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace memory_resource_compile
+
+//------------------------------------------------------------------------------
+
+// memory_resource_io_context test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that an io_context allocates its descriptor state,
+// timer queues and operations from its memory resource, and that all of the
+// memory is returned to the resource.
+
+namespace memory_resource_io_context {
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+struct session;
+
+struct step_handler
+{
+  explicit step_handler(session* s) : session_(s) {}
+  void operator()(const asio::error_code& ec = asio::error_code(),
+      std::size_t = 0);
+  session* session_;
+};
+
+struct session
+{
+  session(asio::io_context& ioc)
+    : reader_(ioc),
+      writer_(ioc),
+      timer_(ioc),
+      steps_(0)
+  {
+    asio::local::connect_pair(reader_, writer_);
+  }
+
+  void step()
+  {
+    switch (steps_++)
+    {
+    case 0:
+      asio::post(reader_.get_executor(), step_handler(this));
+      break;
+    case 1:
+      timer_.expires_after(asio::chrono::milliseconds(1));
+      timer_.async_wait(step_handler(this));
+      break;
+    case 2:
+      writer_.async_write_some(asio::buffer("x", 1), step_handler(this));
+      break;
+    case 3:
+      reader_.async_read_some(asio::buffer(data_), step_handler(this));
+      break;
+    default:
+      break;
+    }
+  }
+
+  socket_type reader_;
+  socket_type writer_;
+  asio::steady_timer timer_;
+  char data_[1];
+  int steps_;
+};
+
+void step_handler::operator()(const asio::error_code& ec, std::size_t)
+{
+  ASIO_CHECK(!ec);
+  session_->step();
+}
+
+struct cancelled_handler
+{
+  void operator()(const asio::error_code& ec)
+  {
+    ASIO_CHECK(ec == asio::error::operation_aborted);
+  }
+};
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  counting_resource resource;
+
+  {
+    asio::io_context ioc(resource);
+    session s(ioc);
+
+    // Registering the sockets allocates their descriptor state.
+    long registered = resource.allocations();
+    ASIO_CHECK(registered > 0);
+
+    // A timer queue allocates its heap when the first wait is started.
+    s.timer_.expires_after(asio::chrono::hours(1));
+    s.timer_.async_wait(cancelled_handler());
+    ASIO_CHECK(resource.allocations() > registered);
+    s.timer_.cancel();
+    asio::post(ioc, step_handler(&s));
+
+    // Operations started by a thread that is running the io_context are
+    // allocated from the resource.
+    long started = resource.allocations();
+    ioc.run();
+    ASIO_CHECK(s.steps_ == 5);
+    ASIO_CHECK(resource.allocations() > started);
+  }
+
+  ASIO_CHECK(resource.outstanding() == 0);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace memory_resource_io_context
+
+//------------------------------------------------------------------------------
+
+// memory_resource_two_contexts test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a block allocated from one io_context's
+// memory resource, and freed on a thread running another io_context, is
+// returned to its origin rather than reused for the other io_context.
+
+namespace memory_resource_two_contexts {
+
+struct state
+{
+  state(asio::io_context& other, counting_resource& origin,
+      counting_resource& resource)
+    : other_(other),
+      origin_(origin),
+      resource_(resource),
+      origin_outstanding_(0),
+      calls_(0)
+  {
+  }
+
+  asio::io_context& other_;
+  counting_resource& origin_;
+  counting_resource& resource_;
+  long origin_outstanding_;
+  int calls_;
+};
+
+struct last_handler
+{
+  explicit last_handler(state* s) : state_(s) {}
+
+  void operator()()
+  {
+    ++state_->calls_;
+  }
+
+  state* state_;
+};
+
+struct other_handler
+{
+  explicit other_handler(state* s) : state_(s) {}
+
+  void operator()()
+  {
+    ++state_->calls_;
+
+    // This handler's memory came from the origin resource, and has already
+    // been returned to it.
+    ASIO_CHECK(state_->origin_.outstanding()
+        == state_->origin_outstanding_ - 1);
+
+    // A new operation is allocated from this io_context's own resource.
+    long allocations = state_->resource_.allocations();
+    asio::post(state_->other_, last_handler(state_));
+    ASIO_CHECK(state_->resource_.allocations() == allocations + 1);
+  }
+
+  state* state_;
+};
+
+struct first_handler
+{
+  explicit first_handler(state* s) : state_(s) {}
+
+  void operator()()
+  {
+    ++state_->calls_;
+    asio::post(state_->other_, other_handler(state_));
+  }
+
+  state* state_;
+};
+
+void test()
+{
+  counting_resource resource_a;
+  counting_resource resource_b;
+
+  {
+    asio::io_context ioc_a(resource_a);
+    asio::io_context ioc_b(resource_b);
+    state s(ioc_b, resource_a, resource_b);
+
+    // The handler posted to ioc_b is allocated from ioc_a's resource, as the
+    // thread posting it is running ioc_a.
+    asio::post(ioc_a, first_handler(&s));
+    ioc_a.run();
+    ASIO_CHECK(s.calls_ == 1);
+    s.origin_outstanding_ = resource_a.outstanding();
+    ASIO_CHECK(s.origin_outstanding_ > 0);
+
+    ioc_b.run();
+    ASIO_CHECK(s.calls_ == 3);
+  }
+
+  ASIO_CHECK(resource_a.outstanding() == 0);
+  ASIO_CHECK(resource_b.outstanding() == 0);
+}
+
+} // namespace memory_resource_two_contexts
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "memory_resource",
+  ASIO_TEST_CASE(memory_resource_compile::test)
+  ASIO_TEST_CASE(memory_resource_io_context::test)
+  ASIO_TEST_CASE(memory_resource_two_contexts::test)
+)
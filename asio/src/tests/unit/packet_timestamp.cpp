@@ -0,0 +1,376 @@
+//
+// packet_timestamp.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/packet_timestamp.hpp"
+
+#include <cstring>
+
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(__linux__)
+# include <linux/net_tstamp.h>
+# include <time.h>
+#endif // defined(__linux__)
+
+//------------------------------------------------------------------------------
+
+// packet_timestamp_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// packet_timestamp, and the timestamp socket options, compile and link
+// correctly. Runtime failures are ignored.
+
+namespace packet_timestamp_compile {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    unsigned char storage[128];
+    ancillary_data control(buffer(storage));
+
+    packet_timestamp ts1;
+    packet_timestamp ts2(control);
+    const packet_timestamp& cts = ts2;
+    ts1 = ts2;
+
+    packet_timestamp::event_type e = cts.event();
+    (void)e;
+    e = packet_timestamp::none;
+    e = packet_timestamp::received;
+    e = packet_timestamp::scheduled;
+    e = packet_timestamp::sent;
+    e = packet_timestamp::acknowledged;
+
+    bool b = cts.has_software();
+    b = cts.has_hardware();
+    (void)b;
+
+    int64_t t = cts.software();
+    t = cts.hardware();
+    (void)t;
+
+    uint32_t id = cts.id();
+    (void)id;
+
+    io_context ioc;
+    ip::udp::socket socket(ioc, ip::udp::v4());
+
+    socket_base::timestamp timestamp1(true);
+    socket.set_option(timestamp1);
+    socket_base::timestamp timestamp2;
+    socket.get_option(timestamp2);
+
+    socket_base::timestamping timestamping1(0);
+    socket.set_option(timestamping1);
+    socket_base::timestamping timestamping2;
+    socket.get_option(timestamping2);
+
+    socket_base::message_flags flags = socket_base::message_error_queue;
+    (void)flags;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace packet_timestamp_compile
+
+//------------------------------------------------------------------------------
+
+// packet_timestamp_receive test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that datagrams and stream data are received with
+// a software timestamp taken from the real-time clock when the timestamp
+// options are enabled, and with no timestamp otherwise.
+
+namespace packet_timestamp_receive {
+
+#if defined(__linux__)
+
+asio::int64_t now()
+{
+  timespec ts;
+  ::clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<asio::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+#endif // defined(__linux__)
+
+void test()
+{
+#if defined(__linux__)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::udp::endpoint loopback(ip::address_v4::loopback(), 0);
+  ip::udp::socket receiver(ioc, loopback);
+  ip::udp::socket sender(ioc, loopback);
+
+  char data[16] = "";
+  unsigned char storage[128];
+  ancillary_data control(buffer(storage));
+  ip::udp::endpoint from;
+
+  // No timestamp unless requested.
+  sender.send_to(buffer("a", 1), receiver.local_endpoint());
+  receiver.receive_msg_from(buffer(data), from, control);
+  packet_timestamp ts1(control);
+  ASIO_CHECK(ts1.event() == packet_timestamp::none);
+  ASIO_CHECK(!ts1.has_software());
+  ASIO_CHECK(!ts1.has_hardware());
+
+  // Nanosecond receive timestamps.
+  receiver.set_option(socket_base::timestamp(true));
+  socket_base::timestamp option;
+  receiver.get_option(option);
+  ASIO_CHECK(option.value());
+
+  int64_t before = now();
+  sender.send_to(buffer("b", 1), receiver.local_endpoint());
+  receiver.receive_msg_from(buffer(data), from, control);
+  int64_t after = now();
+  packet_timestamp ts2(control);
+  ASIO_CHECK(ts2.event() == packet_timestamp::received);
+  ASIO_CHECK(ts2.has_software());
+  ASIO_CHECK(ts2.software() >= before && ts2.software() <= after);
+
+  // Receive timestamps on a stream socket.
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc), server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+  server.set_option(socket_base::timestamping(
+        SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE));
+
+  before = now();
+  write(client, buffer("hello", 5));
+  std::size_t n = server.receive_msg(buffer(data), control);
+  after = now();
+  ASIO_CHECK(n == 5);
+  packet_timestamp ts3(control);
+  ASIO_CHECK(ts3.event() == packet_timestamp::received);
+  ASIO_CHECK(ts3.software() >= before && ts3.software() <= after);
+#endif // defined(__linux__)
+}
+
+} // namespace packet_timestamp_receive
+
+//------------------------------------------------------------------------------
+
+// packet_timestamp_transmit test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that transmit timestamps are read from the error
+// queue, both synchronously and asynchronously, and identify the packets to
+// which they refer.
+
+namespace packet_timestamp_transmit {
+
+#if defined(__linux__)
+
+struct receive_handler
+{
+  receive_handler(asio::error_code* ec, bool* called)
+    : ec_(ec), called_(called)
+  {
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t)
+  {
+    *ec_ = ec;
+    *called_ = true;
+  }
+
+  asio::error_code* ec_;
+  bool* called_;
+};
+
+#endif // defined(__linux__)
+
+void test()
+{
+#if defined(__linux__)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::udp::endpoint loopback(ip::address_v4::loopback(), 0);
+  ip::udp::socket receiver(ioc, loopback);
+  ip::udp::socket sender(ioc, loopback);
+  sender.set_option(socket_base::timestamping(
+        SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+        | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY));
+
+  unsigned char storage[256];
+  ancillary_data control(buffer(storage));
+
+  // Synchronous read of the error queue.
+  sender.send_to(buffer("a", 1), receiver.local_endpoint());
+  sender.receive_msg(mutable_buffer(), control,
+      socket_base::message_error_queue);
+  packet_timestamp ts1(control);
+  ASIO_CHECK(ts1.event() == packet_timestamp::sent);
+  ASIO_CHECK(ts1.has_software());
+  ASIO_CHECK(ts1.id() == 0);
+
+  // Asynchronous read of the error queue, started before the send.
+  asio::error_code ec;
+  bool called = false;
+  sender.async_receive_msg(mutable_buffer(), control,
+      socket_base::message_error_queue, receive_handler(&ec, &called));
+  ioc.poll();
+  ASIO_CHECK(!called);
+  sender.send_to(buffer("b", 1), receiver.local_endpoint());
+  while (!called && ioc.run_one()) {}
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  packet_timestamp ts2(control);
+  ASIO_CHECK(ts2.event() == packet_timestamp::sent);
+  ASIO_CHECK(ts2.id() == 1);
+  ASIO_CHECK(ts2.software() >= ts1.software());
+
+  // The ordinary data is still available to the receiver.
+  char data[16] = "";
+  ASIO_CHECK(receiver.receive(buffer(data)) == 1 && data[0] == 'a');
+  ASIO_CHECK(receiver.receive(buffer(data)) == 1 && data[0] == 'b');
+
+  // Acknowledgement timestamps on a stream socket. The identifier is the
+  // offset of the last byte of the data.
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc), server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+  client.set_option(socket_base::timestamping(
+        SOF_TIMESTAMPING_TX_ACK | SOF_TIMESTAMPING_SOFTWARE
+        | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY));
+
+  called = false;
+  ioc.restart();
+  client.async_receive_msg(mutable_buffer(), control,
+      socket_base::message_error_queue, receive_handler(&ec, &called));
+  write(client, buffer("hello", 5));
+  while (!called && ioc.run_one()) {}
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  packet_timestamp ts3(control);
+  ASIO_CHECK(ts3.event() == packet_timestamp::acknowledged);
+  ASIO_CHECK(ts3.has_software());
+  ASIO_CHECK(ts3.id() == 4);
+#endif // defined(__linux__)
+}
+
+} // namespace packet_timestamp_transmit
+
+//------------------------------------------------------------------------------
+
+// packet_timestamp_zero_copy test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that transmit timestamps are not lost when the
+// reactor reads the error queue for the release of zero-copy sends.
+
+namespace packet_timestamp_zero_copy {
+
+void test()
+{
+#if defined(__linux__)
+  using namespace asio;
+  namespace ip = asio::ip;
+  using packet_timestamp_transmit::receive_handler;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc), server(ioc);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+  client.set_option(socket_base::timestamping(
+        SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+        | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY));
+
+  // The kernel queues each timestamp ahead of the notification that releases
+  // the send's buffers.
+  char send_data[3][1000];
+  for (int i = 0; i < 3; ++i)
+  {
+    std::memset(send_data[i], 'a' + i, sizeof(send_data[i]));
+    asio::error_code ec;
+    bool called = false;
+    client.async_send_zero_copy(buffer(send_data[i]),
+        receive_handler(&ec, &called));
+    ioc.restart();
+    while (!called && ioc.run_one()) {}
+    ASIO_CHECK(called);
+    ASIO_CHECK(!ec);
+  }
+
+  unsigned char storage[256];
+  ancillary_data control(buffer(storage));
+
+  // Synchronous read of the error queue.
+  client.receive_msg(mutable_buffer(), control,
+      socket_base::message_error_queue);
+  packet_timestamp ts1(control);
+  ASIO_CHECK(ts1.event() == packet_timestamp::sent);
+  ASIO_CHECK(ts1.has_software());
+  ASIO_CHECK(ts1.id() == 999);
+
+  // Asynchronous reads of the error queue.
+  for (int i = 1; i < 3; ++i)
+  {
+    asio::error_code ec;
+    bool called = false;
+    client.async_receive_msg(mutable_buffer(), control,
+        socket_base::message_error_queue, receive_handler(&ec, &called));
+    ioc.restart();
+    while (!called && ioc.run_one()) {}
+    ASIO_CHECK(called);
+    ASIO_CHECK(!ec);
+    packet_timestamp ts(control);
+    ASIO_CHECK(ts.event() == packet_timestamp::sent);
+    ASIO_CHECK(ts.id() == static_cast<unsigned>(i * 1000 + 999));
+  }
+
+  // The data is received intact.
+  char data[3000];
+  read(server, buffer(data));
+  for (int i = 0; i < 3; ++i)
+    ASIO_CHECK(std::memcmp(data + i * 1000, send_data[i], 1000) == 0);
+#endif // defined(__linux__)
+}
+
+} // namespace packet_timestamp_zero_copy
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "packet_timestamp",
+  ASIO_TEST_CASE(packet_timestamp_compile::test)
+  ASIO_TEST_CASE(packet_timestamp_receive::test)
+  ASIO_TEST_CASE(packet_timestamp_transmit::test)
+  ASIO_TEST_CASE(packet_timestamp_zero_copy::test)
+)
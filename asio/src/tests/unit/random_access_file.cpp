@@ -0,0 +1,291 @@
+//
+// random_access_file.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/random_access_file.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/read_at.hpp"
+#include "asio/write_at.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+//------------------------------------------------------------------------------
+
+// random_access_file_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// random_access_file compile and link correctly. Runtime failures are ignored.
+
+namespace random_access_file_compile {
+
+void write_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void read_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_FILE)
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    const io_context::executor_type ioc_ex = ioc.get_executor();
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+    const std::string path;
+
+    // basic_random_access_file constructors.
+
+    random_access_file file1(ioc);
+    random_access_file file2(ioc_ex);
+    random_access_file file3(ioc, path, random_access_file::read_only);
+    random_access_file file4(ioc_ex, path, random_access_file::read_only);
+    int native_file1 = -1;
+    random_access_file file5(ioc, native_file1);
+    random_access_file file6(ioc_ex, native_file1);
+
+#if defined(ASIO_HAS_MOVE)
+    random_access_file file7(std::move(file2));
+#endif // defined(ASIO_HAS_MOVE)
+
+    // basic_random_access_file operators.
+
+#if defined(ASIO_HAS_MOVE)
+    file1 = random_access_file(ioc);
+    file1 = std::move(file2);
+#endif // defined(ASIO_HAS_MOVE)
+
+    // basic_io_object functions.
+
+    random_access_file::executor_type ex = file1.get_executor();
+    (void)ex;
+
+    // basic_file functions.
+
+    file1.open(path, random_access_file::read_only);
+    file1.open(path, random_access_file::read_only, ec);
+
+    int native_file2 = -1;
+    file1.assign(native_file2);
+    file1.assign(native_file2, ec);
+
+    bool is_open = file1.is_open();
+    (void)is_open;
+
+    file1.close();
+    file1.close(ec);
+
+    random_access_file::native_handle_type native_file3
+      = file1.native_handle();
+    (void)native_file3;
+
+    random_access_file::native_handle_type native_file4
+      = file1.release();
+    (void)native_file4;
+    random_access_file::native_handle_type native_file5
+      = file1.release(ec);
+    (void)native_file5;
+
+    file1.cancel();
+    file1.cancel(ec);
+
+    asio::uint64_t s1 = file1.size();
+    (void)s1;
+    asio::uint64_t s2 = file1.size(ec);
+    (void)s2;
+
+    file1.resize(asio::uint64_t(0));
+    file1.resize(asio::uint64_t(0), ec);
+
+    file1.sync_all();
+    file1.sync_all(ec);
+
+    file1.sync_data();
+    file1.sync_data(ec);
+
+    // basic_random_access_file functions.
+
+    file1.write_some_at(0, buffer(mutable_char_buffer));
+    file1.write_some_at(0, buffer(const_char_buffer));
+    file1.write_some_at(0, buffer(mutable_char_buffer), ec);
+    file1.write_some_at(0, buffer(const_char_buffer), ec);
+
+    file1.async_write_some_at(0, buffer(mutable_char_buffer),
+        &write_some_handler);
+    file1.async_write_some_at(0, buffer(const_char_buffer),
+        &write_some_handler);
+    int i1 = file1.async_write_some_at(0, buffer(mutable_char_buffer), lazy);
+    (void)i1;
+    int i2 = file1.async_write_some_at(0, buffer(const_char_buffer), lazy);
+    (void)i2;
+
+    file1.read_some_at(0, buffer(mutable_char_buffer));
+    file1.read_some_at(0, buffer(mutable_char_buffer), ec);
+
+    file1.async_read_some_at(0, buffer(mutable_char_buffer),
+        &read_some_handler);
+    int i3 = file1.async_read_some_at(0, buffer(mutable_char_buffer), lazy);
+    (void)i3;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_FILE)
+}
+
+} // namespace random_access_file_compile
+
+//------------------------------------------------------------------------------
+
+// random_access_file_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the random_access_file
+// class.
+
+namespace random_access_file_runtime {
+
+static const char write_data[]
+  = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+void handle_write(const asio::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == sizeof(write_data));
+}
+
+void handle_read(const asio::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == sizeof(write_data));
+}
+
+void handle_read_eof(const asio::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(err == asio::error::eof);
+  ASIO_CHECK(bytes_transferred == 0);
+}
+
+void test()
+{
+#if defined(ASIO_HAS_FILE)
+  using namespace std; // For memcmp and remove.
+  using namespace asio;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+  io_context ioc;
+
+  const std::string path = "random_access_file_runtime.tmp";
+  random_access_file file(ioc, path,
+      random_access_file::read_write
+        | random_access_file::create
+        | random_access_file::truncate);
+  ASIO_CHECK(file.is_open());
+  ASIO_CHECK(file.size() == 0);
+
+  // Write at an offset beyond the end of the file.
+
+  bool write_completed = false;
+  asio::async_write_at(file, 100,
+      asio::buffer(write_data),
+      bindns::bind(handle_write,
+        _1, _2, &write_completed));
+
+  ioc.run();
+  ASIO_CHECK(write_completed);
+  ASIO_CHECK(file.size() == 100 + sizeof(write_data));
+
+  // Read the data back from the same offset.
+
+  char read_buffer[sizeof(write_data)];
+  bool read_completed = false;
+  asio::async_read_at(file, 100,
+      asio::buffer(read_buffer),
+      bindns::bind(handle_read,
+        _1, _2, &read_completed));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completed);
+  ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+  // The gap before the data reads back as zeroes.
+
+  char gap_buffer[100];
+  memset(gap_buffer, 1, sizeof(gap_buffer));
+  size_t n = asio::read_at(file, 0, asio::buffer(gap_buffer));
+  ASIO_CHECK(n == sizeof(gap_buffer));
+  ASIO_CHECK(gap_buffer[0] == 0 && gap_buffer[99] == 0);
+
+  // A read at the end of the file fails with eof.
+
+  bool read_eof_completed = false;
+  file.async_read_some_at(file.size(),
+      asio::buffer(read_buffer),
+      bindns::bind(handle_read_eof,
+        _1, _2, &read_eof_completed));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_eof_completed);
+
+  file.resize(10);
+  ASIO_CHECK(file.size() == 10);
+
+  file.close();
+  ASIO_CHECK(!file.is_open());
+
+  remove(path.c_str());
+#endif // defined(ASIO_HAS_FILE)
+}
+
+} // namespace random_access_file_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "random_access_file",
+  ASIO_TEST_CASE(random_access_file_compile::test)
+  ASIO_TEST_CASE(random_access_file_runtime::test)
+)
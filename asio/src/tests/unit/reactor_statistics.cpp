@@ -0,0 +1,161 @@
+//
+// reactor_statistics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/reactor_statistics.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+//------------------------------------------------------------------------------
+
+// reactor_statistics_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// reactor_statistics compile and link correctly. Runtime failures are ignored.
+
+namespace reactor_statistics_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+
+    reactor_statistics stats1;
+    reactor_statistics stats2(1, 2, 3, 4);
+    reactor_statistics stats3 = get_reactor_statistics(ioc);
+
+    uint64_t wakeups = stats1.wakeups();
+    (void)wakeups;
+    uint64_t polls = stats2.polls();
+    (void)polls;
+    uint64_t events = stats3.events();
+    (void)events;
+    uint64_t full_batches = stats3.full_batches();
+    (void)full_batches;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace reactor_statistics_compile
+
+//------------------------------------------------------------------------------
+
+// reactor_statistics_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the reactor's batch size is configured by the
+// concurrency hint, and that the counters reflect the harvested events.
+
+namespace reactor_statistics_runtime {
+
+void handle_wait(const asio::error_code& err, int* count)
+{
+  ASIO_CHECK(!err);
+  ++(*count);
+}
+
+void test()
+{
+  using namespace asio;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+  const int hint = ASIO_CONCURRENCY_HINT_REACTOR_BATCH(
+      ASIO_CONCURRENCY_HINT_SAFE, 6, true);
+  ASIO_CHECK(ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SIZE(hint) == 64);
+  ASIO_CHECK(ASIO_CONCURRENCY_HINT_IS_REACTOR_REPOLL(hint));
+  ASIO_CHECK(ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER, hint));
+  ASIO_CHECK(ASIO_CONCURRENCY_HINT_IS_LOCKING(REACTOR_IO, hint));
+  ASIO_CHECK(ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SIZE(
+        ASIO_CONCURRENCY_HINT_SAFE) == 0);
+  ASIO_CHECK(!ASIO_CONCURRENCY_HINT_IS_REACTOR_REPOLL(
+        ASIO_CONCURRENCY_HINT_SAFE));
+  ASIO_CHECK(ASIO_CONCURRENCY_HINT_REACTOR_BATCH_SIZE(1) == 0);
+
+  io_context ioc(hint);
+
+  // No reactor has been created yet.
+  reactor_statistics stats = get_reactor_statistics(ioc);
+  ASIO_CHECK(stats.wakeups() == 0);
+  ASIO_CHECK(stats.polls() == 0);
+  ASIO_CHECK(stats.events() == 0);
+  ASIO_CHECK(stats.full_batches() == 0);
+
+#if defined(ASIO_HAS_EPOLL) && defined(ASIO_HAS_LOCAL_SOCKETS)
+  typedef local::stream_protocol::socket socket_type;
+
+  // Make more descriptors ready at once than fit in a single batch.
+  const int pair_count = 100;
+  socket_type* readers[pair_count];
+  socket_type* writers[pair_count];
+  int wait_count = 0;
+  for (int i = 0; i < pair_count; ++i)
+  {
+    readers[i] = new socket_type(ioc);
+    writers[i] = new socket_type(ioc);
+    local::connect_pair(*readers[i], *writers[i]);
+    readers[i]->async_wait(socket_type::wait_read,
+        bindns::bind(handle_wait, _1, &wait_count));
+  }
+
+  for (int i = 0; i < pair_count; ++i)
+    asio::write(*writers[i], asio::buffer("x", 1));
+
+  ioc.run();
+  ASIO_CHECK(wait_count == pair_count);
+
+  stats = get_reactor_statistics(ioc);
+  ASIO_CHECK(stats.wakeups() > 0);
+  ASIO_CHECK(stats.polls() >= stats.wakeups());
+  ASIO_CHECK(stats.events() >= 64);
+  ASIO_CHECK(stats.full_batches() > 0);
+
+  for (int i = 0; i < pair_count; ++i)
+  {
+    delete readers[i];
+    delete writers[i];
+  }
+#endif // defined(ASIO_HAS_EPOLL) && defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace reactor_statistics_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "reactor_statistics",
+  ASIO_TEST_CASE(reactor_statistics_compile::test)
+  ASIO_TEST_CASE(reactor_statistics_runtime::test)
+)
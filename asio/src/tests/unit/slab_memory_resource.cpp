@@ -0,0 +1,278 @@
+//
+// slab_memory_resource.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/slab_memory_resource.hpp"
+
+#include <cstring>
+#include <new>
+#include <vector>
+#include "asio/detail/thread_group.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// slab_memory_resource_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// slab_memory_resource compile and link correctly. Runtime failures are
+// ignored.
+
+namespace slab_memory_resource_compile {
+
+void test()
+{
+  using namespace asio;
+
+  try
+  {
+    slab_memory_resource r1(4096);
+
+    char buffer[4096];
+    slab_memory_resource r2(buffer, sizeof(buffer));
+
+    memory_resource& r = r1;
+    void* p = r.allocate(100);
+    r.deallocate(p, 100);
+
+    bool b = r1.is_equal(r2);
+    (void)b;
+
+    std::size_t capacity = r1.capacity();
+    (void)capacity;
+
+    uint64_t heap_allocations = r2.heap_allocations();
+    (void)heap_allocations;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace slab_memory_resource_compile
+
+//------------------------------------------------------------------------------
+
+// slab_memory_resource_blocks test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that blocks are carved from the region, aligned,
+// reused once freed, and that requests that cannot be met from the region are
+// passed to the heap.
+
+namespace slab_memory_resource_blocks {
+
+bool is_aligned(void* p)
+{
+  return reinterpret_cast<std::size_t>(p) % 64 == 0;
+}
+
+void test()
+{
+  using namespace asio;
+
+  // The region supplied by the caller need not be aligned.
+  static double storage[(1024 + 64 + 1) / sizeof(double) + 1];
+  char* buffer = reinterpret_cast<char*>(storage) + 1;
+  slab_memory_resource resource(buffer, 1024 + 64);
+  ASIO_CHECK(resource.capacity() == 1024);
+  ASIO_CHECK(resource.is_equal(resource));
+
+  slab_memory_resource other(1024);
+  ASIO_CHECK(other.capacity() == 1024);
+  ASIO_CHECK(!resource.is_equal(other));
+
+  // Carve the whole region into blocks of different sizes.
+  void* a = resource.allocate(1);
+  void* b = resource.allocate(64, 64);
+  void* c = resource.allocate(65);
+  void* d = resource.allocate(512);
+  void* e = resource.allocate(200);
+  ASIO_CHECK(is_aligned(a) && is_aligned(b));
+  ASIO_CHECK(is_aligned(c) && is_aligned(d) && is_aligned(e));
+  ASIO_CHECK(resource.heap_allocations() == 0);
+  std::memset(a, 1, 64);
+  std::memset(b, 2, 64);
+  std::memset(c, 3, 128);
+  std::memset(d, 4, 512);
+  std::memset(e, 5, 256);
+
+  // The region is used up.
+  void* f = resource.allocate(64);
+  ASIO_CHECK(resource.heap_allocations() == 1);
+
+  // Freed blocks are reused for requests of the same size class.
+  resource.deallocate(c, 65);
+  void* g = resource.allocate(128);
+  ASIO_CHECK(g == c);
+  ASIO_CHECK(resource.heap_allocations() == 1);
+
+  resource.deallocate(a, 1);
+  resource.deallocate(b, 64, 64);
+  void* h = resource.allocate(10);
+  void* i = resource.allocate(20);
+  ASIO_CHECK((h == a && i == b) || (h == b && i == a));
+  ASIO_CHECK(resource.heap_allocations() == 1);
+
+  // Blocks of one size class are not used for another.
+  resource.deallocate(d, 512);
+  void* j = resource.allocate(256);
+  ASIO_CHECK(j != d);
+  ASIO_CHECK(resource.heap_allocations() == 2);
+
+  // Large requests are passed to the heap.
+  void* k = resource.allocate(100000);
+  ASIO_CHECK(resource.heap_allocations() == 3);
+
+  resource.deallocate(e, 200);
+  resource.deallocate(f, 64);
+  resource.deallocate(g, 128);
+  resource.deallocate(h, 10);
+  resource.deallocate(i, 20);
+  resource.deallocate(j, 256);
+  resource.deallocate(k, 100000);
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  bool threw = false;
+  try
+  {
+    resource.allocate(64, 128);
+  }
+  catch (std::bad_alloc&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
+} // namespace slab_memory_resource_blocks
+
+//------------------------------------------------------------------------------
+
+// slab_memory_resource_threads test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that blocks are never handed out twice when
+// several threads allocate and deallocate at the same time, including from an
+// io_context that uses the resource.
+
+namespace slab_memory_resource_threads {
+
+struct worker
+{
+  worker(asio::memory_resource* resource, unsigned char id, bool* ok)
+    : resource_(resource),
+      id_(id),
+      ok_(ok)
+  {
+  }
+
+  void operator()()
+  {
+    unsigned long state = id_;
+    std::vector<void*> blocks;
+    std::vector<std::size_t> sizes;
+    for (int n = 0; n < 20000; ++n)
+    {
+      state = state * 1103515245UL + 12345UL;
+      if (blocks.size() < 32 && (blocks.empty() || (state & 0x10000)))
+      {
+        std::size_t size = 1 + (state >> 8) % 1000;
+        void* p = resource_->allocate(size);
+        std::memset(p, id_, size);
+        blocks.push_back(p);
+        sizes.push_back(size);
+      }
+      else
+      {
+        std::size_t index = (state >> 8) % blocks.size();
+        unsigned char* p = static_cast<unsigned char*>(blocks[index]);
+        for (std::size_t i = 0; i < sizes[index]; ++i)
+          if (p[i] != id_)
+            *ok_ = false;
+        resource_->deallocate(p, sizes[index]);
+        blocks[index] = blocks.back();
+        blocks.pop_back();
+        sizes[index] = sizes.back();
+        sizes.pop_back();
+      }
+    }
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+      resource_->deallocate(blocks[i], sizes[i]);
+  }
+
+  asio::memory_resource* resource_;
+  unsigned char id_;
+  bool* ok_;
+};
+
+struct chain_handler
+{
+  chain_handler(asio::io_context* ioc, int* count)
+    : ioc_(ioc),
+      count_(count)
+  {
+  }
+
+  void operator()()
+  {
+    if (++*count_ < 10000)
+      asio::post(*ioc_, *this);
+  }
+
+  asio::io_context* ioc_;
+  int* count_;
+};
+
+void test()
+{
+  asio::slab_memory_resource resource(256 * 1024);
+
+  const int num_threads = 4;
+  bool ok[num_threads];
+  asio::detail::thread_group threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    ok[i] = true;
+    threads.create_thread(worker(&resource,
+          static_cast<unsigned char>(i + 1), &ok[i]));
+  }
+
+  {
+    asio::io_context ioc(resource);
+    int count = 0;
+    asio::post(ioc, chain_handler(&ioc, &count));
+    ioc.run();
+    ASIO_CHECK(count == 10000);
+  }
+
+  threads.join();
+  for (int i = 0; i < num_threads; ++i)
+    ASIO_CHECK(ok[i]);
+}
+
+} // namespace slab_memory_resource_threads
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "slab_memory_resource",
+  ASIO_TEST_CASE(slab_memory_resource_compile::test)
+  ASIO_TEST_CASE(slab_memory_resource_blocks::test)
+  ASIO_TEST_CASE(slab_memory_resource_threads::test)
+)
@@ -0,0 +1,200 @@
+//
+// slack_wait_traits.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/slack_wait_traits.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/timer_queue.hpp"
+#include "asio/io_context.hpp"
+
+//------------------------------------------------------------------------------
+
+// slack_wait_traits_queue test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a timer queue for timers with slack reports
+// wake up times on multiples of the slack, and only asks for the reactor to be
+// interrupted when a new timer needs an earlier wake up.
+
+namespace slack_wait_traits_queue {
+
+struct manual_clock
+{
+  typedef asio::chrono::microseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef asio::chrono::time_point<manual_clock> time_point;
+  static const bool is_steady = true;
+
+  static time_point& current()
+  {
+    static time_point t;
+    return t;
+  }
+
+  static time_point now()
+  {
+    return current();
+  }
+};
+
+typedef asio::slack_wait_traits<manual_clock, 10000> traits;
+typedef asio::detail::chrono_time_traits<manual_clock, traits> time_traits;
+typedef asio::detail::timer_queue<time_traits> queue_type;
+
+struct test_op : asio::detail::wait_op
+{
+  test_op()
+    : asio::detail::wait_op(&test_op::do_complete)
+  {
+  }
+
+  static void do_complete(void*, asio::detail::operation*,
+      const asio::error_code&, std::size_t)
+  {
+  }
+};
+
+manual_clock::time_point at(long usec)
+{
+  return manual_clock::time_point(asio::chrono::microseconds(usec));
+}
+
+void test()
+{
+  queue_type queue;
+  manual_clock::current() = at(1000000);
+
+  queue_type::per_timer_data t1, t2, t3;
+  test_op op1, op2, op3;
+
+  // The first timer needs a wake up at the end of its interval.
+  ASIO_CHECK(queue.enqueue_timer(at(1025000), t1, &op1));
+  ASIO_CHECK(queue.wait_duration_usec(1000000) == 30000);
+  ASIO_CHECK(queue.wait_duration_msec(1000) == 30);
+
+  // An earlier timer in the same interval is coalesced with it.
+  ASIO_CHECK(!queue.enqueue_timer(at(1021000), t2, &op2));
+  ASIO_CHECK(queue.wait_duration_usec(1000000) == 30000);
+
+  // An earlier timer in an earlier interval needs an earlier wake up.
+  ASIO_CHECK(queue.enqueue_timer(at(1015000), t3, &op3));
+  ASIO_CHECK(queue.wait_duration_usec(1000000) == 20000);
+
+  // Timers are not dequeued before their expiry.
+  asio::detail::op_queue<asio::detail::operation> ops;
+  manual_clock::current() = at(1019000);
+  queue.get_ready_timers(ops);
+  ASIO_CHECK(ops.front() == &op3);
+  ops.pop();
+  ASIO_CHECK(ops.empty());
+
+  // Timers are dequeued together at the wake up time.
+  manual_clock::current() = at(1030000);
+  queue.get_ready_timers(ops);
+  int count = 0;
+  while (ops.front())
+  {
+    ops.pop();
+    ++count;
+  }
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(queue.empty());
+}
+
+} // namespace slack_wait_traits_queue
+
+//------------------------------------------------------------------------------
+
+// slack_wait_traits_timer test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that waits on a basic_waitable_timer with slack
+// complete no earlier than the expiry, and within the slack.
+
+namespace slack_wait_traits_timer {
+
+typedef asio::basic_waitable_timer<asio::chrono::steady_clock,
+    asio::slack_wait_traits<asio::chrono::steady_clock, 20000> > timer_type;
+
+struct wait_handler
+{
+  wait_handler(timer_type* timer, int* count)
+    : timer_(timer),
+      count_(count)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(timer_->expiry() <= asio::chrono::steady_clock::now());
+    ++(*count_);
+  }
+
+  timer_type* timer_;
+  int* count_;
+};
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  int count = 0;
+
+  timer_type t1(ioc, chrono::milliseconds(1));
+  timer_type t2(ioc, chrono::milliseconds(7));
+  timer_type t3(ioc, chrono::milliseconds(13));
+  t1.async_wait(wait_handler(&t1, &count));
+  t2.async_wait(wait_handler(&t2, &count));
+  t3.async_wait(wait_handler(&t3, &count));
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(chrono::steady_clock::now() - start >= chrono::milliseconds(13));
+}
+
+} // namespace slack_wait_traits_timer
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "slack_wait_traits",
+  ASIO_TEST_CASE(slack_wait_traits_queue::test)
+  ASIO_TEST_CASE(slack_wait_traits_timer::test)
+)
+
+#else // defined(ASIO_HAS_CHRONO)
+
+ASIO_TEST_SUITE
+(
+  "slack_wait_traits",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_CHRONO)
@@ -0,0 +1,333 @@
+//
+// timing_wheel_wait_traits.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2019 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Prevent link dependency on the Boost.System library.
+#if !defined(BOOST_SYSTEM_NO_DEPRECATED)
+#define BOOST_SYSTEM_NO_DEPRECATED
+#endif // !defined(BOOST_SYSTEM_NO_DEPRECATED)
+
+// Test that header file is self-contained.
+#include "asio/timing_wheel_wait_traits.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include <vector>
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/io_context.hpp"
+
+//------------------------------------------------------------------------------
+
+// timing_wheel_queue test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a timer queue using the timing wheel expires
+// each timer at the first tick not earlier than its expiry time, as the wheel
+// is turned by a manually advanced clock.
+
+namespace timing_wheel_queue {
+
+struct manual_clock
+{
+  typedef asio::chrono::microseconds duration;
+  typedef duration::rep rep;
+  typedef duration::period period;
+  typedef asio::chrono::time_point<manual_clock> time_point;
+  static const bool is_steady = true;
+
+  static time_point& current()
+  {
+    static time_point t;
+    return t;
+  }
+
+  static time_point now()
+  {
+    return current();
+  }
+};
+
+const long granularity = 1000;
+
+typedef asio::timing_wheel_wait_traits<manual_clock, granularity> traits;
+typedef asio::detail::chrono_time_traits<manual_clock, traits> time_traits;
+typedef asio::detail::timer_queue<time_traits> queue_type;
+
+struct test_op : asio::detail::wait_op
+{
+  test_op()
+    : asio::detail::wait_op(&test_op::do_complete),
+      id_(0)
+  {
+  }
+
+  static void do_complete(void*, asio::detail::operation*,
+      const asio::error_code&, std::size_t)
+  {
+  }
+
+  std::size_t id_;
+};
+
+struct test_timer
+{
+  test_timer()
+    : expiry_(0),
+      pending_(false)
+  {
+  }
+
+  queue_type::per_timer_data data_;
+  test_op op_;
+  long long expiry_;
+  bool pending_;
+};
+
+// Simple deterministic generator, so that failures are reproducible.
+unsigned long next_random(unsigned long& state)
+{
+  state = state * 1103515245UL + 12345UL;
+  return (state >> 8) & 0xFFFFFF;
+}
+
+long long tick_up(long long usec)
+{
+  return (usec + granularity - 1) / granularity;
+}
+
+long long tick_down(long long usec)
+{
+  return usec / granularity;
+}
+
+void test()
+{
+  using namespace asio;
+
+  manual_clock::current() = manual_clock::time_point(
+      chrono::microseconds(123456789));
+  const manual_clock::time_point origin = manual_clock::now();
+
+  queue_type queue;
+  ASIO_CHECK(queue.empty());
+
+  const std::size_t num_timers = 2000;
+  std::vector<test_timer> timers(num_timers);
+  unsigned long state = 1;
+  long long now = 0;
+
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    test_timer& t = timers[i];
+    t.op_.id_ = i;
+
+    // Spread the timers over the first three levels of the wheel, with some
+    // far in the future.
+    switch (i % 4)
+    {
+    case 0: t.expiry_ = next_random(state) % 64000; break;
+    case 1: t.expiry_ = next_random(state) % 4096000; break;
+    case 2: t.expiry_ = next_random(state) % 20000000; break;
+    default: t.expiry_ = 3600000000LL + next_random(state); break;
+    }
+    t.pending_ = true;
+    queue.enqueue_timer(origin + chrono::microseconds(t.expiry_),
+        t.data_, &t.op_);
+  }
+  ASIO_CHECK(!queue.empty());
+
+  // Move one timer's operation to another timer object.
+  queue_type::per_timer_data moved;
+  queue.move_timer(moved, timers[0].data_);
+  std::vector<queue_type::per_timer_data*> data(num_timers);
+  for (std::size_t i = 0; i < num_timers; ++i)
+    data[i] = (i == 0) ? &moved : &timers[i].data_;
+
+  asio::detail::op_queue<asio::detail::operation> ops;
+  while (now < 30000000)
+  {
+    // Check that the wheel will be turned no later than the next expiry.
+    long long earliest = 0x7FFFFFFFFFFFFFFFLL;
+    for (std::size_t i = 0; i < num_timers; ++i)
+      if (timers[i].pending_ && tick_up(timers[i].expiry_) < earliest)
+        earliest = tick_up(timers[i].expiry_);
+    long wait = queue.wait_duration_usec(1000000000);
+    ASIO_CHECK(now + wait <= earliest * granularity);
+
+    // Cancel some of the timers.
+    std::size_t victim = next_random(state) % num_timers;
+    if (timers[victim].pending_ && victim % 3 == 0)
+    {
+      std::size_t n = queue.cancel_timer(*data[victim], ops);
+      ASIO_CHECK(n == 1);
+      timers[victim].pending_ = false;
+      ASIO_CHECK(ops.front() == &timers[victim].op_);
+      ASIO_CHECK(timers[victim].op_.ec_ == asio::error::operation_aborted);
+      ops.pop();
+    }
+
+    now += next_random(state) % 20000;
+    manual_clock::current() = origin + chrono::microseconds(now);
+    queue.get_ready_timers(ops);
+
+    std::vector<bool> fired(num_timers);
+    while (asio::detail::operation* op = ops.front())
+    {
+      ops.pop();
+      std::size_t id = static_cast<test_op*>(op)->id_;
+      ASIO_CHECK(!fired[id]);
+      fired[id] = true;
+    }
+
+    for (std::size_t i = 0; i < num_timers; ++i)
+    {
+      test_timer& t = timers[i];
+      if (!t.pending_)
+      {
+        ASIO_CHECK(!fired[i]);
+        continue;
+      }
+
+      bool expired = tick_up(t.expiry_) <= tick_down(now);
+      ASIO_CHECK(fired[i] == expired);
+      if (fired[i])
+        t.pending_ = false;
+    }
+  }
+
+  // A timer that has already expired is dequeued on the next turn.
+  test_timer late;
+  queue.enqueue_timer(origin, late.data_, &late.op_);
+  ASIO_CHECK(queue.wait_duration_usec(1000000) == 0);
+  queue.get_ready_timers(ops);
+  ASIO_CHECK(ops.front() == &late.op_);
+  ops.pop();
+
+  // The remaining timers are far in the future.
+  std::size_t pending = 0;
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    ASIO_CHECK(!timers[i].pending_ || i % 4 == 3);
+    pending += timers[i].pending_ ? 1 : 0;
+  }
+  queue.get_all_timers(ops);
+  std::size_t remaining = 0;
+  while (ops.front())
+  {
+    ops.pop();
+    ++remaining;
+  }
+  ASIO_CHECK(remaining == pending);
+  ASIO_CHECK(queue.empty());
+}
+
+} // namespace timing_wheel_queue
+
+//------------------------------------------------------------------------------
+
+// timing_wheel_timer test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a basic_waitable_timer using the timing
+// wheel wait traits completes its waits in order, and not before the expiry
+// time.
+
+namespace timing_wheel_timer {
+
+typedef asio::basic_waitable_timer<asio::chrono::steady_clock,
+    asio::timing_wheel_wait_traits<asio::chrono::steady_clock> > timer_type;
+
+struct wait_handler
+{
+  wait_handler(timer_type* timer, std::vector<int>* order, int id)
+    : timer_(timer),
+      order_(order),
+      id_(id)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    if (ec)
+    {
+      ASIO_CHECK(ec == asio::error::operation_aborted);
+      order_->push_back(-id_);
+    }
+    else
+    {
+      ASIO_CHECK(timer_->expiry() <= asio::chrono::steady_clock::now());
+      order_->push_back(id_);
+    }
+  }
+
+  timer_type* timer_;
+  std::vector<int>* order_;
+  int id_;
+};
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  std::vector<int> order;
+
+  timer_type t1(ioc, chrono::milliseconds(30));
+  timer_type t2(ioc, chrono::milliseconds(10));
+  timer_type t3(ioc, chrono::milliseconds(20));
+  timer_type t4(ioc, chrono::hours(1));
+
+  t1.async_wait(wait_handler(&t1, &order, 1));
+  t2.async_wait(wait_handler(&t2, &order, 2));
+  t3.async_wait(wait_handler(&t3, &order, 3));
+  t4.async_wait(wait_handler(&t4, &order, 4));
+
+  // Resetting the expiry cancels the pending wait.
+  t4.expires_after(chrono::milliseconds(5));
+  t4.async_wait(wait_handler(&t4, &order, 5));
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 5);
+  if (order.size() == 5)
+  {
+    ASIO_CHECK(order[0] == -4);
+    ASIO_CHECK(order[1] == 5);
+    ASIO_CHECK(order[2] == 2);
+    ASIO_CHECK(order[3] == 3);
+    ASIO_CHECK(order[4] == 1);
+  }
+}
+
+} // namespace timing_wheel_timer
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "timing_wheel_wait_traits",
+  ASIO_TEST_CASE(timing_wheel_queue::test)
+  ASIO_TEST_CASE(timing_wheel_timer::test)
+)
+
+#else // defined(ASIO_HAS_CHRONO)
+
+ASIO_TEST_SUITE
+(
+  "timing_wheel_wait_traits",
+  ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(ASIO_HAS_CHRONO)
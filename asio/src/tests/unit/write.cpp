@@ -40,16 +40,18 @@
 
 using namespace std; // For memcmp, memcpy and memset.
 
-class test_stream
+template <std::size_t Max_Length>
+class basic_test_stream
 {
 public:
   typedef asio::io_context::executor_type executor_type;
 
-  test_stream(asio::io_context& io_context)
+  basic_test_stream(asio::io_context& io_context)
     : io_context_(io_context),
       length_(max_length),
       position_(0),
-      next_write_length_(max_length)
+      next_write_length_(max_length),
+      write_count_(0)
   {
     memset(data_, 0, max_length);
   }
@@ -67,6 +69,7 @@ public:
     length_ = length;
     position_ = 0;
     next_write_length_ = length;
+    write_count_ = 0;
   }
 
   void next_write_length(size_t length)
@@ -74,6 +77,11 @@ public:
     next_write_length_ = length;
   }
 
+  size_t write_count() const
+  {
+    return write_count_;
+  }
+
   template <typename Iterator>
   bool check_buffers(Iterator begin, Iterator end, size_t length)
   {
@@ -109,6 +117,7 @@ public:
         asio::buffer(data_, length_) + position_,
         buffers, next_write_length_);
     position_ += n;
+    ++write_count_;
     return n;
   }
 
@@ -132,13 +141,20 @@ public:
 
 private:
   asio::io_context& io_context_;
-  enum { max_length = 8192 };
+  enum { max_length = Max_Length };
   char data_[max_length];
   size_t length_;
   size_t position_;
   size_t next_write_length_;
+  size_t write_count_;
 };
 
+typedef basic_test_stream<8192> test_stream;
+
+// A stream with room for the longer buffer sequences used by the tests of
+// gathering many buffers.
+typedef basic_test_stream<16384> large_test_stream;
+
 static const char write_data[]
   = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 static char mutable_write_data[]
@@ -231,6 +247,66 @@ void test_2_arg_vector_buffers_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_2_arg_many_buffers_write()
+{
+  asio::io_context ioc;
+  large_test_stream s(ioc);
+
+  // Many small buffers are gathered into a few writes.
+  std::vector<asio::const_buffer> small_buffers;
+  for (size_t i = 0; i < 600; ++i)
+    small_buffers.push_back(asio::buffer(write_data + i % 47, 5));
+
+  s.reset();
+  size_t bytes_transferred = asio::write(s, small_buffers);
+  ASIO_CHECK(bytes_transferred == 3000);
+  ASIO_CHECK(s.check_buffers(small_buffers, 3000));
+  ASIO_CHECK(s.write_count() <= 2);
+
+  s.reset();
+  s.next_write_length(7);
+  bytes_transferred = asio::write(s, small_buffers);
+  ASIO_CHECK(bytes_transferred == 3000);
+  ASIO_CHECK(s.check_buffers(small_buffers, 3000));
+
+  // Runs of small buffers between large ones.
+  std::vector<asio::const_buffer> mixed_buffers;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    if (i % 5 == 4)
+      mixed_buffers.push_back(asio::buffer(mutable_write_data, 40));
+    else
+      mixed_buffers.push_back(asio::buffer(write_data + i % 31, 3));
+  }
+
+  s.reset();
+  bytes_transferred = asio::write(s, mixed_buffers);
+  ASIO_CHECK(bytes_transferred == 2080);
+  ASIO_CHECK(s.check_buffers(mixed_buffers, 2080));
+  ASIO_CHECK(s.write_count() == 1);
+
+  s.reset();
+  s.next_write_length(39);
+  bytes_transferred = asio::write(s, mixed_buffers);
+  ASIO_CHECK(bytes_transferred == 2080);
+  ASIO_CHECK(s.check_buffers(mixed_buffers, 2080));
+
+  // Large buffers are not copied, but are still gathered in batches.
+  char large_data[200];
+  for (size_t i = 0; i < sizeof(large_data); ++i)
+    large_data[i] = write_data[i % 52];
+
+  std::vector<asio::const_buffer> large_buffers;
+  for (size_t i = 0; i < 70; ++i)
+    large_buffers.push_back(asio::buffer(large_data));
+
+  s.reset();
+  bytes_transferred = asio::write(s, large_buffers);
+  ASIO_CHECK(bytes_transferred == 14000);
+  ASIO_CHECK(s.check_buffers(large_buffers, 14000));
+  ASIO_CHECK(s.write_count() == 2);
+}
+
 void test_2_arg_dynamic_string_write()
 {
   asio::io_context ioc;
@@ -2454,6 +2530,65 @@ void test_3_arg_vector_buffers_async_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_3_arg_many_buffers_async_write()
+{
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+  char large_data[200];
+  for (size_t i = 0; i < sizeof(large_data); ++i)
+    large_data[i] = write_data[i % 52];
+
+  asio::io_context ioc;
+  large_test_stream s(ioc);
+  std::vector<asio::const_buffer> buffers;
+  for (size_t i = 0; i < 600; ++i)
+  {
+    if (i % 10 == 9)
+      buffers.push_back(asio::buffer(large_data));
+    else
+      buffers.push_back(asio::buffer(write_data + i % 47, 5));
+  }
+
+  s.reset();
+  bool called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 14700, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 14700));
+  ASIO_CHECK(s.write_count() <= 3);
+
+  s.reset();
+  s.next_write_length(1);
+  called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 14700, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 14700));
+
+  s.reset();
+  s.next_write_length(333);
+  called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, 14700, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, 14700));
+}
+
 void test_3_arg_dynamic_string_async_write()
 {
 #if defined(ASIO_HAS_BOOST_BIND)
@@ -4873,6 +5008,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_2_arg_const_buffer_write)
   ASIO_TEST_CASE(test_2_arg_mutable_buffer_write)
   ASIO_TEST_CASE(test_2_arg_vector_buffers_write)
+  ASIO_TEST_CASE(test_2_arg_many_buffers_write)
   ASIO_TEST_CASE(test_2_arg_dynamic_string_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_zero_buffers_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_const_buffer_write)
@@ -4892,6 +5028,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_3_arg_boost_array_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_std_array_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_vector_buffers_async_write)
+  ASIO_TEST_CASE(test_3_arg_many_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_dynamic_string_async_write)
   ASIO_TEST_CASE(test_3_arg_streambuf_async_write)
   ASIO_TEST_CASE(test_4_arg_const_buffer_async_write)